@@ -11,6 +11,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
 
+#include <userver/storages/clickhouse/cursor.hpp>
 #include <userver/storages/clickhouse/fwd.hpp>
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 #include <userver/storages/clickhouse/impl/pool.hpp>
@@ -60,6 +61,21 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters, streaming the result block by block.
+  /// See storages::clickhouse::Cursor for details.
+  template <typename... Args>
+  Cursor ExecuteStreaming(const Query& query, const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters,
+  /// streaming the result block by block.
+  /// @note The command control timeout covers the whole streaming.
+  /// See storages::clickhouse::Cursor for details.
+  template <typename... Args>
+  Cursor ExecuteStreaming(OptionalCommandControl, const Query& query,
+                          const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -116,6 +132,13 @@ class Cluster final {
                   const std::vector<std::string_view>& column_names,
                   const Container& data) const;
 
+  /// @brief Insert an already built block with specified command control
+  /// settings at some host of the cluster.
+  /// Meant for the helpers that build the block themselves, like
+  /// storages::clickhouse::InsertionBuffer.
+  void InsertRequest(OptionalCommandControl,
+                     const impl::InsertionRequest& request) const;
+
   /// Write cluster statistics
   void WriteStatistics(
       USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
@@ -131,6 +154,8 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  Cursor DoExecuteStreaming(OptionalCommandControl, const Query& query) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -175,6 +200,12 @@ void Cluster::InsertRows(OptionalCommandControl optional_cc,
   DoInsert(optional_cc, request);
 }
 
+inline void Cluster::InsertRequest(
+    OptionalCommandControl optional_cc,
+    const impl::InsertionRequest& request) const {
+  DoInsert(optional_cc, request);
+}
+
 template <typename... Args>
 ExecutionResult Cluster::Execute(const Query& query,
                                  const Args&... args) const {
@@ -189,6 +220,20 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename... Args>
+Cursor Cluster::ExecuteStreaming(const Query& query,
+                                 const Args&... args) const {
+  return ExecuteStreaming(OptionalCommandControl{}, query, args...);
+}
+
+template <typename... Args>
+Cursor Cluster::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                 const Query& query,
+                                 const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  return DoExecuteStreaming(optional_cc, formatted_query);
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,83 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/cursor.hpp
+/// @brief @copybrief storages::clickhouse::Cursor
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include <userver/storages/clickhouse/execution_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+class Pool;
+}
+
+// clang-format off
+
+/// @brief Streams the result of a query block by block, as the native blocks
+/// arrive from the server.
+///
+/// Usually retrieved from storages::clickhouse::Cluster::ExecuteStreaming.
+/// At most `max_buffered_blocks` blocks are kept between the connection and
+/// the consumer: while the consumer is busy with a block, the connection
+/// stops reading and the server pauses sending. So the memory stays bounded
+/// by a few blocks regardless of the result size.
+///
+/// The connection is held until the cursor is exhausted or destroyed, and
+/// the command control timeout covers the whole streaming, including the time
+/// spent by the consumer. Destroying the cursor early cancels the query.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/cursor_chtest.cpp  Sample Cursor usage
+
+// clang-format on
+class Cursor final {
+ public:
+  /// Default number of blocks buffered between the connection and consumer.
+  static constexpr std::size_t kDefaultMaxBufferedBlocks = 2;
+
+  Cursor(Cursor&&) noexcept;
+  Cursor& operator=(Cursor&&) noexcept;
+  ~Cursor();
+
+  /// @brief Waits for the next non-empty block of the result.
+  ///
+  /// Use ExecutionResult::As, ExecutionResult::AsRows or
+  /// ExecutionResult::AsContainer to map the block.
+  /// @returns std::nullopt if the result is exhausted.
+  /// @throws std::exception if the query failed.
+  std::optional<ExecutionResult> NextBlock();
+
+  /// @brief Calls `func` with every row of the result, mapped to `Row`.
+  /// See @ref clickhouse_io for better understanding of `Row`'s requirements.
+  template <typename Row, typename Func>
+  void ForEachRow(Func&& func);
+
+ private:
+  friend class impl::Pool;
+
+  struct Impl;
+
+  explicit Cursor(std::unique_ptr<Impl>&& impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+template <typename Row, typename Func>
+void Cursor::ForEachRow(Func&& func) {
+  while (auto block = NextBlock()) {
+    for (auto&& row : std::move(*block).AsRows<Row>()) {
+      func(std::move(row));
+    }
+  }
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,282 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/insertion_buffer.hpp
+/// @brief @copybrief storages::clickhouse::InsertionBuffer
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/clickhouse/impl/insertion_request.hpp>
+#include <userver/storages/clickhouse/io/impl/validate.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+class Cluster;
+
+/// @brief Settings for storages::clickhouse::InsertionBuffer
+struct InsertionBufferSettings final {
+  /// Number of buffered rows that triggers a flush.
+  std::size_t max_rows{10000};
+
+  /// Max time the rows stay in the buffer before being flushed.
+  std::chrono::milliseconds flush_interval{1000};
+
+  /// Rows added when this many rows are already buffered are dropped. Guards
+  /// the memory while ClickHouse is unavailable.
+  std::size_t max_buffered_rows{100000};
+
+  /// Number of attempts to insert a block after the first one failed. A failed
+  /// attempt may still have written the block, so retries duplicate the rows
+  /// unless the table deduplicates inserted blocks; use 0 for other tables.
+  std::size_t max_retries{3};
+
+  /// Delay before the first retry, doubled for every next one.
+  std::chrono::milliseconds retry_delay{100};
+
+  /// Command control of a single insert attempt.
+  OptionalCommandControl command_control;
+};
+
+namespace impl {
+
+template <typename MappedType>
+struct ColumnsStorage;
+
+template <typename... Columns>
+struct ColumnsStorage<std::tuple<Columns...>> final {
+  using type = std::tuple<std::vector<typename Columns::cpp_type>...>;
+};
+
+struct InsertionBufferStatistics;
+
+/// Non-template part of InsertionBuffer: inserts the blocks and accounts them
+class InsertionBufferCore final {
+ public:
+  InsertionBufferCore(std::shared_ptr<Cluster> cluster, std::string table_name,
+                      std::vector<std::string> column_names,
+                      const InsertionBufferSettings& settings);
+  ~InsertionBufferCore();
+
+  const std::string& GetTableName() const { return table_name_; }
+
+  const std::vector<std::string_view>& GetColumnNames() const {
+    return column_name_views_;
+  }
+
+  const InsertionBufferSettings& GetSettings() const { return settings_; }
+
+  /// Inserts the block with a new deduplication token, retrying it with the
+  /// same token on failures, so the table drops the copies that did get
+  /// through, if it deduplicates inserts.
+  void Insert(InsertionRequest& request, std::size_t rows);
+
+  void AccountDropped(std::size_t rows);
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+ private:
+  const std::shared_ptr<Cluster> cluster_;
+  const std::string table_name_;
+  const std::vector<std::string> column_names_;
+  const std::vector<std::string_view> column_name_views_;
+  const InsertionBufferSettings settings_;
+  std::unique_ptr<InsertionBufferStatistics> stats_;
+};
+
+}  // namespace impl
+
+// clang-format off
+
+/// @brief Accumulates rows from concurrent callers and inserts them into a
+/// ClickHouse table in large blocks.
+///
+/// Inserting a few rows per Cluster::Insert call creates a data part per
+/// call, which ClickHouse merges poorly. The buffer appends the rows to
+/// per-column vectors (using the @ref clickhouse_io "io::columns" mapping of
+/// `Row`) and turns them into a single native block when `max_rows` rows
+/// are buffered or `flush_interval` passes, whichever comes first.
+///
+/// Failed inserts are retried with the very same block. An attempt that
+/// failed on the client side (e.g. by a timeout) may still have been written
+/// by the server, so each flush gets a unique `insert_deduplication_token`
+/// that its retries share: the server drops a retried block it has already
+/// written, while identical blocks of different flushes are all kept. This
+/// requires the table to deduplicate inserts: Replicated*MergeTree tables do
+/// that by default, plain MergeTree tables need
+/// `non_replicated_deduplication_window` to be set. For other tables a retry
+/// may write the rows twice; set `max_retries` to 0 if duplicates are not
+/// acceptable.
+///
+/// Rows of a block that failed all the attempts are dropped and accounted in
+/// the statistics. Compression of the blocks is configured by the
+/// `compression` option of components::ClickHouse.
+///
+/// `Row` is expected to be a struct of clickhouse-mapped fields, as for
+/// Cluster::InsertRows.
+
+// clang-format on
+template <typename Row>
+class InsertionBuffer final {
+ public:
+  InsertionBuffer(std::shared_ptr<Cluster> cluster, std::string table_name,
+                  std::vector<std::string> column_names,
+                  const InsertionBufferSettings& settings);
+
+  /// Stops the periodic flushes and flushes the remaining rows
+  ~InsertionBuffer();
+
+  InsertionBuffer(const InsertionBuffer&) = delete;
+  InsertionBuffer& operator=(const InsertionBuffer&) = delete;
+
+  /// @brief Adds a row to the buffer, triggers an asynchronous flush if the
+  /// buffer is full. Never waits for the insert.
+  void Add(Row row);
+
+  /// @brief Inserts the buffered rows right away.
+  /// @throws std::exception if all the insert attempts failed
+  void Flush();
+
+  /// @brief Number of rows waiting for a flush
+  std::size_t GetBufferedRowsCount() const;
+
+  /// Write buffer statistics
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+ private:
+  using MappedType = typename io::CppToClickhouse<Row>::mapped_type;
+  using Columns = typename impl::ColumnsStorage<MappedType>::type;
+
+  static constexpr auto kIndices =
+      std::make_index_sequence<std::tuple_size_v<MappedType>>{};
+
+  template <std::size_t... Indices>
+  static void AppendRow(Columns& columns, Row&& row,
+                        std::index_sequence<Indices...>) {
+    (std::get<Indices>(columns).push_back(
+         std::move(boost::pfr::get<Indices>(row))),
+     ...);
+  }
+
+  template <std::size_t... Indices>
+  static void ReserveColumns(Columns& columns, std::size_t rows,
+                             std::index_sequence<Indices...>) {
+    (std::get<Indices>(columns).reserve(rows), ...);
+  }
+
+  impl::InsertionBufferCore core_;
+
+  mutable engine::Mutex mutex_;
+  Columns columns_;
+  std::size_t rows_{0};
+
+  // Serializes the flushes, so the blocks are inserted in the order of Add
+  engine::Mutex flush_mutex_;
+  utils::PeriodicTask flush_task_;
+};
+
+template <typename Row>
+InsertionBuffer<Row>::InsertionBuffer(std::shared_ptr<Cluster> cluster,
+                                      std::string table_name,
+                                      std::vector<std::string> column_names,
+                                      const InsertionBufferSettings& settings)
+    : core_(std::move(cluster), std::move(table_name), std::move(column_names),
+            settings) {
+  io::impl::ValidateRowsMapping<Row>();
+  io::impl::ValidateColumnsCount<Row>(core_.GetColumnNames().size());
+  UINVARIANT(settings.max_rows > 0, "max_rows should be positive");
+  UINVARIANT(settings.max_buffered_rows >= settings.max_rows,
+             "max_buffered_rows should not be less than max_rows");
+
+  ReserveColumns(columns_, settings.max_rows, kIndices);
+  flush_task_.Start("ch_insertion_buffer/" + core_.GetTableName(),
+                    settings.flush_interval, [this] { Flush(); });
+}
+
+template <typename Row>
+InsertionBuffer<Row>::~InsertionBuffer() {
+  flush_task_.Stop();
+  try {
+    Flush();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to flush the insertion buffer of table '"
+                << core_.GetTableName() << "' on destruction: " << ex;
+  }
+}
+
+template <typename Row>
+void InsertionBuffer<Row>::Add(Row row) {
+  bool is_full = false;
+  {
+    std::lock_guard lock{mutex_};
+    if (rows_ >= core_.GetSettings().max_buffered_rows) {
+      core_.AccountDropped(1);
+      return;
+    }
+    AppendRow(columns_, std::move(row), kIndices);
+    ++rows_;
+    // Keep forcing the flush while the rows are over the limit, the one
+    // forced on reaching it may have failed
+    is_full = rows_ >= core_.GetSettings().max_rows;
+  }
+
+  if (is_full) flush_task_.ForceStepAsync();
+}
+
+template <typename Row>
+void InsertionBuffer<Row>::Flush() {
+  std::lock_guard flush_lock{flush_mutex_};
+
+  Columns columns;
+  std::size_t rows = 0;
+  {
+    std::lock_guard lock{mutex_};
+    if (rows_ == 0) return;
+    std::swap(columns, columns_);
+    std::swap(rows, rows_);
+  }
+
+  {
+    // Reserve the buffer for the next block outside of the lock. If Add() has
+    // appended to the buffer meanwhile, the buffer just grows as needed.
+    Columns next_columns;
+    ReserveColumns(next_columns, core_.GetSettings().max_rows, kIndices);
+    std::lock_guard lock{mutex_};
+    if (rows_ == 0) std::swap(next_columns, columns_);
+  }
+
+  auto request = impl::InsertionRequest::CreateFromColumns<Row>(
+      core_.GetTableName(), core_.GetColumnNames(), columns);
+  core_.Insert(request, rows);
+}
+
+template <typename Row>
+std::size_t InsertionBuffer<Row>::GetBufferedRowsCount() const {
+  std::lock_guard lock{mutex_};
+  return rows_;
+}
+
+template <typename Row>
+void InsertionBuffer<Row>::WriteStatistics(
+    utils::statistics::Writer& writer) const {
+  core_.WriteStatistics(writer);
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,116 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/insertion_buffer_component.hpp
+/// @brief @copybrief storages::clickhouse::InsertionBufferComponent
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/storages/clickhouse/insertion_buffer.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+
+std::shared_ptr<Cluster> FindCluster(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context);
+
+InsertionBufferSettings ParseInsertionBufferSettings(
+    const components::ComponentConfig& config);
+
+utils::statistics::Entry RegisterInsertionBufferStatistics(
+    const components::ComponentContext& context, const std::string& table_name,
+    std::function<void(utils::statistics::Writer&)> func);
+
+yaml_config::Schema GetInsertionBufferComponentSchema();
+
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components userver_base_classes
+///
+/// @brief Base class for components that buffer rows for a ClickHouse table,
+/// see storages::clickhouse::InsertionBuffer.
+///
+/// ## Static options:
+/// Name              | Description                                          | Default value
+/// ----------------- | ---------------------------------------------------- | -------------
+/// clickhouse        | name of the components::ClickHouse component        | --
+/// table             | table to insert into                                 | --
+/// columns           | names of the columns, in the order of `Row` fields   | --
+/// max-rows          | number of buffered rows that triggers a flush        | 10000
+/// flush-interval    | max time the rows stay in the buffer                 | 1s
+/// max-buffered-rows | rows added above this limit are dropped              | 100000
+/// max-retries       | retries of a failed insert, may duplicate rows       | 3
+/// retry-delay       | delay before the first retry, doubled for each next  | 100ms
+/// insert-timeout    | timeout of a single insert attempt                   | driver default
+///
+/// ## Statistics
+/// Reported under `clickhouse.insertion-buffer` with the `clickhouse_table`
+/// label: inserted rows and blocks, retries, failed flushes, dropped rows,
+/// rows-per-block histogram and flush timings (including retries).
+
+// clang-format on
+template <typename Row>
+class InsertionBufferComponent : public components::ComponentBase {
+ public:
+  InsertionBufferComponent(const components::ComponentConfig& config,
+                           const components::ComponentContext& context);
+
+  ~InsertionBufferComponent() override;
+
+  /// @copydoc InsertionBuffer::Add
+  void Add(Row row) { buffer_.Add(std::move(row)); }
+
+  /// @copydoc InsertionBuffer::Flush
+  void Flush() { buffer_.Flush(); }
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  InsertionBuffer<Row> buffer_;
+
+  // Subscriptions must be the last fields.
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <typename Row>
+InsertionBufferComponent<Row>::InsertionBufferComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : ComponentBase(config, context),
+      buffer_(impl::FindCluster(config, context),
+              config["table"].As<std::string>(),
+              config["columns"].As<std::vector<std::string>>(),
+              impl::ParseInsertionBufferSettings(config)) {
+  statistics_holder_ = impl::RegisterInsertionBufferStatistics(
+      context, config["table"].As<std::string>(),
+      [this](utils::statistics::Writer& writer) {
+        buffer_.WriteStatistics(writer);
+      });
+}
+
+template <typename Row>
+InsertionBufferComponent<Row>::~InsertionBufferComponent() {
+  statistics_holder_.Unregister();
+}
+
+template <typename Row>
+yaml_config::Schema InsertionBufferComponent<Row>::GetStaticConfigSchema() {
+  return impl::GetInsertionBufferComponentSchema();
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,37 @@
+#include <userver/storages/clickhouse/cursor.hpp>
+
+#include <userver/utils/assert.hpp>
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+#include <storages/clickhouse/impl/cursor_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+Cursor::Cursor(std::unique_ptr<Impl>&& impl) : impl_{std::move(impl)} {}
+
+Cursor::Cursor(Cursor&&) noexcept = default;
+
+Cursor& Cursor::operator=(Cursor&&) noexcept = default;
+
+Cursor::~Cursor() = default;
+
+std::optional<ExecutionResult> Cursor::NextBlock() {
+  UINVARIANT(impl_, "NextBlock called on a moved-from Cursor");
+  if (!impl_->consumer) return std::nullopt;
+
+  impl::BlockWrapperPtr block;
+  if (impl_->consumer->Pop(block)) {
+    return ExecutionResult{std::move(block)};
+  }
+
+  // The producer is done and the queue is drained, rethrow its error if any
+  impl_->consumer.reset();
+  impl_->producer.Get();
+  return std::nullopt;
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,8 @@
 
 #include <exception>
 
+#include <fmt/format.h>
+
 #include <clickhouse/block.h>
 #include <clickhouse/query.h>
 
@@ -104,13 +106,53 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteStreaming(
+    OptionalCommandControl optional_cc, const Query& query,
+    const std::function<bool(BlockWrapperPtr)>& on_block) {
+  clickhouse_cpp::Query native_query{query.QueryText()};
+
+  auto& span = tracing::Span::CurrentSpan();
+  auto scope = span.CreateScopeTime(scopes::kExec);
+
+  native_query.OnDataCancelable(
+      [&on_block, &scope](const NativeBlock& data) {
+        scope.Reset(scopes::kExec);
+        // we must return 'true' if we don't want to cancel query
+        if (engine::current_task::ShouldCancel()) return false;
+        if (data.GetRowCount() == 0) return true;
+
+        // Blocks share the columns on copy, the data is not copied
+        auto block = NativeBlock{data};
+        return on_block(BlockWrapperPtr{new BlockWrapper{std::move(block)}});
+      });
+
+  DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
+  const auto& token = request.GetDeduplicationToken();
+
+  // clickhouse-cpp can't send settings with an INSERT, so the token is set
+  // in the session for this insert only. A failure breaks the connection,
+  // so the token never leaks to the inserts of other requests.
+  if (!token.empty()) {
+    DoExecute(optional_cc,
+              clickhouse_cpp::Query{fmt::format(
+                  "SET insert_deduplication_token = '{}'", token)});
+  }
 
-  auto guard = GetBrokenGuard();
-  client_.Insert(request.GetTableName(), block.GetNative(),
-                 GetDeadline(optional_cc));
+  {
+    auto guard = GetBrokenGuard();
+    client_.Insert(request.GetTableName(), block.GetNative(),
+                   GetDeadline(optional_cc));
+  }
+
+  if (!token.empty()) {
+    DoExecute(optional_cc,
+              clickhouse_cpp::Query{"SET insert_deduplication_token = ''"});
+  }
 }
 
 void Connection::Ping() {
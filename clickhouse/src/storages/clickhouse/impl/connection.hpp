@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
@@ -28,6 +30,11 @@ class Connection final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  /// Calls `on_block` for every non-empty block of the result as it arrives,
+  /// the query is cancelled if `on_block` returns false.
+  void ExecuteStreaming(OptionalCommandControl, const Query&,
+                        const std::function<bool(BlockWrapperPtr)>& on_block);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
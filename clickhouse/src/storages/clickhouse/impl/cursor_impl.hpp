@@ -0,0 +1,30 @@
+#pragma once
+
+#include <optional>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/clickhouse/cursor.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+
+using BlocksQueue = concurrent::SpscQueue<BlockWrapperPtr>;
+
+}  // namespace impl
+
+struct Cursor::Impl final {
+  // Cancelled and awaited on destruction
+  engine::TaskWithResult<void> producer;
+  // Destroyed before the producer, so that its pushes fail and it cancels
+  // the query
+  std::optional<impl::BlocksQueue::Consumer> consumer;
+};
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
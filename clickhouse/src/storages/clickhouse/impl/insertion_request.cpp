@@ -1,7 +1,12 @@
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 
+#include <algorithm>
+#include <cctype>
+
 #include <clickhouse/block.h>
 
+#include <userver/utils/assert.hpp>
+
 #include <storages/clickhouse/impl/block_wrapper.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +31,20 @@ const std::string& InsertionRequest::GetTableName() const {
 
 const impl::BlockWrapper& InsertionRequest::GetBlock() const { return *block_; }
 
+void InsertionRequest::SetDeduplicationToken(std::string token) {
+  // The token is sent in a query text, see Connection::Insert
+  UINVARIANT(std::all_of(token.begin(), token.end(),
+                         [](unsigned char c) {
+                           return std::isalnum(c) || c == '-' || c == '_';
+                         }),
+             "Deduplication token should be alphanumeric");
+  deduplication_token_ = std::move(token);
+}
+
+const std::string& InsertionRequest::GetDeduplicationToken() const {
+  return deduplication_token_;
+}
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
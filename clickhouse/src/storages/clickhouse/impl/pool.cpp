@@ -4,9 +4,11 @@
 
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/async.hpp>
 
 #include <storages/clickhouse/impl/connection.hpp>
 #include <storages/clickhouse/impl/connection_ptr.hpp>
+#include <storages/clickhouse/impl/cursor_impl.hpp>
 #include <storages/clickhouse/impl/pool_impl.hpp>
 #include <storages/clickhouse/impl/tracing_tags.hpp>
 #include <userver/formats/json/value_builder.hpp>
@@ -45,6 +47,34 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc,
   return conn_ptr->Execute(optional_cc, query);
 }
 
+Cursor Pool::ExecuteStreaming(OptionalCommandControl optional_cc,
+                             const Query& query,
+                             std::size_t max_buffered_blocks) const {
+  auto queue = BlocksQueue::Create(max_buffered_blocks);
+  auto impl = std::make_unique<Cursor::Impl>();
+  impl->consumer.emplace(queue->GetConsumer());
+  impl->producer = USERVER_NAMESPACE::utils::Async(
+      "clickhouse_stream",
+      [pool = impl_, optional_cc, query,
+       producer = queue->GetProducer()]() mutable {
+        auto conn_ptr = pool->Acquire();
+
+        auto span =
+            PrepareExecutionSpan(impl::scopes::kQuery, pool->GetHostName());
+        query.FillSpanTags(span);
+
+        const auto timer = pool->GetExecuteTimer();
+        conn_ptr->ExecuteStreaming(
+            optional_cc, query, [&producer](BlockWrapperPtr block) {
+              // Blocks while the consumer is behind, so the connection stops
+              // reading and the server pauses sending
+              return producer.Push(std::move(block));
+            });
+      });
+
+  return Cursor{std::move(impl)};
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc,
                   const InsertionRequest& request) const {
   auto conn_ptr = impl_->Acquire();
@@ -0,0 +1,109 @@
+#include <userver/storages/clickhouse/insertion_buffer.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/percentile_format_json.hpp>
+#include <userver/utils/uuid4.hpp>
+
+#include <storages/clickhouse/stats/pool_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+namespace {
+
+constexpr double kRowsPerBlockBounds[] = {1,    10,    100,    1000,
+                                          10000, 100000, 1000000};
+
+std::vector<std::string_view> MakeViews(
+    const std::vector<std::string>& strings) {
+  return {strings.begin(), strings.end()};
+}
+
+}  // namespace
+
+struct InsertionBufferStatistics final {
+  stats::Counter rows{};
+  stats::Counter blocks{};
+  stats::Counter retries{};
+  stats::Counter failed_flushes{};
+  stats::Counter dropped_rows{};
+  utils::statistics::Histogram rows_per_block{kRowsPerBlockBounds};
+  stats::RecentPeriod flush_timings{};
+};
+
+InsertionBufferCore::InsertionBufferCore(
+    std::shared_ptr<Cluster> cluster, std::string table_name,
+    std::vector<std::string> column_names,
+    const InsertionBufferSettings& settings)
+    : cluster_(std::move(cluster)),
+      table_name_(std::move(table_name)),
+      column_names_(std::move(column_names)),
+      column_name_views_(MakeViews(column_names_)),
+      settings_(settings),
+      stats_(std::make_unique<InsertionBufferStatistics>()) {
+  UINVARIANT(cluster_, "InsertionBuffer requires a cluster");
+}
+
+InsertionBufferCore::~InsertionBufferCore() = default;
+
+void InsertionBufferCore::Insert(InsertionRequest& request, std::size_t rows) {
+  request.SetDeduplicationToken(utils::generators::GenerateUuid());
+
+  const auto start = std::chrono::steady_clock::now();
+  auto retry_delay = settings_.retry_delay;
+  for (std::size_t attempt = 0;; ++attempt) {
+    try {
+      cluster_->InsertRequest(settings_.command_control, request);
+      break;
+    } catch (const std::exception& ex) {
+      if (attempt >= settings_.max_retries ||
+          engine::current_task::ShouldCancel()) {
+        ++stats_->failed_flushes;
+        stats_->dropped_rows += rows;
+        LOG_ERROR() << "Failed to insert " << rows << " rows into '"
+                    << table_name_ << "', dropping them: " << ex;
+        throw;
+      }
+
+      ++stats_->retries;
+      LOG_WARNING() << "Failed to insert " << rows << " rows into '"
+                    << table_name_ << "', retrying in " << retry_delay.count()
+                    << "ms: " << ex;
+      engine::InterruptibleSleepFor(retry_delay);
+      retry_delay *= 2;
+    }
+  }
+
+  stats_->rows += rows;
+  ++stats_->blocks;
+  stats_->rows_per_block.Account(rows);
+  stats_->flush_timings.GetCurrentCounter().Account(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+}
+
+void InsertionBufferCore::AccountDropped(std::size_t rows) {
+  stats_->dropped_rows += rows;
+  LOG_LIMITED_WARNING() << "Insertion buffer of '" << table_name_
+                        << "' is full, dropping rows";
+}
+
+void InsertionBufferCore::WriteStatistics(
+    utils::statistics::Writer& writer) const {
+  writer["rows"] = stats_->rows;
+  writer["blocks"] = stats_->blocks;
+  writer["retries"] = stats_->retries;
+  writer["failed-flushes"] = stats_->failed_flushes;
+  writer["dropped-rows"] = stats_->dropped_rows;
+  writer["rows-per-block"] = stats_->rows_per_block;
+  writer["flush-timings"] = stats_->flush_timings;
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,106 @@
+#include <userver/storages/clickhouse/insertion_buffer_component.hpp>
+
+#include <chrono>
+#include <optional>
+
+#include <userver/components/statistics_storage.hpp>
+#include <userver/storages/clickhouse/component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+std::shared_ptr<Cluster> FindCluster(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context) {
+  return context
+      .FindComponent<components::ClickHouse>(
+          config["clickhouse"].As<std::string>())
+      .GetCluster();
+}
+
+InsertionBufferSettings ParseInsertionBufferSettings(
+    const components::ComponentConfig& config) {
+  InsertionBufferSettings settings;
+  settings.max_rows = config["max-rows"].As<std::size_t>(settings.max_rows);
+  settings.flush_interval =
+      config["flush-interval"].As<std::chrono::milliseconds>(
+          settings.flush_interval);
+  settings.max_buffered_rows =
+      config["max-buffered-rows"].As<std::size_t>(settings.max_buffered_rows);
+  settings.max_retries =
+      config["max-retries"].As<std::size_t>(settings.max_retries);
+  settings.retry_delay = config["retry-delay"].As<std::chrono::milliseconds>(
+      settings.retry_delay);
+
+  const auto insert_timeout =
+      config["insert-timeout"].As<std::optional<std::chrono::milliseconds>>();
+  if (insert_timeout) {
+    settings.command_control.emplace(*insert_timeout);
+  }
+  return settings;
+}
+
+utils::statistics::Entry RegisterInsertionBufferStatistics(
+    const components::ComponentContext& context, const std::string& table_name,
+    std::function<void(utils::statistics::Writer&)> func) {
+  return context.FindComponent<components::StatisticsStorage>()
+      .GetStorage()
+      .RegisterWriter("clickhouse.insertion-buffer", std::move(func),
+                      {{"clickhouse_table", table_name}});
+}
+
+yaml_config::Schema GetInsertionBufferComponentSchema() {
+  return yaml_config::MergeSchemas<components::ComponentBase>(R"(
+type: object
+description: Base class for ClickHouse insertion buffer components
+additionalProperties: false
+properties:
+    clickhouse:
+        type: string
+        description: name of the components::ClickHouse component
+    table:
+        type: string
+        description: table to insert into
+    columns:
+        type: array
+        description: names of the columns, in the order of Row fields
+        items:
+            type: string
+            description: column name
+    max-rows:
+        type: integer
+        description: number of buffered rows that triggers a flush
+        defaultDescription: 10000
+        minimum: 1
+    flush-interval:
+        type: string
+        description: max time the rows stay in the buffer
+        defaultDescription: 1s
+    max-buffered-rows:
+        type: integer
+        description: rows added above this limit are dropped
+        defaultDescription: 100000
+        minimum: 1
+    max-retries:
+        type: integer
+        description: |
+            number of retries of a failed insert; retries may duplicate rows
+            unless the table deduplicates inserted blocks
+        defaultDescription: 3
+        minimum: 0
+    retry-delay:
+        type: string
+        description: delay before the first retry, doubled for each next one
+        defaultDescription: 100ms
+    insert-timeout:
+        type: string
+        description: timeout of a single insert attempt
+        defaultDescription: driver default
+)");
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
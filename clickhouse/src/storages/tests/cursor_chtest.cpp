@@ -0,0 +1,100 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/storages/clickhouse/cursor.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Numbers final {
+  std::vector<uint64_t> numbers;
+};
+
+struct Number final {
+  uint64_t number;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Numbers> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+template <>
+struct CppToClickhouse<Number> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+// ClickHouse splits the result into blocks of max_block_size rows
+const storages::clickhouse::Query kManyBlocksQuery{
+    "SELECT number FROM system.numbers LIMIT 1000000 "
+    "SETTINGS max_block_size = 10000"};
+
+}  // namespace
+
+UTEST(Cursor, StreamsBlocks) {
+  ClusterWrapper cluster{};
+
+  /// [Sample Cursor usage]
+  auto cursor = cluster->ExecuteStreaming(kManyBlocksQuery);
+
+  uint64_t sum = 0;
+  std::size_t blocks = 0;
+  while (auto block = cursor.NextBlock()) {
+    ++blocks;
+    const auto batch = std::move(*block).As<Numbers>();
+    for (const auto number : batch.numbers) sum += number;
+  }
+  /// [Sample Cursor usage]
+
+  EXPECT_EQ(sum, uint64_t{1000000} * (1000000 - 1) / 2);
+  EXPECT_GT(blocks, 1);
+  EXPECT_FALSE(cursor.NextBlock().has_value());
+}
+
+UTEST(Cursor, ForEachRow) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteStreaming(kManyBlocksQuery);
+  uint64_t expected = 0;
+  cursor.ForEachRow<Number>([&expected](Number row) {
+    EXPECT_EQ(row.number, expected);
+    ++expected;
+  });
+  EXPECT_EQ(expected, 1000000);
+}
+
+UTEST(Cursor, EarlyDestructionCancelsQuery) {
+  ClusterWrapper cluster{};
+
+  {
+    auto cursor = cluster->ExecuteStreaming(
+        "SELECT number FROM system.numbers SETTINGS max_block_size = 1000");
+    ASSERT_TRUE(cursor.NextBlock().has_value());
+  }
+
+  // The cluster is still usable
+  const auto result =
+      cluster->Execute("SELECT number FROM system.numbers LIMIT 10")
+          .As<Numbers>();
+  EXPECT_EQ(result.numbers.size(), 10);
+}
+
+UTEST(Cursor, PropagatesErrors) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteStreaming("SELECT * FROM nonexistent_table");
+  EXPECT_ANY_THROW(cursor.NextBlock());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,191 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/storages/clickhouse/insertion_buffer.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Event final {
+  uint64_t id;
+  std::string name;
+};
+
+struct Count final {
+  std::vector<uint64_t> value;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Event> final {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+template <>
+struct CppToClickhouse<Count> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+using Buffer = storages::clickhouse::InsertionBuffer<Event>;
+
+std::shared_ptr<storages::clickhouse::Cluster> NonOwning(
+    ClusterWrapper& cluster) {
+  return {std::shared_ptr<void>{}, &*cluster};
+}
+
+uint64_t CountRows(ClusterWrapper& cluster, const std::string& table) {
+  return cluster->Execute("SELECT count() FROM " + table)
+      .As<Count>()
+      .value.at(0);
+}
+
+class TableGuard final {
+ public:
+  TableGuard(ClusterWrapper& cluster, std::string name,
+             const std::string& engine = "Memory")
+      : cluster_{cluster}, name_{std::move(name)} {
+    cluster_->Execute("DROP TABLE IF EXISTS " + name_);
+    cluster_->Execute("CREATE TABLE " + name_ +
+                      "(id UInt64, name String) ENGINE = " + engine);
+  }
+
+  ~TableGuard() { cluster_->Execute("DROP TABLE IF EXISTS " + name_); }
+
+  const std::string& GetName() const { return name_; }
+
+ private:
+  ClusterWrapper& cluster_;
+  const std::string name_;
+};
+
+}  // namespace
+
+UTEST(InsertionBuffer, FlushesBySize) {
+  ClusterWrapper cluster{};
+  TableGuard table{cluster, "insertion_buffer_size"};
+
+  storages::clickhouse::InsertionBufferSettings settings;
+  settings.max_rows = 100;
+  settings.flush_interval = std::chrono::hours{1};
+  Buffer buffer{NonOwning(cluster), table.GetName(), {"id", "name"}, settings};
+
+  for (uint64_t i = 0; i < 100; ++i) {
+    buffer.Add({i, "name"});
+  }
+  while (buffer.GetBufferedRowsCount() != 0) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  // The rows are taken out of the buffer before the insert completes
+  buffer.Flush();
+  EXPECT_EQ(CountRows(cluster, table.GetName()), 100);
+}
+
+UTEST(InsertionBuffer, FlushesByTime) {
+  ClusterWrapper cluster{};
+  TableGuard table{cluster, "insertion_buffer_time"};
+
+  storages::clickhouse::InsertionBufferSettings settings;
+  settings.max_rows = 1000;
+  settings.flush_interval = std::chrono::milliseconds{50};
+  Buffer buffer{NonOwning(cluster), table.GetName(), {"id", "name"}, settings};
+
+  buffer.Add({1, "name"});
+  while (CountRows(cluster, table.GetName()) == 0) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  EXPECT_EQ(CountRows(cluster, table.GetName()), 1);
+}
+
+UTEST_MT(InsertionBuffer, ConcurrentWriters, 4) {
+  ClusterWrapper cluster{};
+  TableGuard table{cluster, "insertion_buffer_concurrent"};
+
+  storages::clickhouse::InsertionBufferSettings settings;
+  settings.max_rows = 500;
+  settings.flush_interval = std::chrono::milliseconds{20};
+  settings.max_buffered_rows = 100000;
+
+  constexpr uint64_t kWriters = 8;
+  constexpr uint64_t kRowsPerWriter = 1000;
+  constexpr std::int64_t kTotalRows = kWriters * kRowsPerWriter;
+  {
+    Buffer buffer{NonOwning(cluster), table.GetName(), {"id", "name"},
+                  settings};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (uint64_t i = 0; i < kWriters; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&buffer, i] {
+        for (uint64_t j = 0; j < kRowsPerWriter; ++j) {
+          buffer.Add({i * kRowsPerWriter + j, "name"});
+        }
+      }));
+    }
+    engine::WaitAllChecked(tasks);
+
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter(
+        "buffer", [&buffer](utils::statistics::Writer& writer) {
+          buffer.WriteStatistics(writer);
+        });
+    buffer.Flush();
+    const auto stats = utils::statistics::Snapshot{storage, "buffer"};
+    EXPECT_EQ(stats.SingleMetric("rows").AsInt(), kTotalRows);
+    EXPECT_EQ(stats.SingleMetric("dropped-rows").AsInt(), 0);
+    EXPECT_GE(stats.SingleMetric("blocks").AsInt(), 1);
+  }
+  EXPECT_EQ(CountRows(cluster, table.GetName()), kWriters * kRowsPerWriter);
+}
+
+UTEST(InsertionBuffer, KeepsIdenticalBlocksOfDeduplicatingTable) {
+  ClusterWrapper cluster{};
+  TableGuard table{cluster, "insertion_buffer_dedup",
+                   "MergeTree ORDER BY id "
+                   "SETTINGS non_replicated_deduplication_window = 100"};
+
+  storages::clickhouse::InsertionBufferSettings settings;
+  settings.flush_interval = std::chrono::hours{1};
+  Buffer buffer{NonOwning(cluster), table.GetName(), {"id", "name"}, settings};
+
+  // Each flush has its own deduplication token, so the table does not take
+  // the second block for a retry of the first one
+  buffer.Add({1, "name"});
+  buffer.Flush();
+  buffer.Add({1, "name"});
+  buffer.Flush();
+  EXPECT_EQ(CountRows(cluster, table.GetName()), 2);
+
+  // The token does not stick to the connection
+  const Event event{1, "name"};
+  const std::vector<std::string_view> columns{"id", "name"};
+  cluster->InsertRows(table.GetName(), columns, std::vector{event});
+  cluster->InsertRows(table.GetName(), columns, std::vector{event});
+  EXPECT_EQ(CountRows(cluster, table.GetName()), 3);
+}
+
+UTEST(InsertionBuffer, DropsRowsOnFailures) {
+  ClusterWrapper cluster{};
+
+  storages::clickhouse::InsertionBufferSettings settings;
+  settings.max_rows = 10;
+  settings.flush_interval = std::chrono::hours{1};
+  settings.max_retries = 1;
+  settings.retry_delay = std::chrono::milliseconds{1};
+  Buffer buffer{NonOwning(cluster), "nonexistent", {"id", "name"}, settings};
+
+  buffer.Add({1, "name"});
+  EXPECT_ANY_THROW(buffer.Flush());
+  EXPECT_EQ(buffer.GetBufferedRowsCount(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+import asyncio
+import socket
+import ssl
+
+# Any response will do, only the handshakes matter
+_REQUEST = (
+    b'GET /unknown-path HTTP/1.1\r\n'
+    b'Host: localhost\r\n'
+    b'Connection: close\r\n\r\n'
+)
+
+
+def _make_ssl_context():
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    context.check_hostname = False
+    context.verify_mode = ssl.CERT_NONE
+    return context
+
+
+def _request(context, port, session):
+    with socket.create_connection(('localhost', port)) as sock:
+        with context.wrap_socket(
+                sock, server_hostname='localhost', session=session,
+        ) as tls:
+            tls.sendall(_REQUEST)
+            # TLS 1.3 session tickets arrive before the response
+            assert tls.recv(4096).startswith(b'HTTP/1.1')
+            return tls.session, tls.session_reused
+
+
+async def _request_async(context, port, session=None):
+    loop = asyncio.get_running_loop()
+    return await loop.run_in_executor(
+        None, _request, context, port, session,
+    )
+
+
+async def _handshakes(monitor_client, kind):
+    metric = await monitor_client.single_metric(
+        f'server.connections.tls-handshakes.{kind}',
+    )
+    return metric.value
+
+
+async def test_session_resumption(service_port, monitor_client):
+    full_before = await _handshakes(monitor_client, 'full')
+    resumed_before = await _handshakes(monitor_client, 'resumed')
+
+    # The same context is required to offer the saved session
+    context = _make_ssl_context()
+    session, reused = await _request_async(context, service_port)
+    assert not reused
+
+    _, reused = await _request_async(context, service_port, session)
+    assert reused
+
+    assert await _handshakes(monitor_client, 'resumed') == resumed_before + 1
+    assert await _handshakes(monitor_client, 'full') >= full_before + 1
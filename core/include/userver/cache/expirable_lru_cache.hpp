@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <optional>
 
 #include <userver/cache/lru_cache_config.hpp>
@@ -388,10 +389,17 @@ class LruCacheWrapper final {
  public:
   using Cache = ExpirableLruCache<Key, Value, Hash, Equal>;
   using ReadMode = typename Cache::ReadMode;
+  using InvalidateFunc = std::function<void(const Key&)>;
 
+  /// @param invalidate_func if set, is called by InvalidateByKey before
+  /// the key is invalidated in the cache, e.g. to invalidate it in a
+  /// lower-level storage.
   LruCacheWrapper(std::shared_ptr<Cache> cache,
-                  typename Cache::UpdateValueFunc update_func)
-      : cache_(std::move(cache)), update_func_(std::move(update_func)) {}
+                  typename Cache::UpdateValueFunc update_func,
+                  InvalidateFunc invalidate_func = {})
+      : cache_(std::move(cache)),
+        update_func_(std::move(update_func)),
+        invalidate_func_(std::move(invalidate_func)) {}
 
   /// Get cached value or evaluates if "key" is missing in cache
   Value Get(const Key& key, ReadMode read_mode = ReadMode::kUseCache) {
@@ -403,7 +411,10 @@ class LruCacheWrapper final {
     return cache_->GetOptional(key, update_func_);
   }
 
-  void InvalidateByKey(const Key& key) { cache_->InvalidateByKey(key); }
+  void InvalidateByKey(const Key& key) {
+    if (invalidate_func_) invalidate_func_(key);
+    cache_->InvalidateByKey(key);
+  }
 
   /// Update cached value in background
   void UpdateInBackground(const Key& key) {
@@ -416,6 +427,7 @@ class LruCacheWrapper final {
  private:
   std::shared_ptr<Cache> cache_;
   typename Cache::UpdateValueFunc update_func_;
+  InvalidateFunc invalidate_func_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -92,6 +92,14 @@ class LruCacheComponent : public components::ComponentBase,
  protected:
   virtual Value DoGetByKey(const Key& key) = 0;
 
+  /// Called by CacheWrapper::InvalidateByKey before the key is invalidated in
+  /// the memory cache. Override to invalidate it in a lower-level storage.
+  virtual void DoInvalidateByKey(const Key& /*key*/) {}
+
+  /// Called before the memory cache is dropped by the testsuite. Override to
+  /// drop a lower-level storage.
+  virtual void DoDropCache() {}
+
   std::shared_ptr<Cache> GetCacheRaw() { return cache_; }
 
  private:
@@ -174,11 +182,14 @@ LruCacheComponent<Key, Value, Hash, Equal>::~LruCacheComponent() {
 template <typename Key, typename Value, typename Hash, typename Equal>
 typename LruCacheComponent<Key, Value, Hash, Equal>::CacheWrapper
 LruCacheComponent<Key, Value, Hash, Equal>::GetCache() {
-  return CacheWrapper(cache_, [this](const Key& key) { return GetByKey(key); });
+  return CacheWrapper(
+      cache_, [this](const Key& key) { return GetByKey(key); },
+      [this](const Key& key) { DoInvalidateByKey(key); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::DropCache() {
+  DoDropCache();
   cache_->Invalidate();
 }
 
@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file userver/concurrent/flat_combining_lock.hpp
+/// @brief @copybrief concurrent::FlatCombiningLock
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <userver/utils/function_ref.hpp>
+#include <userver/utils/result_store.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+class AsyncFlatCombiningQueue;
+}  // namespace engine::impl
+
+namespace concurrent {
+
+namespace impl {
+
+class FlatCombiningLockImpl final {
+ public:
+  FlatCombiningLockImpl();
+  ~FlatCombiningLockImpl();
+
+  FlatCombiningLockImpl(FlatCombiningLockImpl&&) = delete;
+  FlatCombiningLockImpl& operator=(FlatCombiningLockImpl&&) = delete;
+
+  // Runs the operation exclusively, either in the current task, or in the task
+  // that currently holds the lock. The operation must not throw.
+  void Run(utils::function_ref<void()> operation) noexcept;
+
+ private:
+  const std::unique_ptr<engine::impl::AsyncFlatCombiningQueue> queue_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Container for shared data, operations on which are executed
+/// exclusively via flat combining.
+///
+/// Instead of waiting for the lock, a coroutine publishes its operation to a
+/// queue. The coroutine that holds the lock (the "combiner") executes the
+/// published operations in a batch and wakes up their owners. This saves
+/// the lock handoffs and most context switches, so for short critical
+/// sections under contention FlatCombiningLock is considerably faster than
+/// engine::Mutex. As a downside, operations are executed in an arbitrary
+/// task, so they must not rely on the current task, task-local variables
+/// or the tracing span.
+///
+/// After a batch of operations the combiner passes the lock to the owner of
+/// the next operation, so the latency of a single Apply is bounded.
+///
+/// Ignores task cancellations (waits for the operation even if the current
+/// task is cancelled).
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/flat_combining_lock_test.cpp  Sample usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename T>
+class FlatCombiningLock final {
+ public:
+  template <typename... Args>
+  explicit FlatCombiningLock(Args&&... args)
+      : data_(std::forward<Args>(args)...) {}
+
+  /// @brief Runs `func(data)` while no other operation on the data is being
+  /// run, in the current task or in another task.
+  /// @returns the result of `func`
+  /// @throws whatever `func` throws
+  /// @note `func` must not block for a long time, as it blocks the
+  /// operations of other coroutines.
+  template <typename Func>
+  std::invoke_result_t<Func&, T&> Apply(Func&& func);
+
+  /// Get raw data. Use with extreme caution, only for cases where it is
+  /// known that no operations are running, e.g. in a destructor.
+  T& GetDataUnsafe() noexcept { return data_; }
+
+  /// @overload
+  const T& GetDataUnsafe() const noexcept { return data_; }
+
+ private:
+  impl::FlatCombiningLockImpl impl_;
+  T data_;
+};
+
+template <typename T>
+template <typename Func>
+std::invoke_result_t<Func&, T&> FlatCombiningLock<T>::Apply(Func&& func) {
+  using Result = std::invoke_result_t<Func&, T&>;
+  static_assert(!std::is_reference_v<Result>,
+                "Returning references to the data is unsafe, as the data "
+                "is only protected while the operation runs");
+  utils::ResultStore<Result> result;
+
+  impl_.Run([&]() noexcept {
+    try {
+      if constexpr (std::is_void_v<Result>) {
+        func(data_);
+        result.SetValue();
+      } else {
+        result.SetValue(func(data_));
+      }
+    } catch (...) {
+      result.SetException(std::current_exception());
+    }
+  });
+
+  return result.Retrieve();
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
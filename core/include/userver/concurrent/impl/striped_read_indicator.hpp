@@ -52,6 +52,14 @@ class StripedReadIndicator final {
   /// unexpectedly not being visible to `IsFree`.
   StripedReadIndicatorLock Lock() noexcept;
 
+  /// @brief Same as `Lock`, but without a lock object, for the cases where
+  /// the lock can not be stored, e.g. `lock_shared`-`unlock_shared` pairs.
+  /// Each `DoLock` call must be matched by exactly one `DoUnlock` call.
+  void DoLock() noexcept;
+
+  /// @brief Drops a lock acquired via `DoLock`.
+  void DoUnlock() noexcept;
+
   /// @returns `true` if there are no locks held on the `StripedReadIndicator`.
   /// @note `IsFree` should only be called after direct access to this
   /// StripedReadIndicator is closed for readers. Locks acquired during
@@ -91,11 +99,6 @@ class StripedReadIndicator final {
   std::uintptr_t GetActiveCountApprox() const noexcept;
 
  private:
-  friend class StripedReadIndicatorLock;
-
-  void DoLock() noexcept;
-  void DoUnlock() noexcept;
-
   StripedCounter acquired_count_;
   StripedCounter released_count_;
 };
@@ -3,12 +3,15 @@
 /// @file userver/concurrent/mutex_set.hpp
 /// @brief @copybrief concurrent::MutexSet
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <unordered_set>
 #include <utility>
 
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/task/cancel.hpp>
@@ -21,10 +24,47 @@ namespace concurrent {
 
 namespace impl {
 
+// Lock-free slot of MutexSet. The state bits are:
+//  * bit 0 - the slot is locked by the key with the hash tag in bits 4-63
+//  * bit 1 - someone waits for the key of the slot to be unlocked
+//  * bit 2 - some keys of the slot are locked through MutexDatum::set
+//
+// A key is locked with a single CAS if the state is zero, otherwise the key
+// goes to MutexDatum::set under MutexDatum::mutex. Keys of a slot have
+// different tags unless their hashes are equal.
+struct MutexSetSlot final {
+  static constexpr std::uint64_t kLocked = 1;
+  static constexpr std::uint64_t kWaiters = 2;
+  static constexpr std::uint64_t kSetLocked = 4;
+  static constexpr int kTagShift = 4;
+
+  static constexpr std::uint64_t MakeLockedState(std::size_t tag) noexcept {
+    return (static_cast<std::uint64_t>(tag) << kTagShift) | kLocked;
+  }
+
+  static constexpr std::uint64_t GetLockedState(std::uint64_t state) noexcept {
+    return state & ~(kWaiters | kSetLocked);
+  }
+
+  std::atomic<std::uint64_t> state{0};
+
+  // Number of keys of the slot in MutexDatum::set, guarded by the mutex
+  std::size_t set_locked_count{0};
+};
+
+inline std::size_t GetMutexSetSlotsCount(std::size_t way_size) noexcept {
+  // The tag of a key is its hash divided by the slots count, at least 16
+  // slots make the tag fit into the state with the flags
+  constexpr std::size_t kMinSlots = 16;
+  std::size_t slots = kMinSlots;
+  while (slots < way_size) slots *= 2;
+  return slots;
+}
+
 template <typename T, typename Equal>
 struct MutexDatum final {
   explicit MutexDatum(size_t way_size, const Equal& equal = Equal{})
-      : set(way_size, {}, equal) {}
+      : set(way_size, {}, equal), slots(GetMutexSetSlotsCount(way_size)) {}
 
   ~MutexDatum() {
     UASSERT_MSG(set.empty(),
@@ -34,6 +74,7 @@ struct MutexDatum final {
   engine::Mutex mutex;
   engine::ConditionVariable cv;
   std::unordered_set<T, std::hash<T>, Equal> set;
+  utils::FixedArray<InterferenceShield<MutexSetSlot>> slots;
 };
 
 }  // namespace impl
@@ -69,10 +110,14 @@ class ItemMutex final {
   bool try_lock_until(std::chrono::time_point<Clock, Duration>);
 
  private:
+  bool TryLockFast() noexcept;
   bool TryFinishLocking();
+  void UnlockSlow();
 
   MutexDatum& md_;
   const HashAndKey key_;
+  impl::MutexSetSlot& slot_;
+  const std::uint64_t locked_state_;
 };
 
 /// @ingroup userver_concurrency userver_containers
@@ -83,12 +128,25 @@ class ItemMutex final {
 /// multiple keys when the key set is not known at compile time and may change
 /// in runtime.
 ///
+/// The keys are distributed over `ways` stripes. Each stripe has at least
+/// `way_size` lock-free slots: an uncontended lock or unlock of a key is a
+/// single CAS on the slot of its hash. The stripe mutex and condition
+/// variable are used only if the slot is busy with another key or someone
+/// waits for the key.
+///
+/// @warning Distinct keys with equal hashes share the critical section, just
+/// like equal keys do. Locking two such keys from the same task deadlocks, so
+/// use a Hash without collisions if a task locks several keys at once.
+///
 /// Example:
 /// @snippet src/concurrent/mutex_set_test.cpp  Sample mutex set usage
 template <typename Key = std::string, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class MutexSet final : Hash {
  public:
+  /// @param ways number of stripes with independent locks
+  /// @param way_size expected number of keys locked at the same time in a
+  /// stripe
   explicit MutexSet(size_t ways = 1, size_t way_size = 1,
                     const Hash& hash = Hash{}, const Equal& equal = Equal{});
 
@@ -122,10 +180,17 @@ ItemMutex<Key, Equal> MutexSet<Key, Hash, Equal>::GetMutexForKey(Key key) {
 
 template <typename Key, typename Equal>
 ItemMutex<Key, Equal>::ItemMutex(MutexDatum& md, HashAndKey&& key)
-    : md_(md), key_(std::move(key)) {}
+    : md_(md),
+      key_(std::move(key)),
+      // slots count is a power of 2
+      slot_(*md_.slots[key_.hash & (md_.slots.size() - 1)]),
+      locked_state_(impl::MutexSetSlot::MakeLockedState(
+          key_.hash / md_.slots.size())) {}
 
 template <typename Key, typename Equal>
 void ItemMutex<Key, Equal>::lock() {
+  if (TryLockFast()) return;
+
   engine::TaskCancellationBlocker blocker;
   std::unique_lock<engine::Mutex> lock(md_.mutex);
 
@@ -136,10 +201,34 @@ void ItemMutex<Key, Equal>::lock() {
 
 template <typename Key, typename Equal>
 void ItemMutex<Key, Equal>::unlock() {
+  auto expected = locked_state_;
+  if (slot_.state.compare_exchange_strong(expected, 0,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    return;
+  }
+  UnlockSlow();
+}
+
+template <typename Key, typename Equal>
+void ItemMutex<Key, Equal>::UnlockSlow() {
   std::unique_lock lock(md_.mutex);
 
   // Forcing the destructor of the node to run outside of the critical section
   [[maybe_unused]] auto node = md_.set.extract(key_);
+  if (node) {
+    UASSERT(slot_.set_locked_count > 0);
+    if (--slot_.set_locked_count == 0) {
+      slot_.state.fetch_and(~impl::MutexSetSlot::kSetLocked,
+                            std::memory_order_acq_rel);
+    }
+  } else {
+    // The key holds the slot, which has waiters or set-locked keys
+    UASSERT(impl::MutexSetSlot::GetLockedState(slot_.state.load()) ==
+            locked_state_);
+    slot_.state.fetch_and(impl::MutexSetSlot::kSetLocked,
+                          std::memory_order_acq_rel);
+  }
 
   // We must wakeup all the waiters, because otherwise we can wake up the wrong
   // one and loose the wakeup:
@@ -160,6 +249,8 @@ void ItemMutex<Key, Equal>::unlock() {
 
 template <typename Key, typename Equal>
 bool ItemMutex<Key, Equal>::try_lock() {
+  if (TryLockFast()) return true;
+
   std::unique_lock<engine::Mutex> lock(md_.mutex);
   return TryFinishLocking();
 }
@@ -168,6 +259,8 @@ template <typename Key, typename Equal>
 template <typename Rep, typename Period>
 bool ItemMutex<Key, Equal>::try_lock_for(
     std::chrono::duration<Rep, Period> duration) {
+  if (TryLockFast()) return true;
+
   std::unique_lock<engine::Mutex> lock(md_.mutex);
   return md_.cv.WaitFor(lock, duration, [this] { return TryFinishLocking(); });
 }
@@ -176,14 +269,63 @@ template <typename Key, typename Equal>
 template <typename Clock, typename Duration>
 bool ItemMutex<Key, Equal>::try_lock_until(
     std::chrono::time_point<Clock, Duration> time_point) {
+  if (TryLockFast()) return true;
+
   std::unique_lock<engine::Mutex> lock(md_.mutex);
   return md_.cv.WaitUntil(lock, time_point,
                           [this] { return TryFinishLocking(); });
 }
 
+template <typename Key, typename Equal>
+bool ItemMutex<Key, Equal>::TryLockFast() noexcept {
+  std::uint64_t expected = 0;
+  return slot_.state.compare_exchange_strong(expected, locked_state_,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+}
+
+// Must be called under md_.mutex
 template <typename Key, typename Equal>
 bool ItemMutex<Key, Equal>::TryFinishLocking() {
-  return md_.set.insert(key_).second;
+  using Slot = impl::MutexSetSlot;
+
+  auto& state = slot_.state;
+
+  auto current = state.load(std::memory_order_acquire);
+  while (true) {
+    if (current == 0) {
+      if (state.compare_exchange_weak(current, locked_state_,
+                                      std::memory_order_acquire)) {
+        return true;
+      }
+    } else if (Slot::GetLockedState(current) == locked_state_) {
+      // The slot is locked by our key or by a key with the same hash,
+      // the unlocker must notify us
+      if (current & Slot::kWaiters) return false;
+      if (state.compare_exchange_weak(current, current | Slot::kWaiters,
+                                      std::memory_order_relaxed)) {
+        return false;
+      }
+    } else if (current & Slot::kSetLocked) {
+      // The bit is cleared under the mutex only
+      break;
+    } else {
+      // Forbid locking of the slot with a CAS while our key may be in the set
+      if (state.compare_exchange_weak(current, current | Slot::kSetLocked,
+                                      std::memory_order_acq_rel)) {
+        break;
+      }
+    }
+  }
+
+  if (md_.set.insert(key_).second) {
+    ++slot_.set_locked_count;
+    return true;
+  }
+  if (slot_.set_locked_count == 0) {
+    state.fetch_and(~Slot::kSetLocked, std::memory_order_relaxed);
+  }
+  return false;
 }
 
 }  // namespace concurrent
@@ -0,0 +1,177 @@
+#pragma once
+
+/// @file userver/congestion_control/adaptive_limiter.hpp
+/// @brief @copybrief congestion_control::AdaptiveLimiter
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/formats/json_fwd.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+/// Algorithm of AdaptiveConcurrencyLimit
+enum class AdaptiveAlgorithm {
+  /// Shrinks the limit by the ratio of the long-term to the current RTT
+  kGradient2,
+  /// Estimates the queue size by the ratio of the no-load to the current RTT
+  kVegas,
+};
+
+// clang-format off
+
+/// @brief Settings of the adaptive concurrency limiting
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// enabled | whether the limiting is enabled | true
+/// algorithm | `gradient2` or `vegas` | gradient2
+/// initial-limit | concurrency limit to start with | 20
+/// min-limit | the limit never goes below | 4
+/// max-limit | the limit never goes above | 1000
+/// window-size | requests aggregated into a single limit update | 50
+/// smoothing | weight of the new limit estimate, in (0, 1] | 0.2
+/// rtt-tolerance | gradient2: RTT increase over the long-term RTT tolerated without shrinking the limit | 1.5
+/// long-window | gradient2: updates in the long-term RTT average; vegas: updates after which the no-load RTT is probed again | 600
+
+// clang-format on
+struct AdaptiveConcurrencyConfig final {
+  bool enabled{true};
+  AdaptiveAlgorithm algorithm{AdaptiveAlgorithm::kGradient2};
+  std::size_t initial_limit{20};
+  std::size_t min_limit{4};
+  std::size_t max_limit{1000};
+  std::size_t window_size{50};
+  double smoothing{0.2};
+  double rtt_tolerance{1.5};
+  std::size_t long_window{600};
+};
+
+AdaptiveConcurrencyConfig Parse(const formats::json::Value& value,
+                                formats::parse::To<AdaptiveConcurrencyConfig>);
+
+AdaptiveConcurrencyConfig Parse(const yaml_config::YamlConfig& value,
+                                formats::parse::To<AdaptiveConcurrencyConfig>);
+
+/// @brief Concurrency limit, adjusted by the RTT of the served requests in
+/// the spirit of Netflix concurrency-limits.
+///
+/// The limit grows while the latency stays close to the best one observed
+/// and shrinks as soon as requests start queueing, so the service is kept
+/// near the knee of its latency curve without knowing its capacity.
+///
+/// Not thread-safe, see AdaptiveLimiter for the concurrent wrapper.
+class AdaptiveConcurrencyLimit final {
+ public:
+  explicit AdaptiveConcurrencyLimit(const AdaptiveConcurrencyConfig& config);
+
+  /// @brief Accounts a window of requests and returns the new limit.
+  /// @param rtt average latency of the requests of the window
+  /// @param max_in_flight max concurrency observed in the window
+  /// @param dropped whether any request of the window timed out or was
+  /// cancelled
+  std::size_t Update(const AdaptiveConcurrencyConfig& config,
+                     std::chrono::microseconds rtt, std::size_t max_in_flight,
+                     bool dropped);
+
+  std::size_t GetLimit() const noexcept;
+
+ private:
+  double UpdateGradient2(const AdaptiveConcurrencyConfig& config, double rtt,
+                         bool dropped);
+  std::optional<double> UpdateVegas(double rtt, bool dropped);
+
+  double estimated_limit_;
+  double long_rtt_us_{0};
+  double no_load_rtt_us_{0};
+  std::size_t updates_{0};
+};
+
+/// @brief Thread-safe concurrency limiter over AdaptiveConcurrencyLimit.
+///
+/// Admission is a single atomic increment. Latency samples are aggregated
+/// into windows under a mutex that is only try-locked, so contended samples
+/// are skipped instead of blocking the requests.
+class AdaptiveLimiter final {
+ public:
+  /// @brief A slot of the limiter, held for the request duration.
+  ///
+  /// The latency is sampled on OnSuccess or OnDropped. If neither is called,
+  /// e.g. the request failed for an unrelated reason, the slot is released
+  /// without a sample.
+  class Token final {
+   public:
+    Token(Token&&) noexcept;
+    Token& operator=(Token&&) = delete;
+    ~Token();
+
+    /// Samples the latency of a served request
+    void OnSuccess() noexcept;
+
+    /// Signals that the request timed out or was cancelled
+    void OnDropped() noexcept;
+
+   private:
+    friend class AdaptiveLimiter;
+
+    Token(AdaptiveLimiter& limiter, const AdaptiveConcurrencyConfig& config,
+          std::size_t in_flight) noexcept;
+
+    void Release(bool dropped) noexcept;
+
+    AdaptiveLimiter* limiter_;
+    AdaptiveConcurrencyConfig config_;
+    std::size_t in_flight_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  explicit AdaptiveLimiter(const AdaptiveConcurrencyConfig& config);
+
+  /// @returns a slot if the current concurrency is below the limit,
+  /// `std::nullopt` if the request should be rejected.
+  /// @note `config` may differ between calls, e.g. come from a dynamic config
+  std::optional<Token> TryAcquire(const AdaptiveConcurrencyConfig& config);
+
+  std::size_t GetLimit() const noexcept;
+
+  std::size_t GetInFlight() const noexcept;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const AdaptiveLimiter& limiter);
+
+ private:
+  struct Window {
+    std::chrono::microseconds rtt_sum{0};
+    std::size_t samples{0};
+    std::size_t max_in_flight{0};
+    bool dropped{false};
+  };
+
+  void OnSample(const AdaptiveConcurrencyConfig& config,
+                std::chrono::microseconds rtt, std::size_t in_flight,
+                bool dropped) noexcept;
+
+  std::atomic<std::size_t> limit_;
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::int64_t> last_rtt_us_{0};
+  utils::statistics::RateCounter accepted_;
+  utils::statistics::RateCounter rejected_;
+
+  engine::Mutex mutex_;
+  Window window_;
+  AdaptiveConcurrencyLimit limit_estimator_;
+};
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
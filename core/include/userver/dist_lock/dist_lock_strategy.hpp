@@ -4,13 +4,21 @@
 /// @brief @copybrief dist_lock::DistLockStrategyBase
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
+#include <optional>
 #include <string>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dist_lock {
 
+/// @brief Fencing token of a distributed lock.
+///
+/// Grows monotonically each time the lock changes its owner, so a storage
+/// may reject writes that carry a token older than the one it has seen.
+using FencingToken = std::uint64_t;
+
 /// Indicates that lock cannot be acquired because it's busy.
 class LockIsAcquiredByAnotherHostException : public std::exception {};
 
@@ -35,6 +43,17 @@ class DistLockStrategyBase {
   virtual void Acquire(std::chrono::milliseconds lock_ttl,
                        const std::string& locker_id) = 0;
 
+  /// Acquires the distributed lock and returns its fencing token, if the
+  /// strategy supports fencing.
+  ///
+  /// The default implementation calls Acquire() and returns no token.
+  /// @throws same as Acquire()
+  virtual std::optional<FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl, const std::string& locker_id) {
+    Acquire(lock_ttl, locker_id);
+    return std::nullopt;
+  }
+
   /// Releases the lock.
   ///
   /// @param locker_id Globally unique ID of the locking entity, must be the
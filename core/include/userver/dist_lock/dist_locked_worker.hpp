@@ -81,6 +81,11 @@ class DistLockedWorker final {
   /// may be less than the real duration.
   std::optional<std::chrono::steady_clock::duration> GetLockedDuration() const;
 
+  /// Returns the fencing token of the held lock, if the lock is held and the
+  /// strategy supports fencing. Pass it along with the writes done under the
+  /// lock, so that the storage could reject the writes of a stale owner.
+  std::optional<FencingToken> GetFencingToken() const noexcept;
+
   /// Returns lock acquisition statistics.
   const Statistics& GetStatistics() const;
 
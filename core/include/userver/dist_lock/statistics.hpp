@@ -14,6 +14,8 @@ struct Statistics {
   utils::statistics::RelaxedCounter<size_t> watchdog_triggers{0};
   utils::statistics::RelaxedCounter<size_t> brain_splits{0};
   utils::statistics::RelaxedCounter<size_t> task_failures{0};
+  utils::statistics::RelaxedCounter<size_t> acquisitions{0};
+  utils::statistics::RelaxedCounter<size_t> releases{0};
 };
 
 }  // namespace dist_lock
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// A `Writer` that appends to an in-memory string, for storing dumpable
+/// values outside of cache dumps
+class StringWriter final : public Writer {
+ public:
+  StringWriter();
+
+  void Finish() override;
+
+  /// Extracts the built string, leaving the Writer in a valid but unspecified
+  /// state
+  std::string Extract() &&;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  std::string data_;
+};
+
+/// A `Reader` that reads from an in-memory string. The string must outlive
+/// the reader.
+class StringReader final : public Reader {
+ public:
+  explicit StringReader(std::string_view data);
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::string_view data_;
+  std::string_view unread_data_;
+};
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -3,7 +3,12 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/crypto/certificate.hpp>
@@ -17,6 +22,95 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// Where the TLS records are encrypted
+enum class TlsOffload {
+  /// Everything is encrypted by OpenSSL in user space
+  kNone,
+  /// @brief The records sent after the key exchange are encrypted by the
+  /// kernel (kTLS) if both the kernel and OpenSSL support it, in user space
+  /// otherwise.
+  ///
+  /// Saves a copy of the sent data and the user space CPU. Requires Linux with
+  /// the `tls` kernel module and OpenSSL 3.0+ built with kTLS. OpenSSL sets
+  /// up the offload on its own socket BIO, and may offload the decryption of
+  /// the received records as well.
+  kKernel,
+};
+
+/// @brief Key of the stateless TLS session tickets.
+///
+/// Has the 80 bytes layout of the nginx `ssl_session_ticket_key` files.
+struct TlsSessionTicketKey final {
+  /// Size of the key in the binary form
+  static constexpr std::size_t kSize = 80;
+
+  /// @brief Parses the binary form of the key.
+  /// @throws TlsException if the data is not kSize bytes long
+  static TlsSessionTicketKey FromBinary(std::string_view data);
+
+  std::array<unsigned char, 16> name{};
+  std::array<unsigned char, 32> hmac_secret{};
+  std::array<unsigned char, 32> aes_key{};
+};
+
+/// Session resumption settings of TlsServerContext
+struct TlsSessionSettings final {
+  /// Max number of sessions in the server side session cache, 0 disables the
+  /// cache
+  std::size_t cache_size{20480};
+
+  /// Lifetime of the cached sessions and of the session tickets
+  std::chrono::seconds timeout{300};
+
+  /// Whether to issue stateless session tickets
+  bool tickets{true};
+
+  /// @brief Keys of the session tickets, the first one encrypts the new
+  /// tickets, all of them decrypt.
+  ///
+  /// If empty, OpenSSL generates a random key, so the tickets are only
+  /// resumed by the same process. Set the same keys on all the instances of
+  /// a service to resume the tickets issued by any of them.
+  std::vector<TlsSessionTicketKey> ticket_keys;
+};
+
+/// @brief Server side TLS settings, session cache and ticket keys shared by
+/// the connections accepted with TlsWrapper::StartTlsServer.
+///
+/// Reusing a single context for the connections of a listener allows the
+/// clients to resume their sessions with abbreviated handshakes, saving the
+/// CPU on the certificate signatures.
+///
+/// Thread safe. Must outlive the connections started with it.
+class TlsServerContext final {
+ public:
+  TlsServerContext(
+      const crypto::Certificate& cert, const crypto::PrivateKey& key,
+      const std::vector<crypto::Certificate>& extra_cert_authorities = {},
+      const TlsSessionSettings& session_settings = {});
+
+  TlsServerContext(TlsServerContext&&) noexcept;
+  TlsServerContext& operator=(TlsServerContext&&) noexcept;
+  ~TlsServerContext();
+
+  /// @brief Replaces the session ticket keys, e.g. to rotate them.
+  ///
+  /// The tickets encrypted with a key that is not the first one any more are
+  /// still accepted while the key is in the list, and are renewed.
+  /// @throws TlsException if the context was created without ticket keys or
+  /// `keys` is empty
+  void SetSessionTicketKeys(std::vector<TlsSessionTicketKey> keys);
+
+  /// Number of sessions in the server side session cache
+  std::size_t GetCachedSessionsCount() const;
+
+ private:
+  friend class TlsWrapper;
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe. E.g. you MAY NOT read and write concurrently from multiple
@@ -29,20 +123,32 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// Starts a TLS client on an opened socket
   static TlsWrapper StartTlsClient(Socket&& socket,
                                    const std::string& server_name,
-                                   Deadline deadline);
+                                   Deadline deadline,
+                                   TlsOffload offload = TlsOffload::kNone);
 
   /// Starts a TLS client with client cert on an opened socket
   static TlsWrapper StartTlsClient(
       Socket&& socket, const std::string& server_name,
       const crypto::Certificate& cert, const crypto::PrivateKey& key,
       Deadline deadline,
-      const std::vector<crypto::Certificate>& extra_cert_authorities = {});
+      const std::vector<crypto::Certificate>& extra_cert_authorities = {},
+      TlsOffload offload = TlsOffload::kNone);
 
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS server on an opened socket.
+  ///
+  /// Sessions are not resumed, use the TlsServerContext overload for that.
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& extra_cert_authorities = {});
+      const std::vector<crypto::Certificate>& extra_cert_authorities = {},
+      TlsOffload offload = TlsOffload::kNone);
+
+  /// @brief Starts a TLS server on an opened socket with the settings and
+  /// sessions of the `context`.
+  static TlsWrapper StartTlsServer(Socket&& socket,
+                                   const TlsServerContext& context,
+                                   Deadline deadline,
+                                   TlsOffload offload = TlsOffload::kNone);
 
   ~TlsWrapper() override;
 
@@ -77,6 +183,8 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
+  /// @note The returned socket is closed if the TLS was offloaded to the
+  ///   kernel, as it cannot be used for plain data any more.
   [[nodiscard]] Socket StopTls(Deadline deadline);
 
   /// @brief Receives at least one byte from the socket.
@@ -104,6 +212,13 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   [[nodiscard]] size_t WriteAll(std::initializer_list<IoData> list,
                                 Deadline deadline) override;
 
+  /// Whether the sent records are encrypted by the kernel, see
+  /// TlsOffload::kKernel.
+  bool IsKernelTlsOffloaded() const noexcept;
+
+  /// Whether the session was resumed with an abbreviated handshake
+  bool IsSessionReused() const noexcept;
+
   int GetRawFd();
 
  private:
@@ -113,7 +228,7 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
 
   class Impl;
   class ReadContextAccessor;
-  constexpr static size_t kSize = 336;
+  constexpr static size_t kSize = 352;
   constexpr static size_t kAlignment = 8;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
@@ -0,0 +1,178 @@
+#pragma once
+
+/// @file userver/engine/reader_biased_shared_mutex.hpp
+/// @brief @copybrief engine::ReaderBiasedSharedMutex
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <userver/concurrent/impl/striped_read_indicator.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @ingroup userver_concurrency
+///
+/// @brief engine::SharedMutex replacement for read-mostly data, readers of
+/// which do not write to any shared cache line.
+///
+/// While there are no writers, the mutex is "read-biased": readers register
+/// themselves in a per-CPU read indicator without touching any memory shared
+/// with readers on other CPUs. A writer revokes the bias and waits for the
+/// registered readers to leave. After that the readers fall back to an
+/// engine::SharedMutex until the bias is restored. The bias is restored by
+/// the readers after a period that is proportional to the time the last
+/// revocation took, so that frequent writers do not pay for the revocations
+/// all the time.
+///
+/// Ignores task cancellations (succeeds even if the current task is cancelled).
+///
+/// Writers (unique locks) have priority over readers (shared locks).
+///
+/// Compared to engine::SharedMutex:
+/// * read locking scales linearly with the number of CPUs;
+/// * write locking is more expensive, especially right after a period of
+///   reads;
+/// * takes `~128 * N_CORES` bytes of memory, use sparingly.
+///
+/// @see Based on ideas from "BRAVO: Biased Locking for Reader-Writer Locks",
+/// https://www.usenix.org/conference/atc19/presentation/dice
+/// @see @ref scripts/docs/en/userver/synchronization.md
+class ReaderBiasedSharedMutex final {
+ public:
+  ReaderBiasedSharedMutex();
+  ~ReaderBiasedSharedMutex();
+
+  ReaderBiasedSharedMutex(const ReaderBiasedSharedMutex&) = delete;
+  ReaderBiasedSharedMutex(ReaderBiasedSharedMutex&&) = delete;
+  ReaderBiasedSharedMutex& operator=(const ReaderBiasedSharedMutex&) = delete;
+  ReaderBiasedSharedMutex& operator=(ReaderBiasedSharedMutex&&) = delete;
+
+  /// Locks the mutex for unique ownership. Blocks current coroutine if the
+  /// mutex is locked by another coroutine for reading or writing.
+  ///
+  /// @note The method waits for the mutex even if the current task is
+  /// cancelled.
+  void lock();
+
+  /// Unlocks the mutex for unique ownership. Before calling this method the
+  /// the mutex should be locked for unique ownership by current coroutine.
+  void unlock();
+
+  /// Tries to lock the mutex for unique ownership without blocking the
+  /// coroutine, returns true if succeeded.
+  [[nodiscard]] bool try_lock();
+
+  /// Tries to lock the mutex for unique ownership in specified duration.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Rep, typename Period>
+  [[nodiscard]] bool try_lock_for(const std::chrono::duration<Rep, Period>&);
+
+  /// Tries to lock the mutex for unique ownership till specified time point.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Clock, typename Duration>
+  [[nodiscard]] bool try_lock_until(
+      const std::chrono::time_point<Clock, Duration>&);
+
+  /// @overload
+  [[nodiscard]] bool try_lock_until(Deadline deadline);
+
+  /// Locks the mutex for shared ownership. Blocks current coroutine if the
+  /// mutex is locked by another coroutine for writing.
+  ///
+  /// @note The method waits for the mutex even if the current task is
+  /// cancelled.
+  void lock_shared();
+
+  /// Unlocks the mutex for shared ownership. Before calling this method the
+  /// mutex should be locked for shared ownership by current coroutine.
+  void unlock_shared();
+
+  /// Tries to lock the mutex for shared ownership without blocking the
+  /// coroutine, returns true if succeeded.
+  [[nodiscard]] bool try_lock_shared();
+
+  /// Tries to lock the mutex for shared ownership in specified duration.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Rep, typename Period>
+  [[nodiscard]] bool try_lock_shared_for(
+      const std::chrono::duration<Rep, Period>&);
+
+  /// Tries to lock the mutex for shared ownership till specified time point.
+  ///
+  /// @returns true if the locking succeeded
+  template <typename Clock, typename Duration>
+  [[nodiscard]] bool try_lock_shared_until(
+      const std::chrono::time_point<Clock, Duration>&);
+
+  /// @overload
+  [[nodiscard]] bool try_lock_shared_until(Deadline deadline);
+
+  /// @cond
+  // For internal use only
+  bool IsReadBiased() const noexcept;
+  /// @endcond
+
+ private:
+  bool TryLockSharedFast();
+
+  void LockSharedFromFallback();
+
+  void MaybeRestoreReadBias() noexcept;
+
+  bool RevokeReadBias(Deadline deadline);
+
+  /* Every reader holds readers_ while inside the critical section.
+   * Fast path readers lock it directly, slow path readers lock it while
+   * holding fallback_ for reading. A writer holds fallback_ for writing.
+   */
+  concurrent::impl::StripedReadIndicator readers_;
+  SharedMutex fallback_;
+
+  /* Only set while fallback_ is held for reading, only reset while fallback_
+   * is held for writing.
+   */
+  std::atomic<bool> read_bias_{true};
+
+  // steady_clock ticks, the read bias is not restored until then
+  std::atomic<std::int64_t> inhibit_until_{0};
+
+  // Signaled by the readers that leave while the read bias is revoked
+  SingleConsumerEvent readers_left_;
+};
+
+template <typename Rep, typename Period>
+bool ReaderBiasedSharedMutex::try_lock_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_until(Deadline::FromDuration(duration));
+}
+
+template <typename Rep, typename Period>
+bool ReaderBiasedSharedMutex::try_lock_shared_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_shared_until(Deadline::FromDuration(duration));
+}
+
+template <typename Clock, typename Duration>
+bool ReaderBiasedSharedMutex::try_lock_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_until(Deadline::FromTimePoint(until));
+}
+
+template <typename Clock, typename Duration>
+bool ReaderBiasedSharedMutex::try_lock_shared_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_shared_until(Deadline::FromTimePoint(until));
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -66,6 +66,11 @@ namespace components {
 /// tls.cert | path to TLS server certificate | -
 /// tls.private-key | path to TLS server certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.session-cache-size | max number of TLS sessions cached by the listener for resumption, 0 disables the cache | 20480
+/// tls.session-timeout | lifetime of TLS sessions and session tickets in seconds | 300
+/// tls.session-tickets | whether to issue stateless TLS session tickets | true
+/// tls.session-ticket-keys-name | name of the session ticket keys located in secdist's "tls_session_ticket_keys" section, see below | random keys of the process
+/// tls.ktls | offload the encryption of the sent data to the kernel (kTLS), falls back to OpenSSL if the kernel or OpenSSL lacks the support | false
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
@@ -81,6 +86,23 @@ namespace components {
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 /// middleware-pipeline-builder | name of a component to build a server-wide middleware pipeline | default-server-middleware-pipeline-builder
 ///
+/// ## TLS session resumption
+///
+/// The TLS connections of a listener share the session cache and the keys of
+/// the session tickets, so the reconnecting clients skip the full handshake.
+/// To resume the tickets issued by other instances of the service and to
+/// rotate the keys, put the base64 encoded 80 byte keys (the format of nginx
+/// `ssl_session_ticket_key` files) into secdist and set their name in
+/// `tls.session-ticket-keys-name`:
+///
+/// ```json
+/// {"tls_session_ticket_keys": {"main": ["<new key>", "<previous key>"]}}
+/// ```
+///
+/// The first key encrypts the new tickets, all of them decrypt. The keys of
+/// both `listener` and `listener-monitor` are reloaded on secdist updates, see
+/// `update-period` of components::Secdist.
+///
 /// @see @ref scripts/docs/en/userver/http_server.md
 
 // clang-format on
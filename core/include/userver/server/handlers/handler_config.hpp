@@ -5,6 +5,7 @@
 #include <variant>
 #include <vector>
 
+#include <userver/congestion_control/adaptive_limiter.hpp>
 #include <userver/server/handlers/auth/handler_auth_config.hpp>
 #include <userver/server/handlers/fallback_handlers.hpp>
 #include <userver/server/http/http_status.hpp>
@@ -37,6 +38,8 @@ struct HandlerConfig {
   UrlTrailingSlashOption url_trailing_slash{UrlTrailingSlashOption::kDefault};
   std::optional<size_t> max_requests_in_flight;
   std::optional<size_t> max_requests_per_second;
+  std::optional<congestion_control::AdaptiveConcurrencyConfig>
+      adaptive_concurrency;
   bool decompress_request{true};
   bool throttling_enabled{true};
   bool response_body_stream{false};
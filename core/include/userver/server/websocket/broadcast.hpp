@@ -0,0 +1,136 @@
+#pragma once
+
+/// @file userver/server/websocket/broadcast.hpp
+/// @brief @copybrief server::websocket::BroadcastHub
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+/// Settings of BroadcastHub
+struct BroadcastSettings final {
+  /// Max number of messages waiting to be sent to a single connection.
+  /// Messages for a connection with a full queue are dropped.
+  std::size_t queue_size{64};
+
+  /// Max time of a single write to a connection. A connection that does not
+  /// take the messages for that long is unsubscribed and can not be written
+  /// to anymore.
+  std::chrono::milliseconds write_timeout{10000};
+
+  /// If set, the messages are also compressed once for the connections
+  /// that negotiated permessage-deflate
+  std::optional<int> compression_level{};
+};
+
+// clang-format off
+
+/// @brief Sends the same messages to many websocket connections.
+///
+/// A message is encoded into a frame once, all the subscribers share it.
+/// Each subscriber has a bounded queue and a task that writes everything
+/// accumulated in the queue with a single write. A slow subscriber loses the
+/// messages that do not fit into its queue instead of slowing down the others.
+/// A subscriber whose write takes longer than BroadcastSettings::write_timeout
+/// is unsubscribed, see Subscription::Unsubscribe.
+///
+/// ## Metrics
+///
+/// Name | Description
+/// ---- | -----------
+/// subscribers | current number of the subscribed connections
+/// messages.broadcasted | number of Broadcast() calls
+/// messages.enqueued | number of messages enqueued to the subscribers
+/// messages.dropped | number of messages dropped because of full queues or failed connections
+/// fanout-latency-ms | histogram of the time from Broadcast() till the message is written to a socket
+///
+/// ## Example usage:
+///
+/// @code
+/// void Handle(WebSocketConnection& ws, server::request::RequestContext&) const override {
+///   const auto subscription = hub_.Subscribe(ws);
+///   Message message;
+///   while (!message.close_status) ws.Recv(message);
+/// }
+///
+/// void Publish(std::string_view event) { hub_.Broadcast(event, true); }
+/// @endcode
+
+// clang-format on
+class BroadcastHub final {
+ public:
+  class Subscription;
+
+  explicit BroadcastHub(const BroadcastSettings& settings = {});
+  ~BroadcastHub();
+
+  BroadcastHub(const BroadcastHub&) = delete;
+  BroadcastHub& operator=(const BroadcastHub&) = delete;
+
+  /// @brief Starts sending the broadcast messages to the connection.
+  ///
+  /// The messages are sent until the returned Subscription is destroyed or
+  /// a write to the connection fails, in the latter case the connection is
+  /// unsubscribed automatically. The connection must outlive the
+  /// Subscription.
+  [[nodiscard]] Subscription Subscribe(WebSocketConnection& connection);
+
+  /// @brief Encodes the message once and enqueues it to all the subscribers.
+  /// @returns number of the subscribers the message was enqueued to
+  std::size_t Broadcast(std::string_view data, bool is_text);
+
+  /// @overload
+  std::size_t Broadcast(const PreparedMessage& message);
+
+  std::size_t GetSubscribersCount() const;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const BroadcastHub& hub);
+
+ private:
+  struct Impl;
+  struct Subscriber;
+
+  std::shared_ptr<Impl> impl_;
+};
+
+/// @brief Subscription of a connection to a BroadcastHub.
+///
+/// The connection stops receiving the messages on destruction, the pending
+/// ones are dropped.
+class BroadcastHub::Subscription final {
+ public:
+  Subscription() noexcept;
+  Subscription(Subscription&&) noexcept;
+  Subscription& operator=(Subscription&&) noexcept;
+  ~Subscription();
+
+  /// Unsubscribes the connection, the pending messages are dropped. Waits
+  /// for the write in progress, so the connection is left at a frame border,
+  /// but no longer than BroadcastSettings::write_timeout. A write that timed
+  /// out leaves the connection in the middle of a frame, so all the next
+  /// writes to it throw.
+  void Unsubscribe() noexcept;
+
+ private:
+  friend class BroadcastHub;
+
+  Subscription(std::shared_ptr<Impl> impl,
+               std::shared_ptr<Subscriber> subscriber) noexcept;
+
+  std::shared_ptr<Impl> impl_;
+  std::shared_ptr<Subscriber> subscriber_;
+};
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
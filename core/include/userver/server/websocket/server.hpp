@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include <userver/engine/io/socket.hpp>
 #include <userver/server/http/http_request.hpp>
@@ -45,9 +46,55 @@ struct Message {
 
 class WebSocketConnectionImpl;
 
+namespace impl {
+struct PreparedFrames;
+}  // namespace impl
+
+/// @brief A data message encoded into a websocket frame once, to be sent to
+/// many connections. Copies share the encoded frame.
+///
+/// @see server::websocket::BroadcastHub
+class PreparedMessage final {
+ public:
+  /// @param compression_level if set, the message is also compressed once
+  /// for the connections that negotiated permessage-deflate
+  PreparedMessage(std::string_view data, bool is_text,
+                  std::optional<int> compression_level = {});
+
+  std::string_view GetPayload() const noexcept;
+
+  bool IsText() const noexcept;
+
+  /// @cond
+  // For internal use only
+  const impl::PreparedFrames& GetFrames() const noexcept;
+  /// @endcond
+
+ private:
+  std::shared_ptr<const impl::PreparedFrames> frames_;
+};
+
+/// @brief permessage-deflate extension settings, see RFC 7692
+struct DeflateConfig final {
+  /// Whether to accept the extension if the client offers it
+  bool enabled = false;
+  /// @brief Reset the compression context after each message.
+  ///
+  /// Worse compression, but the connection holds no zlib context between the
+  /// messages, so idle connections take much less memory.
+  bool server_no_context_takeover = false;
+  /// Ask the client to reset its compression context after each message
+  bool client_no_context_takeover = false;
+  /// zlib compression level, 1 (fastest) to 9 (best)
+  int level = 6;
+  /// Messages shorter than this are sent uncompressed
+  unsigned min_size = 64;
+};
+
 struct Config final {
   unsigned max_remote_payload = 65536;
   unsigned fragment_size = 65536;  // 0 - do not fragment
+  DeflateConfig deflate{};
 };
 
 Config Parse(const yaml_config::YamlConfig&, formats::parse::To<Config>);
@@ -106,6 +153,17 @@ class WebSocketConnection {
         reinterpret_cast<const std::byte*>(message.data() + message.size())));
   }
 
+  /// @brief Send the messages with as few writes as possible. Messages
+  /// longer than Config::fragment_size are fragmented, like in Send().
+  /// @param deadline deadline of the whole write, including the wait for
+  /// the writes of the other tasks
+  /// @throws engine::io::IoException in case of socket errors
+  /// @throws engine::io::IoTimeout if the deadline is reached, the connection
+  /// may be left in the middle of a frame, so all the next writes throw
+  /// @note Has the same thread-safety as Send()
+  virtual void SendPrepared(utils::span<const PreparedMessage> messages,
+                            engine::Deadline deadline = {});
+
   virtual void Close(CloseStatus status_code) = 0;
 
   virtual const engine::io::Sockaddr& RemoteAddr() const = 0;
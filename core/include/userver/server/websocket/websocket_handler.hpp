@@ -12,6 +12,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::websocket {
 
+namespace impl {
+class ZlibStreamPool;
+}  // namespace impl
+
 // clang-format off
 
 /// @ingroup userver_components userver_http_handlers userver_base_classes
@@ -28,6 +32,14 @@ namespace server::websocket {
 /// status-codes-log-level | map of "status": log_level items to override span log level for specific status codes | {}
 /// max-remote-payload | max remote payload size | 65536
 /// fragment-size | max output fragment size | 65536
+/// permessage-deflate.enabled | accept the RFC 7692 permessage-deflate extension if the client offers it | false
+/// permessage-deflate.server-no-context-takeover | reset the compression context after each sent message, trading the ratio for memory | false
+/// permessage-deflate.client-no-context-takeover | ask the client to reset its compression context after each message | false
+/// permessage-deflate.level | zlib compression level, from 1 to 9 | 6
+/// permessage-deflate.min-size | outgoing messages shorter than this are sent uncompressed | 64
+///
+/// zlib contexts of the connections without context takeover are taken
+/// from a pool shared by the handler connections for a single message.
 ///
 /// ## Example usage:
 ///
@@ -73,6 +85,7 @@ class WebsocketHandlerBase : public server::handlers::HttpHandlerBase {
       server::request::RequestContext& context) const override;
 
   websocket::Config config_;
+  std::shared_ptr<impl::ZlibStreamPool> zlib_pool_;
   mutable Statistics stats_;
   utils::statistics::Entry statistics_holder_;
 };
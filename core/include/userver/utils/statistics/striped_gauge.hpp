@@ -0,0 +1,68 @@
+#pragma once
+
+/// @file userver/utils/statistics/striped_gauge.hpp
+/// @brief @copybrief utils::statistics::StripedGauge
+
+#include <cstdint>
+
+#include <userver/concurrent/striped_counter.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief A gauge for non-negative values that are incremented and
+/// decremented from many threads, e.g. the number of active connections.
+///
+/// Differences from `std::atomic<std::int64_t>`:
+///
+/// 1. StripedGauge takes `8 * N_CORES` memory, while an atomic is just
+///    8 bytes.
+/// 2. StripedGauge uses split counters on x86_64, which results
+///    in perfect performance even under heavy concurrent usage.
+/// 3. Load() is approx. `N_CORES` times slower.
+///
+/// Use StripedGauge sparingly, in places where a lot of threads are supposed
+/// to be hammering on the same metrics.
+///
+/// @see utils::statistics::StripedRateCounter for monotonic counters
+class StripedGauge final {
+ public:
+  using ValueType = std::int64_t;
+
+  StripedGauge() = default;
+
+  void Add(std::int64_t value) noexcept {
+    val_.Add(static_cast<std::uintptr_t>(value));
+  }
+
+  void Subtract(std::int64_t value) noexcept {
+    val_.Subtract(static_cast<std::uintptr_t>(value));
+  }
+
+  StripedGauge& operator++() noexcept {
+    val_.Add(1);
+    return *this;
+  }
+
+  StripedGauge& operator--() noexcept {
+    val_.Subtract(1);
+    return *this;
+  }
+
+  /// @returns the current value, or `0` for logically impossible negative
+  /// values that could be observed if an `Add` and a `Subtract` race.
+  std::int64_t Load() const noexcept {
+    return static_cast<std::int64_t>(val_.NonNegativeRead());
+  }
+
+ private:
+  USERVER_NAMESPACE::concurrent::StripedCounter val_;
+};
+
+void DumpMetric(Writer& writer, const StripedGauge& value);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
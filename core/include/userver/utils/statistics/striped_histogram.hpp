@@ -0,0 +1,67 @@
+#pragma once
+
+/// @file userver/utils/statistics/striped_histogram.hpp
+/// @brief @copybrief utils::statistics::StripedHistogram
+
+#include <cstdint>
+#include <memory>
+
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/span.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/striped_rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief A histogram with per-CPU buckets, with memory consumption and read
+/// performance traded for write performance.
+///
+/// This class is represented as a histogram metric when serializing to
+/// statistics, like utils::statistics::Histogram.
+///
+/// Differences from utils::statistics::Histogram:
+///
+/// 1. StripedHistogram takes `8 * N_CORES * (bucket_count + 1)` memory.
+/// 2. Each bucket of StripedHistogram is a
+///    utils::statistics::StripedRateCounter, so Account does not touch cache
+///    lines shared with other CPUs on x86_64.
+/// 3. Contents are read using GetSnapshot, which is approx.
+///    `N_CORES * bucket_count` times slower than Histogram::GetView.
+///
+/// Use StripedHistogram instead of Histogram sparingly, in places where a lot
+/// of threads are supposed to be hammering on the same metrics.
+class StripedHistogram final {
+ public:
+  /// Sets upper bounds for each non-"infinite" bucket. The lowest bound is
+  /// always 0.
+  explicit StripedHistogram(utils::span<const double> upper_bounds);
+
+  StripedHistogram(const StripedHistogram&) = delete;
+  StripedHistogram& operator=(const StripedHistogram&) = delete;
+  ~StripedHistogram();
+
+  /// Increment the bucket corresponding to the given value.
+  void Account(double value, std::uint64_t count = 1) noexcept;
+
+  /// Collects the current values of all buckets into a Histogram.
+  Histogram GetSnapshot() const;
+
+  /// Reset all counters to zero.
+  friend void ResetMetric(StripedHistogram& histogram) noexcept;
+
+ private:
+  // Only bounds are stored here, the counters are unused.
+  std::unique_ptr<impl::histogram::Bucket[]> bounds_;
+  // 0th counter is the "infinity" bucket, same as in Histogram.
+  utils::FixedArray<StripedRateCounter> counters_;
+};
+
+/// Metric serialization support for StripedHistogram.
+void DumpMetric(Writer& writer, const StripedHistogram& histogram);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
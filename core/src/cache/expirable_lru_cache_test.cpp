@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
@@ -380,4 +381,20 @@ UTEST(LruCacheWrapper, HitWrapper) {
   EXPECT_EQ(Counter::Zero(), *counter);
 }
 
+UTEST(LruCacheWrapper, InvalidateFunc) {
+  auto counter = std::make_shared<Counter>();
+  std::vector<SimpleCacheKey> invalidated;
+
+  auto cache_ptr = CreateSimpleCachePtr();
+  SimpleWrapper wrapper(
+      cache_ptr, UpdateValue(counter, 1),
+      [&](const SimpleCacheKey& key) { invalidated.push_back(key); });
+
+  SimpleCacheKey key = "my-key";
+  EXPECT_EQ(1, wrapper.Get(key));
+  wrapper.InvalidateByKey(key);
+  EXPECT_EQ(std::vector<SimpleCacheKey>{key}, invalidated);
+  EXPECT_EQ(std::nullopt, cache_ptr->GetOptionalNoUpdate(key));
+}
+
 USERVER_NAMESPACE_END
@@ -25,12 +25,12 @@ T SumToMean(T sum, U count) {
 }  // namespace
 
 RequestStats::RequestStats(Statistics& stats) : stats_(&stats) {
-  stats_->easy_handles_++;
+  ++stats_->easy_handles_;
 }
 
 RequestStats::~RequestStats() {
   if (stats_) {
-    stats_->easy_handles_--;
+    --stats_->easy_handles_;
   }
 }
 
@@ -210,7 +210,7 @@ void DumpMetric(utils::statistics::Writer& writer,
 }
 
 InstanceStatistics::InstanceStatistics(const Statistics& other)
-    : easy_handles(other.easy_handles_.load()),
+    : easy_handles(static_cast<uint64_t>(other.easy_handles_.Load())),
       last_time_to_start_us(other.last_time_to_start_us_.load()),
       timings_percentile(other.timings_percentile_.GetStatsForPeriod()),
       retries(other.retries_.Load()),
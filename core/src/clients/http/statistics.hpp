@@ -8,8 +8,9 @@
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/rate.hpp>
-#include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/striped_gauge.hpp>
+#include <userver/utils/statistics/striped_rate_counter.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <utils/statistics/http_codes.hpp>
 
@@ -97,16 +98,17 @@ class Statistics {
   void AccountStatus(int);
 
  private:
-  std::atomic<uint64_t> easy_handles_{0};
+  utils::statistics::StripedGauge easy_handles_;
   std::atomic<uint64_t> last_time_to_start_us_{0};
   utils::statistics::RecentPeriod<Percentile, Percentile,
                                   utils::datetime::SteadyClock>
       timings_percentile_;
-  std::array<utils::statistics::RateCounter, kErrorGroupCount> error_count_;
-  utils::statistics::RateCounter retries_;
-  utils::statistics::RateCounter socket_open_{0};
-  utils::statistics::RateCounter timeout_updated_by_deadline_;
-  utils::statistics::RateCounter cancelled_by_deadline_;
+  std::array<utils::statistics::StripedRateCounter, kErrorGroupCount>
+      error_count_;
+  utils::statistics::StripedRateCounter retries_;
+  utils::statistics::StripedRateCounter socket_open_{0};
+  utils::statistics::StripedRateCounter timeout_updated_by_deadline_;
+  utils::statistics::StripedRateCounter cancelled_by_deadline_;
   utils::statistics::HttpCodes reply_status_;
 
   friend struct InstanceStatistics;
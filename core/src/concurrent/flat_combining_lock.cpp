@@ -0,0 +1,75 @@
+#include <userver/concurrent/flat_combining_lock.hpp>
+
+#include <engine/impl/async_flat_combining_queue.hpp>
+#include <userver/engine/single_use_event.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+namespace {
+
+using Queue = engine::impl::AsyncFlatCombiningQueue;
+
+// After this many operations the combiner passes the lock to the owner of the
+// next operation, otherwise it could be stuck serving others forever.
+constexpr std::size_t kMaxCombinedOperations = 64;
+
+struct Node final : public SinglyLinkedBaseHook {
+  explicit Node(utils::function_ref<void()> operation) noexcept
+      : operation(operation) {}
+
+  const utils::function_ref<void()> operation;
+  engine::SingleUseEvent done;
+  // Set if the lock is passed to the owner of the node, instead of running
+  // the operation.
+  Queue::Consumer consumer;
+};
+
+void Combine(Queue::Consumer& consumer, std::size_t executed) noexcept {
+  do {
+    while (auto* const base = consumer.TryPop()) {
+      auto& node = static_cast<Node&>(*base);
+      if (executed == kMaxCombinedOperations) {
+        node.consumer = std::move(consumer);
+        node.done.Send();
+        return;
+      }
+
+      node.operation();
+      ++executed;
+      // The node may be destroyed right after that
+      node.done.Send();
+    }
+  } while (!consumer.TryStopConsuming());
+}
+
+}  // namespace
+
+FlatCombiningLockImpl::FlatCombiningLockImpl()
+    : queue_(std::make_unique<Queue>()) {}
+
+FlatCombiningLockImpl::~FlatCombiningLockImpl() = default;
+
+void FlatCombiningLockImpl::Run(
+    utils::function_ref<void()> operation) noexcept {
+  Node node{operation};
+  auto consumer = queue_->PushAndTryStartConsuming(node);
+  if (consumer.IsValid()) {
+    // Our node is the first one in the queue
+    Combine(consumer, 0);
+    return;
+  }
+
+  node.done.WaitNonCancellable();
+  if (!node.consumer.IsValid()) return;
+
+  // The previous combiner has already popped our node
+  consumer = std::move(node.consumer);
+  node.operation();
+  Combine(consumer, 1);
+}
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
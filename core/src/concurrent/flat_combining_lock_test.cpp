@@ -0,0 +1,82 @@
+#include <userver/concurrent/flat_combining_lock.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(FlatCombiningLock, Sample) {
+  /// [Sample usage]
+  concurrent::FlatCombiningLock<std::map<std::string, int>> index;
+
+  index.Apply([](auto& data) { data["foo"] = 42; });
+
+  const auto value = index.Apply([](const auto& data) {
+    const auto it = data.find("foo");
+    return it == data.end() ? 0 : it->second;
+  });
+  EXPECT_EQ(value, 42);
+  /// [Sample usage]
+}
+
+UTEST(FlatCombiningLock, Exception) {
+  concurrent::FlatCombiningLock<int> lock{0};
+
+  const auto throwing_operation = [](int& value) {
+    ++value;
+    throw std::runtime_error("test");
+  };
+  UEXPECT_THROW(lock.Apply(throwing_operation), std::runtime_error);
+
+  // The lock is released after an exception
+  EXPECT_EQ(lock.Apply([](int& value) { return value; }), 1);
+}
+
+UTEST(FlatCombiningLock, Cancelled) {
+  concurrent::FlatCombiningLock<int> lock{0};
+
+  engine::current_task::GetCancellationToken().RequestCancel();
+  lock.Apply([](int& value) { ++value; });
+  EXPECT_EQ(lock.GetDataUnsafe(), 1);
+}
+
+UTEST_MT(FlatCombiningLock, Contention, 4) {
+  constexpr int kOperationsPerTask = 10000;
+  concurrent::FlatCombiningLock<std::pair<std::int64_t, std::int64_t>> lock;
+  std::atomic<std::int64_t> mismatches{0};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < GetThreadCount() * 4; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (int j = 0; j < kOperationsPerTask; ++j) {
+        const auto ok = lock.Apply([](auto& data) {
+          ++data.first;
+          const bool consistent = data.first == data.second + 1;
+          ++data.second;
+          return consistent;
+        });
+        if (!ok) ++mismatches;
+        if (j % 100 == 0) engine::Yield();
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  const auto expected =
+      static_cast<std::int64_t>(tasks.size()) * kOperationsPerTask;
+  EXPECT_EQ(lock.GetDataUnsafe().first, expected);
+  EXPECT_EQ(lock.GetDataUnsafe().second, expected);
+  EXPECT_EQ(mismatches.load(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -2,7 +2,7 @@
 
 #include <atomic>
 
-#include <concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/concurrent/impl/intrusive_hooks.hpp>
 #include <userver/utils/not_null.hpp>
 
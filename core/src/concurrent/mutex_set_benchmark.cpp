@@ -2,6 +2,7 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -186,6 +187,68 @@ BENCHMARK_TEMPLATE(mutex_set_8ways_lock_unlock_contention, std::string)
     ->RangeMultiplier(2)
     ->Range(1, 8);
 
+// Locks random keys from 64 threads. state.range(1) percent of the locks go
+// to a single hot key, the others are spread uniformly over kKeysCount keys.
+void mutex_set_lock_unlock_skewed(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    constexpr std::size_t kKeysCount = 4096;
+    constexpr std::size_t kKeysPerThread = 1024;
+    constexpr std::size_t kWays = 16;
+    concurrent::MutexSet<int> ms(kWays);
+
+    const std::size_t concurrent_jobs = state.range(0);
+    const auto hot_percent = static_cast<std::size_t>(state.range(1));
+
+    const auto make_keys = [&](std::size_t thread_id) {
+      std::vector<int> keys(kKeysPerThread);
+      std::uint64_t random = thread_id + 1;
+      for (auto& key : keys) {
+        random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+        const auto value = random >> 33;
+        key = (value % 100 < hot_percent)
+                  ? 0
+                  : static_cast<int>(1 + (value / 100) % kKeysCount);
+      }
+      return keys;
+    };
+
+    const auto do_work = [&](const std::vector<int>& keys, std::size_t i) {
+      auto mutex = ms.GetMutexForKey(keys[i % keys.size()]);
+      std::unique_lock lock(mutex);
+      benchmark::DoNotOptimize(lock);
+    };
+
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(concurrent_jobs);
+
+    for (std::size_t thread_id = 1; thread_id < concurrent_jobs; ++thread_id) {
+      tasks.push_back(engine::AsyncNoSpan([&, thread_id] {
+        const auto keys = make_keys(thread_id);
+        for (std::size_t i = 0; keep_running; ++i) {
+          do_work(keys, i);
+        }
+      }));
+    }
+
+    const auto keys = make_keys(0);
+    std::size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      do_work(keys, i++);
+    }
+
+    keep_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+
+BENCHMARK(mutex_set_lock_unlock_skewed)
+    ->ArgsProduct({{1, 8, 64}, {0, 10, 90}})
+    ->UseRealTime();
+
 }  // namespace
 
 USERVER_NAMESPACE_END
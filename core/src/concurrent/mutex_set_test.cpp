@@ -1,5 +1,9 @@
 #include <userver/utest/utest.hpp>
 
+#include <array>
+#include <string>
+#include <vector>
+
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/async.hpp>
@@ -119,6 +123,82 @@ UTEST(MutexSet, Sample) {
   /// [Sample mutex set usage]
 }
 
+UTEST(MutexSet, SlotCollision) {
+  // With 16 lock-free slots per way the keys share the slot of key 0
+  concurrent::MutexSet<int> ms;
+  auto m0 = ms.GetMutexForKey(0);
+  auto m16 = ms.GetMutexForKey(16);
+  auto m32 = ms.GetMutexForKey(32);
+
+  ASSERT_TRUE(m0.try_lock());
+  ASSERT_TRUE(m16.try_lock());
+  EXPECT_FALSE(ms.GetMutexForKey(0).try_lock());
+  EXPECT_FALSE(ms.GetMutexForKey(16).try_lock());
+
+  m0.unlock();
+  ASSERT_TRUE(m32.try_lock());
+  ASSERT_TRUE(m0.try_lock());
+  EXPECT_FALSE(ms.GetMutexForKey(0).try_lock());
+
+  m16.unlock();
+  m32.unlock();
+  m0.unlock();
+
+  // The slot is free again
+  ASSERT_TRUE(m16.try_lock());
+  EXPECT_FALSE(ms.GetMutexForKey(16).try_lock());
+  m16.unlock();
+}
+
+UTEST(MutexSet, HashCollision) {
+  struct ConstantHash {
+    std::size_t operator()(const std::string&) const { return 42; }
+  };
+
+  concurrent::MutexSet<std::string, ConstantHash> ms;
+  auto a = ms.GetMutexForKey("a");
+  auto b = ms.GetMutexForKey("b");
+
+  // Keys with equal hashes share the slot and wait for each other
+  ASSERT_TRUE(a.try_lock());
+  EXPECT_FALSE(b.try_lock());
+
+  auto task = engine::AsyncNoSpan([&] { std::lock_guard lock(b); });
+  engine::Yield();
+  EXPECT_FALSE(task.IsFinished());
+
+  a.unlock();
+  task.Get();
+
+  ASSERT_TRUE(b.try_lock());
+  EXPECT_FALSE(a.try_lock());
+  b.unlock();
+}
+
+UTEST_MT(MutexSet, SlotCollisionContention, 4) {
+  constexpr std::size_t kKeysCount = 3;
+  constexpr std::size_t kIterations = 1000;
+  concurrent::MutexSet<int> ms;
+  std::array<std::size_t, kKeysCount> counters{};
+
+  std::vector<engine::Task> tasks;
+  for (std::size_t thread_no = 0; thread_no < GetThreadCount(); ++thread_no) {
+    tasks.push_back(engine::AsyncNoSpan([&, thread_no] {
+      for (std::size_t i = 0; i < kIterations; ++i) {
+        const auto key = (thread_no + i) % kKeysCount;
+        auto mutex = ms.GetMutexForKey(key * 16);
+        std::lock_guard lock(mutex);
+        ++counters[key];
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Wait();
+
+  std::size_t total = 0;
+  for (const auto counter : counters) total += counter;
+  EXPECT_EQ(total, GetThreadCount() * kIterations);
+}
+
 UTEST_MT(MutexSet, HighContention, 4) {
   const auto concurrent_jobs = GetThreadCount();
   concurrent::MutexSet<int> ms;
@@ -0,0 +1,275 @@
+#include <userver/congestion_control/adaptive_limiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/value.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/trivial_map.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+namespace {
+
+// The long-term RTT is a plain average until that many updates are seen
+constexpr std::size_t kLongRttWarmupUpdates = 10;
+
+// Decay of the long-term RTT once it lags far behind the current one, so that
+// a sustained latency change is eventually taken as the new normal
+constexpr double kLongRttDecayThreshold = 2.0;
+constexpr double kLongRttDecay = 0.95;
+
+constexpr double kMinGradient = 0.5;
+
+constexpr utils::TrivialBiMap kAlgorithms = [](auto selector) {
+  return selector()
+      .Case(AdaptiveAlgorithm::kGradient2, "gradient2")
+      .Case(AdaptiveAlgorithm::kVegas, "vegas");
+};
+
+template <typename Value>
+AdaptiveConcurrencyConfig ParseConfig(const Value& value) {
+  AdaptiveConcurrencyConfig config;
+  config.enabled = value["enabled"].template As<bool>(config.enabled);
+  if (const auto algorithm = value["algorithm"]; !algorithm.IsMissing()) {
+    config.algorithm = utils::ParseFromValueString(algorithm, kAlgorithms);
+  }
+  config.initial_limit =
+      value["initial-limit"].template As<std::size_t>(config.initial_limit);
+  config.min_limit =
+      value["min-limit"].template As<std::size_t>(config.min_limit);
+  config.max_limit =
+      value["max-limit"].template As<std::size_t>(config.max_limit);
+  config.window_size =
+      value["window-size"].template As<std::size_t>(config.window_size);
+  config.smoothing = value["smoothing"].template As<double>(config.smoothing);
+  config.rtt_tolerance =
+      value["rtt-tolerance"].template As<double>(config.rtt_tolerance);
+  config.long_window =
+      value["long-window"].template As<std::size_t>(config.long_window);
+
+  if (config.min_limit == 0 || config.min_limit > config.initial_limit ||
+      config.initial_limit > config.max_limit) {
+    throw std::runtime_error(fmt::format(
+        "Validation 0 < min-limit <= initial-limit <= max-limit failed for "
+        "'{}' (got: {}, {}, {})",
+        value.GetPath(), config.min_limit, config.initial_limit,
+        config.max_limit));
+  }
+  if (config.window_size == 0 || config.long_window == 0) {
+    throw std::runtime_error(
+        fmt::format("Validation window-size > 0 and long-window > 0 failed "
+                    "for '{}'",
+                    value.GetPath()));
+  }
+  if (config.smoothing <= 0 || config.smoothing > 1) {
+    throw std::runtime_error(fmt::format(
+        "Validation 0 < smoothing <= 1 failed for '{}' (got: {})",
+        value.GetPath(), config.smoothing));
+  }
+  if (config.rtt_tolerance < 1) {
+    throw std::runtime_error(
+        fmt::format("Validation rtt-tolerance >= 1 failed for '{}' (got: {})",
+                    value.GetPath(), config.rtt_tolerance));
+  }
+  return config;
+}
+
+double Clamp(double limit, const AdaptiveConcurrencyConfig& config) {
+  return std::clamp(limit, static_cast<double>(config.min_limit),
+                    static_cast<double>(config.max_limit));
+}
+
+}  // namespace
+
+AdaptiveConcurrencyConfig Parse(const formats::json::Value& value,
+                                formats::parse::To<AdaptiveConcurrencyConfig>) {
+  return ParseConfig(value);
+}
+
+AdaptiveConcurrencyConfig Parse(const yaml_config::YamlConfig& value,
+                                formats::parse::To<AdaptiveConcurrencyConfig>) {
+  return ParseConfig(value);
+}
+
+AdaptiveConcurrencyLimit::AdaptiveConcurrencyLimit(
+    const AdaptiveConcurrencyConfig& config)
+    : estimated_limit_(static_cast<double>(config.initial_limit)) {}
+
+std::size_t AdaptiveConcurrencyLimit::Update(
+    const AdaptiveConcurrencyConfig& config, std::chrono::microseconds rtt,
+    std::size_t max_in_flight, bool dropped) {
+  const auto rtt_us = std::max(static_cast<double>(rtt.count()), 1.0);
+  ++updates_;
+
+  if (config.algorithm == AdaptiveAlgorithm::kVegas) {
+    if (no_load_rtt_us_ == 0 || rtt_us < no_load_rtt_us_ ||
+        updates_ % config.long_window == 0) {
+      no_load_rtt_us_ = rtt_us;
+    }
+  } else {
+    if (updates_ <= kLongRttWarmupUpdates) {
+      long_rtt_us_ += (rtt_us - long_rtt_us_) / static_cast<double>(updates_);
+    } else {
+      const auto factor = 2.0 / static_cast<double>(config.long_window + 1);
+      long_rtt_us_ += (rtt_us - long_rtt_us_) * factor;
+    }
+    if (long_rtt_us_ / rtt_us > kLongRttDecayThreshold) {
+      long_rtt_us_ *= kLongRttDecay;
+    }
+  }
+
+  // The limit is not reached, so the latency says nothing about it
+  if (!dropped && static_cast<double>(max_in_flight) * 2 < estimated_limit_) {
+    return GetLimit();
+  }
+
+  std::optional<double> new_limit;
+  if (config.algorithm == AdaptiveAlgorithm::kVegas) {
+    new_limit = UpdateVegas(rtt_us, dropped);
+  } else {
+    new_limit = UpdateGradient2(config, rtt_us, dropped);
+  }
+
+  if (new_limit) {
+    estimated_limit_ = Clamp(estimated_limit_ * (1 - config.smoothing) +
+                                 *new_limit * config.smoothing,
+                             config);
+  }
+  return GetLimit();
+}
+
+double AdaptiveConcurrencyLimit::UpdateGradient2(
+    const AdaptiveConcurrencyConfig& config, double rtt, bool dropped) {
+  const auto gradient =
+      dropped ? kMinGradient
+              : std::clamp(config.rtt_tolerance * long_rtt_us_ / rtt,
+                           kMinGradient, 1.0);
+  // Some queueing is allowed, so that the limit can grow at all
+  const auto queue_size = std::sqrt(estimated_limit_);
+  return estimated_limit_ * gradient + queue_size;
+}
+
+std::optional<double> AdaptiveConcurrencyLimit::UpdateVegas(double rtt,
+                                                            bool dropped) {
+  const auto log_limit = std::max(1.0, std::log10(estimated_limit_));
+  if (dropped) return estimated_limit_ - log_limit;
+
+  const auto queue_size =
+      std::ceil(estimated_limit_ * (1 - no_load_rtt_us_ / rtt));
+  const auto alpha = 3 * log_limit;
+  const auto beta = 6 * log_limit;
+
+  if (queue_size <= log_limit) return estimated_limit_ + beta;
+  if (queue_size < alpha) return estimated_limit_ + log_limit;
+  if (queue_size > beta) return estimated_limit_ - log_limit;
+  return std::nullopt;
+}
+
+std::size_t AdaptiveConcurrencyLimit::GetLimit() const noexcept {
+  return static_cast<std::size_t>(estimated_limit_);
+}
+
+AdaptiveLimiter::Token::Token(AdaptiveLimiter& limiter,
+                              const AdaptiveConcurrencyConfig& config,
+                              std::size_t in_flight) noexcept
+    : limiter_(&limiter),
+      config_(config),
+      in_flight_(in_flight),
+      start_(std::chrono::steady_clock::now()) {}
+
+AdaptiveLimiter::Token::Token(Token&& other) noexcept
+    : limiter_(std::exchange(other.limiter_, nullptr)),
+      config_(other.config_),
+      in_flight_(other.in_flight_),
+      start_(other.start_) {}
+
+AdaptiveLimiter::Token::~Token() {
+  if (limiter_) {
+    limiter_->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void AdaptiveLimiter::Token::OnSuccess() noexcept { Release(false); }
+
+void AdaptiveLimiter::Token::OnDropped() noexcept { Release(true); }
+
+void AdaptiveLimiter::Token::Release(bool dropped) noexcept {
+  UASSERT_MSG(limiter_, "The token is already released");
+  if (!limiter_) return;
+
+  auto& limiter = *std::exchange(limiter_, nullptr);
+  limiter.in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  limiter.OnSample(config_,
+                   std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start_),
+                   in_flight_, dropped);
+}
+
+AdaptiveLimiter::AdaptiveLimiter(const AdaptiveConcurrencyConfig& config)
+    : limit_(config.initial_limit), limit_estimator_(config) {}
+
+std::optional<AdaptiveLimiter::Token> AdaptiveLimiter::TryAcquire(
+    const AdaptiveConcurrencyConfig& config) {
+  const auto in_flight = in_flight_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (in_flight > limit_.load(std::memory_order_relaxed)) {
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    ++rejected_;
+    return std::nullopt;
+  }
+  ++accepted_;
+  return Token{*this, config, in_flight};
+}
+
+std::size_t AdaptiveLimiter::GetLimit() const noexcept {
+  return limit_.load(std::memory_order_relaxed);
+}
+
+std::size_t AdaptiveLimiter::GetInFlight() const noexcept {
+  return in_flight_.load(std::memory_order_relaxed);
+}
+
+void AdaptiveLimiter::OnSample(const AdaptiveConcurrencyConfig& config,
+                               std::chrono::microseconds rtt,
+                               std::size_t in_flight, bool dropped) noexcept {
+  // Losing a sample to a concurrent one is fine, blocking the request is not
+  std::unique_lock lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) return;
+
+  window_.rtt_sum += rtt;
+  ++window_.samples;
+  window_.max_in_flight = std::max(window_.max_in_flight, in_flight);
+  window_.dropped = window_.dropped || dropped;
+  if (window_.samples < config.window_size) return;
+
+  const auto avg_rtt =
+      window_.rtt_sum / static_cast<std::int64_t>(window_.samples);
+  const auto new_limit = limit_estimator_.Update(
+      config, avg_rtt, window_.max_in_flight, window_.dropped);
+  window_ = Window{};
+
+  limit_.store(new_limit, std::memory_order_relaxed);
+  last_rtt_us_.store(avg_rtt.count(), std::memory_order_relaxed);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AdaptiveLimiter& limiter) {
+  writer["limit"] = limiter.GetLimit();
+  writer["in-flight"] = limiter.GetInFlight();
+  writer["rtt-us"] = limiter.last_rtt_us_.load(std::memory_order_relaxed);
+  writer["accepted"] = limiter.accepted_.Load();
+  writer["rejected"] = limiter.rejected_.Load();
+}
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,145 @@
+#include <userver/utest/utest.hpp>
+
+#include <optional>
+#include <vector>
+
+#include <userver/congestion_control/adaptive_limiter.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using congestion_control::AdaptiveAlgorithm;
+using congestion_control::AdaptiveConcurrencyConfig;
+using congestion_control::AdaptiveConcurrencyLimit;
+using congestion_control::AdaptiveLimiter;
+
+constexpr std::chrono::microseconds kBaseRtt{1000};
+
+AdaptiveConcurrencyConfig MakeConfig(AdaptiveAlgorithm algorithm) {
+  AdaptiveConcurrencyConfig config;
+  config.algorithm = algorithm;
+  config.initial_limit = 20;
+  config.max_limit = 200;
+  return config;
+}
+
+// Saturated service with the given RTT
+std::size_t RunUpdates(AdaptiveConcurrencyLimit& limit,
+                       const AdaptiveConcurrencyConfig& config,
+                       std::chrono::microseconds rtt, int updates) {
+  for (int i = 0; i < updates; ++i) {
+    limit.Update(config, rtt, limit.GetLimit(), false);
+  }
+  return limit.GetLimit();
+}
+
+class AdaptiveConcurrencyLimitTest
+    : public ::testing::TestWithParam<AdaptiveAlgorithm> {};
+
+}  // namespace
+
+TEST_P(AdaptiveConcurrencyLimitTest, GrowsWhileRttIsStable) {
+  const auto config = MakeConfig(GetParam());
+  AdaptiveConcurrencyLimit limit{config};
+
+  EXPECT_GT(RunUpdates(limit, config, kBaseRtt, 50), config.initial_limit);
+  EXPECT_EQ(RunUpdates(limit, config, kBaseRtt, 1000), config.max_limit);
+}
+
+TEST_P(AdaptiveConcurrencyLimitTest, ShrinksOnQueueing) {
+  const auto config = MakeConfig(GetParam());
+  AdaptiveConcurrencyLimit limit{config};
+
+  const auto grown = RunUpdates(limit, config, kBaseRtt, 100);
+  const auto shrunk = RunUpdates(limit, config, kBaseRtt * 4, 20);
+  EXPECT_LT(shrunk, grown);
+  EXPECT_GE(shrunk, config.min_limit);
+}
+
+TEST_P(AdaptiveConcurrencyLimitTest, ShrinksOnDrops) {
+  const auto config = MakeConfig(GetParam());
+  AdaptiveConcurrencyLimit limit{config};
+
+  for (int i = 0; i < 100; ++i) {
+    limit.Update(config, kBaseRtt, limit.GetLimit(), true);
+  }
+  EXPECT_EQ(limit.GetLimit(), config.min_limit);
+}
+
+TEST_P(AdaptiveConcurrencyLimitTest, IgnoresAppLimitedWindows) {
+  const auto config = MakeConfig(GetParam());
+  AdaptiveConcurrencyLimit limit{config};
+
+  for (int i = 0; i < 100; ++i) {
+    limit.Update(config, kBaseRtt * (i % 5 + 1), 1, false);
+  }
+  EXPECT_EQ(limit.GetLimit(), config.initial_limit);
+}
+
+INSTANTIATE_TEST_SUITE_P(/*no prefix*/, AdaptiveConcurrencyLimitTest,
+                         ::testing::Values(AdaptiveAlgorithm::kGradient2,
+                                           AdaptiveAlgorithm::kVegas));
+
+TEST(AdaptiveConcurrencyConfig, Parse) {
+  const auto config = formats::json::FromString(R"({
+      "algorithm": "vegas",
+      "min-limit": 2,
+      "initial-limit": 10,
+      "window-size": 5
+  })")
+                          .As<AdaptiveConcurrencyConfig>();
+  EXPECT_TRUE(config.enabled);
+  EXPECT_EQ(config.algorithm, AdaptiveAlgorithm::kVegas);
+  EXPECT_EQ(config.min_limit, 2);
+  EXPECT_EQ(config.initial_limit, 10);
+  EXPECT_EQ(config.window_size, 5);
+
+  EXPECT_ANY_THROW(formats::json::FromString(R"({"min-limit": 100})")
+                       .As<AdaptiveConcurrencyConfig>());
+  EXPECT_ANY_THROW(formats::json::FromString(R"({"smoothing": 0})")
+                       .As<AdaptiveConcurrencyConfig>());
+}
+
+UTEST(AdaptiveLimiter, RejectsOverLimit) {
+  auto config = MakeConfig(AdaptiveAlgorithm::kGradient2);
+  config.initial_limit = 3;
+  config.min_limit = 1;
+  AdaptiveLimiter limiter{config};
+
+  std::vector<AdaptiveLimiter::Token> tokens;
+  for (int i = 0; i < 3; ++i) {
+    auto token = limiter.TryAcquire(config);
+    ASSERT_TRUE(token);
+    tokens.push_back(std::move(*token));
+  }
+  EXPECT_EQ(limiter.GetInFlight(), 3);
+  EXPECT_FALSE(limiter.TryAcquire(config));
+
+  tokens.back().OnSuccess();
+  tokens.pop_back();
+  EXPECT_EQ(limiter.GetInFlight(), 2);
+  EXPECT_TRUE(limiter.TryAcquire(config));
+
+  tokens.clear();
+  EXPECT_EQ(limiter.GetInFlight(), 0);
+}
+
+UTEST(AdaptiveLimiter, UpdatesLimitPerWindow) {
+  auto config = MakeConfig(AdaptiveAlgorithm::kGradient2);
+  config.window_size = 4;
+  AdaptiveLimiter limiter{config};
+
+  for (int window = 0; window < 10; ++window) {
+    std::vector<AdaptiveLimiter::Token> tokens;
+    while (auto token = limiter.TryAcquire(config)) {
+      tokens.push_back(std::move(*token));
+    }
+    for (auto& token : tokens) token.OnSuccess();
+  }
+  EXPECT_GT(limiter.GetLimit(), config.initial_limit);
+}
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,8 @@
 
 #include <sys/param.h>
 
+#include <optional>
+
 #include <userver/concurrent/variable.hpp>
 #include <userver/dist_lock/dist_lock_settings.hpp>
 #include <userver/dist_lock/dist_lock_strategy.hpp>
@@ -75,6 +77,34 @@ class MockDistLockStrategy final : public dist_lock::DistLockStrategyBase {
 
 auto MakeMockStrategy() { return std::make_shared<MockDistLockStrategy>(); }
 
+class FencedMockDistLockStrategy final
+    : public dist_lock::DistLockStrategyBase {
+ public:
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override {
+    AcquireWithFencingToken(lock_ttl, locker_id);
+  }
+
+  std::optional<dist_lock::FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl,
+      const std::string& locker_id) override {
+    mock_.Acquire(lock_ttl, locker_id);
+    return token_.load();
+  }
+
+  void Release(const std::string& locker_id) override {
+    mock_.Release(locker_id);
+  }
+
+  void Allow(bool allowed) { mock_.Allow(allowed); }
+
+  void SetToken(dist_lock::FencingToken token) { token_ = token; }
+
+ private:
+  MockDistLockStrategy mock_;
+  std::atomic<dist_lock::FencingToken> token_{1};
+};
+
 class DistLockWorkload {
  public:
   explicit DistLockWorkload(bool abort_on_cancel = false)
@@ -244,6 +274,47 @@ UTEST_MT(LockedWorker, LockedByOther, 3) {
   locked_worker.Stop();
 }
 
+UTEST_MT(LockedWorker, FencingToken, 3) {
+  auto strategy = std::make_shared<FencedMockDistLockStrategy>();
+  DistLockWorkload work;
+  dist_lock::DistLockedWorker locked_worker(
+      kWorkerName, [&] { work.Work(); }, strategy, MakeSettings());
+
+  locked_worker.Start();
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+
+  strategy->SetToken(42);
+  strategy->Allow(true);
+  EXPECT_TRUE(work.WaitForLocked(true, utest::kMaxTestWaitTime));
+  EXPECT_EQ(locked_worker.GetFencingToken(), 42);
+  EXPECT_EQ(locked_worker.GetStatistics().acquisitions.Load(), 1);
+
+  // Someone else has owned the lock since the last prolongation
+  strategy->SetToken(43);
+  while (locked_worker.GetFencingToken() != 43) {
+    engine::SleepFor(kAttemptInterval);
+  }
+  EXPECT_EQ(locked_worker.GetStatistics().brain_splits.Load(), 1);
+
+  locked_worker.Stop();
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+  EXPECT_EQ(locked_worker.GetStatistics().releases.Load(), 1);
+}
+
+UTEST_MT(LockedWorker, NoFencingToken, 3) {
+  auto strategy = MakeMockStrategy();
+  DistLockWorkload work;
+  dist_lock::DistLockedWorker locked_worker(
+      kWorkerName, [&] { work.Work(); }, strategy, MakeSettings());
+
+  locked_worker.Start();
+  strategy->Allow(true);
+  EXPECT_TRUE(work.WaitForLocked(true, utest::kMaxTestWaitTime));
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+
+  locked_worker.Stop();
+}
+
 UTEST_MT(LockedTask, Smoke, 3) {
   auto strategy = MakeMockStrategy();
   DistLockWorkload work;
@@ -92,6 +92,11 @@ DistLockedWorker::GetLockedDuration() const {
   return locker_ptr_->GetLockedDuration();
 }
 
+std::optional<FencingToken> DistLockedWorker::GetFencingToken()
+    const noexcept {
+  return locker_ptr_->GetFencingToken();
+}
+
 const Statistics& DistLockedWorker::GetStatistics() const {
   return locker_ptr_->GetStatistics();
 }
@@ -114,6 +119,8 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["watchdog-triggers"] = stats.watchdog_triggers.Load();
   writer["brain-splits"] = stats.brain_splits.Load();
   writer["task-failures"] = stats.task_failures.Load();
+  writer["acquisitions"] = stats.acquisitions.Load();
+  writer["releases"] = stats.releases.Load();
 }
 
 }  // namespace dist_lock
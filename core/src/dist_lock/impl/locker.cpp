@@ -105,8 +105,10 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
     const auto attempt_start = utils::datetime::SteadyNow();
 
     try {
-      strategy_->Acquire(settings.lock_ttl, Id());
+      const auto fencing_token =
+          strategy_->AcquireWithFencingToken(settings.lock_ttl, Id());
       stats_.lock_successes++;
+      UpdateFencingToken(fencing_token);
       if (!ExchangeLockState(true, attempt_start)) {
         LOG_DEBUG() << "Starting watchdog task";
         GetTask(watchdog_task, WatchdogName(name_));
@@ -190,6 +192,25 @@ engine::TaskWithResult<void> Locker::RunAsync(
 
 bool Locker::OwnsLock() const noexcept { return is_locked_.load(); }
 
+std::optional<FencingToken> Locker::GetFencingToken() const noexcept {
+  if (!is_locked_) return {};
+  const auto token = fencing_token_.load();
+  if (token == 0) return {};
+  return token;
+}
+
+void Locker::UpdateFencingToken(std::optional<FencingToken> token) {
+  const auto old_token = fencing_token_.exchange(token.value_or(0));
+  if (is_locked_ && token && old_token != 0 && *token != old_token) {
+    LOG_ERROR() << "Fencing token changed from " << old_token << " to "
+                << *token
+                << " while we're assuming we're holding the lock. Someone "
+                   "else has owned the lock in between, it may be a brain "
+                   "split.";
+    stats_.brain_splits++;
+  }
+}
+
 bool Locker::ExchangeLockState(bool is_locked,
                                std::chrono::steady_clock::time_point when) {
   lock_refresh_since_epoch_.store(when.time_since_epoch(),
@@ -200,8 +221,10 @@ bool Locker::ExchangeLockState(bool is_locked,
     if (!was_locked) {
       LOG(base_log_level_) << "Acquired the lock";
       lock_acquire_since_epoch_ = when.time_since_epoch();
+      stats_.acquisitions++;
     } else {
       LOG(base_log_level_) << "Released (or lost) the lock";
+      stats_.releases++;
     }
   }
   return was_locked;
@@ -46,6 +46,8 @@ class Locker final {
 
   bool OwnsLock() const noexcept;
 
+  std::optional<FencingToken> GetFencingToken() const noexcept;
+
  private:
   class LockGuard;
 
@@ -55,6 +57,8 @@ class Locker final {
   bool ExchangeLockState(bool is_locked,
                          std::chrono::steady_clock::time_point when);
 
+  void UpdateFencingToken(std::optional<FencingToken> token);
+
   void RunWatchdog();
 
   const std::string name_;
@@ -69,6 +73,8 @@ class Locker final {
   std::atomic<bool> is_locked_{false};
   std::atomic<std::chrono::steady_clock::duration> lock_refresh_since_epoch_{};
   std::atomic<std::chrono::steady_clock::duration> lock_acquire_since_epoch_{};
+  // 0 stands for 'no token'
+  std::atomic<FencingToken> fencing_token_{0};
 
   Statistics stats_;
   const logging::Level base_log_level_;
@@ -1,16 +1,34 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
 #include <boost/stacktrace/stacktrace.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <exception>
 #include <memory>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#else
+#include <openssl/hmac.h>
+#endif
+
+#if defined(__linux__) && OPENSSL_VERSION_NUMBER >= 0x30000000L && \
+    defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define USERVER_IMPL_HAS_KTLS
+#endif
 
 #include <userver/crypto/openssl.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <crypto/helpers.hpp>
@@ -60,6 +78,10 @@ struct SocketBioData {
   Socket socket;
   Deadline current_deadline;
   std::exception_ptr last_exception;
+
+  // The OpenSSL socket BIO is used instead of ours, so that OpenSSL could set
+  // up kTLS on the socket. It does not wait, the coroutine waits for it.
+  bool is_native_bio{false};
 };
 
 int SocketBioWriteEx(BIO* bio, const char* data, size_t len,
@@ -263,8 +285,205 @@ void AddCertAuthorities(
   }
 }
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+using TicketMacCtx = EVP_MAC_CTX;
+
+bool InitTicketMac(EVP_MAC_CTX* ctx, const TlsSessionTicketKey& key) {
+  static char kDigest[] = "sha256";
+  // OSSL_PARAM does not modify the key, it is just not const-correct
+  auto* secret = const_cast<unsigned char*>(key.hmac_secret.data());
+  const OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, secret,
+                                        key.hmac_secret.size()),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, kDigest, 0),
+      OSSL_PARAM_construct_end(),
+  };
+  return 1 == EVP_MAC_CTX_set_params(ctx, params);
+}
+#else
+using TicketMacCtx = HMAC_CTX;
+
+bool InitTicketMac(HMAC_CTX* ctx, const TlsSessionTicketKey& key) {
+  return 1 == HMAC_Init_ex(ctx, key.hmac_secret.data(), key.hmac_secret.size(),
+                           EVP_sha256(), nullptr);
+}
+#endif
+
 }  // namespace
 
+TlsSessionTicketKey TlsSessionTicketKey::FromBinary(std::string_view data) {
+  if (data.size() != kSize) {
+    throw TlsException(
+        fmt::format("Invalid size of a TLS session ticket key: {}, expected {}",
+                    data.size(), kSize));
+  }
+
+  TlsSessionTicketKey key;
+  const auto* it = data.data();
+  std::memcpy(key.name.data(), it, key.name.size());
+  it += key.name.size();
+  std::memcpy(key.hmac_secret.data(), it, key.hmac_secret.size());
+  it += key.hmac_secret.size();
+  std::memcpy(key.aes_key.data(), it, key.aes_key.size());
+  return key;
+}
+
+class TlsServerContext::Impl final {
+ public:
+  Impl(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+       const std::vector<crypto::Certificate>& extra_cert_authorities,
+       const TlsSessionSettings& session_settings);
+
+  // Follows the callback contract of SSL_CTX_set_tlsext_ticket_key_cb
+  static int OnTicketKey(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                         EVP_CIPHER_CTX* cipher_ctx, TicketMacCtx* mac_ctx,
+                         int enc) noexcept;
+
+  SslCtx ssl_ctx;
+  const bool has_ticket_keys;
+  rcu::Variable<std::vector<TlsSessionTicketKey>> ticket_keys;
+};
+
+TlsServerContext::Impl::Impl(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    const TlsSessionSettings& session_settings)
+    : ssl_ctx(MakeSslCtx()),
+      has_ticket_keys(!session_settings.ticket_keys.empty()),
+      ticket_keys(session_settings.ticket_keys) {
+  if (!extra_cert_authorities.empty()) {
+    AddCertAuthorities(ssl_ctx, extra_cert_authorities);
+    SSL_CTX_set_verify(ssl_ctx.get(),
+                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                       nullptr);
+    LOG_INFO() << "Client SSL cert will be verified";
+  } else {
+    LOG_INFO() << "Client SSL cert will not be verified";
+  }
+
+  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
+  }
+
+  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
+  }
+
+  // Sessions are not resumed without it if the client cert is verified
+  static constexpr unsigned char kSessionIdContext[] = "userver";
+  if (1 != SSL_CTX_set_session_id_context(ssl_ctx.get(), kSessionIdContext,
+                                          sizeof(kSessionIdContext) - 1)) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: "
+        "SSL_CTX_set_session_id_context"));
+  }
+
+  if (session_settings.cache_size) {
+    SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ssl_ctx.get(), session_settings.cache_size);
+  } else {
+    SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_OFF);
+  }
+  SSL_CTX_set_timeout(ssl_ctx.get(), session_settings.timeout.count());
+
+  if (!session_settings.tickets) {
+    SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+    // TLS 1.3 sends stateful tickets with SSL_OP_NO_TICKET, useless without
+    // the cache
+    if (!session_settings.cache_size) {
+      SSL_CTX_set_num_tickets(ssl_ctx.get(), 0);
+    }
+#endif
+  } else if (has_ticket_keys) {
+    SSL_CTX_set_app_data(ssl_ctx.get(), this);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    const auto ret =
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ssl_ctx.get(), &Impl::OnTicketKey);
+#else
+    const auto ret =
+        SSL_CTX_set_tlsext_ticket_key_cb(ssl_ctx.get(), &Impl::OnTicketKey);
+#endif
+    if (1 != ret) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up server TLS wrapper: session ticket key callback"));
+    }
+  }
+}
+
+int TlsServerContext::Impl::OnTicketKey(SSL* ssl, unsigned char* key_name,
+                                        unsigned char* iv,
+                                        EVP_CIPHER_CTX* cipher_ctx,
+                                        TicketMacCtx* mac_ctx,
+                                        int enc) noexcept {
+  const auto* self =
+      static_cast<const Impl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  UASSERT(self);
+  const auto keys = self->ticket_keys.Read();
+  const auto* cipher = EVP_aes_256_cbc();
+
+  if (enc) {
+    // A new ticket is encrypted with the first key
+    if (keys->empty()) return 0;
+    const auto& key = keys->front();
+    std::copy(key.name.begin(), key.name.end(), key_name);
+    if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(cipher))) return -1;
+    if (1 != EVP_EncryptInit_ex(cipher_ctx, cipher, nullptr,
+                                key.aes_key.data(), iv)) {
+      return -1;
+    }
+    return InitTicketMac(mac_ctx, key) ? 1 : -1;
+  }
+
+  const auto it =
+      std::find_if(keys->begin(), keys->end(), [key_name](const auto& key) {
+        return std::equal(key.name.begin(), key.name.end(), key_name);
+      });
+  // Unknown or dropped key, falling back to a full handshake
+  if (it == keys->end()) return 0;
+
+  if (!InitTicketMac(mac_ctx, *it) ||
+      1 != EVP_DecryptInit_ex(cipher_ctx, cipher, nullptr, it->aes_key.data(),
+                              iv)) {
+    return -1;
+  }
+  // The tickets of the previous keys are renewed
+  return it == keys->begin() ? 1 : 2;
+}
+
+TlsServerContext::TlsServerContext(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    const TlsSessionSettings& session_settings)
+    : impl_(std::make_unique<Impl>(cert, key, extra_cert_authorities,
+                                   session_settings)) {}
+
+TlsServerContext::TlsServerContext(TlsServerContext&&) noexcept = default;
+
+TlsServerContext& TlsServerContext::operator=(TlsServerContext&&) noexcept =
+    default;
+
+TlsServerContext::~TlsServerContext() = default;
+
+void TlsServerContext::SetSessionTicketKeys(
+    std::vector<TlsSessionTicketKey> keys) {
+  if (!impl_->has_ticket_keys) {
+    throw TlsException(
+        "Session ticket keys may only be replaced if the TlsServerContext was "
+        "created with them");
+  }
+  if (keys.empty()) {
+    throw TlsException("At least one session ticket key is required");
+  }
+  impl_->ticket_keys.Assign(std::move(keys));
+}
+
+std::size_t TlsServerContext::GetCachedSessionsCount() const {
+  return SSL_CTX_sess_number(impl_->ssl_ctx.get());
+}
+
 class TlsWrapper::ReadContextAccessor final
     : public engine::impl::ContextAccessor {
  public:
@@ -298,20 +517,39 @@ class TlsWrapper::Impl {
         is_in_shutdown(other.is_in_shutdown) {
     UASSERT(ssl);
     UASSERT(SSL_get_rbio(ssl.get()) == SSL_get_wbio(ssl.get()));
-    SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    if (!bio_data.is_native_bio) {
+      SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    }
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
-    Bio socket_bio{BIO_new(GetSocketBioMethod())};
-    if (!socket_bio) {
-      throw TlsException(
-          crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+  void SetUp(SSL_CTX* ssl_ctx, TlsOffload offload) {
+    if (offload == TlsOffload::kKernel) {
+#ifdef USERVER_IMPL_HAS_KTLS
+      bio_data.is_native_bio = true;
+#else
+      LOG_LIMITED_INFO() << "kTLS is not supported by the platform or OpenSSL";
+#endif
+    }
+
+    Bio socket_bio;
+    if (bio_data.is_native_bio) {
+      socket_bio.reset(BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE));
+      if (!socket_bio) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up TLS wrapper: BIO_new_socket"));
+      }
+    } else {
+      socket_bio.reset(BIO_new(GetSocketBioMethod()));
+      if (!socket_bio) {
+        throw TlsException(
+            crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+      }
+      BIO_set_shutdown(socket_bio.get(), 0);
+      SyncBioData(socket_bio.get(), nullptr);
+      BIO_set_init(socket_bio.get(), 1);
     }
-    BIO_set_shutdown(socket_bio.get(), 0);
-    SyncBioData(socket_bio.get(), nullptr);
-    BIO_set_init(socket_bio.get(), 1);
 
-    ssl.reset(SSL_new(ssl_ctx.get()));
+    ssl.reset(SSL_new(ssl_ctx));
     if (!ssl) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: SSL_new"));
@@ -321,6 +559,44 @@ class TlsWrapper::Impl {
 #endif
     SSL_set_bio(ssl.get(), socket_bio.get(), socket_bio.get());
     [[maybe_unused]] const auto* disowned_bio = socket_bio.release();
+
+#ifdef USERVER_IMPL_HAS_KTLS
+    if (bio_data.is_native_bio) {
+      // OpenSSL falls back to user space if the kernel or the cipher does not
+      // support kTLS
+      SSL_set_options(ssl.get(), SSL_OP_ENABLE_KTLS);
+    }
+#endif
+  }
+
+  template <typename SslHandshakeFunc>
+  int DoHandshake(SslHandshakeFunc&& handshake_func) {
+    while (true) {
+      const int ret = handshake_func(ssl.get());
+      if (ret == 1 || !bio_data.is_native_bio) return ret;
+
+      const int ssl_error = SSL_get_error(ssl.get(), ret);
+      if (ssl_error != SSL_ERROR_WANT_READ &&
+          ssl_error != SSL_ERROR_WANT_WRITE) {
+        return ret;
+      }
+      bio_data.last_exception = WaitNativeBio(ssl_error, 0);
+      if (bio_data.last_exception) return ret;
+    }
+  }
+
+  // Returns the exception to throw if the socket did not get ready in time
+  std::exception_ptr WaitNativeBio(int ssl_error, size_t bytes_transferred) {
+    UASSERT(bio_data.is_native_bio);
+    const bool is_ready =
+        ssl_error == SSL_ERROR_WANT_WRITE
+            ? bio_data.socket.WaitWriteable(bio_data.current_deadline)
+            : bio_data.socket.WaitReadable(bio_data.current_deadline);
+    if (is_ready) return {};
+    if (current_task::ShouldCancel()) {
+      return std::make_exception_ptr(IoCancelled(bytes_transferred));
+    }
+    return std::make_exception_ptr(IoTimeout(bytes_transferred));
   }
 
   void ClientConnect(const std::string& server_name, Deadline deadline) {
@@ -335,7 +611,7 @@ class TlsWrapper::Impl {
 
     bio_data.current_deadline = deadline;
 
-    auto ret = SSL_connect(ssl.get());
+    auto ret = DoHandshake(&SSL_connect);
     if (1 != ret) {
       if (bio_data.last_exception) {
         std::rethrow_exception(bio_data.last_exception);
@@ -366,6 +642,8 @@ class TlsWrapper::Impl {
 #endif
 
     bio_data.current_deadline = deadline;
+    // Unlike our BIO, the native one does not reset it on success
+    if (bio_data.is_native_bio) bio_data.last_exception = {};
 
     char* const begin = static_cast<char*>(buf);
     char* const end = begin + len;
@@ -386,6 +664,10 @@ class TlsWrapper::Impl {
           // timeout, cancel, EOF, or just a spurious wakeup
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            if (bio_data.is_native_bio) {
+              bio_data.last_exception = WaitNativeBio(ssl_error, pos - begin);
+            }
+            break;
           case SSL_ERROR_ZERO_RETURN:
             break;
 
@@ -482,12 +764,12 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {
 
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
-                                      Deadline deadline) {
+                                      Deadline deadline, TlsOffload offload) {
   auto ssl_ctx = MakeSslCtx();
   SetServerName(ssl_ctx, server_name);
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(ssl_ctx.get(), offload);
   wrapper.impl_->ClientConnect(server_name, deadline);
   return wrapper;
 }
@@ -496,7 +778,8 @@ TlsWrapper TlsWrapper::StartTlsClient(
     Socket&& socket, const std::string& server_name,
     const crypto::Certificate& cert, const crypto::PrivateKey& key,
     Deadline deadline,
-    const std::vector<crypto::Certificate>& extra_cert_authorities) {
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    TlsOffload offload) {
   auto ssl_ctx = MakeSslCtx();
   SetServerName(ssl_ctx, server_name);
 
@@ -519,7 +802,7 @@ TlsWrapper TlsWrapper::StartTlsClient(
   }
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(ssl_ctx.get(), offload);
   wrapper.impl_->ClientConnect(server_name, deadline);
   return wrapper;
 }
@@ -527,34 +810,26 @@ TlsWrapper TlsWrapper::StartTlsClient(
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& extra_cert_authorities) {
-  auto ssl_ctx = MakeSslCtx();
-
-  if (!extra_cert_authorities.empty()) {
-    AddCertAuthorities(ssl_ctx, extra_cert_authorities);
-    SSL_CTX_set_verify(ssl_ctx.get(),
-                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
-                       nullptr);
-    LOG_INFO() << "Client SSL cert will be verified";
-  } else {
-    LOG_INFO() << "Client SSL cert will not be verified";
-  }
-
-  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
-  }
-
-  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
-  }
-
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    TlsOffload offload) {
+  // The context dies with the connection, nothing could be resumed with it
+  TlsSessionSettings session_settings;
+  session_settings.cache_size = 0;
+  session_settings.tickets = false;
+  return StartTlsServer(
+      std::move(socket),
+      TlsServerContext{cert, key, extra_cert_authorities, session_settings},
+      deadline, offload);
+}
+
+TlsWrapper TlsWrapper::StartTlsServer(Socket&& socket,
+                                      const TlsServerContext& context,
+                                      Deadline deadline, TlsOffload offload) {
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(context.impl_->ssl_ctx.get(), offload);
   wrapper.impl_->bio_data.current_deadline = deadline;
 
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
+  auto ret = wrapper.impl_->DoHandshake(&SSL_accept);
   if (1 != ret) {
     if (wrapper.impl_->bio_data.last_exception) {
       std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
@@ -675,9 +950,14 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
 }
 
 Socket TlsWrapper::StopTls(Deadline deadline) {
+  // The kernel would keep encrypting whatever is sent to the socket. Without
+  // the SSL object there is no telling whether it was offloaded.
+  const bool must_close =
+      impl_->bio_data.is_native_bio && (!impl_->ssl || IsKernelTlsOffloaded());
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
     impl_->bio_data.current_deadline = deadline;
+    if (impl_->bio_data.is_native_bio) impl_->bio_data.last_exception = {};
     int shutdown_ret = 0;
     while (shutdown_ret != 1) {
       shutdown_ret = SSL_shutdown(impl_->ssl.get());
@@ -687,6 +967,10 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
           // this is fine
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            if (impl_->bio_data.is_native_bio) {
+              impl_->bio_data.last_exception =
+                  impl_->WaitNativeBio(ssl_error, 0);
+            }
             break;
 
           // connection breaking errors
@@ -708,9 +992,23 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
     }
     impl_->ssl.reset();
   }
+  if (must_close) impl_->bio_data.socket.Close();
   return std::move(impl_->bio_data.socket);
 }
 
+bool TlsWrapper::IsKernelTlsOffloaded() const noexcept {
+#ifdef USERVER_IMPL_HAS_KTLS
+  if (!impl_->ssl || !impl_->bio_data.is_native_bio) return false;
+  return BIO_get_ktls_send(SSL_get_wbio(impl_->ssl.get()));
+#else
+  return false;
+#endif
+}
+
+bool TlsWrapper::IsSessionReused() const noexcept {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get()) == 1;
+}
+
 int TlsWrapper::GetRawFd() { return impl_->bio_data.socket.Fd(); }
 
 }  // namespace engine::io
@@ -181,4 +181,56 @@ BENCHMARK(tls_write_all_default)
     ->Range(1 << 6, 1 << 12)
     ->Unit(benchmark::kNanosecond);
 
+// Server sends records of state.range(0) bytes to the client over loopback,
+// with the encryption offloaded to the kernel if state.range(1) is set.
+[[maybe_unused]] void tls_send_throughput(benchmark::State& state) {
+  engine::RunStandalone(2, [&]() {
+    const auto deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    const auto offload =
+        state.range(1) ? io::TlsOffload::kKernel : io::TlsOffload::kNone;
+
+    TcpListener tcp_listener;
+    auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+
+    std::atomic<bool> reading{true};
+    auto client_task = engine::AsyncNoSpan(
+        [&reading, deadline](auto&& client) {
+          auto tls_client = io::TlsWrapper::StartTlsClient(
+              std::forward<decltype(client)>(client), {}, deadline);
+
+          std::array<std::byte, 16'384> buf{};
+          while (tls_client.RecvSome(buf.data(), buf.size(), deadline) > 0 &&
+                 reading) {
+            /* receiving msgs */
+          }
+        },
+        std::move(client));
+
+    auto tls_server = io::TlsWrapper::StartTlsServer(
+        std::move(server), crypto::Certificate::LoadFromString(cert),
+        crypto::PrivateKey::LoadFromString(key), deadline, {}, offload);
+    if (offload == io::TlsOffload::kKernel) {
+      state.SetLabel(tls_server.IsKernelTlsOffloaded() ? "ktls"
+                                                       : "ktls-fallback");
+    }
+
+    const std::string payload(state.range(0), 'x');
+    for ([[maybe_unused]] auto _ : state) {
+      auto send_bytes =
+          tls_server.SendAll(payload.data(), payload.size(), deadline);
+      benchmark::DoNotOptimize(send_bytes);
+    }
+    state.SetBytesProcessed(state.iterations() * payload.size());
+
+    reading.store(false);
+    // wake up the client if it has read everything
+    static_cast<void>(tls_server.SendAll("x", 1, deadline));
+    client_task.Get();
+  });
+}
+
+BENCHMARK(tls_send_throughput)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 16}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
 USERVER_NAMESPACE_END
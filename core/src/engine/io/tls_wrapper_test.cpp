@@ -1,13 +1,23 @@
 #include <userver/utest/utest.hpp>
 
+#include <openssl/bio.h>
 #include <openssl/opensslv.h>
+#include <openssl/ssl.h>
 #include <sys/socket.h>
+#ifdef __linux__
+#include <netinet/tcp.h>
+#endif
 
+#include <array>
+#include <functional>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -137,6 +147,22 @@ v2R63aFo/UfQSQ4dhC0o2Vy74DyLwnO3pH8wudfBJ8/LX/Uz/A==
 
 constexpr auto kShortTimeout = std::chrono::milliseconds{10};
 
+// Whether both OpenSSL and the kernel can do kTLS
+bool IsKernelTlsSupported(Deadline deadline) {
+#if defined(__linux__) && OPENSSL_VERSION_NUMBER >= 0x30000000L && \
+    defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  // The `tls` ULP can only be attached to an established connection
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+  static constexpr char kTlsUlp[] = "tls";
+  return ::setsockopt(client.Fd(), SOL_TCP, TCP_ULP, kTlsUlp,
+                      sizeof(kTlsUlp)) == 0;
+#else
+  (void)deadline;
+  return false;
+#endif
+}
+
 }  // namespace
 
 UTEST(TlsWrapper, InitListSmall) {
@@ -296,6 +322,50 @@ UTEST_MT(TlsWrapper, Smoke, 2) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, KernelOffload, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  if (!IsKernelTlsSupported(test_deadline)) {
+    GTEST_SKIP() << "kTLS is not supported by the kernel or OpenSSL";
+  }
+  const std::string payload(100'000, 'x');
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline, &payload](auto&& server) {
+        try {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+              io::TlsOffload::kKernel);
+          EXPECT_TRUE(tls_server.IsKernelTlsOffloaded());
+          EXPECT_EQ(payload.size(), tls_server.SendAll(
+                                        payload.data(), payload.size(),
+                                        test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          EXPECT_EQ('2', c);
+        } catch (const std::exception& e) {
+          LOG_ERROR() << e;
+          FAIL() << e.what();
+        }
+      },
+      std::move(server));
+
+  auto tls_client =
+      io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+  EXPECT_FALSE(tls_client.IsKernelTlsOffloaded());
+  std::string received(payload.size(), '\0');
+  EXPECT_EQ(payload.size(), tls_client.RecvAll(received.data(), received.size(),
+                                               test_deadline));
+  EXPECT_EQ(payload, received);
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+  server_task.Get();
+}
+
 UTEST_MT(TlsWrapper, DocTest, 2) {
   static constexpr std::string_view kData = "hello world";
   const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
@@ -686,4 +756,260 @@ UTEST(TlsWrapper, PeerDisconnect) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, SharedServerContext, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  io::TlsSessionSettings session_settings;
+  session_settings.ticket_keys.push_back(
+      io::TlsSessionTicketKey::FromBinary(std::string(80, 'k')));
+  io::TlsServerContext context{crypto::Certificate::LoadFromString(cert),
+                               crypto::PrivateKey::LoadFromString(key),
+                               {},
+                               session_settings};
+
+  TcpListener tcp_listener;
+  for (int i = 0; i < 2; ++i) {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline, &context](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server), context, test_deadline);
+          // The client does not offer the session of the first connection
+          EXPECT_FALSE(tls_server.IsSessionReused());
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+        },
+        std::move(server));
+
+    auto tls_client =
+        io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+    char c = 0;
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ('1', c);
+    server_task.Get();
+  }
+
+  context.SetSessionTicketKeys(
+      {io::TlsSessionTicketKey::FromBinary(std::string(80, 'n')),
+       io::TlsSessionTicketKey::FromBinary(std::string(80, 'k'))});
+  EXPECT_THROW(context.SetSessionTicketKeys({}), io::TlsException);
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+
+namespace {
+
+using SessionPtr = std::unique_ptr<SSL_SESSION, decltype(&SSL_SESSION_free)>;
+
+// TlsWrapper can't offer a saved session, so the resumption tests use a bare
+// OpenSSL client over memory BIOs
+class ResumingTlsClient final {
+ public:
+  ResumingTlsClient(io::Socket&& socket, SSL_SESSION* session,
+                    Deadline deadline)
+      : socket_(std::move(socket)), deadline_(deadline) {
+    if (!ctx_ || !ssl_) throw std::runtime_error("Failed to create SSL");
+    // SSL takes the ownership of the BIOs
+    SSL_set_bio(ssl_.get(), BIO_new(BIO_s_mem()), BIO_new(BIO_s_mem()));
+    if (session && 1 != SSL_set_session(ssl_.get(), session)) {
+      throw std::runtime_error("SSL_set_session failed");
+    }
+    SSL_set_connect_state(ssl_.get());
+    Run([this] { return SSL_do_handshake(ssl_.get()); });
+  }
+
+  // TLS 1.3 session tickets are received with the data after the handshake
+  char RecvByte() {
+    char c = 0;
+    Run([this, &c] { return SSL_read(ssl_.get(), &c, 1); });
+    return c;
+  }
+
+  SessionPtr GetSession() const {
+    return {SSL_get1_session(ssl_.get()), &SSL_SESSION_free};
+  }
+
+  bool IsSessionReused() const { return SSL_session_reused(ssl_.get()) == 1; }
+
+ private:
+  void Run(const std::function<int()>& operation) {
+    while (true) {
+      const int ret = operation();
+      Flush();
+      if (ret > 0) return;
+      if (SSL_get_error(ssl_.get(), ret) != SSL_ERROR_WANT_READ) {
+        throw std::runtime_error("TLS client failed");
+      }
+
+      std::array<char, 16384> buffer{};
+      const auto size =
+          socket_.RecvSome(buffer.data(), buffer.size(), deadline_);
+      if (size == 0) throw std::runtime_error("Connection closed");
+      BIO_write(SSL_get_rbio(ssl_.get()), buffer.data(),
+                static_cast<int>(size));
+    }
+  }
+
+  void Flush() {
+    auto* bio = SSL_get_wbio(ssl_.get());
+    char* data = nullptr;
+    const auto size = static_cast<std::size_t>(BIO_get_mem_data(bio, &data));
+    if (size == 0) return;
+    if (socket_.SendAll(data, size, deadline_) != size) {
+      throw std::runtime_error("Connection closed");
+    }
+    BIO_reset(bio);
+  }
+
+  io::Socket socket_;
+  const Deadline deadline_;
+  std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> ctx_{
+      SSL_CTX_new(TLS_client_method()), &SSL_CTX_free};
+  std::unique_ptr<SSL, decltype(&SSL_free)> ssl_{SSL_new(ctx_.get()),
+                                                 &SSL_free};
+};
+
+struct Handshake final {
+  bool server_reused{false};
+  bool client_reused{false};
+  SessionPtr session{nullptr, &SSL_SESSION_free};
+};
+
+Handshake Connect(
+    TcpListener& tcp_listener,
+    const std::function<io::TlsWrapper(io::Socket&&)>& start_server,
+    SSL_SESSION* session, Deadline deadline) {
+  auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+  auto server_task = engine::AsyncNoSpan(
+      [&start_server, deadline](auto&& server) {
+        auto tls_server =
+            start_server(std::forward<decltype(server)>(server));
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, deadline));
+        return tls_server.IsSessionReused();
+      },
+      std::move(server));
+
+  ResumingTlsClient tls_client{std::move(client), session, deadline};
+  EXPECT_EQ('1', tls_client.RecvByte());
+
+  Handshake handshake;
+  handshake.server_reused = server_task.Get();
+  handshake.client_reused = tls_client.IsSessionReused();
+  handshake.session = tls_client.GetSession();
+  return handshake;
+}
+
+Handshake Connect(TcpListener& tcp_listener,
+                  const io::TlsServerContext& context, SSL_SESSION* session,
+                  Deadline deadline) {
+  return Connect(
+      tcp_listener,
+      [&context, deadline](io::Socket&& socket) {
+        return io::TlsWrapper::StartTlsServer(std::move(socket), context,
+                                              deadline);
+      },
+      session, deadline);
+}
+
+io::TlsSessionTicketKey MakeTicketKey(char fill) {
+  return io::TlsSessionTicketKey::FromBinary(
+      std::string(io::TlsSessionTicketKey::kSize, fill));
+}
+
+}  // namespace
+
+UTEST(TlsWrapper, SessionCacheResumption) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  io::TlsSessionSettings session_settings;
+  session_settings.tickets = false;
+  const io::TlsServerContext context{crypto::Certificate::LoadFromString(cert),
+                                     crypto::PrivateKey::LoadFromString(key),
+                                     {},
+                                     session_settings};
+
+  TcpListener tcp_listener;
+  const auto first = Connect(tcp_listener, context, nullptr, test_deadline);
+  EXPECT_FALSE(first.server_reused);
+  ASSERT_TRUE(first.session);
+  EXPECT_GE(context.GetCachedSessionsCount(), 1);
+
+  const auto second =
+      Connect(tcp_listener, context, first.session.get(), test_deadline);
+  EXPECT_TRUE(second.server_reused);
+  EXPECT_TRUE(second.client_reused);
+}
+
+UTEST(TlsWrapper, SessionTicketKeyRotation) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  // Without the cache the sessions may only be resumed with the tickets
+  io::TlsSessionSettings session_settings;
+  session_settings.cache_size = 0;
+  session_settings.ticket_keys = {MakeTicketKey('k')};
+  io::TlsServerContext context{crypto::Certificate::LoadFromString(cert),
+                               crypto::PrivateKey::LoadFromString(key),
+                               {},
+                               session_settings};
+
+  TcpListener tcp_listener;
+  const auto old_ticket =
+      Connect(tcp_listener, context, nullptr, test_deadline);
+  EXPECT_FALSE(old_ticket.server_reused);
+  ASSERT_TRUE(old_ticket.session);
+  EXPECT_EQ(context.GetCachedSessionsCount(), 0);
+
+  EXPECT_TRUE(
+      Connect(tcp_listener, context, old_ticket.session.get(), test_deadline)
+          .server_reused);
+
+  // The previous key still decrypts, the ticket is renewed with the new one
+  context.SetSessionTicketKeys({MakeTicketKey('n'), MakeTicketKey('k')});
+  const auto renewed =
+      Connect(tcp_listener, context, old_ticket.session.get(), test_deadline);
+  EXPECT_TRUE(renewed.server_reused);
+  EXPECT_TRUE(renewed.client_reused);
+  ASSERT_TRUE(renewed.session);
+
+  context.SetSessionTicketKeys({MakeTicketKey('n')});
+  EXPECT_FALSE(
+      Connect(tcp_listener, context, old_ticket.session.get(), test_deadline)
+          .server_reused);
+  EXPECT_TRUE(
+      Connect(tcp_listener, context, renewed.session.get(), test_deadline)
+          .server_reused);
+}
+
+UTEST(TlsWrapper, NoResumptionWithoutContext) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const auto start_server = [test_deadline](io::Socket&& socket) {
+    return io::TlsWrapper::StartTlsServer(
+        std::move(socket), crypto::Certificate::LoadFromString(cert),
+        crypto::PrivateKey::LoadFromString(key), test_deadline);
+  };
+
+  TcpListener tcp_listener;
+  const auto handshake =
+      Connect(tcp_listener, start_server, nullptr, test_deadline);
+  EXPECT_FALSE(handshake.server_reused);
+  // Neither a session id nor a ticket is issued by a per-connection context
+  EXPECT_FALSE(handshake.session &&
+               SSL_SESSION_is_resumable(handshake.session.get()));
+}
+
+#endif
+
+TEST(TlsSessionTicketKey, FromBinary) {
+  std::string data(io::TlsSessionTicketKey::kSize, 'a');
+  data[0] = 'n';
+  data[16] = 'h';
+  data[48] = 'e';
+  const auto key = io::TlsSessionTicketKey::FromBinary(data);
+  EXPECT_EQ(key.name[0], 'n');
+  EXPECT_EQ(key.hmac_secret[0], 'h');
+  EXPECT_EQ(key.aes_key[0], 'e');
+
+  EXPECT_THROW(io::TlsSessionTicketKey::FromBinary("short"), io::TlsException);
+}
+
 USERVER_NAMESPACE_END
@@ -6,7 +6,8 @@
 #include <thread>
 #include <vector>
 
-#include <concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/flat_combining_lock.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -125,6 +126,36 @@ void generic_contention_with_payload(benchmark::State& state) {
       total_lock_unlock_count / state.range(0), benchmark::Counter::kIsRate);
 }
 
+template <bool WithPayload>
+void flat_combining_contention(benchmark::State& state) {
+  std::atomic<std::uint64_t> apply_count{0};
+  concurrent::FlatCombiningLock<std::uint64_t> data{0};
+
+  RunParallelBenchmark(state, [&](auto& range) {
+    std::uint64_t local_apply_count = 0;
+
+    for ([[maybe_unused]] auto _ : range) {
+      data.Apply([](std::uint64_t& value) {
+        if constexpr (WithPayload) {
+          for (int i = 0; i < 10; ++i) {
+            benchmark::DoNotOptimize(utils::Rand());
+          }
+        }
+        ++value;
+      });
+      ++local_apply_count;
+    }
+
+    apply_count += local_apply_count;
+  });
+
+  const auto total_apply_count = static_cast<double>(apply_count.load());
+  state.counters["locks"] =
+      benchmark::Counter(total_apply_count, benchmark::Counter::kIsRate);
+  state.counters["locks-per-thread"] = benchmark::Counter(
+      total_apply_count / state.range(0), benchmark::Counter::kIsRate);
+}
+
 //////// Benchmarks
 
 // Note: We intentionally do not run std::* benchmarks from RunStandalone to
@@ -172,6 +203,11 @@ void single_waiting_task_mutex_contention(benchmark::State& state) {
   });
 }
 
+void flat_combining_lock_contention(benchmark::State& state) {
+  engine::RunStandalone(state.range(0),
+                        [&] { flat_combining_contention<false>(state); });
+}
+
 void mutex_coro_contention_with_payload(benchmark::State& state) {
   engine::RunStandalone(state.range(0), [&] {
     generic_contention_with_payload<engine::Mutex>(state);
@@ -189,6 +225,11 @@ void single_waiting_task_mutex_contention_with_payload(
   });
 }
 
+void flat_combining_lock_contention_with_payload(benchmark::State& state) {
+  engine::RunStandalone(state.range(0),
+                        [&] { flat_combining_contention<true>(state); });
+}
+
 }  // namespace
 
 BENCHMARK(mutex_coro_lock);
@@ -202,9 +243,13 @@ BENCHMARK(single_waiting_task_mutex_unlock);
 BENCHMARK(mutex_coro_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention)->Range(1, 2);
+BENCHMARK(flat_combining_lock_contention)->RangeMultiplier(2)->Range(1, 32);
 
 BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention_with_payload)->Range(1, 2);
+BENCHMARK(flat_combining_lock_contention_with_payload)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
 
 USERVER_NAMESPACE_END
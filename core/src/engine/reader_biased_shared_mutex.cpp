@@ -0,0 +1,135 @@
+#include <userver/engine/reader_biased_shared_mutex.hpp>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// The read bias is restored after kInhibitMultiplier revocation durations,
+// which limits the time spent on revocations by 1/kInhibitMultiplier.
+constexpr int kInhibitMultiplier = 9;
+
+}  // namespace
+
+ReaderBiasedSharedMutex::ReaderBiasedSharedMutex() = default;
+
+ReaderBiasedSharedMutex::~ReaderBiasedSharedMutex() = default;
+
+void ReaderBiasedSharedMutex::lock() {
+  const auto ok = try_lock_until(Deadline{});
+  UASSERT(ok);
+}
+
+void ReaderBiasedSharedMutex::unlock() { fallback_.unlock(); }
+
+bool ReaderBiasedSharedMutex::try_lock() {
+  return try_lock_until(Deadline::Passed());
+}
+
+bool ReaderBiasedSharedMutex::try_lock_until(Deadline deadline) {
+  if (!fallback_.try_lock_until(deadline)) return false;
+
+  if (!RevokeReadBias(deadline)) {
+    fallback_.unlock();
+    return false;
+  }
+  return true;
+}
+
+void ReaderBiasedSharedMutex::lock_shared() {
+  if (TryLockSharedFast()) return;
+
+  fallback_.lock_shared();
+  LockSharedFromFallback();
+}
+
+void ReaderBiasedSharedMutex::unlock_shared() {
+  readers_.DoUnlock();
+
+  // Pairs with the fence in RevokeReadBias: either the writer sees that we
+  // have left, or we see the revoked bias and wake up the writer.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!read_bias_.load(std::memory_order_relaxed)) readers_left_.Send();
+}
+
+bool ReaderBiasedSharedMutex::try_lock_shared() {
+  if (TryLockSharedFast()) return true;
+
+  if (!fallback_.try_lock_shared()) return false;
+  LockSharedFromFallback();
+  return true;
+}
+
+bool ReaderBiasedSharedMutex::try_lock_shared_until(Deadline deadline) {
+  if (TryLockSharedFast()) return true;
+
+  if (!fallback_.try_lock_shared_until(deadline)) return false;
+  LockSharedFromFallback();
+  return true;
+}
+
+bool ReaderBiasedSharedMutex::IsReadBiased() const noexcept {
+  return read_bias_.load(std::memory_order_relaxed);
+}
+
+bool ReaderBiasedSharedMutex::TryLockSharedFast() {
+  if (!read_bias_.load(std::memory_order_relaxed)) return false;
+
+  readers_.DoLock();
+
+  // Pairs with the fence in RevokeReadBias: either the writer sees our lock,
+  // or we see the revoked bias.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (read_bias_.load(std::memory_order_acquire)) return true;
+
+  unlock_shared();
+  return false;
+}
+
+void ReaderBiasedSharedMutex::LockSharedFromFallback() {
+  // Writers are excluded by fallback_, they will see our lock once they get it
+  MaybeRestoreReadBias();
+  readers_.DoLock();
+  fallback_.unlock_shared();
+}
+
+void ReaderBiasedSharedMutex::MaybeRestoreReadBias() noexcept {
+  if (read_bias_.load(std::memory_order_relaxed)) return;
+
+  const auto now = Clock::now().time_since_epoch().count();
+  if (now < inhibit_until_.load(std::memory_order_relaxed)) return;
+
+  read_bias_.store(true, std::memory_order_release);
+}
+
+bool ReaderBiasedSharedMutex::RevokeReadBias(Deadline deadline) {
+  const bool was_biased = read_bias_.exchange(false);
+  const auto revocation_start = was_biased ? Clock::now() : Clock::time_point{};
+
+  // Pairs with the fences in TryLockSharedFast and unlock_shared
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  TaskCancellationBlocker blocker;
+  while (!readers_.IsFree()) {
+    if (!readers_left_.WaitForEventUntil(deadline)) return false;
+  }
+
+  if (was_biased) {
+    const auto now = Clock::now();
+    const auto inhibit_until =
+        now + kInhibitMultiplier * (now - revocation_start);
+    inhibit_until_.store(inhibit_until.time_since_epoch().count(),
+                         std::memory_order_relaxed);
+  }
+  return true;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
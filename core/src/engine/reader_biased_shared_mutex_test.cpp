@@ -0,0 +1,140 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/reader_biased_shared_mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kWaitTime{50};
+
+}  // namespace
+
+UTEST(ReaderBiasedSharedMutex, SharedLockUnlockDouble) {
+  engine::ReaderBiasedSharedMutex mutex;
+  EXPECT_TRUE(mutex.IsReadBiased());
+
+  mutex.lock_shared();
+  mutex.lock_shared();
+  mutex.unlock_shared();
+  mutex.unlock_shared();
+
+  EXPECT_TRUE(mutex.IsReadBiased());
+}
+
+UTEST(ReaderBiasedSharedMutex, SharedAndUniqueLock) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  std::unique_lock lock(mutex);
+  EXPECT_FALSE(mutex.IsReadBiased());
+  EXPECT_FALSE(mutex.try_lock_shared());
+
+  auto reader = utils::Async("", [&mutex] { std::shared_lock lock(mutex); });
+
+  reader.WaitFor(kWaitTime);
+  EXPECT_FALSE(reader.IsFinished());
+
+  lock.unlock();
+
+  reader.WaitFor(kWaitTime);
+  EXPECT_TRUE(reader.IsFinished());
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, UniqueAndSharedLock) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  std::shared_lock lock(mutex);
+  auto writer = utils::Async("", [&mutex] { std::unique_lock lock(mutex); });
+
+  writer.WaitFor(kWaitTime);
+  EXPECT_FALSE(writer.IsFinished());
+
+  lock.unlock();
+
+  writer.WaitFor(kWaitTime);
+  EXPECT_TRUE(writer.IsFinished());
+  UEXPECT_NO_THROW(writer.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, TryLock) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+  }
+
+  // mutex must be free of writers
+  ASSERT_TRUE(mutex.try_lock_shared());
+  mutex.unlock_shared();
+}
+
+UTEST(ReaderBiasedSharedMutex, TryLockFail) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  std::shared_lock lock(mutex);
+  EXPECT_FALSE(utils::Async("", [&mutex] { return mutex.try_lock(); }).Get());
+  EXPECT_FALSE(utils::Async("", [&mutex] {
+                 return mutex.try_lock_for(kWaitTime);
+               }).Get());
+
+  // readers are not blocked by the failed writers
+  auto reader = utils::Async("", [&mutex] { std::shared_lock lock(mutex); });
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, ReadBiasRestored) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  { std::unique_lock lock(mutex); }
+  EXPECT_FALSE(mutex.IsReadBiased());
+
+  // The revocation took no time, so the read bias is restored shortly
+  engine::SleepFor(kWaitTime);
+  { std::shared_lock lock(mutex); }
+  EXPECT_TRUE(mutex.IsReadBiased());
+}
+
+UTEST_MT(ReaderBiasedSharedMutex, ReadersAndWriters, 4) {
+  engine::ReaderBiasedSharedMutex mutex;
+  std::int64_t first = 0;
+  std::int64_t second = 0;
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> readers;
+  for (std::size_t i = 0; i < GetThreadCount() - 1; ++i) {
+    readers.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        std::shared_lock lock(mutex);
+        ASSERT_EQ(first, second);
+      }
+    }));
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    std::unique_lock lock(mutex);
+    ++first;
+    engine::Yield();
+    ++second;
+  }
+
+  keep_running = false;
+  for (auto& reader : readers) reader.Get();
+
+  std::shared_lock lock(mutex);
+  EXPECT_EQ(first, 1000);
+  EXPECT_EQ(second, 1000);
+}
+
+USERVER_NAMESPACE_END
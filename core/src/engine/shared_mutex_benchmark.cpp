@@ -1,16 +1,21 @@
 #include <benchmark/benchmark.h>
 
+#include <cstddef>
+#include <type_traits>
+
 #include <userver/engine/async.hpp>
+#include <userver/engine/reader_biased_shared_mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/shared_mutex.hpp>
 #include <utils/impl/parallelize_benchmark.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+template <typename Mutex>
 void shared_mutex_benchmark(benchmark::State& state) {
   engine::RunStandalone(state.range(0), [&] {
     int variable = 0;
-    engine::SharedMutex mutex;
+    Mutex mutex;
 
     auto initial_lock_holder = engine::AsyncNoSpan([&] {
       // ensure the locks are actually needed
@@ -26,6 +31,46 @@ void shared_mutex_benchmark(benchmark::State& state) {
     });
   });
 }
-BENCHMARK(shared_mutex_benchmark)->DenseRange(1, 6);
+BENCHMARK_TEMPLATE(shared_mutex_benchmark, engine::SharedMutex)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(shared_mutex_benchmark, engine::ReaderBiasedSharedMutex)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->UseRealTime();
+
+// Readers with a writer that takes the lock once per 1024 of its own reads
+template <typename Mutex>
+void shared_mutex_read_mostly(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    int variable = 0;
+    Mutex mutex;
+
+    RunParallelBenchmark(state, [&](auto& range) {
+      // the benchmark thread is the writer
+      constexpr bool kIsWriter =
+          std::is_same_v<std::decay_t<decltype(range)>, benchmark::State>;
+      std::size_t i = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        if (kIsWriter && ++i % 1024 == 0) {
+          std::unique_lock lock(mutex);
+          ++variable;
+        } else {
+          std::shared_lock lock(mutex);
+          benchmark::DoNotOptimize(variable);
+        }
+      }
+    });
+  });
+}
+BENCHMARK_TEMPLATE(shared_mutex_read_mostly, engine::SharedMutex)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(shared_mutex_read_mostly, engine::ReaderBiasedSharedMutex)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->UseRealTime();
 
 USERVER_NAMESPACE_END
@@ -10,13 +10,13 @@
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
-#include <concurrent/impl/interference_shield.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_queue.hpp>
 #include <engine/task/work_stealing_queue/task_queue.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 #include <userver/logging/logger.hpp>
 
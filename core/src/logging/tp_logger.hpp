@@ -9,6 +9,7 @@
 #include <variant>
 #include <vector>
 
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/future.hpp>
 #include <userver/engine/mutex.hpp>
@@ -16,7 +17,6 @@
 #include <userver/logging/format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 
-#include <concurrent/impl/interference_shield.hpp>
 #include <engine/impl/async_flat_combining_queue.hpp>
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
@@ -134,6 +134,27 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    ktls:
+                        type: boolean
+                        description: offload the encryption of the sent data to the kernel if possible
+                        defaultDescription: false
+                    session-cache-size:
+                        type: integer
+                        description: max number of TLS sessions cached by the listener, 0 disables the cache
+                        defaultDescription: 20480
+                        minimum: 0
+                    session-timeout:
+                        type: integer
+                        description: lifetime of TLS sessions and session tickets in seconds
+                        defaultDescription: 300
+                    session-tickets:
+                        type: boolean
+                        description: whether to issue stateless TLS session tickets
+                        defaultDescription: true
+                    session-ticket-keys-name:
+                        type: string
+                        description: name of the session ticket keys located in secdist's "tls_session_ticket_keys" section
+                        defaultDescription: random keys of the process
             handler-defaults:
                 type: object
                 description: handler defaults options
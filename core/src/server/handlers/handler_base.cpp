@@ -91,6 +91,42 @@ properties:
         type: integer
         description: integer to limit RPS to this handler
         defaultDescription: <no limit>
+    adaptive_concurrency:
+        type: object
+        description: limit pending requests to this handler by their latency, see congestion_control::AdaptiveConcurrencyConfig
+        defaultDescription: <no limit>
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: whether the limiting is enabled
+            algorithm:
+                type: string
+                description: limit adjustment algorithm
+                enum:
+                  - gradient2
+                  - vegas
+            initial-limit:
+                type: integer
+                description: concurrency limit to start with
+            min-limit:
+                type: integer
+                description: the limit never goes below
+            max-limit:
+                type: integer
+                description: the limit never goes above
+            window-size:
+                type: integer
+                description: requests aggregated into a single limit update
+            smoothing:
+                type: number
+                description: weight of the new limit estimate, in (0, 1]
+            rtt-tolerance:
+                type: number
+                description: gradient2 latency increase tolerated without shrinking the limit
+            long-window:
+                type: integer
+                description: limit updates in the long-term latency estimate
     decompress_request:
         type: boolean
         description: allow decompression of the requests
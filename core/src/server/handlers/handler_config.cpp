@@ -82,6 +82,9 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
           kLogRequestDataSizeDefaultLimit);
   config.max_requests_per_second =
       value["max_requests_per_second"].As<std::optional<size_t>>();
+  config.adaptive_concurrency =
+      value["adaptive_concurrency"]
+          .As<std::optional<congestion_control::AdaptiveConcurrencyConfig>>();
   config.decompress_request = value["decompress_request"].As<bool>(true);
   config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
   config.set_response_server_hostname =
@@ -12,6 +12,7 @@
 
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/congestion_control/adaptive_limiter.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/task/cancel.hpp>
@@ -185,6 +186,9 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
       std::move(prefix),
       [this](utils::statistics::Writer& result) {
         FormatStatistics(result["handler"], *handler_statistics_);
+        if (const auto* limiter = handler_statistics_->GetAdaptiveLimiter()) {
+          result["handler"]["adaptive-concurrency"] = *limiter;
+        }
         if constexpr (kIncludeServerHttpMetrics) {
           FormatStatistics(result["request"], *request_statistics_);
         }
@@ -22,6 +22,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["in-flight"] = stats.in_flight;
   writer["too-many-requests-in-flight"] = stats.too_many_requests_in_flight;
   writer["rate-limit-reached"] = stats.rate_limit_reached;
+  writer["adaptive-concurrency-rejected"] = stats.adaptive_concurrency_rejected;
   writer["deadline-received"] = stats.deadline_received;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
   writer["timings"] = stats.timings;
@@ -58,6 +59,8 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(
       finished(stats.finished_.Load()),
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
+      adaptive_concurrency_rejected(
+          stats.adaptive_concurrency_rejected_.Load()),
       deadline_received(stats.deadline_received_.Load()),
       cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
 
@@ -69,6 +72,7 @@ void HttpHandlerStatisticsSnapshot::Add(
   finished += other.finished;
   too_many_requests_in_flight += other.too_many_requests_in_flight;
   rate_limit_reached += other.rate_limit_reached;
+  adaptive_concurrency_rejected += other.adaptive_concurrency_rejected;
   deadline_received += other.deadline_received;
   cancelled_by_deadline += other.cancelled_by_deadline;
 }
@@ -17,6 +17,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace congestion_control {
+class AdaptiveLimiter;
+}
+
 namespace server::handlers {
 
 // Statistics for a single request from the handler perspective.
@@ -47,6 +51,10 @@ class HttpHandlerMethodStatistics final {
 
   void IncrementRateLimitReached() noexcept { ++rate_limit_reached_; }
 
+  void IncrementAdaptiveConcurrencyRejected() noexcept {
+    ++adaptive_concurrency_rejected_;
+  }
+
  private:
   friend struct HttpHandlerStatisticsSnapshot;
 
@@ -61,6 +69,7 @@ class HttpHandlerMethodStatistics final {
   utils::statistics::RateCounter finished_;
   utils::statistics::RateCounter too_many_requests_in_flight_;
   utils::statistics::RateCounter rate_limit_reached_;
+  utils::statistics::RateCounter adaptive_concurrency_rejected_;
   utils::statistics::RateCounter deadline_received_;
   utils::statistics::RateCounter cancelled_by_deadline_;
 };
@@ -82,6 +91,7 @@ struct HttpHandlerStatisticsSnapshot final {
   utils::statistics::Rate finished;
   utils::statistics::Rate too_many_requests_in_flight;
   utils::statistics::Rate rate_limit_reached;
+  utils::statistics::Rate adaptive_concurrency_rejected;
   utils::statistics::Rate deadline_received;
   utils::statistics::Rate cancelled_by_deadline;
 };
@@ -133,7 +143,23 @@ class ByMethodStatistics {
 };
 
 class HttpHandlerStatistics final
-    : public ByMethodStatistics<HttpHandlerMethodStatistics> {};
+    : public ByMethodStatistics<HttpHandlerMethodStatistics> {
+ public:
+  // The limiter is shared by all the methods of the handler and must outlive
+  // the statistics writer of the handler
+  void SetAdaptiveLimiter(
+      const congestion_control::AdaptiveLimiter& limiter) noexcept {
+    adaptive_limiter_ = &limiter;
+  }
+
+  const congestion_control::AdaptiveLimiter* GetAdaptiveLimiter()
+      const noexcept {
+    return adaptive_limiter_;
+  }
+
+ private:
+  const congestion_control::AdaptiveLimiter* adaptive_limiter_{nullptr};
+};
 
 class HttpRequestStatistics final
     : public ByMethodStatistics<HttpRequestMethodStatistics> {};
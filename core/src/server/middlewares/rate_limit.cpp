@@ -2,6 +2,7 @@
 
 #include <server/handlers/http_handler_base_statistics.hpp>
 
+#include <userver/engine/task/cancel.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/server/handlers/exceptions.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
@@ -16,7 +17,12 @@ RateLimit::RateLimit(const handlers::HttpHandlerBase& handler)
       statistics_{handler.GetHandlerStatistics()},
       max_requests_per_second_{handler.GetConfig().max_requests_per_second},
       max_requests_in_flight_{handler.GetConfig().max_requests_in_flight},
+      adaptive_concurrency_{handler.GetConfig().adaptive_concurrency},
       handler_{handler} {
+  if (adaptive_concurrency_ && adaptive_concurrency_->enabled) {
+    adaptive_limiter_.emplace(*adaptive_concurrency_);
+    statistics_.SetAdaptiveLimiter(*adaptive_limiter_);
+  }
   if (max_requests_per_second_.has_value()) {
     const auto max_rps = *max_requests_per_second_;
     UASSERT_MSG(
@@ -30,11 +36,51 @@ RateLimit::RateLimit(const handlers::HttpHandlerBase& handler)
 
 void RateLimit::HandleRequest(http::HttpRequest& request,
                               request::RequestContext& context) const {
-  if (CheckRateLimit(request)) {
+  if (!CheckRateLimit(request)) return;
+
+  if (adaptive_limiter_) {
+    HandleWithAdaptiveConcurrency(request, context);
+  } else {
     Next(request, context);
   }
 }
 
+void RateLimit::HandleWithAdaptiveConcurrency(
+    http::HttpRequest& request, request::RequestContext& context) const {
+  auto token = AcquireAdaptiveConcurrency(request);
+  if (!token) return;
+
+  Next(request, context);
+
+  const auto& response = request.GetHttpResponse();
+  if (engine::current_task::ShouldCancel() ||
+      response.GetStatus() ==
+          handler_.GetConfig().deadline_expired_status_code) {
+    token->OnDropped();
+  } else {
+    token->OnSuccess();
+  }
+}
+
+std::optional<congestion_control::AdaptiveLimiter::Token>
+RateLimit::AcquireAdaptiveConcurrency(const http::HttpRequest& request) const {
+  auto token = adaptive_limiter_->TryAcquire(*adaptive_concurrency_);
+  if (token) return token;
+
+  auto& http_response = request.GetHttpResponse();
+  auto log_reason = fmt::format("reached adaptive concurrency limit={}",
+                                adaptive_limiter_->GetLimit());
+  SetThrottleReason(
+      http_response, std::move(log_reason),
+      std::string{
+          USERVER_NAMESPACE::http::headers::ratelimit_reason::kInFlight});
+  statistics_.ForMethod(request.GetMethod())
+      .IncrementAdaptiveConcurrencyRejected();
+
+  FailProcessingAndSetResponse(request);
+  return std::nullopt;
+}
+
 bool RateLimit::CheckRateLimit(const http::HttpRequest& request) const {
   auto& statistics = statistics_.ForMethod(request.GetMethod());
 
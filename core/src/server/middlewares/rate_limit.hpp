@@ -2,6 +2,7 @@
 
 #include <optional>
 
+#include <userver/congestion_control/adaptive_limiter.hpp>
 #include <userver/server/middlewares/builtin.hpp>
 #include <userver/server/middlewares/http_middleware_base.hpp>
 #include <userver/utils/token_bucket.hpp>
@@ -26,6 +27,12 @@ class RateLimit final : public HttpMiddlewareBase {
 
   bool CheckRateLimit(const http::HttpRequest& request) const;
 
+  std::optional<congestion_control::AdaptiveLimiter::Token>
+  AcquireAdaptiveConcurrency(const http::HttpRequest& request) const;
+
+  void HandleWithAdaptiveConcurrency(http::HttpRequest& request,
+                                     request::RequestContext& context) const;
+
   void FailProcessingAndSetResponse(const http::HttpRequest& request) const;
 
   mutable utils::TokenBucket rate_limit_;
@@ -34,6 +41,10 @@ class RateLimit final : public HttpMiddlewareBase {
   std::optional<std::size_t> max_requests_per_second_;
   std::optional<std::size_t> max_requests_in_flight_;
 
+  std::optional<congestion_control::AdaptiveConcurrencyConfig>
+      adaptive_concurrency_;
+  mutable std::optional<congestion_control::AdaptiveLimiter> adaptive_limiter_;
+
   const handlers::HttpHandlerBase& handler_;
 };
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <atomic>
+#include <optional>
+
+#include <userver/engine/io/tls_wrapper.hpp>
 
 #include <server/http/http_request_handler.hpp>
 #include <server/net/connection.hpp>
@@ -18,6 +21,8 @@ struct EndpointInfo {
   const ListenerConfig& listener_config;
   http::HttpRequestHandler& request_handler;
   Connection::Type connection_type{Connection::Type::kRequest};
+  // shared by the listener shards to resume the TLS sessions
+  std::optional<engine::io::TlsServerContext> tls_context;
 
   std::atomic<size_t> connection_count{0};
 };
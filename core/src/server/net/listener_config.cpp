@@ -57,6 +57,23 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   if (!pkey_pass_name.empty()) {
     config.tls_private_key_passphrase_name = pkey_pass_name;
   }
+  config.tls_ktls = value["tls"]["ktls"].As<bool>(false);
+  auto& session_settings = config.tls_session_settings;
+  session_settings.cache_size = value["tls"]["session-cache-size"].As<size_t>(
+      session_settings.cache_size);
+  session_settings.timeout =
+      value["tls"]["session-timeout"].As<std::chrono::seconds>(
+          session_settings.timeout);
+  session_settings.tickets =
+      value["tls"]["session-tickets"].As<bool>(session_settings.tickets);
+  config.tls_session_ticket_keys_name =
+      value["tls"]["session-ticket-keys-name"].As<std::string>({});
+  if (!session_settings.tickets &&
+      !config.tls_session_ticket_keys_name.empty()) {
+    throw std::runtime_error(
+        "tls.session-ticket-keys-name is set while tls.session-tickets are "
+        "disabled");
+  }
   auto ca_paths = value["tls"]["ca"].As<std::vector<std::string>>({});
   for (const auto& ca_path : ca_paths) {
     auto contents = fs::blocking::ReadFileContents(ca_path);
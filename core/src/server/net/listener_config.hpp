@@ -5,6 +5,7 @@
 
 #include <userver/crypto/certificate.hpp>
 #include <userver/crypto/private_key.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -26,11 +27,15 @@ struct ListenerConfig {
   std::string task_processor;
 
   bool tls{false};
+  bool tls_ktls{false};
   crypto::Certificate tls_cert;
   std::string tls_private_key_path;
   std::string tls_private_key_passphrase_name;
   crypto::PrivateKey tls_private_key;
   std::vector<crypto::Certificate> tls_certificate_authorities;
+  // ticket keys are loaded from secdist
+  engine::io::TlsSessionSettings tls_session_settings;
+  std::string tls_session_ticket_keys_name;
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
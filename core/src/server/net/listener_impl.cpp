@@ -102,10 +102,25 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
   auto remote_address = peer_socket.Getpeername();
   if (endpoint_info_->listener_config.tls) {
     const auto& config = endpoint_info_->listener_config;
-    socket = std::make_unique<engine::io::TlsWrapper>(
+    UASSERT(endpoint_info_->tls_context);
+    auto tls_socket = std::make_unique<engine::io::TlsWrapper>(
         engine::io::TlsWrapper::StartTlsServer(
-            std::move(peer_socket), config.tls_cert, config.tls_private_key, {},
-            config.tls_certificate_authorities));
+            std::move(peer_socket), *endpoint_info_->tls_context, {},
+            config.tls_ktls ? engine::io::TlsOffload::kKernel
+                            : engine::io::TlsOffload::kNone));
+    if (tls_socket->IsSessionReused()) {
+      ++stats_->tls_handshakes_resumed;
+    } else {
+      ++stats_->tls_handshakes_full;
+    }
+    if (config.tls_ktls) {
+      if (tls_socket->IsKernelTlsOffloaded()) {
+        ++stats_->tls_ktls_offloaded;
+      } else {
+        ++stats_->tls_ktls_fallback;
+      }
+    }
+    socket = std::move(tls_socket);
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
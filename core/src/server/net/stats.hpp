@@ -1,11 +1,11 @@
 #pragma once
 
-#include <atomic>
 #include <cstddef>
 #include <optional>
 #include <vector>
 
 #include <userver/concurrent/striped_counter.hpp>
+#include <userver/utils/statistics/striped_gauge.hpp>
 #include <userver/utils/statistics/striped_rate_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -59,9 +59,13 @@ struct ParserStatsAggregation final {
 
 struct Stats {
   // per listener
-  std::atomic<size_t> active_connections{0};
-  std::atomic<size_t> connections_created{0};
-  std::atomic<size_t> connections_closed{0};
+  utils::statistics::StripedGauge active_connections;
+  utils::statistics::StripedRateCounter connections_created{0};
+  utils::statistics::StripedRateCounter connections_closed{0};
+  utils::statistics::StripedRateCounter tls_ktls_offloaded{0};
+  utils::statistics::StripedRateCounter tls_ktls_fallback{0};
+  utils::statistics::StripedRateCounter tls_handshakes_full{0};
+  utils::statistics::StripedRateCounter tls_handshakes_resumed{0};
 
   // per connection
   ParserStats parser_stats;
@@ -73,9 +77,14 @@ struct StatsAggregation final {
   StatsAggregation() = default;
 
   explicit StatsAggregation(const Stats& stats)
-      : active_connections{stats.active_connections.load()},
-        connections_created{stats.connections_created.load()},
-        connections_closed{stats.connections_closed.load()},
+      : active_connections{static_cast<std::size_t>(
+            stats.active_connections.Load())},
+        connections_created{stats.connections_created.Load().value},
+        connections_closed{stats.connections_closed.Load().value},
+        tls_ktls_offloaded{stats.tls_ktls_offloaded.Load().value},
+        tls_ktls_fallback{stats.tls_ktls_fallback.Load().value},
+        tls_handshakes_full{stats.tls_handshakes_full.Load().value},
+        tls_handshakes_resumed{stats.tls_handshakes_resumed.Load().value},
         parser_stats{stats.parser_stats},
         active_request_count{stats.active_request_count.NonNegativeRead()},
         requests_processed_count{stats.requests_processed_count.Read()} {}
@@ -84,6 +93,10 @@ struct StatsAggregation final {
     active_connections += other.active_connections;
     connections_created += other.connections_created;
     connections_closed += other.connections_closed;
+    tls_ktls_offloaded += other.tls_ktls_offloaded;
+    tls_ktls_fallback += other.tls_ktls_fallback;
+    tls_handshakes_full += other.tls_handshakes_full;
+    tls_handshakes_resumed += other.tls_handshakes_resumed;
 
     parser_stats += other.parser_stats;
     active_request_count += other.active_request_count;
@@ -95,6 +108,10 @@ struct StatsAggregation final {
   std::size_t active_connections{0};
   std::size_t connections_created{0};
   std::size_t connections_closed{0};
+  std::size_t tls_ktls_offloaded{0};
+  std::size_t tls_ktls_fallback{0};
+  std::size_t tls_handshakes_full{0};
+  std::size_t tls_handshakes_resumed{0};
 
   // per connection
   ParserStatsAggregation parser_stats;
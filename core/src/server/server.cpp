@@ -18,6 +18,7 @@
 #include <server/pph_config.hpp>
 #include <server/requests_view.hpp>
 #include <server/server_config.hpp>
+#include <server/tls_ticket_keys_config.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/server/middlewares/configuration.hpp>
 
@@ -60,6 +61,12 @@ void PortInfo::Init(const ServerConfig& config,
 
   endpoint_info_ =
       std::make_shared<net::EndpointInfo>(listener_config, *request_handler_);
+  if (listener_config.tls) {
+    endpoint_info_->tls_context.emplace(
+        listener_config.tls_cert, listener_config.tls_private_key,
+        listener_config.tls_certificate_authorities,
+        listener_config.tls_session_settings);
+  }
 
   const auto& event_thread_pool = task_processor.EventThreadPool();
   size_t listener_shards = listener_config.shards ? *listener_config.shards
@@ -98,6 +105,51 @@ bool PortInfo::IsRunning() const noexcept {
   return request_handler_ && request_handler_->IsAddHandlerDisabled();
 }
 
+bool HasTlsTicketKeys(const net::ListenerConfig& listener_config) {
+  return listener_config.tls &&
+         !listener_config.tls_session_ticket_keys_name.empty();
+}
+
+void LoadTlsSecrets(net::ListenerConfig& listener_config,
+                    const storages::secdist::SecdistConfig& secdist) {
+  if (!listener_config.tls) return;
+
+  auto contents =
+      fs::blocking::ReadFileContents(listener_config.tls_private_key_path);
+  if (listener_config.tls_private_key_passphrase_name.empty()) {
+    listener_config.tls_private_key =
+        crypto::PrivateKey::LoadFromString(contents);
+  } else {
+    auto pph = secdist.Get<PassphraseConfig>().GetPassphrase(
+        listener_config.tls_private_key_passphrase_name);
+    listener_config.tls_private_key =
+        crypto::PrivateKey::LoadFromString(contents, pph.GetUnderlying());
+  }
+
+  if (HasTlsTicketKeys(listener_config)) {
+    listener_config.tls_session_settings.ticket_keys =
+        secdist.Get<TlsTicketKeysConfig>().GetKeys(
+            listener_config.tls_session_ticket_keys_name);
+  }
+}
+
+void UpdateTlsTicketKeys(PortInfo& port_info,
+                         const net::ListenerConfig& listener_config,
+                         const storages::secdist::SecdistConfig& secdist) {
+  if (!HasTlsTicketKeys(listener_config)) return;
+
+  auto& tls_context = port_info.endpoint_info_->tls_context;
+  UASSERT(tls_context);
+  try {
+    const auto& keys = secdist.Get<TlsTicketKeysConfig>().GetKeys(
+        listener_config.tls_session_ticket_keys_name);
+    tls_context->SetSessionTicketKeys(keys);
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Failed to update TLS session ticket keys '"
+                << listener_config.tls_session_ticket_keys_name << "': " << e;
+  }
+}
+
 }  // namespace
 
 class ServerImpl final {
@@ -128,6 +180,8 @@ class ServerImpl final {
   std::uint64_t GetTotalRequests() const;
 
  private:
+  void OnSecdistUpdate(const storages::secdist::SecdistConfig& secdist);
+
   PortInfo main_port_info_;
   PortInfo monitor_port_info_;
 
@@ -141,6 +195,8 @@ class ServerImpl final {
 
   ServerConfig config_;
   std::vector<std::string> middlewares_;
+
+  concurrent::AsyncEventSubscriberScope secdist_subscriber_;
 };
 
 ServerImpl::ServerImpl(ServerConfig config,
@@ -149,18 +205,9 @@ ServerImpl::ServerImpl(ServerConfig config,
     : config_(std::move(config)) {
   LOG_DEBUG() << "Creating server";
 
-  if (config_.listener.tls) {
-    auto contents =
-        fs::blocking::ReadFileContents(config_.listener.tls_private_key_path);
-    if (config_.listener.tls_private_key_passphrase_name.empty()) {
-      config_.listener.tls_private_key =
-          crypto::PrivateKey::LoadFromString(contents);
-    } else {
-      auto pph = secdist.Get<PassphraseConfig>().GetPassphrase(
-          config_.listener.tls_private_key_passphrase_name);
-      config_.listener.tls_private_key =
-          crypto::PrivateKey::LoadFromString(contents, pph.GetUnderlying());
-    }
+  LoadTlsSecrets(config_.listener, secdist);
+  if (config_.monitor_listener) {
+    LoadTlsSecrets(*config_.monitor_listener, secdist);
   }
 
   main_port_info_.Init(config_, config_.listener, component_context, false);
@@ -173,6 +220,18 @@ ServerImpl::ServerImpl(ServerConfig config,
                             component_context, true);
   }
 
+  if (HasTlsTicketKeys(config_.listener) ||
+      (config_.monitor_listener &&
+       HasTlsTicketKeys(*config_.monitor_listener))) {
+    auto* secdist_component =
+        component_context.FindComponentOptional<components::Secdist>();
+    if (secdist_component) {
+      secdist_subscriber_ = secdist_component->GetStorage().UpdateAndListen(
+          this, "server_tls_session_ticket_keys",
+          &ServerImpl::OnSecdistUpdate);
+    }
+  }
+
   middlewares_ = component_context
                      .FindComponent<middlewares::PipelineBuilder>(
                          config_.middleware_pipeline_builder)
@@ -213,12 +272,23 @@ void ServerImpl::Stop() {
     is_stopping_ = true;
   }
 
+  secdist_subscriber_.Unsubscribe();
+
   LOG_INFO() << "Stopping server";
   main_port_info_.Stop();
   monitor_port_info_.Stop();
   LOG_INFO() << "Stopped server";
 }
 
+void ServerImpl::OnSecdistUpdate(
+    const storages::secdist::SecdistConfig& secdist) {
+  UpdateTlsTicketKeys(main_port_info_, config_.listener, secdist);
+  if (config_.monitor_listener) {
+    UpdateTlsTicketKeys(monitor_port_info_, *config_.monitor_listener,
+                        secdist);
+  }
+}
+
 void ServerImpl::AddHandler(const handlers::HttpHandlerBase& handler,
                             engine::TaskProcessor& task_processor) {
   UASSERT(!main_port_info_.IsRunning());
@@ -356,6 +426,14 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
     conn_stats["active"] = server_stats.active_connections;
     conn_stats["opened"] = server_stats.connections_created;
     conn_stats["closed"] = server_stats.connections_closed;
+    if (auto ktls_stats = conn_stats["ktls"]) {
+      ktls_stats["offloaded"] = server_stats.tls_ktls_offloaded;
+      ktls_stats["fallback"] = server_stats.tls_ktls_fallback;
+    }
+    if (auto handshake_stats = conn_stats["tls-handshakes"]) {
+      handshake_stats["full"] = server_stats.tls_handshakes_full;
+      handshake_stats["resumed"] = server_stats.tls_handshakes_resumed;
+    }
   }
 
   if (auto request_stats = writer["requests"]) {
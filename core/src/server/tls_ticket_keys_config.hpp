@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/crypto/base64.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server {
+
+class TlsTicketKeysConfig final {
+ public:
+  using Keys = std::vector<engine::io::TlsSessionTicketKey>;
+
+  explicit TlsTicketKeysConfig(const formats::json::Value& doc) {
+    const auto encoded_keys =
+        doc["tls_session_ticket_keys"]
+            .As<std::unordered_map<std::string, std::vector<std::string>>>(
+                {});
+    for (const auto& [name, encoded] : encoded_keys) {
+      auto& keys = keys_[name];
+      for (const auto& key : encoded) {
+        keys.push_back(engine::io::TlsSessionTicketKey::FromBinary(
+            crypto::base64::Base64Decode(key)));
+      }
+    }
+  }
+
+  const Keys& GetKeys(const std::string& name) const {
+    auto it = keys_.find(name);
+    if (it == keys_.cend() || it->second.empty()) {
+      throw std::runtime_error(fmt::format(
+          "No keys with name '{}' in secdist 'tls_session_ticket_keys' entry",
+          name));
+    }
+
+    return it->second;
+  }
+
+ private:
+  std::unordered_map<std::string, Keys> keys_;
+};
+
+}  // namespace server
+
+USERVER_NAMESPACE_END
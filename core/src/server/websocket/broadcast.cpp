@@ -0,0 +1,217 @@
+#include <userver/server/websocket/broadcast.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/striped_histogram.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Max number of messages written with a single syscall, well below IOV_MAX
+constexpr std::size_t kMaxBatchSize = 64;
+
+constexpr double kFanoutLatencyBoundsMs[] = {
+    0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000};
+
+struct QueuedMessage final {
+  std::optional<PreparedMessage> message;
+  Clock::time_point enqueued_at;
+};
+
+using Queue = concurrent::NonFifoMpscQueue<QueuedMessage>;
+
+}  // namespace
+
+struct BroadcastHub::Subscriber final {
+  explicit Subscriber(std::size_t queue_size)
+      : queue(Queue::Create(queue_size)), producer(queue->GetProducer()) {}
+
+  std::shared_ptr<Queue> queue;
+  // The queue is FIFO for a single producer token only, so the messages are
+  // pushed through this one under the hub mutex
+  Queue::Producer producer;
+  engine::TaskWithResult<void> writer;
+};
+
+struct BroadcastHub::Impl final {
+  explicit Impl(const BroadcastSettings& settings) : settings(settings) {}
+
+  void RunWriter(Queue::Consumer consumer, WebSocketConnection& connection,
+                 const std::weak_ptr<Subscriber>& subscriber);
+
+  const BroadcastSettings settings;
+
+  mutable engine::Mutex mutex;
+  std::unordered_set<std::shared_ptr<Subscriber>> subscribers;
+
+  utils::statistics::RateCounter broadcasted;
+  utils::statistics::RateCounter enqueued;
+  utils::statistics::RateCounter dropped;
+  // Accounted by every writer for every message, so it must not be a shared
+  // cache line
+  utils::statistics::StripedHistogram fanout_latency{kFanoutLatencyBoundsMs};
+};
+
+void BroadcastHub::Impl::RunWriter(
+    Queue::Consumer consumer, WebSocketConnection& connection,
+    const std::weak_ptr<Subscriber>& subscriber) {
+  std::vector<PreparedMessage> batch;
+  std::vector<Clock::time_point> enqueued_at;
+  batch.reserve(kMaxBatchSize);
+  enqueued_at.reserve(kMaxBatchSize);
+
+  QueuedMessage item;
+  while (consumer.Pop(item)) {
+    // Everything enqueued while the writer was asleep goes with one write
+    batch.clear();
+    enqueued_at.clear();
+    do {
+      batch.push_back(std::move(*item.message));
+      enqueued_at.push_back(item.enqueued_at);
+    } while (batch.size() < kMaxBatchSize && consumer.PopNoblock(item));
+
+    try {
+      // Unsubscribe() must not interrupt a write in the middle of a frame,
+      // otherwise the next frames written to the connection are garbage.
+      // A stuck write is bounded by the deadline, after which the connection
+      // refuses any further writes.
+      const engine::TaskCancellationBlocker block_cancel;
+      connection.SendPrepared(
+          batch, engine::Deadline::FromDuration(settings.write_timeout));
+    } catch (const std::exception& ex) {
+      LOG_INFO() << "Stopping the broadcast to "
+                 << connection.RemoteAddr().PrimaryAddressString()
+                 << ", the write failed: " << ex;
+      dropped += utils::statistics::Rate{batch.size()};
+
+      // Stop enqueueing messages that nobody would send
+      if (const auto self = subscriber.lock()) {
+        const std::lock_guard lock(mutex);
+        subscribers.erase(self);
+      }
+      return;
+    }
+
+    const auto now = Clock::now();
+    for (const auto time : enqueued_at) {
+      fanout_latency.Account(
+          std::chrono::duration<double, std::milli>(now - time).count());
+    }
+  }
+}
+
+BroadcastHub::BroadcastHub(const BroadcastSettings& settings)
+    : impl_(std::make_shared<Impl>(settings)) {}
+
+BroadcastHub::~BroadcastHub() = default;
+
+BroadcastHub::Subscription BroadcastHub::Subscribe(
+    WebSocketConnection& connection) {
+  auto subscriber = std::make_shared<Subscriber>(impl_->settings.queue_size);
+  // The writer can't fail before the first message, so it won't try to
+  // erase the subscriber before it is inserted
+  subscriber->writer = engine::CriticalAsyncNoSpan(
+      [impl = impl_.get(), &connection,
+       weak_subscriber = std::weak_ptr{subscriber}](Queue::Consumer consumer) {
+        impl->RunWriter(std::move(consumer), connection, weak_subscriber);
+      },
+      subscriber->queue->GetConsumer());
+
+  {
+    const std::lock_guard lock(impl_->mutex);
+    impl_->subscribers.insert(subscriber);
+  }
+  return Subscription{impl_, std::move(subscriber)};
+}
+
+std::size_t BroadcastHub::Broadcast(std::string_view data, bool is_text) {
+  return Broadcast(
+      PreparedMessage{data, is_text, impl_->settings.compression_level});
+}
+
+std::size_t BroadcastHub::Broadcast(const PreparedMessage& message) {
+  ++impl_->broadcasted;
+  const auto now = Clock::now();
+
+  std::size_t subscribers_count = 0;
+  std::size_t enqueued_count = 0;
+  {
+    const std::lock_guard lock(impl_->mutex);
+    subscribers_count = impl_->subscribers.size();
+    for (const auto& subscriber : impl_->subscribers) {
+      if (subscriber->producer.PushNoblock({message, now})) ++enqueued_count;
+    }
+  }
+
+  impl_->enqueued += utils::statistics::Rate{enqueued_count};
+  impl_->dropped +=
+      utils::statistics::Rate{subscribers_count - enqueued_count};
+  return enqueued_count;
+}
+
+std::size_t BroadcastHub::GetSubscribersCount() const {
+  const std::lock_guard lock(impl_->mutex);
+  return impl_->subscribers.size();
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const BroadcastHub& hub) {
+  const auto& impl = *hub.impl_;
+  writer["subscribers"] = hub.GetSubscribersCount();
+  writer["messages"]["broadcasted"] = impl.broadcasted;
+  writer["messages"]["enqueued"] = impl.enqueued;
+  writer["messages"]["dropped"] = impl.dropped;
+  writer["fanout-latency-ms"] = impl.fanout_latency;
+}
+
+BroadcastHub::Subscription::Subscription() noexcept = default;
+
+BroadcastHub::Subscription::Subscription(
+    std::shared_ptr<Impl> impl, std::shared_ptr<Subscriber> subscriber) noexcept
+    : impl_(std::move(impl)), subscriber_(std::move(subscriber)) {}
+
+BroadcastHub::Subscription::Subscription(Subscription&&) noexcept = default;
+
+BroadcastHub::Subscription& BroadcastHub::Subscription::operator=(
+    Subscription&& other) noexcept {
+  if (this != &other) {
+    Unsubscribe();
+    impl_ = std::move(other.impl_);
+    subscriber_ = std::move(other.subscriber_);
+  }
+  return *this;
+}
+
+BroadcastHub::Subscription::~Subscription() { Unsubscribe(); }
+
+void BroadcastHub::Subscription::Unsubscribe() noexcept {
+  if (!subscriber_) return;
+
+  {
+    const std::lock_guard lock(impl_->mutex);
+    impl_->subscribers.erase(subscriber_);
+  }
+  subscriber_->writer.SyncCancel();
+
+  subscriber_.reset();
+  impl_.reset();
+}
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,268 @@
+#include <userver/server/websocket/broadcast.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+#include <server/websocket/deflate.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ws = server::websocket;
+
+namespace {
+
+struct ConnectionPair final {
+  std::shared_ptr<ws::WebSocketConnection> server;
+  std::shared_ptr<ws::WebSocketConnection> client;
+};
+
+ConnectionPair MakeConnectionPair(
+    const std::optional<ws::impl::DeflateParams>& deflate = {},
+    const ws::Config& server_config = {}) {
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  internal::net::TcpListener listener;
+  auto [server, client] = listener.MakeSocketPair(deadline);
+
+  auto pool = std::make_shared<ws::impl::ZlibStreamPool>(6, 1);
+  return {
+      ws::impl::MakeWebSocket(std::make_unique<engine::io::Socket>(
+                                  std::move(server)),
+                              {}, server_config, deflate, pool),
+      ws::impl::MakeWebSocket(std::make_unique<engine::io::Socket>(
+                                  std::move(client)),
+                              {}, {}, deflate, pool),
+  };
+}
+
+}  // namespace
+
+UTEST(WebsocketBroadcast, FanOut) {
+  ws::BroadcastHub hub;
+  EXPECT_EQ(hub.Broadcast("nobody", true), 0);
+
+  std::vector<ConnectionPair> connections(3);
+  std::vector<ws::BroadcastHub::Subscription> subscriptions;
+  for (auto& connection : connections) {
+    connection = MakeConnectionPair();
+    subscriptions.push_back(hub.Subscribe(*connection.server));
+  }
+  EXPECT_EQ(hub.GetSubscribersCount(), 3);
+
+  EXPECT_EQ(hub.Broadcast("first", true), 3);
+  EXPECT_EQ(hub.Broadcast(ws::PreparedMessage{"second", false}), 3);
+
+  ws::Message message;
+  for (auto& connection : connections) {
+    connection.client->Recv(message);
+    EXPECT_EQ(message.data, "first");
+    EXPECT_TRUE(message.is_text);
+
+    connection.client->Recv(message);
+    EXPECT_EQ(message.data, "second");
+    EXPECT_FALSE(message.is_text);
+  }
+
+  subscriptions.front().Unsubscribe();
+  EXPECT_EQ(hub.GetSubscribersCount(), 2);
+  EXPECT_EQ(hub.Broadcast("third", true), 2);
+}
+
+UTEST(WebsocketBroadcast, Compressed) {
+  ws::BroadcastSettings settings;
+  settings.compression_level = 6;
+  ws::BroadcastHub hub{settings};
+
+  // with context takeover
+  auto compressed = MakeConnectionPair(ws::impl::DeflateParams{});
+  auto plain = MakeConnectionPair();
+  const auto compressed_subscription = hub.Subscribe(*compressed.server);
+  const auto plain_subscription = hub.Subscribe(*plain.server);
+
+  const std::string payload(10000, 'x');
+  ws::Message message;
+  compressed.server->SendText(payload);
+  compressed.client->Recv(message);
+  EXPECT_EQ(message.data, payload);
+
+  EXPECT_EQ(hub.Broadcast(payload, true), 2);
+  compressed.client->Recv(message);
+  EXPECT_EQ(message.data, payload);
+  plain.client->Recv(message);
+  EXPECT_EQ(message.data, payload);
+
+  // The connection's own deflate stream keeps working after a shared frame
+  compressed.server->SendText(payload);
+  compressed.client->Recv(message);
+  EXPECT_EQ(message.data, payload);
+}
+
+UTEST(WebsocketBroadcast, SlowConsumerDrops) {
+  ws::BroadcastSettings settings;
+  settings.queue_size = 1;
+  ws::BroadcastHub hub{settings};
+
+  utils::statistics::Storage storage;
+  const auto statistics_holder = storage.RegisterWriter(
+      "broadcast",
+      [&hub](utils::statistics::Writer& writer) { writer = hub; });
+
+  auto connection = MakeConnectionPair();
+  const auto subscription = hub.Subscribe(*connection.server);
+
+  // The client does not read, so the writer gets stuck once the socket
+  // buffers are full, and then the queue overflows
+  const std::string payload(60000, 'x');
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  std::size_t enqueued = 0;
+  while (hub.Broadcast(payload, false) != 0) {
+    ++enqueued;
+    ASSERT_FALSE(deadline.IsReached());
+    engine::Yield();
+  }
+  EXPECT_EQ(hub.Broadcast(payload, false), 0);
+
+  const utils::statistics::Snapshot snapshot{storage, "broadcast"};
+  EXPECT_EQ(snapshot.SingleMetric("messages.dropped").AsRate().value, 2);
+  EXPECT_EQ(snapshot.SingleMetric("messages.enqueued").AsRate().value,
+            enqueued);
+  // A slow subscriber is not unsubscribed
+  EXPECT_EQ(hub.GetSubscribersCount(), 1);
+
+  ws::Message message;
+  for (std::size_t i = 0; i < enqueued; ++i) {
+    connection.client->Recv(message);
+    ASSERT_EQ(message.data.size(), payload.size());
+  }
+
+  // The dropped messages did not break the connection
+  EXPECT_EQ(hub.Broadcast("after", true), 1);
+  connection.client->Recv(message);
+  EXPECT_EQ(message.data, "after");
+}
+
+UTEST(WebsocketBroadcast, FailedWriteUnsubscribes) {
+  ws::BroadcastHub hub;
+  auto connection = MakeConnectionPair();
+  const auto subscription = hub.Subscribe(*connection.server);
+  connection.client.reset();
+
+  // The first writes may succeed before the peer's RST arrives
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (hub.GetSubscribersCount() != 0) {
+    ASSERT_FALSE(deadline.IsReached());
+    hub.Broadcast("message", true);
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(hub.Broadcast("message", true), 0);
+}
+
+UTEST(WebsocketBroadcast, UnsubscribeStuckWriter) {
+  ws::BroadcastSettings settings;
+  settings.write_timeout = std::chrono::milliseconds{100};
+  ws::BroadcastHub hub{settings};
+
+  auto connection = MakeConnectionPair();
+  auto subscription = hub.Subscribe(*connection.server);
+
+  // The client does not read, so the writer gets stuck on the full socket
+  const std::string payload(60000, 'x');
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (hub.Broadcast(payload, false) != 0) {
+    ASSERT_FALSE(deadline.IsReached());
+    engine::Yield();
+  }
+
+  // Waits for the stuck write no longer than the write timeout
+  subscription.Unsubscribe();
+  EXPECT_EQ(hub.GetSubscribersCount(), 0);
+
+  // The timed out write left the connection in the middle of a frame
+  UEXPECT_THROW(connection.server->SendText("garbage"),
+                engine::io::IoException);
+}
+
+UTEST_MT(WebsocketBroadcast, FifoFromManyThreads, 4) {
+  constexpr std::size_t kPublishers = 4;
+  constexpr std::size_t kMessages = 200;
+
+  ws::BroadcastSettings settings;
+  settings.queue_size = kPublishers * kMessages;
+  ws::BroadcastHub hub{settings};
+
+  auto connection = MakeConnectionPair();
+  const auto subscription = hub.Subscribe(*connection.server);
+
+  // Each publisher hops between the threads, yet its messages must arrive
+  // in the order they were broadcast
+  std::vector<engine::TaskWithResult<void>> publishers;
+  for (std::size_t publisher = 0; publisher < kPublishers; ++publisher) {
+    publishers.push_back(engine::AsyncNoSpan([&hub, publisher] {
+      for (std::size_t i = 0; i < kMessages; ++i) {
+        EXPECT_EQ(hub.Broadcast(fmt::format("{}:{}", publisher, i), true), 1);
+        engine::Yield();
+      }
+    }));
+  }
+
+  std::vector<std::size_t> next(kPublishers, 0);
+  ws::Message message;
+  for (std::size_t i = 0; i < kPublishers * kMessages; ++i) {
+    connection.client->Recv(message);
+    const auto colon = message.data.find(':');
+    ASSERT_NE(colon, std::string::npos);
+    const auto publisher =
+        utils::FromString<std::size_t>(message.data.substr(0, colon));
+    ASSERT_LT(publisher, kPublishers);
+    EXPECT_EQ(utils::FromString<std::size_t>(message.data.substr(colon + 1)),
+              next[publisher]++);
+  }
+  engine::GetAll(publishers);
+}
+
+UTEST(WebsocketBroadcast, Fragmented) {
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  internal::net::TcpListener listener;
+  auto [server, client] = listener.MakeSocketPair(deadline);
+
+  ws::Config config;
+  config.fragment_size = 100;
+  const auto connection = ws::impl::MakeWebSocket(
+      std::make_unique<engine::io::Socket>(std::move(server)), {}, config, {},
+      {});
+
+  ws::BroadcastHub hub;
+  const auto subscription = hub.Subscribe(*connection);
+  const std::string payload(150, 'x');
+  EXPECT_EQ(hub.Broadcast(payload, true), 1);
+
+  // Non-final text frame of 100 bytes, then a final continuation frame
+  std::string frames(2 + 100 + 2 + 50, '\0');
+  ASSERT_EQ(client.RecvAll(frames.data(), frames.size(), deadline),
+            frames.size());
+  EXPECT_EQ(frames[0], '\x01');
+  EXPECT_EQ(frames[1], '\x64');
+  EXPECT_EQ(frames.substr(2, 100), payload.substr(0, 100));
+  EXPECT_EQ(frames[102], '\x80');
+  EXPECT_EQ(frames[103], '\x32');
+  EXPECT_EQ(frames.substr(104), payload.substr(100));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,226 @@
+#include <server/websocket/deflate.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+constexpr std::string_view kExtensionName = "permessage-deflate";
+constexpr int kMinWindowBits = 9;  // zlib does not support 8 for raw deflate
+constexpr int kMemLevel = 8;
+constexpr std::size_t kInflateChunk = 4096;
+
+std::string_view TrimView(std::string_view str) {
+  const auto begin = str.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return {};
+  const auto end = str.find_last_not_of(" \t");
+  return str.substr(begin, end - begin + 1);
+}
+
+std::optional<int> ParseWindowBits(std::string_view value) {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+  int bits = 0;
+  const auto [ptr, ec] =
+      std::from_chars(value.data(), value.data() + value.size(), bits);
+  if (ec != std::errc{} || ptr != value.data() + value.size()) return {};
+  if (bits < 8 || bits > kMaxWindowBits) return {};
+  return bits;
+}
+
+std::optional<DeflateParams> ParseOffer(std::string_view offer,
+                                        const DeflateConfig& config) {
+  const auto tokens = utils::text::SplitIntoStringViewVector(offer, ";");
+  if (tokens.empty() || TrimView(tokens.front()) != kExtensionName) return {};
+
+  DeflateParams params;
+  params.server_no_context_takeover = config.server_no_context_takeover;
+  params.client_no_context_takeover = config.client_no_context_takeover;
+  params.level = config.level;
+  params.min_size = config.min_size;
+
+  for (auto it = std::next(tokens.begin()); it != tokens.end(); ++it) {
+    const auto param = TrimView(*it);
+    const auto eq_pos = param.find('=');
+    const auto key = TrimView(param.substr(0, eq_pos));
+    const auto value = eq_pos == std::string_view::npos
+                           ? std::string_view{}
+                           : TrimView(param.substr(eq_pos + 1));
+
+    if (key == "server_no_context_takeover" && value.empty()) {
+      params.server_no_context_takeover = true;
+    } else if (key == "client_no_context_takeover" && value.empty()) {
+      // the client supports it, and we save the inflater memory
+      params.client_no_context_takeover = true;
+    } else if (key == "server_max_window_bits") {
+      const auto bits = ParseWindowBits(value);
+      if (!bits || *bits < kMinWindowBits) return {};
+      params.server_max_window_bits = *bits;
+    } else if (key == "client_max_window_bits") {
+      // Any client window fits into ours, nothing to answer
+      if (!value.empty() && !ParseWindowBits(value)) return {};
+    } else {
+      return {};
+    }
+  }
+  return params;
+}
+
+}  // namespace
+
+std::optional<DeflateParams> NegotiateDeflate(std::string_view extensions,
+                                              const DeflateConfig& config) {
+  if (!config.enabled || extensions.empty()) return {};
+
+  for (const auto offer :
+       utils::text::SplitIntoStringViewVector(extensions, ",")) {
+    auto params = ParseOffer(offer, config);
+    if (params) return params;
+  }
+  return {};
+}
+
+std::string MakeDeflateResponseHeader(const DeflateParams& params) {
+  std::string header{kExtensionName};
+  if (params.server_no_context_takeover) {
+    header += "; server_no_context_takeover";
+  }
+  if (params.client_no_context_takeover) {
+    header += "; client_no_context_takeover";
+  }
+  if (params.server_max_window_bits != kMaxWindowBits) {
+    header += fmt::format("; server_max_window_bits={}",
+                          params.server_max_window_bits);
+  }
+  return header;
+}
+
+Deflater::Deflater(int level, int window_bits) : window_bits_(window_bits) {
+  UASSERT(window_bits >= kMinWindowBits && window_bits <= kMaxWindowBits);
+  // Negative window bits produce raw deflate data without zlib headers
+  if (deflateInit2(&stream_, level, Z_DEFLATED, -window_bits, kMemLevel,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("Failed to initialize zlib deflate stream");
+  }
+}
+
+Deflater::~Deflater() { deflateEnd(&stream_); }
+
+void Deflater::Compress(utils::span<const std::byte> data, std::string& out) {
+  // zlib does not modify the input, it is just not const-correct
+  stream_.next_in =
+      reinterpret_cast<Bytef*>(const_cast<std::byte*>(data.data()));
+  stream_.avail_in = data.size();
+
+  std::size_t written = out.size();
+  out.resize(written + deflateBound(&stream_, data.size()) +
+             kDeflateTail.size());
+  while (true) {
+    stream_.next_out = reinterpret_cast<Bytef*>(out.data() + written);
+    stream_.avail_out = out.size() - written;
+    const auto ret = deflate(&stream_, Z_SYNC_FLUSH);
+    written = out.size() - stream_.avail_out;
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw std::runtime_error(
+          fmt::format("zlib deflate failed with code {}", ret));
+    }
+    // The flush is complete if there is space left in the output
+    if (stream_.avail_out != 0) break;
+    out.resize(out.size() * 2);
+  }
+
+  UASSERT(written >= kDeflateTail.size());
+  UASSERT(std::string_view(out).substr(written - kDeflateTail.size(),
+                                       kDeflateTail.size()) == kDeflateTail);
+  out.resize(written - kDeflateTail.size());
+}
+
+void Deflater::Reset() { deflateReset(&stream_); }
+
+Inflater::Inflater() {
+  if (inflateInit2(&stream_, -kMaxWindowBits) != Z_OK) {
+    throw std::runtime_error("Failed to initialize zlib inflate stream");
+  }
+}
+
+Inflater::~Inflater() { inflateEnd(&stream_); }
+
+CloseStatus Inflater::Decompress(std::string_view data, std::string& out,
+                                 std::size_t max_size) {
+  // zlib does not modify the input, it is just not const-correct
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_.avail_in = data.size();
+
+  const auto limit = out.size() + max_size;
+  std::size_t written = out.size();
+  while (true) {
+    if (written == out.size()) {
+      // one byte over the limit tells a too big message from a fitting one
+      if (written > limit) return CloseStatus::kTooBigData;
+      out.resize(std::min(limit + 1, std::max(written * 2,
+                                              written + kInflateChunk)));
+    }
+    stream_.next_out = reinterpret_cast<Bytef*>(out.data() + written);
+    stream_.avail_out = out.size() - written;
+    const auto ret = inflate(&stream_, Z_SYNC_FLUSH);
+    written = out.size() - stream_.avail_out;
+
+    if (ret == Z_STREAM_END) {
+      // The final block was set by the peer, the next message starts anew
+      inflateReset(&stream_);
+      break;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR) return CloseStatus::kBadMessageData;
+    if (stream_.avail_in == 0 && stream_.avail_out != 0) break;
+  }
+
+  out.resize(written);
+  return written > limit ? CloseStatus::kTooBigData : CloseStatus::kNone;
+}
+
+void Inflater::Reset() { inflateReset(&stream_); }
+
+ZlibStreamPool::ZlibStreamPool(int level, std::size_t max_size)
+    : level_(level), max_size_(max_size) {}
+
+std::unique_ptr<Deflater> ZlibStreamPool::AcquireDeflater(int window_bits) {
+  std::unique_ptr<Deflater> deflater;
+  if (window_bits == kMaxWindowBits && deflaters_.try_dequeue(deflater)) {
+    return deflater;
+  }
+  return std::make_unique<Deflater>(level_, window_bits);
+}
+
+std::unique_ptr<Inflater> ZlibStreamPool::AcquireInflater() {
+  std::unique_ptr<Inflater> inflater;
+  if (inflaters_.try_dequeue(inflater)) return inflater;
+  return std::make_unique<Inflater>();
+}
+
+void ZlibStreamPool::Release(std::unique_ptr<Deflater> deflater) noexcept {
+  if (!deflater || deflater->GetWindowBits() != kMaxWindowBits) return;
+  if (deflaters_.size_approx() >= max_size_) return;
+  deflater->Reset();
+  [[maybe_unused]] const auto ok = deflaters_.enqueue(std::move(deflater));
+}
+
+void ZlibStreamPool::Release(std::unique_ptr<Inflater> inflater) noexcept {
+  if (!inflater || inflaters_.size_approx() >= max_size_) return;
+  inflater->Reset();
+  [[maybe_unused]] const auto ok = inflaters_.enqueue(std::move(inflater));
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
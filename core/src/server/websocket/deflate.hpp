@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <moodycamel/concurrentqueue.h>
+#include <zlib.h>
+
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.1
+// Trailing bytes of a sync flush, stripped from the compressed messages
+inline constexpr std::string_view kDeflateTail{"\x00\x00\xff\xff", 4};
+
+inline constexpr int kMaxWindowBits = 15;
+
+/// Negotiated parameters of the permessage-deflate extension
+struct DeflateParams final {
+  bool server_no_context_takeover = false;
+  bool client_no_context_takeover = false;
+  int server_max_window_bits = kMaxWindowBits;
+  int level = 6;
+  unsigned min_size = 64;
+};
+
+/// Selects the first acceptable permessage-deflate offer of the
+/// Sec-WebSocket-Extensions request header.
+std::optional<DeflateParams> NegotiateDeflate(std::string_view extensions,
+                                              const DeflateConfig& config);
+
+/// Sec-WebSocket-Extensions response header for the accepted offer
+std::string MakeDeflateResponseHeader(const DeflateParams& params);
+
+class Deflater final {
+ public:
+  Deflater(int level, int window_bits);
+  ~Deflater();
+
+  Deflater(const Deflater&) = delete;
+  Deflater& operator=(const Deflater&) = delete;
+
+  /// Appends the compressed message without the kDeflateTail to `out`
+  void Compress(utils::span<const std::byte> data, std::string& out);
+
+  void Reset();
+
+  int GetWindowBits() const noexcept { return window_bits_; }
+
+ private:
+  // z_stream must not move after the initialization
+  z_stream stream_{};
+  const int window_bits_;
+};
+
+class Inflater final {
+ public:
+  Inflater();
+  ~Inflater();
+
+  Inflater(const Inflater&) = delete;
+  Inflater& operator=(const Inflater&) = delete;
+
+  /// @brief Appends the decompressed message to `out`.
+  /// @param data compressed message with the kDeflateTail appended
+  /// @returns kTooBigData if the message exceeds `max_size`,
+  /// kBadMessageData on malformed data, kNone otherwise
+  CloseStatus Decompress(std::string_view data, std::string& out,
+                         std::size_t max_size);
+
+  void Reset();
+
+ private:
+  z_stream stream_{};
+};
+
+/// @brief Pool of zlib contexts shared by the connections of a handler.
+///
+/// A zlib context takes hundreds of kilobytes, so the connections without
+/// context takeover borrow them for a single message only.
+class ZlibStreamPool final {
+ public:
+  ZlibStreamPool(int level, std::size_t max_size);
+
+  std::unique_ptr<Deflater> AcquireDeflater(int window_bits);
+  std::unique_ptr<Inflater> AcquireInflater();
+
+  void Release(std::unique_ptr<Deflater> deflater) noexcept;
+  void Release(std::unique_ptr<Inflater> inflater) noexcept;
+
+ private:
+  const int level_;
+  const std::size_t max_size_;
+  moodycamel::ConcurrentQueue<std::unique_ptr<Deflater>> deflaters_;
+  moodycamel::ConcurrentQueue<std::unique_ptr<Inflater>> inflaters_;
+};
+
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateParams>& deflate,
+    std::shared_ptr<ZlibStreamPool> pool);
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
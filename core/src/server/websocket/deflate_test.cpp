@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <server/websocket/deflate.hpp>
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ws = server::websocket;
+
+namespace {
+
+ws::DeflateConfig MakeEnabledConfig() {
+  ws::DeflateConfig config;
+  config.enabled = true;
+  return config;
+}
+
+utils::span<const std::byte> AsBytes(const std::string& str) {
+  return utils::as_bytes(utils::span<const char>(str));
+}
+
+}  // namespace
+
+TEST(WebsocketDeflate, Negotiate) {
+  const auto config = MakeEnabledConfig();
+
+  EXPECT_FALSE(ws::impl::NegotiateDeflate("", config));
+  EXPECT_FALSE(ws::impl::NegotiateDeflate("x-webkit-deflate-frame", config));
+  EXPECT_FALSE(
+      ws::impl::NegotiateDeflate("permessage-deflate", ws::DeflateConfig{}));
+
+  auto params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; client_max_window_bits", config);
+  ASSERT_TRUE(params);
+  EXPECT_EQ(ws::impl::MakeDeflateResponseHeader(*params),
+            "permessage-deflate");
+
+  // The first offer asks for a window zlib does not support
+  params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=8, "
+      "permessage-deflate; server_max_window_bits=10; "
+      "client_no_context_takeover",
+      config);
+  ASSERT_TRUE(params);
+  EXPECT_EQ(params->server_max_window_bits, 10);
+  EXPECT_EQ(ws::impl::MakeDeflateResponseHeader(*params),
+            "permessage-deflate; client_no_context_takeover; "
+            "server_max_window_bits=10");
+
+  EXPECT_FALSE(ws::impl::NegotiateDeflate(
+      "permessage-deflate; unknown_param", config));
+}
+
+TEST(WebsocketDeflate, RoundTrip) {
+  ws::impl::Deflater deflater{6, ws::impl::kMaxWindowBits};
+  ws::impl::Inflater inflater;
+
+  const std::string message(10000, 'a');
+  for (int i = 0; i < 3; ++i) {
+    std::string compressed;
+    deflater.Compress(AsBytes(message), compressed);
+    EXPECT_LT(compressed.size(), message.size() / 10);
+
+    compressed.append(ws::impl::kDeflateTail);
+    std::string decompressed;
+    EXPECT_EQ(inflater.Decompress(compressed, decompressed, message.size()),
+              ws::CloseStatus::kNone);
+    EXPECT_EQ(decompressed, message);
+  }
+}
+
+TEST(WebsocketDeflate, TooBig) {
+  ws::impl::Deflater deflater{6, ws::impl::kMaxWindowBits};
+  ws::impl::Inflater inflater;
+
+  const std::string message(10000, 'a');
+  std::string compressed;
+  deflater.Compress(AsBytes(message), compressed);
+  compressed.append(ws::impl::kDeflateTail);
+
+  std::string decompressed;
+  EXPECT_EQ(inflater.Decompress(compressed, decompressed, message.size() - 1),
+            ws::CloseStatus::kTooBigData);
+}
+
+TEST(WebsocketDeflate, BadData) {
+  ws::impl::Inflater inflater;
+  std::string decompressed;
+  EXPECT_EQ(inflater.Decompress("\xff\xff\xff\xff", decompressed, 1000),
+            ws::CloseStatus::kBadMessageData);
+}
+
+TEST(WebsocketProtocol, XorMaskInplace) {
+  ws::impl::Mask32 mask;
+  mask.mask8[0] = 0x01;
+  mask.mask8[1] = 0x02;
+  mask.mask8[2] = 0x04;
+  mask.mask8[3] = 0x08;
+
+  for (std::size_t size : {0, 3, 15, 16, 17, 63, 100}) {
+    std::vector<std::uint8_t> data(size, 0xf0);
+    ws::impl::XorMaskInplace(data.data(), data.size(), mask);
+    for (std::size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(data[i], 0xf0 ^ mask.mask8[i % 4]) << "size " << size;
+    }
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,12 @@
 #include <cstdlib>
 #include <cstring>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include <cryptopp/sha.h>
 #include <boost/endian/conversion.hpp>
 
@@ -53,21 +59,6 @@ utils::span<T> MakeSpan(T* ptr, size_t count) {
   return utils::span<T>(ptr, ptr + count);
 }
 
-union Mask32 {
-  uint32_t mask32 = 0;
-  uint8_t mask8[4];
-};
-
-void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) {
-  auto* dest32 = reinterpret_cast<uint32_t*>(dest);
-  while (len >= sizeof(uint32_t)) {
-    *(dest32++) ^= mask.mask32;
-    len -= sizeof(uint32_t);
-  }
-  auto* dest8 = reinterpret_cast<uint8_t*>(dest32);
-  for (unsigned i = 0; i < len; ++i) *(dest8++) ^= mask.mask8[i];
-}
-
 template <class T, class V>
 void PushRaw(const T& value, V& data) {
   const auto* valBytes = reinterpret_cast<const char*>(&value);
@@ -80,7 +71,7 @@ namespace frames {
 
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final) {
+    Continuation is_continuation, Final is_final, Compressed is_compressed) {
   boost::container::small_vector<char, impl::kMaxFrameHeaderSize> frame;
 
   frame.resize(sizeof(WSHeader));
@@ -93,6 +84,9 @@ boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
   hdr->bits.fin = is_final == Final::kYes ? 1 : 0;
   hdr->bits.opcode = is_text ? kText : kBinary;
   if (is_continuation == Continuation::kYes) hdr->bits.opcode = kContinuation;
+  if (is_compressed == Compressed::kYes) {
+    hdr->bits.reserved = kReservedCompressed;
+  }
 
   if (data.size() <= 125) {
     hdr->bits.payloadLen = data.size();
@@ -146,6 +140,36 @@ const std::array<char, sizeof(WSHeader)>& CloseFrame() {
 
 }  // namespace frames
 
+void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) noexcept {
+  // All the blocks are multiples of 4 bytes, so the mask stays in phase
+#if defined(__SSE2__)
+  const auto mask128 = _mm_set1_epi32(static_cast<int>(mask.mask32));
+  for (; len >= sizeof(__m128i); dest += sizeof(__m128i),
+                                 len -= sizeof(__m128i)) {
+    auto* dest128 = reinterpret_cast<__m128i*>(dest);
+    _mm_storeu_si128(dest128,
+                     _mm_xor_si128(_mm_loadu_si128(dest128), mask128));
+  }
+#elif defined(__ARM_NEON)
+  const auto mask128 = vreinterpretq_u8_u32(vdupq_n_u32(mask.mask32));
+  for (; len >= sizeof(mask128); dest += sizeof(mask128),
+                                 len -= sizeof(mask128)) {
+    vst1q_u8(dest, veorq_u8(vld1q_u8(dest), mask128));
+  }
+#endif
+
+  const uint64_t mask64 =
+      (static_cast<uint64_t>(mask.mask32) << 32) | mask.mask32;
+  for (; len >= sizeof(uint64_t);
+       dest += sizeof(uint64_t), len -= sizeof(uint64_t)) {
+    uint64_t chunk = 0;
+    std::memcpy(&chunk, dest, sizeof(chunk));
+    chunk ^= mask64;
+    std::memcpy(dest, &chunk, sizeof(chunk));
+  }
+  for (size_t i = 0; i < len; ++i) dest[i] ^= mask.mask8[i % 4];
+}
+
 std::string WebsocketSecAnswer(std::string_view sec_key) {
   // guid is taken from RFC
   // https://datatracker.ietf.org/doc/html/rfc6455#section-1.3
@@ -198,6 +222,15 @@ CloseStatus ReadWSFrameImpl(WSHeader& hdr, FrameParserState& frame,
     return CloseStatus::kProtocolError;
   }
 
+  if (hdr.bits.reserved) {
+    // only the first frame of a compressed message may have RSV1
+    if (!frame.allow_compressed || hdr.bits.reserved != kReservedCompressed ||
+        !(hdr.bits.opcode == kText || hdr.bits.opcode == kBinary)) {
+      return CloseStatus::kProtocolError;
+    }
+    frame.is_compressed = true;
+  }
+
   if (payload_len + frame.payload->size() > max_payload_size)
     return CloseStatus::kTooBigData;
 
@@ -220,9 +253,11 @@ CloseStatus ReadWSFrameImpl(WSHeader& hdr, FrameParserState& frame,
                 {});
     if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
+    // the mask applies to the payload of this frame only
     if (mask.mask32)
-      XorMaskInplace(reinterpret_cast<uint8_t*>(frame.payload->data()),
-                     frame.payload->size(), mask);
+      XorMaskInplace(
+          reinterpret_cast<uint8_t*>(frame.payload->data() + newPayloadOffset),
+          payload_len, mask);
   }
   char opcode = hdr.bits.opcode;
   char fin = hdr.bits.fin;
@@ -61,6 +61,10 @@ union WSHeader {
 
 static_assert(sizeof(WSHeader) == 2);
 
+// RSV1 marks the compressed messages of permessage-deflate, see
+// https://datatracker.ietf.org/doc/html/rfc7692#section-6
+constexpr inline unsigned char kReservedCompressed = 0b100;
+
 constexpr inline unsigned int kMaxFrameHeaderSize =
     sizeof(WSHeader) + sizeof(uint64_t);
 
@@ -76,9 +80,15 @@ enum class Final {
   kNo,
 };
 
+enum class Compressed {
+  kYes,
+  kNo,
+};
+
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final);
+    Continuation is_continuation, Final is_final,
+    Compressed is_compressed = Compressed::kNo);
 std::array<char, sizeof(WSHeader)> MakeControlFrame(
     WSOpcodes opcode, utils::span<const std::byte> data = {});
 std::string CloseFrame(CloseStatusInt status_code);
@@ -89,12 +99,33 @@ const std::array<char, sizeof(WSHeader)>& CloseFrame();
 
 std::string WebsocketSecAnswer(std::string_view sec_key);
 
+// Frames of a PreparedMessage
+struct PreparedFrames final {
+  std::string plain;
+  // Empty if the message was not compressed or did not get smaller
+  std::string compressed;
+  std::size_t payload_offset{0};
+  std::size_t compressed_payload_offset{0};
+  bool is_text{false};
+};
+
+union Mask32 {
+  uint32_t mask32 = 0;
+  uint8_t mask8[4];
+};
+
+/// Unmasks the payload of a single frame, vectorized where possible
+void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) noexcept;
+
 struct FrameParserState {
   bool closed = false;
   bool ping_received = false;
   bool pong_received = false;
   bool waiting_continuation = false;
   bool is_text = false;
+  // permessage-deflate is negotiated
+  bool allow_compressed = false;
+  bool is_compressed = false;
   CloseStatusInt remote_close_status = 0;
   size_t offset_when_noblock = 0;
 
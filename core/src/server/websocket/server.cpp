@@ -1,5 +1,7 @@
 #include <userver/server/websocket/server.hpp>
 
+#include <boost/container/small_vector.hpp>
+
 #include <userver/components/component.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
@@ -7,6 +9,7 @@
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include "deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -16,10 +19,11 @@ namespace server::websocket {
 namespace {
 inline void SendExactly(engine::io::WritableBase& writable,
                         utils::span<const char> data1,
-                        utils::span<const std::byte> data2) {
+                        utils::span<const std::byte> data2,
+                        engine::Deadline deadline = {}) {
   if (writable.WriteAll(
-          {{data1.data(), data1.size()}, {data2.data(), data2.size()}}, {}) !=
-      data1.size() + data2.size())
+          {{data1.data(), data1.size()}, {data2.data(), data2.size()}},
+          deadline) != data1.size() + data2.size())
     throw(engine::io::IoException() << "Socket closed during transfer");
 }
 
@@ -33,9 +37,22 @@ utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) {
 
 Config Parse(const yaml_config::YamlConfig& config,
              formats::parse::To<Config>) {
+  const auto deflate_config = config["permessage-deflate"];
+  DeflateConfig deflate;
+  deflate.enabled = deflate_config["enabled"].As<bool>(deflate.enabled);
+  deflate.server_no_context_takeover =
+      deflate_config["server-no-context-takeover"].As<bool>(
+          deflate.server_no_context_takeover);
+  deflate.client_no_context_takeover =
+      deflate_config["client-no-context-takeover"].As<bool>(
+          deflate.client_no_context_takeover);
+  deflate.level = deflate_config["level"].As<int>(deflate.level);
+  deflate.min_size = deflate_config["min-size"].As<unsigned>(deflate.min_size);
+
   return {
       config["max-remote-payload"].As<unsigned>(65536),
       config["fragment-size"].As<unsigned>(65536),
+      deflate,
   };
 }
 
@@ -55,6 +72,10 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
   // and user coroutine with data response.
   engine::Mutex write_mutex_;
 
+  // Set under write_mutex_ when a write with a deadline stopped in the middle
+  // of a frame, nothing can be written after that
+  bool is_write_broken_{false};
+
   const engine::io::Sockaddr remote_addr_;
   Statistics stats_;
 
@@ -64,21 +85,77 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
 
   Config config;
 
+  // permessage-deflate state. The deflater and its buffer are guarded by
+  // write_mutex_, the inflater and its buffer are used by Recv() only.
+  const std::optional<impl::DeflateParams> deflate_;
+  const std::shared_ptr<impl::ZlibStreamPool> zlib_pool_;
+  std::unique_ptr<impl::Deflater> deflater_;
+  std::unique_ptr<impl::Inflater> inflater_;
+  std::string deflate_buffer_;
+  std::string inflate_buffer_;
+
  public:
   WebSocketConnectionImpl(std::unique_ptr<engine::io::RwBase> io_,
                           const engine::io::Sockaddr& remote_addr,
-                          const Config& server_config)
-      : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {}
+                          const Config& server_config,
+                          const std::optional<impl::DeflateParams>& deflate,
+                          std::shared_ptr<impl::ZlibStreamPool> zlib_pool)
+      : io(std::move(io_)),
+        remote_addr_(remote_addr),
+        config(server_config),
+        deflate_(deflate),
+        zlib_pool_(std::move(zlib_pool)) {
+    UASSERT(!deflate_ || zlib_pool_);
+    frame_.allow_compressed = deflate_.has_value();
+  }
 
   ~WebSocketConnectionImpl() override {
+    if (zlib_pool_) {
+      zlib_pool_->Release(std::move(deflater_));
+      zlib_pool_->Release(std::move(inflater_));
+    }
     LOG_TRACE() << "Websocket connection closed";
   }
 
+  bool ShouldCompress(utils::span<const std::byte> data) const noexcept {
+    return deflate_ && data.size() >= deflate_->min_size;
+  }
+
+  // Must be called under write_mutex_
+  utils::span<const std::byte> Compress(utils::span<const std::byte> data) {
+    if (!deflater_) {
+      deflater_ = zlib_pool_->AcquireDeflater(deflate_->server_max_window_bits);
+    }
+    deflate_buffer_.resize(0);  // do not call .clear() to keep the memory
+    deflater_->Compress(data, deflate_buffer_);
+    if (deflate_->server_no_context_takeover) {
+      zlib_pool_->Release(std::move(deflater_));
+    }
+    return MakeBinarySpan(deflate_buffer_);
+  }
+
+  // Replaces the compressed payload with the decompressed one
+  CloseStatus Decompress(std::string& payload) {
+    // keep the memory of both buffers for the next messages
+    inflate_buffer_.swap(payload);
+    payload.resize(0);
+    inflate_buffer_.append(impl::kDeflateTail);
+
+    if (!inflater_) inflater_ = zlib_pool_->AcquireInflater();
+    const auto status = inflater_->Decompress(inflate_buffer_, payload,
+                                              config.max_remote_payload);
+    if (deflate_->client_no_context_takeover) {
+      zlib_pool_->Release(std::move(inflater_));
+    }
+    return status;
+  }
+
   void SendExtended(MessageExtended& message) {
     stats_.msg_sent++;
     stats_.bytes_sent += message.data.size();
 
     const std::unique_lock lock(write_mutex_);
+    ThrowIfWriteBroken();
 
     LOG_TRACE() << "Write message " << message.data.size() << " bytes";
     if (message.opcode == impl::WSOpcodes::kPing) {
@@ -93,26 +170,136 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       SendExactly(*io, close_frame, {});
     } else if (!message.data.empty()) {
       utils::span<const std::byte> data_to_send{message.data};
-      auto continuation = impl::frames::Continuation::kNo;
-      while (data_to_send.size() > config.fragment_size &&
-             config.fragment_size > 0) {
-        const auto data_frame_header = impl::frames::DataFrameHeader(
-            data_to_send.first(config.fragment_size),
-            message.opcode == impl::WSOpcodes::kText, continuation,
-            impl::frames::Final::kNo);
-        SendExactly(*io, data_frame_header,
-                    data_to_send.first(config.fragment_size));
-        continuation = impl::frames::Continuation::kYes;
-        data_to_send =
-            data_to_send.last(data_to_send.size() - config.fragment_size);
+      // RSV1 is set on the first frame of a compressed message only
+      auto compressed = impl::frames::Compressed::kNo;
+      if (ShouldCompress(data_to_send)) {
+        data_to_send = Compress(data_to_send);
+        compressed = impl::frames::Compressed::kYes;
       }
+
+      SendDataFrames(data_to_send, message.opcode == impl::WSOpcodes::kText,
+                     compressed);
+    }
+  }
+
+  // Must be called under write_mutex_
+  void ThrowIfWriteBroken() const {
+    if (is_write_broken_) {
+      throw engine::io::IoException()
+          << "A previous write timed out in the middle of a frame";
+    }
+  }
+
+  bool ShouldFragment(std::size_t payload_size) const noexcept {
+    return config.fragment_size > 0 && payload_size > config.fragment_size;
+  }
+
+  // Must be called under write_mutex_
+  void SendDataFrames(utils::span<const std::byte> data_to_send, bool is_text,
+                      impl::frames::Compressed compressed,
+                      engine::Deadline deadline = {}) {
+    auto continuation = impl::frames::Continuation::kNo;
+    while (ShouldFragment(data_to_send.size())) {
       const auto data_frame_header = impl::frames::DataFrameHeader(
-          data_to_send, message.opcode == impl::WSOpcodes::kText, continuation,
-          impl::frames::Final::kYes);
-      SendExactly(*io, data_frame_header, data_to_send);
+          data_to_send.first(config.fragment_size), is_text, continuation,
+          impl::frames::Final::kNo, compressed);
+      SendExactly(*io, data_frame_header,
+                  data_to_send.first(config.fragment_size), deadline);
+      continuation = impl::frames::Continuation::kYes;
+      compressed = impl::frames::Compressed::kNo;
+      data_to_send =
+          data_to_send.last(data_to_send.size() - config.fragment_size);
+    }
+    const auto data_frame_header = impl::frames::DataFrameHeader(
+        data_to_send, is_text, continuation, impl::frames::Final::kYes,
+        compressed);
+    SendExactly(*io, data_frame_header, data_to_send, deadline);
+  }
+
+  // Must be called under write_mutex_
+  void SendIov(utils::span<const engine::io::IoData> iov,
+               std::size_t total_size, engine::Deadline deadline) {
+    LOG_TRACE() << "Write " << iov.size() << " prepared messages, "
+                << total_size << " bytes";
+    std::size_t sent = 0;
+    if (auto* socket = dynamic_cast<engine::io::Socket*>(io.get())) {
+      sent = socket->SendAll(iov.data(), iov.size(), deadline);
+    } else {
+      for (const auto& io_data : iov) {
+        sent += io->WriteAll(io_data.data, io_data.len, deadline);
+      }
+    }
+    if (sent != total_size) {
+      throw(engine::io::IoException() << "Socket closed during transfer");
     }
   }
 
+  // A pre-compressed frame has no back references, so the peer may inflate
+  // it with any context. Our deflater does not know the peer's window got
+  // the message, so it restarts afterwards.
+  bool CanSendCompressed(const impl::PreparedFrames& frames) const noexcept {
+    return deflate_ && !frames.compressed.empty() &&
+           deflate_->server_max_window_bits == impl::kMaxWindowBits;
+  }
+
+  void SendPrepared(utils::span<const PreparedMessage> messages,
+                    engine::Deadline deadline) override {
+    if (messages.empty()) return;
+
+    if (!write_mutex_.try_lock_until(deadline)) {
+      throw engine::io::IoTimeout()
+          << "Timed out waiting for the other writes to the connection";
+    }
+    const std::unique_lock lock(write_mutex_, std::adopt_lock);
+    ThrowIfWriteBroken();
+
+    try {
+      DoSendPrepared(messages, deadline);
+    } catch (const engine::io::IoTimeout&) {
+      is_write_broken_ = true;
+      throw;
+    }
+  }
+
+  // Must be called under write_mutex_
+  void DoSendPrepared(utils::span<const PreparedMessage> messages,
+                      engine::Deadline deadline) {
+    boost::container::small_vector<engine::io::IoData, 16> iov;
+    std::size_t total_size = 0;
+
+    for (const auto& message : messages) {
+      const auto& frames = message.GetFrames();
+      const bool compressed = CanSendCompressed(frames);
+      if (compressed) zlib_pool_->Release(std::move(deflater_));
+
+      stats_.msg_sent++;
+      stats_.bytes_sent += message.GetPayload().size();
+
+      const auto& frame = compressed ? frames.compressed : frames.plain;
+      const auto payload_offset = compressed ? frames.compressed_payload_offset
+                                             : frames.payload_offset;
+      if (!ShouldFragment(frame.size() - payload_offset)) {
+        iov.push_back({frame.data(), frame.size()});
+        total_size += frame.size();
+        continue;
+      }
+
+      // The prepared frame is larger than the fragment size, so the
+      // payload is framed once more, for this connection only
+      if (!iov.empty()) SendIov(iov, total_size, deadline);
+      iov.clear();
+      total_size = 0;
+      SendDataFrames(
+          MakeBinarySpan(std::string_view{frame}.substr(payload_offset)),
+          frames.is_text,
+          compressed ? impl::frames::Compressed::kYes
+                     : impl::frames::Compressed::kNo,
+          deadline);
+    }
+
+    if (!iov.empty()) SendIov(iov, total_size, deadline);
+  }
+
   void Send(const Message& message) override {
     MessageExtended mext{
         MakeBinarySpan(message.data),
@@ -134,6 +321,7 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
   bool RecvImpl(Message& msg, bool do_not_wait_for_message_header) {
     msg.data.resize(0);  // do not call .clear() to keep the allocated memory
     frame_.payload = &msg.data;
+    frame_.is_compressed = false;
 
     while (true) {
       std::size_t payload_len = 0;
@@ -184,6 +372,17 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       }
       if (frame_.waiting_continuation) continue;
 
+      if (frame_.is_compressed) {
+        const auto inflate_status = Decompress(msg.data);
+        if (inflate_status != CloseStatus::kNone) {
+          MessageExtended close_msg{
+              {}, impl::WSOpcodes::kClose, inflate_status};
+          SendExtended(close_msg);
+          msg = CloseMessage(inflate_status);
+          return true;
+        }
+      }
+
       msg.is_text = frame_.is_text;
       stats_.msg_recv++;
       stats_.bytes_recv += msg.data.size();
@@ -230,13 +429,77 @@ WebSocketConnection::WebSocketConnection() = default;
 
 WebSocketConnection::~WebSocketConnection() = default;
 
+void WebSocketConnection::SendPrepared(
+    utils::span<const PreparedMessage> messages, engine::Deadline) {
+  for (const auto& message : messages) {
+    Send({std::string{message.GetPayload()}, {}, message.IsText()});
+  }
+}
+
+PreparedMessage::PreparedMessage(std::string_view data, bool is_text,
+                                 std::optional<int> compression_level) {
+  auto frames = std::make_shared<impl::PreparedFrames>();
+  frames->is_text = is_text;
+
+  const auto payload = MakeBinarySpan(data);
+  const auto header = impl::frames::DataFrameHeader(
+      payload, is_text, impl::frames::Continuation::kNo,
+      impl::frames::Final::kYes);
+  frames->payload_offset = header.size();
+  frames->plain.reserve(header.size() + data.size());
+  frames->plain.append(header.data(), header.size());
+  frames->plain.append(data);
+
+  if (compression_level) {
+    std::string compressed;
+    impl::Deflater{*compression_level, impl::kMaxWindowBits}.Compress(
+        payload, compressed);
+    const auto compressed_header = impl::frames::DataFrameHeader(
+        MakeBinarySpan(compressed), is_text, impl::frames::Continuation::kNo,
+        impl::frames::Final::kYes, impl::frames::Compressed::kYes);
+    if (compressed_header.size() + compressed.size() < frames->plain.size()) {
+      frames->compressed_payload_offset = compressed_header.size();
+      frames->compressed.reserve(compressed_header.size() + compressed.size());
+      frames->compressed.append(compressed_header.data(),
+                                compressed_header.size());
+      frames->compressed.append(compressed);
+    }
+  }
+
+  frames_ = std::move(frames);
+}
+
+std::string_view PreparedMessage::GetPayload() const noexcept {
+  return std::string_view{frames_->plain}.substr(frames_->payload_offset);
+}
+
+bool PreparedMessage::IsText() const noexcept { return frames_->is_text; }
+
+const impl::PreparedFrames& PreparedMessage::GetFrames() const noexcept {
+  return *frames_;
+}
+
 std::shared_ptr<WebSocketConnection> MakeWebSocket(
     std::unique_ptr<engine::io::RwBase>&& socket,
     engine::io::Sockaddr&& peer_name, const Config& config) {
   return std::make_shared<WebSocketConnectionImpl>(
-      std::move(socket), std::move(peer_name), config);
+      std::move(socket), std::move(peer_name), config, std::nullopt, nullptr);
+}
+
+namespace impl {
+
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateParams>& deflate,
+    std::shared_ptr<ZlibStreamPool> pool) {
+  return std::make_shared<WebSocketConnectionImpl>(
+      std::move(socket), std::move(peer_name), config, deflate,
+      std::move(pool));
 }
 
+}  // namespace impl
+
 }  // namespace server::websocket
 
 USERVER_NAMESPACE_END
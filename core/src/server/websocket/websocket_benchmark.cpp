@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/server/websocket/server.hpp>
+
+#include <server/websocket/deflate.hpp>
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace io = engine::io;
+namespace ws = server::websocket;
+
+constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
+
+// Counts the bytes passing through the socket, i.e. the bytes on the wire
+class CountingSocket final : public io::RwBase {
+ public:
+  CountingSocket(io::Socket&& socket, std::atomic<std::uint64_t>& counter)
+      : socket_(std::move(socket)), counter_(counter) {}
+
+  bool IsValid() const override { return socket_.IsValid(); }
+
+  bool WaitReadable(engine::Deadline deadline) override {
+    return socket_.WaitReadable(deadline);
+  }
+
+  std::optional<size_t> ReadNoblock(void* buf, size_t len) override {
+    auto read = socket_.ReadNoblock(buf, len);
+    if (read) counter_.fetch_add(*read, std::memory_order_relaxed);
+    return read;
+  }
+
+  size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override {
+    return Count(socket_.ReadSome(buf, len, deadline));
+  }
+
+  size_t ReadAll(void* buf, size_t len, engine::Deadline deadline) override {
+    return Count(socket_.ReadAll(buf, len, deadline));
+  }
+
+  bool WaitWriteable(engine::Deadline deadline) override {
+    return socket_.WaitWriteable(deadline);
+  }
+
+  size_t WriteAll(const void* buf, size_t len,
+                  engine::Deadline deadline) override {
+    return Count(socket_.WriteAll(buf, len, deadline));
+  }
+
+  size_t WriteAll(std::initializer_list<io::IoData> list,
+                  engine::Deadline deadline) override {
+    return Count(socket_.WriteAll(list, deadline));
+  }
+
+ private:
+  size_t Count(size_t bytes) {
+    counter_.fetch_add(bytes, std::memory_order_relaxed);
+    return bytes;
+  }
+
+  io::Socket socket_;
+  std::atomic<std::uint64_t>& counter_;
+};
+
+// JSON-like payload, compressible about as well as the typical API messages
+std::string MakePayload(std::size_t size) {
+  static constexpr std::string_view kPattern =
+      R"({"id":12345,"name":"websocket","tags":["a","b"],"value":3.1415},)";
+  std::string payload;
+  payload.reserve(size);
+  std::uint32_t noise = 1;
+  while (payload.size() < size) {
+    payload.append(kPattern.substr(0, size - payload.size()));
+    noise = noise * 1664525 + 1013904223;
+    if (!payload.empty()) payload.back() = 'a' + noise % 26;
+  }
+  return payload;
+}
+
+}  // namespace
+
+void websocket_xor_mask(benchmark::State& state) {
+  std::vector<std::uint8_t> payload(state.range(0), 0x42);
+  ws::impl::Mask32 mask;
+  mask.mask32 = 0xa1b2c3d4;
+
+  for ([[maybe_unused]] auto _ : state) {
+    ws::impl::XorMaskInplace(payload.data(), payload.size(), mask);
+    benchmark::DoNotOptimize(payload.data());
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(websocket_xor_mask)->RangeMultiplier(4)->Range(16, 1 << 16);
+
+// Client sends messages of mixed sizes and waits for the server echo,
+// with permessage-deflate negotiated if state.range(0) is set.
+void websocket_echo(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+
+    std::optional<ws::impl::DeflateParams> deflate;
+    if (state.range(0)) deflate.emplace();
+    auto pool = std::make_shared<ws::impl::ZlibStreamPool>(6, 4);
+
+    internal::net::TcpListener tcp_listener;
+    auto [server_socket, client_socket] = tcp_listener.MakeSocketPair(deadline);
+
+    std::atomic<std::uint64_t> wire_bytes{0};
+    ws::Config config;
+    auto server = ws::impl::MakeWebSocket(
+        std::make_unique<io::Socket>(std::move(server_socket)), io::Sockaddr{},
+        config, deflate, pool);
+    auto client = ws::impl::MakeWebSocket(
+        std::make_unique<CountingSocket>(std::move(client_socket), wire_bytes),
+        io::Sockaddr{}, config, deflate, pool);
+
+    auto echo_task = engine::AsyncNoSpan([&server] {
+      ws::Message message;
+      while (true) {
+        server->Recv(message);
+        if (message.close_status) break;
+        server->Send(message);
+      }
+    });
+
+    const std::array<std::string, 4> payloads{
+        MakePayload(32), MakePayload(512), MakePayload(4096),
+        MakePayload(32768)};
+    std::uint64_t payload_bytes = 0;
+
+    ws::Message message;
+    ws::Message reply;
+    std::size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      message.data = payloads[i++ % payloads.size()];
+      message.is_text = true;
+      client->Send(message);
+      client->Recv(reply);
+      payload_bytes += 2 * reply.data.size();
+      benchmark::DoNotOptimize(reply.data.data());
+    }
+
+    client->Close(ws::CloseStatus::kNormal);
+    echo_task.Get();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(payload_bytes);
+    // both directions pass through the client socket
+    state.counters["wire_bytes_per_msg"] =
+        benchmark::Counter(static_cast<double>(wire_bytes.load()) / 2,
+                           benchmark::Counter::kAvgIterations);
+  });
+}
+BENCHMARK(websocket_echo)->Arg(0)->Arg(1);
+
+USERVER_NAMESPACE_END
@@ -11,17 +11,26 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/server/websocket/server.hpp>
+#include "deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::websocket {
 
+namespace {
+constexpr std::size_t kZlibPoolMaxSize = 256;
+}  // namespace
+
 WebsocketHandlerBase::WebsocketHandlerBase(
     const components::ComponentConfig& config,
     const components::ComponentContext& context)
     : server::handlers::HttpHandlerBase(config, context),
       config_(config.As<Config>()) {
+  if (config_.deflate.enabled) {
+    zlib_pool_ = std::make_shared<impl::ZlibStreamPool>(config_.deflate.level,
+                                                        kZlibPoolMaxSize);
+  }
   auto& statistics_storage =
       context.FindComponent<components::StatisticsStorage>().GetStorage();
   statistics_holder_ = statistics_storage.RegisterWriter(
@@ -73,14 +82,23 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
   response.SetHeader(USERVER_NAMESPACE::http::headers::kWebsocketAccept,
                      websocket::impl::WebsocketSecAnswer(secWebsocketKey));
 
+  auto deflate = impl::NegotiateDeflate(
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions),
+      config_.deflate);
+  if (deflate) {
+    response.SetHeader(
+        USERVER_NAMESPACE::http::headers::kWebsocketExtensions,
+        impl::MakeDeflateResponseHeader(*deflate));
+  }
+
   request.SetUpgradeWebsocket(
       [context = std::make_shared<server::request::RequestContext>(
            std::move(context)),
-       this](std::unique_ptr<engine::io::RwBase> socket,
-             engine::io::Sockaddr&& peer_name) {
+       deflate, this](std::unique_ptr<engine::io::RwBase> socket,
+                      engine::io::Sockaddr&& peer_name) {
         tracing::Span span("ws/" + HandlerName());
-        auto ws = websocket::MakeWebSocket(std::move(socket),
-                                           std::move(peer_name), config_);
+        auto ws = impl::MakeWebSocket(std::move(socket), std::move(peer_name),
+                                      config_, deflate, zlib_pool_);
         try {
           Handle(*ws, *context);
         } catch (const std::exception& e) {
@@ -116,6 +134,33 @@ properties:
         type: integer
         description: max output fragment size
         defaultDescription: 65536
+    permessage-deflate:
+        type: object
+        description: RFC 7692 per-message compression settings
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: accept the permessage-deflate extension if the client offers it
+                defaultDescription: false
+            server-no-context-takeover:
+                type: boolean
+                description: reset the compression context after each sent message
+                defaultDescription: false
+            client-no-context-takeover:
+                type: boolean
+                description: ask the client to reset its compression context after each message
+                defaultDescription: false
+            level:
+                type: integer
+                description: zlib compression level
+                defaultDescription: 6
+                minimum: 1
+                maximum: 9
+            min-size:
+                type: integer
+                description: outgoing messages shorter than this are sent uncompressed
+                defaultDescription: 64
 )");
 }
 
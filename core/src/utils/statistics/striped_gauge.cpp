@@ -0,0 +1,15 @@
+#include <userver/utils/statistics/striped_gauge.hpp>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+void DumpMetric(Writer& writer, const StripedGauge& value) {
+  writer = value.Load();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
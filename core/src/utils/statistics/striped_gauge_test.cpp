@@ -0,0 +1,65 @@
+#include <userver/utils/statistics/striped_gauge.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+TEST(StripedGauge, Basic) {
+  StripedGauge gauge;
+  EXPECT_EQ(gauge.Load(), 0);
+
+  ++gauge;
+  gauge.Add(5);
+  EXPECT_EQ(gauge.Load(), 6);
+
+  --gauge;
+  gauge.Subtract(2);
+  EXPECT_EQ(gauge.Load(), 3);
+}
+
+TEST(StripedGauge, NegativeIsClamped) {
+  StripedGauge gauge;
+  --gauge;
+  EXPECT_EQ(gauge.Load(), 0);
+  ++gauge;
+  EXPECT_EQ(gauge.Load(), 0);
+}
+
+UTEST(StripedGauge, DumpMetric) {
+  Storage storage;
+  StripedGauge gauge;
+  gauge.Add(10);
+  const auto gauge_scope = storage.RegisterWriter(
+      "test", [&gauge](Writer& writer) { writer = gauge; });
+
+  EXPECT_EQ(Snapshot{storage}.SingleMetric("test").AsInt(), 10);
+}
+
+UTEST_MT(StripedGauge, Concurrent, 4) {
+  constexpr int kIterations = 10000;
+  StripedGauge gauge;
+
+  auto tasks = utils::GenerateFixedArray(GetThreadCount(), [&](std::size_t) {
+    return engine::AsyncNoSpan([&] {
+      for (int i = 0; i < kIterations; ++i) {
+        ++gauge;
+        ++gauge;
+        --gauge;
+      }
+    });
+  });
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(gauge.Load(),
+            static_cast<std::int64_t>(GetThreadCount()) * kIterations);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#include <userver/utils/statistics/striped_histogram.hpp>
+
+#include <functional>
+
+#include <boost/range/algorithm/upper_bound.hpp>
+
+#include <userver/utils/statistics/impl/histogram_bucket.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <utils/statistics/impl/histogram_view_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+StripedHistogram::StripedHistogram(utils::span<const double> upper_bounds)
+    : bounds_(
+          std::make_unique<impl::histogram::Bucket[]>(upper_bounds.size() + 1)),
+      counters_(upper_bounds.size() + 1) {
+  impl::histogram::CopyBounds(bounds_.get(), upper_bounds);
+}
+
+StripedHistogram::~StripedHistogram() = default;
+
+void StripedHistogram::Account(double value, std::uint64_t count) noexcept {
+  const auto bounds_view = impl::histogram::Access::Bounds(
+      impl::histogram::MakeView(bounds_.get()));
+  // Values on the bucket borders fall into the lower bucket.
+  const auto iter = boost::upper_bound(bounds_view, value, std::less_equal<>{});
+  const auto bucket_index =
+      iter == bounds_view.end()
+          ? 0
+          : static_cast<std::size_t>(iter - bounds_view.begin()) + 1;
+  counters_[bucket_index].Add(Rate{count});
+}
+
+Histogram StripedHistogram::GetSnapshot() const {
+  const auto bucket_count = counters_.size();
+  const auto buckets =
+      std::make_unique<impl::histogram::Bucket[]>(bucket_count);
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    buckets[i].upper_bound = bounds_[i].upper_bound;
+    buckets[i].counter.store(counters_[i].Load().value,
+                             std::memory_order_relaxed);
+  }
+  return Histogram{impl::histogram::MakeView(buckets.get())};
+}
+
+void ResetMetric(StripedHistogram& histogram) noexcept {
+  for (auto& counter : histogram.counters_) {
+    counter.Store(Rate{});
+  }
+}
+
+void DumpMetric(Writer& writer, const StripedHistogram& histogram) {
+  const auto snapshot = histogram.GetSnapshot();
+  writer = snapshot.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,85 @@
+#include <userver/utils/statistics/striped_histogram.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+auto Bounds() { return std::vector<double>{1.5, 5, 42, 60}; }
+
+void AccountSome(utils::statistics::StripedHistogram& histogram) {
+  histogram.Account(10);
+  histogram.Account(1.2);
+  histogram.Account(1.8);
+  histogram.Account(100);
+  histogram.Account(30, 4);
+}
+
+}  // namespace
+
+UTEST(StatisticsStripedHistogram, Account) {
+  utils::statistics::StripedHistogram histogram{Bounds()};
+  AccountSome(histogram);
+  EXPECT_EQ(fmt::to_string(histogram.GetSnapshot().GetView()),
+            "[1.5]=1,[5]=1,[42]=5,[60]=0,[inf]=1");
+}
+
+UTEST(StatisticsStripedHistogram, ValueOnBucketBorder) {
+  utils::statistics::StripedHistogram histogram{Bounds()};
+  histogram.Account(5);
+  histogram.Account(60);
+  EXPECT_EQ(fmt::to_string(histogram.GetSnapshot().GetView()),
+            "[1.5]=0,[5]=1,[42]=0,[60]=1,[inf]=0");
+}
+
+UTEST(StatisticsStripedHistogram, ZeroBuckets) {
+  utils::statistics::StripedHistogram histogram{std::vector<double>{}};
+  histogram.Account(5);
+  const auto snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(snapshot.GetView().GetBucketCount(), 0);
+  EXPECT_EQ(snapshot.GetView().GetValueAtInf(), 1);
+}
+
+UTEST(StatisticsStripedHistogram, DumpAndReset) {
+  utils::statistics::Storage storage;
+  utils::statistics::StripedHistogram histogram{Bounds()};
+  const auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  AccountSome(histogram);
+  EXPECT_EQ(fmt::to_string(
+                utils::statistics::Snapshot{storage}.SingleMetric("test")),
+            "[1.5]=1,[5]=1,[42]=5,[60]=0,[inf]=1");
+
+  ResetMetric(histogram);
+  EXPECT_EQ(fmt::to_string(
+                utils::statistics::Snapshot{storage}.SingleMetric("test")),
+            "[1.5]=0,[5]=0,[42]=0,[60]=0,[inf]=0");
+}
+
+UTEST_MT(StatisticsStripedHistogram, Concurrent, 4) {
+  constexpr int kIterations = 1000;
+  utils::statistics::StripedHistogram histogram{Bounds()};
+
+  auto tasks = utils::GenerateFixedArray(GetThreadCount(), [&](std::size_t) {
+    return engine::AsyncNoSpan([&] {
+      for (int i = 0; i < kIterations; ++i) {
+        AccountSome(histogram);
+      }
+    });
+  });
+  for (auto& task : tasks) task.Get();
+
+  const auto total = GetThreadCount() * kIterations;
+  EXPECT_EQ(histogram.GetSnapshot().GetView().GetTotalCount(), total * 8);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/striped_gauge.hpp>
+#include <userver/utils/statistics/striped_histogram.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using AtomicGauge = std::atomic<std::int64_t>;
+using utils::statistics::Histogram;
+using utils::statistics::StripedGauge;
+using utils::statistics::StripedHistogram;
+
+auto Bounds() { return std::vector<double>{1, 2, 5, 10, 20, 50, 100, 200}; }
+
+}  // namespace
+
+template <typename Gauge>
+void GaugeBenchmark(benchmark::State& state) {
+  Gauge gauge{};
+
+  RunParallelBenchmark(state, [&](auto& range) {
+    for ([[maybe_unused]] auto _ : range) {
+      ++gauge;
+      --gauge;
+    }
+  });
+}
+
+template <typename Metric>
+void HistogramBenchmark(benchmark::State& state) {
+  Metric histogram{Bounds()};
+
+  RunParallelBenchmark(state, [&](auto& range) {
+    std::int64_t value = 0;
+    for ([[maybe_unused]] auto _ : range) {
+      histogram.Account(static_cast<double>(value++ % 256));
+    }
+  });
+}
+
+BENCHMARK_TEMPLATE(GaugeBenchmark, AtomicGauge)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(GaugeBenchmark, StripedGauge)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(HistogramBenchmark, Histogram)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(HistogramBenchmark, StripedHistogram)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+
+USERVER_NAMESPACE_END
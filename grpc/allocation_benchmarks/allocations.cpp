@@ -0,0 +1,43 @@
+#include "allocations.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> allocations_count{0};
+std::atomic<std::uint64_t> allocated_bytes{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::bench {
+
+std::uint64_t GetAllocationsCount() noexcept {
+  return allocations_count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t GetAllocatedBytes() noexcept {
+  return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+}  // namespace ugrpc::bench
+
+USERVER_NAMESPACE_END
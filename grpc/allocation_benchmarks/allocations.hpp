@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::bench {
+
+// Counters of the heap allocations of the whole process, both client and
+// server sides. Only the allocations through operator new are counted, so
+// the slices allocated by grpc-core are not.
+//
+// The global operator new is replaced for the whole binary, that is why these
+// benchmarks are not a part of userver-grpc-benchmark.
+std::uint64_t GetAllocationsCount() noexcept;
+
+std::uint64_t GetAllocatedBytes() noexcept;
+
+}  // namespace ugrpc::bench
+
+USERVER_NAMESPACE_END
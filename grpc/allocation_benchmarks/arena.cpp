@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <google/protobuf/arena.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <tests/nested_messages_client.usrv.pb.hpp>
+#include <tests/nested_messages_service.usrv.pb.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include "allocations.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+namespace {
+
+constexpr int kTagsPerItem = 4;
+
+class NestedMessagesService final
+    : public sample::ugrpc::NestedMessagesServiceBase {
+ public:
+  void Echo(EchoCall& call, sample::ugrpc::NestedBatch&& request) override {
+    std::optional<sample::ugrpc::NestedBatch> heap_response;
+    sample::ugrpc::NestedBatch* response = nullptr;
+    if (auto* arena = call.GetArena()) {
+      response =
+          google::protobuf::Arena::CreateMessage<sample::ugrpc::NestedBatch>(
+              arena);
+    } else {
+      response = &heap_response.emplace();
+    }
+
+    for (const auto& item : request.items()) {
+      auto& out = *response->add_items();
+      out.set_id(item.id());
+      out.set_name(item.name());
+      *out.mutable_tags() = item.tags();
+    }
+    call.Finish(*response);
+  }
+};
+
+class NestedMessagesServer final : public tests::ServiceBase {
+ public:
+  explicit NestedMessagesServer(bool use_arena) {
+    GetServer().AddService(
+        service_, server::ServiceConfig{
+                      engine::current_task::GetTaskProcessor(),
+                      /*middlewares=*/{},
+                      use_arena,
+                  });
+    StartServer();
+  }
+
+  ~NestedMessagesServer() override { StopServer(); }
+
+ private:
+  NestedMessagesService service_;
+};
+
+sample::ugrpc::NestedBatch MakeBatch(std::size_t items_count) {
+  sample::ugrpc::NestedBatch batch;
+  for (std::size_t i = 0; i < items_count; ++i) {
+    auto& item = *batch.add_items();
+    item.set_id(static_cast<std::int64_t>(i));
+    item.set_name("item name that does not fit into SSO #" + std::to_string(i));
+    for (int tag = 0; tag < kTagsPerItem; ++tag) {
+      item.add_tags("tag that does not fit into SSO #" + std::to_string(tag));
+    }
+  }
+  return batch;
+}
+
+}  // namespace
+
+// Args: items in the request, use arena
+void ServerArena(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    NestedMessagesServer server{state.range(1) != 0};
+    auto client =
+        server.MakeClient<sample::ugrpc::NestedMessagesServiceClient>();
+    const auto request = MakeBatch(state.range(0));
+
+    const auto allocations_before = bench::GetAllocationsCount();
+    for (auto _ : state) {
+      auto response = client.Echo(request).Finish();
+      UINVARIANT(response.items_size() == request.items_size(),
+                 "Behavior broken");
+    }
+    const auto allocations = bench::GetAllocationsCount() - allocations_before;
+
+    state.counters["allocations_per_call"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  });
+}
+BENCHMARK(ServerArena)
+    ->ArgsProduct({{10, 100, 1000}, {0, 1}})
+    ->ArgNames({"items", "use_arena"})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
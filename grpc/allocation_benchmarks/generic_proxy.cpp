@@ -0,0 +1,152 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/ugrpc/client/generic.hpp>
+#include <userver/ugrpc/server/generic_service_base.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include "allocations.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+namespace {
+
+constexpr std::string_view kCallName = "sample.ugrpc.UnitTestService/SayHello";
+
+// The way of passing the bodies through the proxy
+enum class ForwardMode {
+  kByteBuffer,
+  kStringCopy,
+};
+
+// What a proxy does if it converts the bodies to std::string, e.g. for logging
+grpc::ByteBuffer CopyThroughString(const grpc::ByteBuffer& buffer) {
+  grpc::ByteBuffer buffer_ref{buffer};
+  std::vector<grpc::Slice> slices;
+  UINVARIANT(buffer_ref.Dump(&slices).ok(), "Failed to dump a ByteBuffer");
+
+  std::string body;
+  for (const auto& slice : slices) {
+    body.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+  }
+  grpc::Slice slice{body};
+  return grpc::ByteBuffer{&slice, 1};
+}
+
+class EchoGenericService final : public server::GenericServiceBase {
+ public:
+  void Handle(Call& call) override {
+    grpc::ByteBuffer request;
+    UINVARIANT(call.Read(request), "Missing request");
+    call.WriteAndFinish(request);
+  }
+};
+
+class ProxyGenericService final : public server::GenericServiceBase {
+ public:
+  ProxyGenericService(client::GenericClient& client, ForwardMode mode)
+      : client_(client), mode_(mode) {}
+
+  void Handle(Call& call) override {
+    grpc::ByteBuffer request;
+    UINVARIANT(call.Read(request), "Missing request");
+    if (mode_ == ForwardMode::kStringCopy) request = CopyThroughString(request);
+
+    auto response = client_.UnaryCall(call.GetCallName(), request).Finish();
+    if (mode_ == ForwardMode::kStringCopy) {
+      response = CopyThroughString(response);
+    }
+    call.WriteAndFinish(response);
+  }
+
+ private:
+  client::GenericClient& client_;
+  const ForwardMode mode_;
+};
+
+class UpstreamServer final : public tests::ServiceBase {
+ public:
+  UpstreamServer() {
+    RegisterService(service_);
+    StartServer();
+  }
+
+  ~UpstreamServer() override { StopServer(); }
+
+ private:
+  EchoGenericService service_;
+};
+
+class ProxyServer final : public tests::ServiceBase {
+ public:
+  ProxyServer(UpstreamServer& upstream, ForwardMode mode)
+      : upstream_client_(upstream.MakeClient<client::GenericClient>()),
+        service_(upstream_client_, mode) {
+    RegisterService(service_);
+    StartServer();
+  }
+
+  ~ProxyServer() override { StopServer(); }
+
+ private:
+  client::GenericClient upstream_client_;
+  ProxyGenericService service_;
+};
+
+grpc::ByteBuffer MakeRequest(std::size_t size) {
+  grpc::Slice slice{std::string(size, 'x')};
+  return grpc::ByteBuffer{&slice, 1};
+}
+
+}  // namespace
+
+// Args: message size, forward mode (0 - ByteBuffer, 1 - copy through string)
+//
+// `allocated_bytes_per_call` is everything allocated through operator new in
+// the process: the client, the proxy and the upstream. Slices allocated by
+// grpc-core are not counted, so the difference between the modes is the
+// memory allocated for the copies in the proxying code.
+void GenericProxy(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    const auto message_size = static_cast<std::size_t>(state.range(0));
+    const auto mode = state.range(1) == 0 ? ForwardMode::kByteBuffer
+                                          : ForwardMode::kStringCopy;
+
+    UpstreamServer upstream;
+    ProxyServer proxy{upstream, mode};
+    auto client = proxy.MakeClient<client::GenericClient>();
+    const auto request = MakeRequest(message_size);
+
+    const auto allocated_before = bench::GetAllocatedBytes();
+    for (auto _ : state) {
+      auto response = client.UnaryCall(kCallName, request).Finish();
+      UINVARIANT(response.Length() == message_size, "Behavior broken");
+    }
+    const auto allocated = bench::GetAllocatedBytes() - allocated_before;
+
+    state.counters["allocated_bytes_per_call"] = benchmark::Counter(
+        static_cast<double>(allocated), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * message_size * 2));
+  });
+}
+BENCHMARK(GenericProxy)
+    ->ArgsProduct({{64 << 10, 1 << 20, 3 << 20}, {0, 1}})
+    ->ArgNames({"message_size", "string_copy"})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,139 @@
+#include <cstddef>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+namespace {
+
+constexpr std::size_t kClientsCount = 16;
+constexpr std::size_t kCallsPerClient = 64;
+constexpr std::size_t kMessagesPerStream = 256;
+
+class EchoService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name(std::move(*request.mutable_name()));
+    call.Finish(response);
+  }
+
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    while (call.Read(request)) {
+      response.set_number(request.number());
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+class EchoServer final : public tests::ServiceBase {
+ public:
+  explicit EchoServer(ugrpc::impl::QueuePollingMode polling_mode)
+      : tests::ServiceBase(MakeServerConfig(polling_mode)) {
+    RegisterService(service_);
+    StartServer();
+  }
+
+  ~EchoServer() override { StopServer(); }
+
+ private:
+  static server::ServerConfig MakeServerConfig(
+      ugrpc::impl::QueuePollingMode polling_mode) {
+    server::ServerConfig config;
+    config.completion_queue_polling = polling_mode;
+    return config;
+  }
+
+  EchoService service_;
+};
+
+ugrpc::impl::QueuePollingMode GetPollingMode(const benchmark::State& state) {
+  return state.range(1) == 0 ? ugrpc::impl::QueuePollingMode::kDedicatedThread
+                             : ugrpc::impl::QueuePollingMode::kTaskProcessor;
+}
+
+void DoUnaryCalls(sample::ugrpc::UnitTestServiceClient& client) {
+  sample::ugrpc::GreetingRequest request;
+  request.set_name("userver");
+  for (std::size_t i = 0; i < kCallsPerClient; ++i) {
+    auto response = client.SayHello(request).Finish();
+    benchmark::DoNotOptimize(response);
+  }
+}
+
+void DoStreamingCalls(sample::ugrpc::UnitTestServiceClient& client) {
+  auto stream = client.Chat();
+  sample::ugrpc::StreamGreetingRequest request;
+  sample::ugrpc::StreamGreetingResponse response;
+  for (std::size_t i = 0; i < kMessagesPerStream; ++i) {
+    request.set_number(static_cast<int>(i));
+    UINVARIANT(stream.Write(request), "Stream broken");
+    UINVARIANT(stream.Read(response), "Stream broken");
+  }
+  UINVARIANT(stream.WritesDone(), "Stream broken");
+  UINVARIANT(!stream.Read(response), "Extra messages in stream");
+}
+
+template <typename Payload>
+void RunThroughput(benchmark::State& state, Payload payload,
+                   std::size_t messages_per_client) {
+  engine::RunStandalone(state.range(0), [&] {
+    EchoServer server{GetPollingMode(state)};
+    auto clients = utils::GenerateFixedArray(kClientsCount, [&server](auto) {
+      return server.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+    });
+
+    for (auto _ : state) {
+      auto tasks = utils::GenerateFixedArray(kClientsCount, [&](auto i) {
+        return engine::AsyncNoSpan(payload, std::ref(clients[i]));
+      });
+      engine::GetAll(tasks);
+    }
+
+    state.counters["messages_per_second"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * kClientsCount *
+                            messages_per_client),
+        benchmark::Counter::kIsRate);
+  });
+}
+
+}  // namespace
+
+// Args: worker threads, polling mode (0 - dedicated threads, 1 - task
+// processor)
+void QueuePollingUnary(benchmark::State& state) {
+  RunThroughput(state, DoUnaryCalls, kCallsPerClient);
+}
+BENCHMARK(QueuePollingUnary)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1}})
+    ->ArgNames({"threads", "task_processor_polling"})
+    ->Unit(benchmark::kMillisecond);
+
+void QueuePollingStreaming(benchmark::State& state) {
+  RunThroughput(state, DoStreamingCalls, kMessagesPerStream);
+}
+BENCHMARK(QueuePollingStreaming)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1}})
+    ->ArgNames({"threads", "task_processor_polling"})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
@@ -1,3 +1,4 @@
+import re
 import typing
 
 import pytest
@@ -9,6 +10,7 @@ def _normalize_metrics(metrics: str) -> str:
 
     result = _drop_non_grpc_metrics(result)
     result = _hide_metrics_values(result)
+    result = _hide_endpoints(result)
 
     result.sort()
     return '\n'.join(result) + '\n'
@@ -27,6 +29,14 @@ def _hide_metrics_values(metrics: typing.List[str]) -> typing.List[str]:
     return ['\t'.join(line.split('\t')[0:2]) for line in metrics]
 
 
+def _hide_endpoints(metrics: typing.List[str]) -> typing.List[str]:
+    # gRPC mockserver listens on a random port
+    return [
+        re.sub('grpc_endpoint=[^,\t]+', 'grpc_endpoint=<endpoint>', line)
+        for line in metrics
+    ]
+
+
 @pytest.fixture(name='force_metrics_to_appear')
 async def _force_metrics_to_appear(grpc_client, mock_grpc_greeter):
     @mock_grpc_greeter('SayHello')
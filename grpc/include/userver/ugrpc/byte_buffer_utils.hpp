@@ -4,6 +4,7 @@
 /// @brief Helper functions for working with `grpc::ByteBuffer`
 
 #include <cstddef>
+#include <string>
 
 #include <google/protobuf/message.h>
 #include <grpcpp/support/byte_buffer.h>
@@ -33,6 +34,14 @@ grpc::ByteBuffer SerializeToByteBuffer(
 bool ParseFromByteBuffer(grpc::ByteBuffer&& buffer,
                          ::google::protobuf::Message& message);
 
+/// @brief Copy at most @a max_size first bytes of the buffer, e.g. for logging.
+///
+/// Unlike `grpc::ByteBuffer::DumpToSingleSlice`, the slices are read one by
+/// one and only until @a max_size bytes are copied, and @a buffer is left
+/// intact, so it can be forwarded further without copying.
+std::string GetByteBufferPrefix(const grpc::ByteBuffer& buffer,
+                                std::size_t max_size);
+
 }  // namespace ugrpc
 
 USERVER_NAMESPACE_END
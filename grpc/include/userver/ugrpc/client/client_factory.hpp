@@ -4,6 +4,7 @@
 /// @brief @copybrief ugrpc::client::ClientFactory
 
 #include <cstddef>
+#include <cstdint>
 
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/security/credentials.h>
@@ -14,6 +15,7 @@
 #include <userver/logging/level.hpp>
 #include <userver/storages/secdist/secdist.hpp>
 #include <userver/testsuite/grpc_control.hpp>
+#include <userver/utils/statistics/entry.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
@@ -48,6 +50,19 @@ struct ClientFactorySettings final {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// Max number of underlying channels for every client in this factory. If
+  /// greater than `channel_count`, a channel is added each time all the
+  /// channels have `channel_growth_threshold` RPCs in flight.
+  std::size_t max_channel_count{1};
+
+  /// Number of RPCs in flight per channel upon which more channels are added.
+  std::uint64_t channel_growth_threshold{100};
+
+  /// Whether each channel of a client opens its own connections. Otherwise
+  /// the channels share the connections via the gRPC global subchannel pool,
+  /// which only spreads the RPCs over the channel-level queues.
+  bool separate_channel_connections{false};
 };
 
 /// @ingroup userver_clients
@@ -64,6 +79,8 @@ class ClientFactory final {
                 testsuite::GrpcControl& testsuite_grpc,
                 dynamic_config::Source source);
 
+  ~ClientFactory();
+
   template <typename Client>
   Client MakeClient(const std::string& client_name,
                     const std::string& endpoint);
@@ -72,6 +89,8 @@ class ClientFactory final {
   impl::ChannelCache::Token GetChannel(const std::string& client_name,
                                        const std::string& endpoint);
 
+  void WriteChannelStatistics(utils::statistics::Writer& writer);
+
   engine::TaskProcessor& channel_task_processor_;
   MiddlewareFactories mws_;
   grpc::CompletionQueue& queue_;
@@ -81,6 +100,7 @@ class ClientFactory final {
   ugrpc::impl::StatisticsStorage client_statistics_storage_;
   const dynamic_config::Source config_source_;
   testsuite::GrpcControl& testsuite_grpc_;
+  utils::statistics::Entry channel_statistics_holder_;
 };
 
 template <typename Client>
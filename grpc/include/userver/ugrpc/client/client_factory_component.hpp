@@ -33,6 +33,10 @@ namespace ugrpc::client {
 /// service config should be distributed via the name resolution process.
 /// We allow setting default service_config: pass desired JSON literal
 /// to `default-service-config` parameter
+///
+/// ## Channels
+/// Each RPC goes to the channel with the fewest RPCs in flight. The number of
+/// RPCs in flight per channel is reported in `grpc.client.channels` metrics.
 
 // clang-format off
 
@@ -47,6 +51,9 @@ namespace ugrpc::client {
 /// auth-type | authentication method, see above | -
 /// default-service-config | default service config, see above | -
 /// channel-count | Number of underlying grpc::Channel objects | 1
+/// max-channel-count | Max number of grpc::Channel objects, more channels are activated under load | channel-count
+/// channel-growth-threshold | RPCs in flight per channel upon which one more channel is activated | 100
+/// separate-channel-connections | Whether each channel opens its own connections instead of sharing them via the gRPC global subchannel pool | false
 /// middlewares | middlewares names to use | []
 ///
 ///
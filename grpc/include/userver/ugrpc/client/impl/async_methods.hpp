@@ -150,6 +150,7 @@ class RpcData final {
   grpc::CompletionQueue& queue_;
   RpcConfigValues config_values_;
   const Middlewares& mws_;
+  ChannelInFlightGuard in_flight_;
 
   CallKind call_kind_{};
 
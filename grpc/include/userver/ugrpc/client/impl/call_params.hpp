@@ -27,18 +27,20 @@ struct CallParams {
   std::unique_ptr<grpc::ClientContext> context;
   ugrpc::impl::MethodStatistics& statistics;
   const Middlewares& mws;
+  ChannelInFlightGuard in_flight;
 };
 
 CallParams CreateCallParams(const ClientData& client_data,
                             std::size_t method_id,
                             std::unique_ptr<grpc::ClientContext> client_context,
                             const dynamic_config::Key<ClientQos>& client_qos,
-                            const Qos& qos);
+                            const Qos& qos, ChannelInFlightGuard&& in_flight);
 
 CallParams CreateGenericCallParams(
     const ClientData& client_data, std::string_view call_name,
     std::unique_ptr<grpc::ClientContext> client_context, const Qos& qos,
-    std::optional<std::string_view> metrics_call_name);
+    std::optional<std::string_view> metrics_call_name,
+    ChannelInFlightGuard&& in_flight);
 
 }  // namespace ugrpc::client::impl
 
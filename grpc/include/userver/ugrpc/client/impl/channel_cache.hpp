@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -15,13 +16,50 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
 namespace ugrpc::client::impl {
 
+/// Settings of the channels created for every endpoint
+struct ChannelPoolSettings final {
+  /// Number of channels used from the start
+  std::size_t channel_count{1};
+
+  /// Upper bound for the number of channels. If greater than `channel_count`,
+  /// more channels are activated on demand, and are never deactivated.
+  std::size_t max_channel_count{1};
+
+  /// A new channel is activated once every active channel has at least that
+  /// many RPCs in flight. Should be close to the server's
+  /// MAX_CONCURRENT_STREAMS, as RPCs over it queue up inside the channel.
+  std::uint64_t growth_threshold{100};
+
+  /// Give each channel its own connections. By default the channels with
+  /// equal arguments share the connections via the global subchannel pool.
+  bool separate_connections{false};
+};
+
+/// Counts an RPC as in flight on a channel while alive
+class ChannelInFlightGuard final {
+ public:
+  ChannelInFlightGuard() noexcept = default;
+  explicit ChannelInFlightGuard(std::atomic<std::uint64_t>& in_flight) noexcept;
+
+  ChannelInFlightGuard(ChannelInFlightGuard&&) noexcept;
+  ChannelInFlightGuard& operator=(ChannelInFlightGuard&&) noexcept;
+  ~ChannelInFlightGuard();
+
+ private:
+  std::atomic<std::uint64_t>* in_flight_{nullptr};
+};
+
 class ChannelCache final {
  public:
   ChannelCache(std::shared_ptr<grpc::ChannelCredentials>&& credentials,
                const grpc::ChannelArguments& channel_args,
-               std::size_t channel_count);
+               const ChannelPoolSettings& pool_settings);
 
   ~ChannelCache();
 
@@ -31,14 +69,24 @@ class ChannelCache final {
   // alive.
   Token Get(const std::string& endpoint);
 
+  void WriteStatistics(utils::statistics::Writer& writer);
+
  private:
+  struct ChannelState final {
+    std::shared_ptr<grpc::Channel> channel;
+    std::atomic<std::uint64_t> in_flight{0};
+  };
+
   struct CountedChannel final {
     CountedChannel(const std::string& endpoint,
                    const std::shared_ptr<grpc::ChannelCredentials>& credentials,
                    const grpc::ChannelArguments& channel_args,
-                   std::size_t count);
+                   const ChannelPoolSettings& pool_settings);
 
-    utils::FixedArray<std::shared_ptr<grpc::Channel>> channels;
+    // Sized for the max channel count, only the first `active_count` are used
+    utils::FixedArray<ChannelState> channels;
+    std::atomic<std::size_t> active_count;
+    const std::uint64_t growth_threshold;
     std::uint64_t counter{0};
   };
 
@@ -46,7 +94,7 @@ class ChannelCache final {
 
   const std::shared_ptr<grpc::ChannelCredentials> credentials_;
   const grpc::ChannelArguments channel_args_;
-  const std::size_t channel_count_;
+  const ChannelPoolSettings pool_settings_;
   concurrent::Variable<Map> channels_;
 };
 
@@ -62,11 +110,23 @@ class ChannelCache::Token final {
   Token& operator=(Token&&) noexcept;
   ~Token();
 
+  // Number of the currently active channels
   std::size_t GetChannelCount() const noexcept;
 
+  std::size_t GetMaxChannelCount() const noexcept;
+
   const std::shared_ptr<grpc::Channel>& GetChannel(std::size_t index) const
       noexcept;
 
+  // Returns the index of the active channel with the fewest RPCs in flight,
+  // ties are broken randomly. Activates one more channel if all the active
+  // ones are loaded up to the growth threshold.
+  std::size_t PickLeastLoadedChannel() const;
+
+  ChannelInFlightGuard StartRpc(std::size_t index) const noexcept;
+
+  std::uint64_t GetInFlight(std::size_t index) const noexcept;
+
  private:
   ChannelCache* cache_{nullptr};
   const std::string* endpoint_{nullptr};
@@ -15,7 +15,6 @@
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/utils/fixed_array.hpp>
-#include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -38,6 +37,14 @@ struct ClientParams final {
 
 struct GenericClientTag final {};
 
+/// A stub of the channel picked for an RPC, the RPC is counted as in flight on
+/// that channel while `in_flight` is alive
+template <typename Stub>
+struct StubHandle final {
+  Stub& stub;
+  ChannelInFlightGuard in_flight;
+};
+
 /// A helper class for generated gRPC clients
 class ClientData final {
  public:
@@ -67,9 +74,10 @@ class ClientData final {
   ClientData& operator=(const ClientData&) = delete;
 
   template <typename Service>
-  Stub<Service>& NextStub() const {
-    return *static_cast<Stub<Service>*>(
-        stubs_[utils::RandRange(stubs_.size())].get());
+  StubHandle<Stub<Service>> NextStub() const {
+    const auto index = params_.channel_token.PickLeastLoadedChannel();
+    return {*static_cast<Stub<Service>*>(stubs_[index].get()),
+            params_.channel_token.StartRpc(index)};
   }
 
   grpc::CompletionQueue& GetQueue() const { return params_.queue; }
@@ -107,7 +115,9 @@ class ClientData final {
   template <typename Service>
   static utils::FixedArray<StubPtr> MakeStubs(
       impl::ChannelCache::Token& channel_token) {
-    const std::size_t channel_count = channel_token.GetChannelCount();
+    // Stubs for the channels that may be activated later are created
+    // beforehand, they are cheap
+    const std::size_t channel_count = channel_token.GetMaxChannelCount();
     return utils::GenerateFixedArray(channel_count, [&](std::size_t index) {
       return StubPtr(
           Service::NewStub(channel_token.GetChannel(index)).release(),
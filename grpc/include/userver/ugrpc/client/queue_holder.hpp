@@ -5,6 +5,7 @@
 
 #include <grpcpp/completion_queue.h>
 
+#include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,7 +15,8 @@ namespace ugrpc::client {
 /// @brief Manages a gRPC completion queue, usable only in clients
 class QueueHolder final {
  public:
-  QueueHolder();
+  explicit QueueHolder(ugrpc::impl::QueuePollingMode polling_mode =
+                           ugrpc::impl::QueuePollingMode::kDedicatedThread);
 
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
@@ -24,7 +26,7 @@ class QueueHolder final {
 
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 176, 16> impl_;
+  utils::FastPimpl<Impl, 208, 16> impl_;
 };
 
 }  // namespace ugrpc::client
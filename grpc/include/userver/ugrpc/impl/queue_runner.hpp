@@ -1,21 +1,49 @@
 #pragma once
 
+#include <memory>
+#include <optional>
+
 #include <grpcpp/completion_queue.h>
 
 #include <userver/engine/single_use_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
 
+/// How the events of a completion queue are delivered to the awaiting tasks
+enum class QueuePollingMode {
+  /// A dedicated OS thread blocks in `CompletionQueue::Next` and wakes up
+  /// the awaiting tasks
+  kDedicatedThread,
+
+  /// A task of the current task processor drains the queue with a zero
+  /// deadline, so a burst of events is handled by the engine worker threads
+  /// without a cross-thread handoff per event. Once the queue is empty the
+  /// task parks, and a helper OS thread blocks in `CompletionQueue::Next`
+  /// until the next event, hands it off and wakes the task up.
+  ///
+  /// @warning This mode still costs one OS thread per queue, as
+  /// kDedicatedThread does: grpc completion queues can not be waited for
+  /// without blocking a thread.
+  kTaskProcessor,
+};
+
+class QueueIdleWaiter;
+
 class QueueRunner final {
  public:
-  explicit QueueRunner(grpc::CompletionQueue& queue);
+  explicit QueueRunner(
+      grpc::CompletionQueue& queue,
+      QueuePollingMode mode = QueuePollingMode::kDedicatedThread);
   ~QueueRunner();
 
  private:
   grpc::CompletionQueue& queue_;
   engine::SingleUseEvent completion_;
+  std::unique_ptr<QueueIdleWaiter> idle_waiter_;
+  std::optional<engine::TaskWithResult<void>> poller_;
 };
 
 }  // namespace ugrpc::impl
@@ -54,6 +54,14 @@ class MethodStatistics final {
 
   void AccountCancelled() noexcept;
 
+  // CPU time spent serializing and compressing a response message on the
+  // serialization task processor.
+  void AccountSerializationOffload(std::chrono::microseconds cpu_time) noexcept;
+
+  // A response message serialized on the handler task processor because it
+  // is smaller than the offload threshold. Not timed to keep it cheap.
+  void AccountSerializationInline(std::size_t bytes) noexcept;
+
   friend void DumpMetric(utils::statistics::Writer& writer,
                          const MethodStatistics& stats);
 
@@ -82,6 +90,11 @@ class MethodStatistics final {
 
   RateCounter deadline_updated_{0};
   RateCounter deadline_cancelled_{0};
+
+  RateCounter serialization_offload_us_{0};
+  RateCounter serialization_offloaded_{0};
+  RateCounter serialization_inline_{0};
+  RateCounter serialization_inline_bytes_{0};
 };
 
 struct MethodStatisticsSnapshot final {
@@ -105,6 +118,11 @@ struct MethodStatisticsSnapshot final {
 
   Rate deadline_updated{0};
   Rate deadline_cancelled{0};
+
+  Rate serialization_offload_us{0};
+  Rate serialization_offloaded{0};
+  Rate serialization_inline{0};
+  Rate serialization_inline_bytes{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -30,6 +30,10 @@ class RpcStatisticsScope final {
 
   void OnNetworkError();
 
+  void OnSerializationOffload(std::chrono::microseconds cpu_time);
+
+  void OnSerializationInline(std::size_t bytes);
+
   void Flush();
 
   // Not thread-safe with respect to Flush.
@@ -30,7 +30,9 @@ namespace ugrpc::server {
 ///
 /// Middlewares are customizable and are applied as usual, except that no
 /// message hooks are called, meaning that there won't be any logs of messages
-/// from the default middleware.
+/// from the default middleware. To log the bodies, use
+/// @ref ugrpc::GetByteBufferPrefix: it copies a bounded prefix and keeps the
+/// buffer intact, so that the body is still forwarded without copying.
 ///
 /// Statically-typed services, if registered, take priority over generic
 /// services. It only makes sense to register at most 1 generic service.
@@ -42,11 +42,16 @@ void ThrowOnError(impl::AsyncMethodInvocation::WaitStatus status,
 extern const grpc::Status kUnimplementedStatus;
 extern const grpc::Status kUnknownErrorStatus;
 
-template <typename GrpcStream, typename Response>
+// Response messages are serialized and compressed synchronously inside the
+// grpcpp call that starts the operation. `start_write` invokes it, possibly
+// on another task processor, see CallAnyBase::StartWrite.
+
+template <typename GrpcStream, typename Response, typename StartWrite>
 void Finish(GrpcStream& stream, const Response& response,
-            const grpc::Status& status, std::string_view call_name) {
+            const grpc::Status& status, std::string_view call_name,
+            StartWrite&& start_write) {
   AsyncMethodInvocation finish;
-  stream.Finish(response, status, finish.GetTag());
+  start_write([&] { stream.Finish(response, status, finish.GetTag()); });
   ThrowOnError(Wait(finish), call_name, "Finish");
 }
 
@@ -96,20 +101,23 @@ bool Read(GrpcStream& stream, Request& request) {
   return Wait(read) == impl::AsyncMethodInvocation::WaitStatus::kOk;
 }
 
-template <typename GrpcStream, typename Response>
+template <typename GrpcStream, typename Response, typename StartWrite>
 void Write(GrpcStream& stream, const Response& response,
-           grpc::WriteOptions options, std::string_view call_name) {
+           grpc::WriteOptions options, std::string_view call_name,
+           StartWrite&& start_write) {
   AsyncMethodInvocation write;
-  stream.Write(response, options, write.GetTag());
+  start_write([&] { stream.Write(response, options, write.GetTag()); });
   ThrowOnError(Wait(write), call_name, "Write");
 }
 
-template <typename GrpcStream, typename Response>
+template <typename GrpcStream, typename Response, typename StartWrite>
 void WriteAndFinish(GrpcStream& stream, const Response& response,
                     grpc::WriteOptions options, const grpc::Status& status,
-                    std::string_view call_name) {
+                    std::string_view call_name, StartWrite&& start_write) {
   AsyncMethodInvocation write_and_finish;
-  stream.WriteAndFinish(response, options, status, write_and_finish.GetTag());
+  start_write([&] {
+    stream.WriteAndFinish(response, options, status, write_and_finish.GetTag());
+  });
   ThrowOnError(Wait(write_and_finish), call_name, "WriteAndFinish");
 }
 
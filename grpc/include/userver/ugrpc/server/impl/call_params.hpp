@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
 #include <string_view>
 
+#include <google/protobuf/arena.h>
+#include <grpc/compression.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_context.h>
 
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/logging/fwd.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/any_storage.hpp>
@@ -22,6 +27,20 @@ class StatisticsStorage;
 
 namespace ugrpc::server::impl {
 
+/// How the responses of an RPC are compressed and serialized
+struct ResponseWriteSettings final {
+  std::optional<grpc_compression_algorithm> compression_algorithm;
+  std::optional<grpc_compression_level> compression_level;
+  std::size_t compression_min_size{0};
+
+  engine::TaskProcessor* serialization_task_processor{nullptr};
+  std::size_t serialization_offload_min_size{0};
+
+  bool IsCompressionEnabled() const noexcept {
+    return compression_algorithm.has_value() || compression_level.has_value();
+  }
+};
+
 struct CallParams {
   grpc::ServerContext& context;
   const std::string_view call_name;
@@ -33,6 +52,8 @@ struct CallParams {
   tracing::Span& call_span;
   utils::AnyStorage<StorageContext>& storage_context;
   const Middlewares& middlewares;
+  google::protobuf::Arena* arena;
+  ResponseWriteSettings write_settings;
 };
 
 }  // namespace ugrpc::server::impl
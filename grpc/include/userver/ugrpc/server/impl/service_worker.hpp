@@ -31,6 +31,9 @@ struct ServiceSettings final {
   Middlewares middlewares;
   logging::LoggerPtr access_tskv_logger;
   const dynamic_config::Source config_source;
+  bool use_arena;
+  engine::TaskProcessor* serialization_task_processor;
+  std::size_t serialization_offload_min_size;
 };
 
 /// @brief Listens to requests for a gRPC service, forwarding them to a
@@ -8,7 +8,9 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/impl/service_type.h>
 #include <grpcpp/server_context.h>
@@ -41,6 +43,11 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server::impl {
 
+// Most requests and responses fit, so a typical RPC allocates a single block
+inline constexpr std::size_t kArenaStartBlockSize = 4096;
+
+google::protobuf::ArenaOptions MakeArenaOptions();
+
 void ReportHandlerError(
     const std::exception& ex, std::string_view call_name, tracing::Span& span,
     ugrpc::impl::RpcStatisticsScope& statistics_scope) noexcept;
@@ -57,11 +64,19 @@ void ReportCustomError(
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                grpc::ServerContext& context, std::string_view call_name);
 
+ResponseWriteSettings MakeResponseWriteSettings(
+    const dynamic_config::Snapshot& config, std::string_view call_name,
+    std::string_view service_name, const ServiceSettings& settings);
+
 void ParseGenericCallName(std::string_view generic_call_name,
                           std::string_view& call_name,
                           std::string_view& service_name,
                           std::string_view& method_name);
 
+std::vector<MiddlewareMethodStates> MakeMiddlewareMethodStates(
+    const Middlewares& middlewares,
+    const ugrpc::impl::StaticServiceMetadata& metadata);
+
 /// Per-gRPC-service data
 template <typename GrpcppService>
 struct ServiceData final {
@@ -77,6 +92,9 @@ struct ServiceData final {
   utils::impl::WaitTokenStorage wait_tokens;
   ugrpc::impl::ServiceStatistics& service_statistics{
       settings.statistics_storage.GetServiceStatistics(metadata, std::nullopt)};
+  // Indexed by method_id
+  const std::vector<MiddlewareMethodStates> middleware_states{
+      MakeMiddlewareMethodStates(settings.middlewares, metadata)};
 };
 
 /// Per-gRPC-method data
@@ -95,6 +113,8 @@ struct MethodData final {
       call_name.substr(service_data.metadata.service_full_name.size() + 1)};
   ugrpc::impl::MethodStatistics& statistics{
       service_data.service_statistics.GetMethodStatistics(method_id)};
+  const MiddlewareMethodStates& middleware_states{
+      service_data.middleware_states[method_id]};
 };
 
 template <typename GrpcppService, typename CallTraits>
@@ -121,9 +141,20 @@ class CallData final {
     auto& queue = method_data_.service_data.settings.queue.GetQueue(
         method_data_.queue_id);
 
+    // Only the initial request is created by the framework. Streamed requests
+    // and responses are owned by the handler, it may put them on the arena
+    // via CallAnyBase::GetArena.
+    if (method_data_.service_data.settings.use_arena) {
+      arena_.emplace(MakeArenaOptions());
+      if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+        initial_request_ =
+            google::protobuf::Arena::CreateMessage<InitialRequest>(&*arena_);
+      }
+    }
+
     // the request for an incoming RPC must be performed synchronously
     method_data_.service_data.async_service.template Prepare<CallTraits>(
-        method_data_.method_id, context_, initial_request_, raw_responder_,
+        method_data_.method_id, context_, *initial_request_, raw_responder_,
         queue, queue, prepare_.GetTag());
 
     // Note: we ignore task cancellations here. Even if notify_when_done has
@@ -186,30 +217,34 @@ class CallData final {
     auto& statistics_storage =
         method_data_.service_data.settings.statistics_storage;
     utils::AnyStorage<StorageContext> storage_context;
+    const auto config =
+        method_data_.service_data.settings.config_source.GetSnapshot();
     Call responder(
         CallParams{context_, call_name, service_name, method_name,
                    statistics_scope, statistics_storage, *access_tskv_logger,
-                   span_->Get(), storage_context, middlewares},
+                   span_->Get(), storage_context, middlewares,
+                   arena_ ? &*arena_ : nullptr,
+                   MakeResponseWriteSettings(config, call_name, service_name,
+                                             method_data_.service_data.settings)},
         raw_responder_);
     auto do_call = [&] {
       if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
         (method_data_.service.*(method_data_.service_method))(responder);
       } else {
         (method_data_.service.*(method_data_.service_method))(
-            responder, std::move(initial_request_));
+            responder, std::move(*initial_request_));
       }
     };
 
     try {
       ::google::protobuf::Message* initial_request = nullptr;
       if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
-        initial_request = &initial_request_;
+        initial_request = initial_request_;
       }
 
       MiddlewareCallContext middleware_context(
-          middlewares, responder, do_call,
-          method_data_.service_data.settings.config_source.GetSnapshot(),
-          initial_request);
+          middlewares, method_data_.middleware_states, responder, do_call,
+          config, initial_request);
       responder.RunMiddlewarePipeline(utils::impl::InternalTag{},
                                       middleware_context);
     } catch (
@@ -229,7 +264,11 @@ class CallData final {
   MethodData<GrpcppService, CallTraits> method_data_;
 
   typename CallTraits::ContextType context_{};
-  InitialRequest initial_request_{};
+  // Messages of the RPC, and the responder that may hold a pointer to the
+  // request, must be destroyed before the arena
+  std::optional<google::protobuf::Arena> arena_;
+  InitialRequest default_initial_request_{};
+  InitialRequest* initial_request_{&default_initial_request_};
   RawCall raw_responder_{&context_};
   ugrpc::impl::AsyncMethodInvocation prepare_;
   std::optional<tracing::InPlaceSpan> span_{};
@@ -4,9 +4,11 @@
 /// @brief @copybrief ugrpc::server::MiddlewareBase
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include <userver/components/component_base.hpp>
+#include <userver/utils/any_movable.hpp>
 #include <userver/utils/function_ref.hpp>
 
 #include <userver/ugrpc/server/middlewares/fwd.hpp>
@@ -20,7 +22,9 @@ namespace ugrpc::server {
 class MiddlewareCallContext final {
  public:
   /// @cond
-  MiddlewareCallContext(const Middlewares& middlewares, CallAnyBase& call,
+  MiddlewareCallContext(const Middlewares& middlewares,
+                        const MiddlewareMethodStates& method_states,
+                        CallAnyBase& call,
                         utils::function_ref<void()> user_call,
                         const dynamic_config::Snapshot& config,
                         ::google::protobuf::Message* request);
@@ -36,11 +40,16 @@ class MiddlewareCallContext final {
   /// deleted when the last middleware completes
   const dynamic_config::Snapshot& GetInitialDynamicConfig() const;
 
+  /// @brief Get the state the current middleware has prepared for the called
+  /// method, see MiddlewareBase::MakeMethodState
+  const utils::AnyMovable& GetMethodState() const;
+
  private:
   void ClearMiddlewaresResources();
 
   Middlewares::const_iterator middleware_;
   Middlewares::const_iterator middleware_end_;
+  MiddlewareMethodStates::const_iterator method_state_;
   utils::function_ref<void()> user_call_;
 
   CallAnyBase& call_;
@@ -74,6 +83,16 @@ class MiddlewareBase {
   /// @brief Response hook. The function is invoked on each response
   virtual void CallResponseHook(const MiddlewareCallContext& context,
                                 google::protobuf::Message& response);
+
+  /// @brief Prepares the state of the middleware for a method, so that
+  /// Handle could get it with MiddlewareCallContext::GetMethodState instead
+  /// of looking it up by the call name. Invoked once for each method of each
+  /// service the middleware is set up for, before the service starts.
+  ///
+  /// Returns an empty state by default.
+  /// @note Generic services get a single state for all the calls
+  virtual utils::AnyMovable MakeMethodState(
+      std::string_view call_name, std::string_view service_name) const;
 };
 
 /// @ingroup userver_base_classes
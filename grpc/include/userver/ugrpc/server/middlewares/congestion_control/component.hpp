@@ -5,6 +5,7 @@
 /// ugrpc::server::middlewares::congestion_control::Component
 
 #include <userver/ugrpc/server/middlewares/base.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -15,7 +16,14 @@ class Middleware;
 
 /// @ingroup userver_components userver_base_classes
 ///
-/// @brief Component for gRPC server logging
+/// @brief Component for gRPC server congestion control
+///
+/// Limits the RPS by the server overload sensor, see
+/// congestion_control::Component. Additionally limits the concurrency of
+/// services and methods adaptively by their latency, see
+/// congestion_control::AdaptiveConcurrencyConfig and the
+/// USERVER_GRPC_SERVER_ADAPTIVE_CONCURRENCY dynamic config. The limiters
+/// report to `grpc.server.adaptive-concurrency`.
 class Component final : public MiddlewareComponentBase {
  public:
   /// @ingroup userver_component_names
@@ -26,12 +34,15 @@ class Component final : public MiddlewareComponentBase {
   Component(const components::ComponentConfig& config,
             const components::ComponentContext& context);
 
+  ~Component() override;
+
   std::shared_ptr<MiddlewareBase> GetMiddleware() override;
 
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
   std::shared_ptr<Middleware> middleware_;
+  utils::statistics::Entry statistics_holder_;
 };
 
 }  // namespace ugrpc::server::middlewares::congestion_control
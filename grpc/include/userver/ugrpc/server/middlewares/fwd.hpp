@@ -6,6 +6,8 @@
 #include <memory>
 #include <vector>
 
+#include <userver/utils/any_movable.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server {
@@ -17,6 +19,10 @@ class MiddlewareCallContext;
 /// @brief A chain of middlewares
 using Middlewares = std::vector<std::shared_ptr<MiddlewareBase>>;
 
+/// @brief States of a chain of middlewares for a method, see
+/// MiddlewareBase::MakeMethodState
+using MiddlewareMethodStates = std::vector<utils::AnyMovable>;
+
 }  // namespace ugrpc::server
 
 USERVER_NAMESPACE_END
@@ -3,11 +3,16 @@
 /// @file userver/ugrpc/server/rpc.hpp
 /// @brief Classes representing an incoming RPC
 
+#include <cstddef>
+#include <type_traits>
+
 #include <google/protobuf/message.h>
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/function_ref.hpp>
 
 #include <userver/ugrpc/impl/deadline_timepoint.hpp>
 #include <userver/ugrpc/impl/internal_tag_fwd.hpp>
@@ -98,6 +103,17 @@ class CallAnyBase {
     return params_.storage_context;
   }
 
+  /// @brief Returns the protobuf arena of the RPC if the service is
+  /// configured with `use-arena`, `nullptr` otherwise.
+  ///
+  /// Only the request of a unary or server-streaming RPC is allocated on the
+  /// arena by the framework. The other messages are passed to Read and Write
+  /// by the handler, so their storage is up to it: create them with
+  /// `google::protobuf::Arena::CreateMessage` on this arena, e.g. for large
+  /// responses or streamed requests, and they are released all at once when
+  /// the RPC completes.
+  google::protobuf::Arena* GetArena() { return params_.arena; }
+
   /// @brief Useful for generic error reporting via @ref FinishWithError
   virtual bool IsFinished() const = 0;
 
@@ -131,12 +147,55 @@ class CallAnyBase {
 
   void ApplyResponseHook(google::protobuf::Message* response);
 
+  // Returns the serialized size of `response`, if compression or
+  // serialization offload need it, 0 otherwise
+  template <typename Response>
+  std::size_t GetResponseSize(const Response& response) const;
+
+  // Whether a response of `size` bytes should be compressed according to
+  // USERVER_GRPC_SERVER_COMPRESSION
+  bool ShouldCompress(std::size_t size) const noexcept;
+
+  // Enables compression of the responses, if configured. Must be first called
+  // before the initial metadata is sent.
+  void EnableCompression();
+
+  // Opts a streamed response out of the compression enabled by
+  // EnableCompression, if it is smaller than the configured min-size
+  void DisableCompressionIfSmall(std::size_t size,
+                                 grpc::WriteOptions& write_options) const;
+
+  // Serializes and sends the response of `size` bytes by calling `start`,
+  // on the serialization task processor if the response is large enough
+  void StartWrite(std::size_t size, utils::function_ref<void()> start);
+
+  auto WriteStarter(std::size_t size) {
+    return [this, size](utils::function_ref<void()> start) {
+      StartWrite(size, start);
+    };
+  }
+
  private:
+  bool NeedsResponseSize() const noexcept;
+
   impl::CallParams params_;
   CallKind call_kind_;
   MiddlewareCallContext* middleware_call_context_{nullptr};
+  bool is_compression_enabled_{false};
 };
 
+template <typename Response>
+std::size_t CallAnyBase::GetResponseSize(const Response& response) const {
+  if (!NeedsResponseSize()) return 0;
+  if constexpr (std::is_base_of_v<google::protobuf::Message, Response>) {
+    return response.ByteSizeLong();
+  } else if constexpr (std::is_same_v<Response, grpc::ByteBuffer>) {
+    return response.Length();
+  } else {
+    return 0;
+  }
+}
+
 /// @brief Controls a single request -> single response RPC
 ///
 /// The RPC is cancelled on destruction unless `Finish` has been called.
@@ -423,8 +482,14 @@ void UnaryCall<Response>::Finish(Response& response) {
 
   ApplyResponseHook(&response);
 
+  // Initial metadata is sent along with the response, so compression may
+  // still be chosen by the response size
+  const auto size = GetResponseSize(response);
+  if (ShouldCompress(size)) EnableCompression();
+
   LogFinish(grpc::Status::OK);
-  impl::Finish(stream_, response, grpc::Status::OK, GetCallName());
+  impl::Finish(stream_, response, grpc::Status::OK, GetCallName(),
+               WriteStarter(size));
   GetStatistics().OnExplicitFinish(grpc::StatusCode::OK);
   ugrpc::impl::UpdateSpanWithStatus(GetSpan(), grpc::Status::OK);
 }
@@ -488,7 +553,10 @@ void InputStream<Request, Response>::Finish(Response& response) {
 
   ApplyResponseHook(&response);
 
-  impl::Finish(stream_, response, status, GetCallName());
+  const auto size = GetResponseSize(response);
+  if (ShouldCompress(size)) EnableCompression();
+
+  impl::Finish(stream_, response, status, GetCallName(), WriteStarter(size));
   GetStatistics().OnExplicitFinish(status.error_code());
   ugrpc::impl::UpdateSpanWithStatus(GetSpan(), status);
 }
@@ -534,6 +602,10 @@ template <typename Response>
 void OutputStream<Response>::Write(Response& response) {
   UINVARIANT(state_ != State::kFinished, "'Write' called on a finished stream");
 
+  // The compression algorithm is announced in the initial metadata, small
+  // messages then opt out of it one by one
+  if (state_ == State::kNew) EnableCompression();
+
   // For some reason, gRPC requires explicit 'SendInitialMetadata' in output
   // streams
   impl::SendInitialMetadataIfNew(stream_, GetCallName(), state_);
@@ -544,7 +616,11 @@ void OutputStream<Response>::Write(Response& response) {
 
   ApplyResponseHook(&response);
 
-  impl::Write(stream_, response, write_options, GetCallName());
+  const auto size = GetResponseSize(response);
+  DisableCompressionIfSmall(size, write_options);
+
+  impl::Write(stream_, response, write_options, GetCallName(),
+              WriteStarter(size));
 }
 
 template <typename Response>
@@ -591,7 +667,12 @@ void OutputStream<Response>::WriteAndFinish(Response& response) {
 
   ApplyResponseHook(&response);
 
-  impl::WriteAndFinish(stream_, response, write_options, status, GetCallName());
+  EnableCompression();
+  const auto size = GetResponseSize(response);
+  DisableCompressionIfSmall(size, write_options);
+
+  impl::WriteAndFinish(stream_, response, write_options, status, GetCallName(),
+                       WriteStarter(size));
   GetStatistics().OnExplicitFinish(grpc::StatusCode::OK);
   ugrpc::impl::UpdateSpanWithStatus(GetSpan(), status);
 }
@@ -648,8 +729,15 @@ void BidirectionalStream<Request, Response>::Write(Response& response) {
     ApplyResponseHook(&response);
   }
 
+  // Initial metadata goes with the first write, small messages then opt out
+  // of compression one by one
+  EnableCompression();
+  const auto size = GetResponseSize(response);
+  DisableCompressionIfSmall(size, write_options);
+
   try {
-    impl::Write(stream_, response, write_options, GetCallName());
+    impl::Write(stream_, response, write_options, GetCallName(),
+                WriteStarter(size));
   } catch (const RpcInterruptedError&) {
     is_finished_ = true;
     throw;
@@ -702,7 +790,12 @@ void BidirectionalStream<Request, Response>::WriteAndFinish(
     ApplyResponseHook(&response);
   }
 
-  impl::WriteAndFinish(stream_, response, write_options, status, GetCallName());
+  EnableCompression();
+  const auto size = GetResponseSize(response);
+  DisableCompressionIfSmall(size, write_options);
+
+  impl::WriteAndFinish(stream_, response, write_options, status, GetCallName(),
+                       WriteStarter(size));
   GetStatistics().OnExplicitFinish(status.error_code());
   ugrpc::impl::UpdateSpanWithStatus(GetSpan(), status);
 }
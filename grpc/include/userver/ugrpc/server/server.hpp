@@ -19,6 +19,7 @@
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
+#include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/ugrpc/server/middlewares/fwd.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
@@ -44,6 +45,12 @@ struct ServerConfig final {
   /// of worker threads for best RPS.
   int completion_queue_num{2};
 
+  /// How the completion queues are polled: by a dedicated thread per queue,
+  /// or by a task per queue on the task processor that starts the server
+  /// (which still needs a helper thread per queue to wait for events).
+  ugrpc::impl::QueuePollingMode completion_queue_polling{
+      ugrpc::impl::QueuePollingMode::kDedicatedThread};
+
   /// Optional grpc-core channel args
   /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
   std::unordered_map<std::string, std::string> channel_args{};
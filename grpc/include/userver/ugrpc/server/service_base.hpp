@@ -3,6 +3,8 @@
 /// @file userver/ugrpc/server/service_base.hpp
 /// @brief @copybrief ugrpc::server::ServiceBase
 
+#include <cstddef>
+
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <userver/ugrpc/server/impl/service_worker.hpp>
@@ -12,6 +14,9 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server {
 
+/// Messages smaller than that are serialized faster than a task switch
+inline constexpr std::size_t kDefaultSerializationOffloadMinSize = 64 * 1024;
+
 /// Per-service settings
 struct ServiceConfig final {
   /// TaskProcessor to use for serving RPCs.
@@ -19,6 +24,20 @@ struct ServiceConfig final {
 
   /// Server middlewares to use for the gRPC service.
   Middlewares middlewares;
+
+  /// Allocate the request of each RPC on a per-call protobuf arena, that is
+  /// also available to the handler, see CallAnyBase::GetArena.
+  bool use_arena{false};
+
+  /// If set, response messages of at least `serialization_offload_min_size`
+  /// bytes are serialized and compressed on this TaskProcessor, keeping the
+  /// `task_processor` responsive.
+  engine::TaskProcessor* serialization_task_processor{nullptr};
+
+  /// Min size of a response message to serialize it on
+  /// `serialization_task_processor`. A non-zero value costs an extra
+  /// ByteSizeLong call per response.
+  std::size_t serialization_offload_min_size{kDefaultSerializationOffloadMinSize};
 };
 
 /// @brief The type-erased base class for all gRPC service implementations
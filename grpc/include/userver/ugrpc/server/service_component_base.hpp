@@ -29,6 +29,9 @@ class GenericServiceBase;
 /// ---- | ----------- | -------------
 /// task-processor | the task processor to use for responses | taken from grpc-server.service-defaults
 /// middlewares | middleware component names to use for each RPC call, can be empty array ([]) | taken from grpc-server.service-defaults
+/// use-arena | allocate the request of each RPC on a per-call protobuf arena, see ugrpc::server::CallAnyBase::GetArena | taken from grpc-server.service-defaults or false
+/// serialization-task-processor | the task processor to serialize and compress large responses on | taken from grpc-server.service-defaults, otherwise no offloading
+/// serialization-offload-min-size | min size of a response to serialize it on serialization-task-processor | taken from grpc-server.service-defaults or 65536
 
 // clang-format on
 
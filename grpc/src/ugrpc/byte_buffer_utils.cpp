@@ -1,5 +1,7 @@
 #include <userver/ugrpc/byte_buffer_utils.hpp>
 
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <grpcpp/support/proto_buffer_reader.h>
 #include <grpcpp/support/proto_buffer_writer.h>
@@ -35,6 +37,24 @@ bool ParseFromByteBuffer(grpc::ByteBuffer&& buffer,
   return message.ParseFromZeroCopyStream(&reader);
 }
 
+std::string GetByteBufferPrefix(const grpc::ByteBuffer& buffer,
+                                std::size_t max_size) {
+  // The reader only peeks at the slices one by one, the buffer is not modified
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  grpc::ProtoBufferReader reader{const_cast<grpc::ByteBuffer*>(&buffer)};
+
+  std::string prefix;
+  prefix.reserve(std::min(max_size, buffer.Length()));
+  const void* data = nullptr;
+  int size = 0;
+  while (prefix.size() < max_size && reader.Next(&data, &size)) {
+    const auto chunk_size =
+        std::min(static_cast<std::size_t>(size), max_size - prefix.size());
+    prefix.append(static_cast<const char*>(data), chunk_size);
+  }
+  return prefix;
+}
+
 }  // namespace ugrpc
 
 USERVER_NAMESPACE_END
@@ -8,6 +8,8 @@
 #include <userver/engine/async.hpp>
 #include <userver/logging/level_serialization.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <ugrpc/client/impl/client_factory_config.hpp>
@@ -19,6 +21,17 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
+namespace {
+
+impl::ChannelPoolSettings MakeChannelPoolSettings(
+    const ClientFactorySettings& settings) {
+  return {settings.channel_count, settings.max_channel_count,
+          settings.channel_growth_threshold,
+          settings.separate_channel_connections};
+}
+
+}  // namespace
+
 ClientFactory::ClientFactory(ClientFactorySettings&& settings,
                              engine::TaskProcessor& channel_task_processor,
                              MiddlewareFactories mws,
@@ -32,7 +45,7 @@ ClientFactory::ClientFactory(ClientFactorySettings&& settings,
       channel_cache_(testsuite_grpc.IsTlsEnabled()
                          ? settings.credentials
                          : grpc::InsecureChannelCredentials(),
-                     settings.channel_args, settings.channel_count),
+                     settings.channel_args, MakeChannelPoolSettings(settings)),
       client_statistics_storage_(statistics_storage,
                                  ugrpc::impl::StatisticsDomain::kClient),
       config_source_(source),
@@ -46,10 +59,17 @@ ClientFactory::ClientFactory(ClientFactorySettings&& settings,
         std::make_unique<impl::ChannelCache>(
             testsuite_grpc.IsTlsEnabled() ? creds
                                           : grpc::InsecureChannelCredentials(),
-            settings.channel_args, settings.channel_count));
+            settings.channel_args, MakeChannelPoolSettings(settings)));
   }
+
+  channel_statistics_holder_ = statistics_storage.RegisterWriter(
+      "grpc.client.channels", [this](utils::statistics::Writer& writer) {
+        WriteChannelStatistics(writer);
+      });
 }
 
+ClientFactory::~ClientFactory() { channel_statistics_holder_.Unregister(); }
+
 impl::ChannelCache::Token ClientFactory::GetChannel(
     const std::string& client_name, const std::string& endpoint) {
   // Spawn a blocking task creating a gRPC channel
@@ -69,6 +89,13 @@ impl::ChannelCache::Token ClientFactory::GetChannel(
       .Get();
 }
 
+void ClientFactory::WriteChannelStatistics(utils::statistics::Writer& writer) {
+  channel_cache_.WriteStatistics(writer);
+  for (const auto& [client_name, channel_cache] : client_channel_cache_) {
+    channel_cache->WriteStatistics(writer);
+  }
+}
+
 }  // namespace ugrpc::client
 
 USERVER_NAMESPACE_END
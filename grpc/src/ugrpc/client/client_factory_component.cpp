@@ -119,6 +119,27 @@ properties:
         description: |
             Number of channels created for each endpoint.
         defaultDescription: 1
+    max-channel-count:
+        type: integer
+        description: |
+            Max number of channels for each endpoint. Channels over
+            channel-count are activated when all the active channels have
+            channel-growth-threshold RPCs in flight.
+        defaultDescription: channel-count
+    channel-growth-threshold:
+        type: integer
+        description: |
+            Number of RPCs in flight per channel upon which one more channel
+            is activated, should be close to the server's max concurrent
+            streams limit
+        defaultDescription: 100
+    separate-channel-connections:
+        type: boolean
+        description: |
+            Whether each channel opens its own connections. By default the
+            channels to an endpoint share the connections via the gRPC
+            global subchannel pool
+        defaultDescription: false
     middlewares:
         type: array
         items:
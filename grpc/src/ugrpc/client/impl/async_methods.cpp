@@ -110,6 +110,7 @@ RpcData::RpcData(impl::CallParams&& params, CallKind call_kind)
       queue_(params.queue),
       config_values_(params.config),
       mws_(params.mws),
+      in_flight_(std::move(params.in_flight)),
       call_kind_(call_kind) {
   UASSERT(context_);
   UASSERT(!client_name_.empty());
@@ -25,7 +25,7 @@ CallParams CreateCallParams(const ClientData& client_data,
                             std::size_t method_id,
                             std::unique_ptr<grpc::ClientContext> client_context,
                             const dynamic_config::Key<ClientQos>& client_qos,
-                            const Qos& qos) {
+                            const Qos& qos, ChannelInFlightGuard&& in_flight) {
   const auto& metadata = client_data.GetMetadata();
   const auto call_name = metadata.method_full_names[method_id];
   const auto method_name =
@@ -48,13 +48,15 @@ CallParams CreateCallParams(const ClientData& client_data,
       std::move(client_context),
       client_data.GetStatistics(method_id),
       client_data.GetMiddlewares(),
+      std::move(in_flight),
   };
 }
 
 CallParams CreateGenericCallParams(
     const ClientData& client_data, std::string_view call_name,
     std::unique_ptr<grpc::ClientContext> client_context, const Qos& qos,
-    std::optional<std::string_view> metrics_call_name) {
+    std::optional<std::string_view> metrics_call_name,
+    ChannelInFlightGuard&& in_flight) {
   CheckValidCallName(call_name);
   if (metrics_call_name) {
     CheckValidCallName(*metrics_call_name);
@@ -71,6 +73,7 @@ CallParams CreateGenericCallParams(
       std::move(client_context),
       client_data.GetGenericStatistics(metrics_call_name.value_or(call_name)),
       client_data.GetMiddlewares(),
+      std::move(in_flight),
   };
 }
 
@@ -1,12 +1,17 @@
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
+#include <grpc/grpc.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 #include <ugrpc/impl/to_string.hpp>
 
@@ -14,6 +19,36 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+namespace {
+
+ChannelPoolSettings NormalizePoolSettings(ChannelPoolSettings settings) {
+  settings.max_channel_count =
+      std::max(settings.max_channel_count, settings.channel_count);
+  return settings;
+}
+
+}  // namespace
+
+ChannelInFlightGuard::ChannelInFlightGuard(
+    std::atomic<std::uint64_t>& in_flight) noexcept
+    : in_flight_(&in_flight) {
+  in_flight_->fetch_add(1, std::memory_order_relaxed);
+}
+
+ChannelInFlightGuard::ChannelInFlightGuard(
+    ChannelInFlightGuard&& other) noexcept
+    : in_flight_(std::exchange(other.in_flight_, nullptr)) {}
+
+ChannelInFlightGuard& ChannelInFlightGuard::operator=(
+    ChannelInFlightGuard&& other) noexcept {
+  std::swap(in_flight_, other.in_flight_);
+  return *this;
+}
+
+ChannelInFlightGuard::~ChannelInFlightGuard() {
+  if (in_flight_) in_flight_->fetch_sub(1, std::memory_order_relaxed);
+}
+
 ChannelCache::Token::Token(ChannelCache& cache, const std::string& endpoint,
                            CountedChannel& counted_channel) noexcept
     : cache_(&cache), endpoint_(&endpoint), counted_channel_(&counted_channel) {
@@ -47,33 +82,110 @@ const std::shared_ptr<grpc::Channel>& ChannelCache::Token::GetChannel(
     std::size_t index) const noexcept {
   UASSERT(counted_channel_);
   UASSERT(index < counted_channel_->channels.size());
-  return counted_channel_->channels[index];
+  return counted_channel_->channels[index].channel;
 }
 
 std::size_t ChannelCache::Token::GetChannelCount() const noexcept {
+  UASSERT(counted_channel_);
+  return counted_channel_->active_count.load(std::memory_order_acquire);
+}
+
+std::size_t ChannelCache::Token::GetMaxChannelCount() const noexcept {
   UASSERT(counted_channel_);
   return counted_channel_->channels.size();
 }
 
+std::size_t ChannelCache::Token::PickLeastLoadedChannel() const {
+  UASSERT(counted_channel_);
+  auto& counted_channel = *counted_channel_;
+  auto active_count =
+      counted_channel.active_count.load(std::memory_order_acquire);
+  UASSERT(active_count > 0);
+
+  // Start from a random channel, so that equally loaded channels are picked
+  // evenly
+  const auto start = utils::RandRange(active_count);
+  auto best_index = start;
+  auto best_in_flight =
+      counted_channel.channels[start].in_flight.load(std::memory_order_relaxed);
+  for (std::size_t i = 1; i < active_count && best_in_flight != 0; ++i) {
+    const auto index = (start + i) % active_count;
+    const auto in_flight = counted_channel.channels[index].in_flight.load(
+        std::memory_order_relaxed);
+    if (in_flight < best_in_flight) {
+      best_index = index;
+      best_in_flight = in_flight;
+    }
+  }
+
+  if (best_in_flight < counted_channel.growth_threshold ||
+      active_count == counted_channel.channels.size()) {
+    return best_index;
+  }
+
+  if (counted_channel.active_count.compare_exchange_strong(
+          active_count, active_count + 1, std::memory_order_acq_rel)) {
+    LOG_INFO() << "All " << active_count << " gRPC channels to '" << *endpoint_
+               << "' have at least " << counted_channel.growth_threshold
+               << " RPCs in flight, activating one more channel";
+    return active_count;
+  }
+  // Someone else has just activated a channel, it is the least loaded one
+  return active_count - 1;
+}
+
+ChannelInFlightGuard ChannelCache::Token::StartRpc(
+    std::size_t index) const noexcept {
+  UASSERT(counted_channel_);
+  UASSERT(index < counted_channel_->channels.size());
+  return ChannelInFlightGuard{counted_channel_->channels[index].in_flight};
+}
+
+std::uint64_t ChannelCache::Token::GetInFlight(
+    std::size_t index) const noexcept {
+  UASSERT(counted_channel_);
+  UASSERT(index < counted_channel_->channels.size());
+  return counted_channel_->channels[index].in_flight.load(
+      std::memory_order_relaxed);
+}
+
 ChannelCache::CountedChannel::CountedChannel(
     const std::string& endpoint,
     const std::shared_ptr<grpc::ChannelCredentials>& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t count) {
+    const grpc::ChannelArguments& channel_args,
+    const ChannelPoolSettings& pool_settings)
+    : channels(pool_settings.max_channel_count),
+      active_count(pool_settings.channel_count),
+      growth_threshold(pool_settings.growth_threshold) {
+  UASSERT(pool_settings.channel_count > 0);
+  UASSERT(pool_settings.channel_count <= pool_settings.max_channel_count);
+
+  // Channels with equal arguments share the connections via the global
+  // subchannel pool unless asked otherwise
+  auto pool_channel_args = channel_args;
+  if (pool_settings.separate_connections && channels.size() > 1) {
+    pool_channel_args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  }
+
+  // Inactive channels stay idle and do not connect until used
   const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
-  channels = utils::GenerateFixedArray(count, [&](std::size_t) {
-    return grpc::CreateCustomChannel(endpoint_string, credentials,
-                                     channel_args);
-  });
-  UASSERT(count > 0);
+  for (auto& state : channels) {
+    state.channel = grpc::CreateCustomChannel(endpoint_string, credentials,
+                                              pool_channel_args);
+  }
 }
 
 ChannelCache::ChannelCache(
     std::shared_ptr<grpc::ChannelCredentials>&& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t channel_count)
+    const grpc::ChannelArguments& channel_args,
+    const ChannelPoolSettings& pool_settings)
     : credentials_(std::move(credentials)),
       channel_args_(channel_args),
-      channel_count_(channel_count) {
-  UINVARIANT(channel_count > 0, "Channels count must be greater than zero");
+      pool_settings_(NormalizePoolSettings(pool_settings)) {
+  UINVARIANT(pool_settings.channel_count > 0,
+             "Channels count must be greater than zero");
+  UINVARIANT(pool_settings.growth_threshold > 0,
+             "Channel growth threshold must be greater than zero");
 }
 
 ChannelCache::~ChannelCache() = default;
@@ -81,10 +193,25 @@ ChannelCache::~ChannelCache() = default;
 ChannelCache::Token ChannelCache::Get(const std::string& endpoint) {
   auto channels = channels_.Lock();
   const auto [it, _] = channels->try_emplace(endpoint, endpoint, credentials_,
-                                             channel_args_, channel_count_);
+                                             channel_args_, pool_settings_);
   return {*this, it->first, it->second};
 }
 
+void ChannelCache::WriteStatistics(utils::statistics::Writer& writer) {
+  auto channels = channels_.Lock();
+  for (const auto& [endpoint, counted_channel] : *channels) {
+    const auto active_count =
+        counted_channel.active_count.load(std::memory_order_relaxed);
+    writer["active-channels"].ValueWithLabels(active_count,
+                                              {"grpc_endpoint", endpoint});
+    for (std::size_t i = 0; i < active_count; ++i) {
+      writer["in-flight"].ValueWithLabels(
+          counted_channel.channels[i].in_flight.load(std::memory_order_relaxed),
+          {{"grpc_endpoint", endpoint}, {"grpc_channel", std::to_string(i)}});
+    }
+  }
+}
+
 }  // namespace ugrpc::client::impl
 
 USERVER_NAMESPACE_END
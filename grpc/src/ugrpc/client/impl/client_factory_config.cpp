@@ -1,5 +1,9 @@
 #include <ugrpc/client/impl/client_factory_config.hpp>
 
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <userver/logging/level_serialization.hpp>
 #include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -68,6 +72,21 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
       value["native-log-level"].As<logging::Level>(config.native_log_level);
   config.channel_count =
       value["channel-count"].As<std::size_t>(config.channel_count);
+  config.max_channel_count =
+      value["max-channel-count"].As<std::size_t>(config.channel_count);
+  config.channel_growth_threshold =
+      value["channel-growth-threshold"].As<std::uint64_t>(
+          config.channel_growth_threshold);
+  config.separate_channel_connections =
+      value["separate-channel-connections"].As<bool>(
+          config.separate_channel_connections);
+
+  if (config.max_channel_count < config.channel_count) {
+    throw std::runtime_error(fmt::format(
+        "Invalid gRPC client factory config: max-channel-count ({}) is less "
+        "than channel-count ({})",
+        config.max_channel_count, config.channel_count));
+  }
 
   return config;
 }
@@ -95,6 +114,9 @@ ClientFactorySettings MakeFactorySettings(
       config.channel_args,
       config.native_log_level,
       config.channel_count,
+      config.max_channel_count,
+      config.channel_growth_threshold,
+      config.separate_channel_connections,
   };
 }
 
@@ -26,6 +26,16 @@ struct ClientFactoryConfig final {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// Max number of underlying channels, more channels than `channel_count`
+  /// are added on demand.
+  std::size_t max_channel_count{1};
+
+  /// Number of RPCs in flight per channel upon which more channels are added.
+  std::uint64_t channel_growth_threshold{100};
+
+  /// Whether each channel opens its own connections.
+  bool separate_channel_connections{false};
 };
 
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
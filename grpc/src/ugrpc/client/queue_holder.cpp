@@ -1,17 +1,19 @@
 #include <userver/ugrpc/client/queue_holder.hpp>
 
-#include <userver/ugrpc/impl/queue_runner.hpp>
-
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
 struct QueueHolder::Impl final {
+  explicit Impl(ugrpc::impl::QueuePollingMode polling_mode)
+      : queue_runner(queue, polling_mode) {}
+
   grpc::CompletionQueue queue;
-  ugrpc::impl::QueueRunner queue_runner{queue};
+  ugrpc::impl::QueueRunner queue_runner;
 };
 
-QueueHolder::QueueHolder() = default;
+QueueHolder::QueueHolder(ugrpc::impl::QueuePollingMode polling_mode)
+    : impl_(polling_mode) {}
 
 QueueHolder::~QueueHolder() = default;
 
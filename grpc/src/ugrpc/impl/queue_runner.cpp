@@ -1,7 +1,13 @@
 #include <userver/ugrpc/impl/queue_runner.hpp>
 
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/thread_name.hpp>
 
@@ -13,6 +19,15 @@ namespace ugrpc::impl {
 
 namespace {
 
+// Events handled in a row before letting other tasks of the task processor run
+constexpr std::size_t kMaxEventsPerYield = 64;
+
+void NotifyEvent(void* tag, bool ok) noexcept {
+  auto* call = static_cast<EventBase*>(tag);
+  UASSERT(call != nullptr);
+  call->Notify(ok);
+}
+
 void ProcessQueue(grpc::CompletionQueue& queue,
                   engine::SingleUseEvent& completion) noexcept {
   utils::SetCurrentThreadName("grpc-queue");
@@ -20,24 +35,136 @@ void ProcessQueue(grpc::CompletionQueue& queue,
   void* tag = nullptr;
   bool ok = false;
 
-  while (queue.Next(&tag, &ok)) {
-    auto* call = static_cast<EventBase*>(tag);
-    UASSERT(call != nullptr);
-    call->Notify(ok);
-  }
+  while (queue.Next(&tag, &ok)) NotifyEvent(tag, ok);
 
   completion.Send();
 }
 
 }  // namespace
 
-QueueRunner::QueueRunner(grpc::CompletionQueue& queue) : queue_(queue) {
-  std::thread([this] { ProcessQueue(queue_, completion_); }).detach();
+// Blocks in CompletionQueue::Next on behalf of the parked poller, so that an
+// idle queue is waited for instead of being polled. Only one of them takes
+// events from the queue at a time. The first event after the queue runs empty
+// is handed off across threads, as in kDedicatedThread mode.
+class QueueIdleWaiter final {
+ public:
+  QueueIdleWaiter(grpc::CompletionQueue& queue,
+                  engine::SingleUseEvent& completion)
+      : queue_(queue), completion_(completion) {
+    std::thread([this] { Run(); }).detach();
+  }
+
+  // Parks the poller until the queue gets an event or is shut down
+  void WaitForEvent() {
+    {
+      std::lock_guard lock{mutex_};
+      is_wait_requested_ = true;
+    }
+    cv_.notify_one();
+
+    // Not cancellable: the queue must be drained until the shutdown
+    const engine::TaskCancellationBlocker block_cancel;
+    [[maybe_unused]] const bool is_woken_up = wakeup_.WaitForEvent();
+    UASSERT(is_woken_up);
+  }
+
+  // Must only be called after the poller has seen the shutdown
+  void Stop() {
+    {
+      std::lock_guard lock{mutex_};
+      is_stopped_ = true;
+    }
+    cv_.notify_one();
+    completion_.WaitNonCancellable();
+  }
+
+ private:
+  void Run() noexcept {
+    utils::SetCurrentThreadName("grpc-queue");
+
+    while (true) {
+      {
+        std::unique_lock lock{mutex_};
+        cv_.wait(lock, [this] { return is_wait_requested_ || is_stopped_; });
+        if (is_stopped_) break;
+        is_wait_requested_ = false;
+      }
+
+      void* tag = nullptr;
+      bool ok = false;
+      // On shutdown the poller sees it in AsyncNext and stops
+      if (queue_.Next(&tag, &ok)) NotifyEvent(tag, ok);
+      wakeup_.Send();
+    }
+
+    completion_.Send();
+  }
+
+  grpc::CompletionQueue& queue_;
+  engine::SingleUseEvent& completion_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool is_wait_requested_{false};
+  bool is_stopped_{false};
+  engine::SingleConsumerEvent wakeup_;
+};
+
+namespace {
+
+void PollQueue(grpc::CompletionQueue& queue, QueueIdleWaiter& idle_waiter) {
+  const auto zero_deadline = gpr_time_0(GPR_CLOCK_MONOTONIC);
+
+  void* tag = nullptr;
+  bool ok = false;
+  std::size_t events_in_row = 0;
+
+  while (true) {
+    switch (queue.AsyncNext(&tag, &ok, zero_deadline)) {
+      case grpc::CompletionQueue::GOT_EVENT:
+        NotifyEvent(tag, ok);
+        if (++events_in_row == kMaxEventsPerYield) {
+          events_in_row = 0;
+          engine::Yield();
+        }
+        break;
+      case grpc::CompletionQueue::TIMEOUT:
+        // The queue is empty: park right away instead of polling it again
+        events_in_row = 0;
+        idle_waiter.WaitForEvent();
+        break;
+      case grpc::CompletionQueue::SHUTDOWN:
+        return;
+    }
+  }
+}
+
+}  // namespace
+
+QueueRunner::QueueRunner(grpc::CompletionQueue& queue, QueuePollingMode mode)
+    : queue_(queue) {
+  switch (mode) {
+    case QueuePollingMode::kDedicatedThread:
+      std::thread([this] { ProcessQueue(queue_, completion_); }).detach();
+      break;
+    case QueuePollingMode::kTaskProcessor:
+      idle_waiter_ = std::make_unique<QueueIdleWaiter>(queue_, completion_);
+      poller_.emplace(engine::CriticalAsyncNoSpan(
+          [this] { PollQueue(queue_, *idle_waiter_); }));
+      break;
+  }
 }
 
 QueueRunner::~QueueRunner() {
   queue_.Shutdown();
-  completion_.WaitNonCancellable();
+  if (poller_) {
+    {
+      const engine::TaskCancellationBlocker block_cancel;
+      poller_->Wait();
+    }
+    idle_waiter_->Stop();
+  } else {
+    completion_.WaitNonCancellable();
+  }
 }
 
 }  // namespace ugrpc::impl
@@ -47,6 +47,20 @@ void MethodStatistics::AccountDeadlinePropagated() noexcept {
 
 void MethodStatistics::AccountCancelled() noexcept { ++cancelled_; }
 
+void MethodStatistics::AccountSerializationOffload(
+    std::chrono::microseconds cpu_time) noexcept {
+  serialization_offload_us_.Add(utils::statistics::Rate{
+      static_cast<utils::statistics::Rate::ValueType>(cpu_time.count())});
+  ++serialization_offloaded_;
+}
+
+void MethodStatistics::AccountSerializationInline(std::size_t bytes) noexcept {
+  ++serialization_inline_;
+  serialization_inline_bytes_.Add(
+      utils::statistics::Rate{static_cast<utils::statistics::Rate::ValueType>(
+          bytes)});
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const MethodStatistics& stats) {
   writer = MethodStatisticsSnapshot{stats};
@@ -118,6 +132,15 @@ void DumpMetric(utils::statistics::Writer& writer,
 
   writer["deadline-propagated"] = stats.deadline_updated;
   writer["cancelled-by-deadline-propagation"] = deadline_cancelled_value;
+
+  // Only services with a serialization task processor account these
+  if (stats.serialization_offloaded || stats.serialization_inline) {
+    auto serialization = writer["serialization"];
+    serialization["cpu-time-us"]["offload"] = stats.serialization_offload_us;
+    serialization["offloaded"] = stats.serialization_offloaded;
+    serialization["inline"] = stats.serialization_inline;
+    serialization["bytes"]["inline"] = stats.serialization_inline_bytes;
+  }
 }
 
 MethodStatisticsSnapshot::MethodStatisticsSnapshot(
@@ -134,7 +157,11 @@ MethodStatisticsSnapshot::MethodStatisticsSnapshot(
       internal_errors(stats.internal_errors_.Load()),
       cancelled(stats.cancelled_.Load()),
       deadline_updated(stats.deadline_updated_.Load()),
-      deadline_cancelled(stats.deadline_cancelled_.Load()) {
+      deadline_cancelled(stats.deadline_cancelled_.Load()),
+      serialization_offload_us(stats.serialization_offload_us_.Load()),
+      serialization_offloaded(stats.serialization_offloaded_.Load()),
+      serialization_inline(stats.serialization_inline_.Load()),
+      serialization_inline_bytes(stats.serialization_inline_bytes_.Load()) {
   // For the 'active' metric, it is important to load the 'started' value after
   // loading the 'started_renamed' and 'total_requests' values.
   // More details in DumpMetric for MethodStatisticsSnapshot
@@ -153,6 +180,10 @@ void MethodStatisticsSnapshot::Add(const MethodStatisticsSnapshot& other) {
   cancelled += other.cancelled;
   deadline_updated += other.deadline_updated;
   deadline_cancelled += other.deadline_cancelled;
+  serialization_offload_us += other.serialization_offload_us;
+  serialization_offloaded += other.serialization_offloaded;
+  serialization_inline += other.serialization_inline;
+  serialization_inline_bytes += other.serialization_inline_bytes;
 }
 
 void DumpMetricWithLabels(utils::statistics::Writer& writer,
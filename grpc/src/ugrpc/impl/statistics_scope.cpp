@@ -24,6 +24,15 @@ void RpcStatisticsScope::OnNetworkError() {
   finish_kind_ = std::max(finish_kind_, FinishKind::kNetworkError);
 }
 
+void RpcStatisticsScope::OnSerializationOffload(
+    std::chrono::microseconds cpu_time) {
+  statistics_->AccountSerializationOffload(cpu_time);
+}
+
+void RpcStatisticsScope::OnSerializationInline(std::size_t bytes) {
+  statistics_->AccountSerializationInline(bytes);
+}
+
 void RpcStatisticsScope::OnCancelledByDeadlinePropagation() {
   finish_kind_ = std::max(finish_kind_, FinishKind::kDeadlinePropagation);
 }
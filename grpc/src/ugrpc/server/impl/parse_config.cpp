@@ -6,6 +6,7 @@
 #include <userver/logging/level_serialization.hpp>
 #include <userver/logging/null_logger.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 #include <userver/ugrpc/server/middlewares/base.hpp>
 
@@ -17,6 +18,11 @@ namespace {
 
 constexpr std::string_view kTaskProcessorKey = "task-processor";
 constexpr std::string_view kMiddlewaresKey = "middlewares";
+constexpr std::string_view kUseArenaKey = "use-arena";
+constexpr std::string_view kSerializationTaskProcessorKey =
+    "serialization-task-processor";
+constexpr std::string_view kSerializationOffloadMinSizeKey =
+    "serialization-offload-min-size";
 
 template <typename ParserFunc>
 auto ParseOptional(const yaml_config::YamlConfig& service_field,
@@ -53,6 +59,24 @@ std::vector<std::string> ParseMiddlewares(
   return field.As<std::vector<std::string>>();
 }
 
+bool ParseUseArena(const yaml_config::YamlConfig& field,
+                   const components::ComponentContext& /*context*/) {
+  return field.As<bool>(false);
+}
+
+engine::TaskProcessor* ParseSerializationTaskProcessor(
+    const yaml_config::YamlConfig& field,
+    const components::ComponentContext& context) {
+  if (field.IsMissing()) return nullptr;
+  return &context.GetTaskProcessor(field.As<std::string>());
+}
+
+std::size_t ParseSerializationOffloadMinSize(
+    const yaml_config::YamlConfig& field,
+    const components::ComponentContext& /*context*/) {
+  return field.As<std::size_t>(server::kDefaultSerializationOffloadMinSize);
+}
+
 Middlewares FindMiddlewares(const std::vector<std::string>& names,
                             const components::ComponentContext& context) {
   return utils::AsContainer<Middlewares>(
@@ -62,6 +86,18 @@ Middlewares FindMiddlewares(const std::vector<std::string>& names,
       }));
 }
 
+ugrpc::impl::QueuePollingMode ParseQueuePollingMode(
+    const yaml_config::YamlConfig& value) {
+  constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(ugrpc::impl::QueuePollingMode::kDedicatedThread, "thread")
+        .Case(ugrpc::impl::QueuePollingMode::kTaskProcessor, "task-processor");
+  });
+
+  if (value.IsMissing()) return ugrpc::impl::QueuePollingMode::kDedicatedThread;
+  return utils::ParseFromValueString(value, kMap);
+}
+
 }  // namespace
 
 ServiceDefaults ParseServiceDefaults(
@@ -72,6 +108,13 @@ ServiceDefaults ParseServiceDefaults(
                                        ParseTaskProcessor),
       /*middleware_names=*/
       ParseOptional(value[kMiddlewaresKey], context, ParseMiddlewares),
+      /*use_arena=*/ParseOptional(value[kUseArenaKey], context, ParseUseArena),
+      /*serialization_task_processor=*/
+      ParseOptional(value[kSerializationTaskProcessorKey], context,
+                    ParseSerializationTaskProcessor),
+      /*serialization_offload_min_size=*/
+      ParseOptional(value[kSerializationOffloadMinSizeKey], context,
+                    ParseSerializationOffloadMinSize),
   };
 }
 
@@ -88,6 +131,17 @@ server::ServiceConfig ParseServiceConfig(
           MergeField(value[kMiddlewaresKey], defaults.middleware_names, context,
                      ParseMiddlewares),
           context),
+      /*use_arena=*/
+      MergeField(value[kUseArenaKey], defaults.use_arena, context,
+                 ParseUseArena),
+      /*serialization_task_processor=*/
+      MergeField(value[kSerializationTaskProcessorKey],
+                 defaults.serialization_task_processor, context,
+                 ParseSerializationTaskProcessor),
+      /*serialization_offload_min_size=*/
+      MergeField(value[kSerializationOffloadMinSizeKey],
+                 defaults.serialization_offload_min_size, context,
+                 ParseSerializationOffloadMinSize),
   };
 }
 
@@ -98,6 +152,8 @@ ServerConfig ParseServerConfig(const yaml_config::YamlConfig& value,
       value["unix-socket-path"].As<std::optional<std::string>>();
   config.port = value["port"].As<std::optional<int>>();
   config.completion_queue_num = value["completion-queue-count"].As<int>(2);
+  config.completion_queue_polling =
+      ParseQueuePollingMode(value["completion-queue-polling"]);
   config.channel_args =
       value["channel-args"].As<decltype(config.channel_args)>({});
   config.native_log_level =
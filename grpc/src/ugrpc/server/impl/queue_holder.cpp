@@ -4,7 +4,6 @@
 
 #include <grpcpp/server_builder.h>
 
-#include <userver/ugrpc/impl/queue_runner.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fixed_array.hpp>
 
@@ -15,19 +14,22 @@ namespace ugrpc::server::impl {
 namespace {
 
 struct QueueSubHolder final {
-  explicit QueueSubHolder(std::unique_ptr<grpc::ServerCompletionQueue> queue)
-      : queue(std::move(queue)) {}
+  QueueSubHolder(std::unique_ptr<grpc::ServerCompletionQueue> queue,
+                 ugrpc::impl::QueuePollingMode polling_mode)
+      : queue(std::move(queue)), queue_runner(*this->queue, polling_mode) {}
 
   std::unique_ptr<grpc::ServerCompletionQueue> queue;
-  ugrpc::impl::QueueRunner queue_runner{*queue};
+  ugrpc::impl::QueueRunner queue_runner;
 };
 
 }  // namespace
 
 struct QueueHolder::Impl final {
-  explicit Impl(std::size_t num, grpc::ServerBuilder& server_builder)
-      : queue(utils::GenerateFixedArray(num, [&server_builder](size_t) {
-          return QueueSubHolder(server_builder.AddCompletionQueue());
+  Impl(std::size_t num, grpc::ServerBuilder& server_builder,
+       ugrpc::impl::QueuePollingMode polling_mode)
+      : queue(utils::GenerateFixedArray(num, [&](size_t) {
+          return QueueSubHolder(server_builder.AddCompletionQueue(),
+                                polling_mode);
         })) {
     for (auto& subholder : queue)
       queues.queues.push_back(subholder.queue.get());
@@ -37,8 +39,9 @@ struct QueueHolder::Impl final {
   ugrpc::impl::CompletionQueues queues;
 };
 
-QueueHolder::QueueHolder(std::size_t num, grpc::ServerBuilder& server_builder)
-    : impl_(num, server_builder) {}
+QueueHolder::QueueHolder(std::size_t num, grpc::ServerBuilder& server_builder,
+                         ugrpc::impl::QueuePollingMode polling_mode)
+    : impl_(num, server_builder, polling_mode) {}
 
 QueueHolder::~QueueHolder() = default;
 
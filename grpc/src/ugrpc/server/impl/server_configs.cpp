@@ -1,14 +1,83 @@
 #include "server_configs.hpp"
 
+#include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server::impl {
 
+namespace {
+
+constexpr utils::TrivialBiMap kCompressionAlgorithms = [](auto selector) {
+  return selector()
+      .Case(GRPC_COMPRESS_NONE, "none")
+      .Case(GRPC_COMPRESS_DEFLATE, "deflate")
+      .Case(GRPC_COMPRESS_GZIP, "gzip");
+};
+
+constexpr utils::TrivialBiMap kCompressionLevels = [](auto selector) {
+  return selector()
+      .Case(GRPC_COMPRESS_LEVEL_NONE, "none")
+      .Case(GRPC_COMPRESS_LEVEL_LOW, "low")
+      .Case(GRPC_COMPRESS_LEVEL_MED, "medium")
+      .Case(GRPC_COMPRESS_LEVEL_HIGH, "high");
+};
+
+}  // namespace
+
 const dynamic_config::Key<bool> kServerCancelTaskByDeadline{
     "USERVER_GRPC_SERVER_CANCEL_TASK_BY_DEADLINE", true};
 
+bool CompressionSettings::IsEnabled() const noexcept {
+  return (algorithm && *algorithm != GRPC_COMPRESS_NONE) ||
+         (level && *level != GRPC_COMPRESS_LEVEL_NONE);
+}
+
+CompressionSettings Parse(const formats::json::Value& value,
+                          formats::parse::To<CompressionSettings>) {
+  CompressionSettings settings;
+  if (const auto algorithm = value["algorithm"]; !algorithm.IsMissing()) {
+    settings.algorithm =
+        utils::ParseFromValueString(algorithm, kCompressionAlgorithms);
+  }
+  if (const auto level = value["level"]; !level.IsMissing()) {
+    settings.level = utils::ParseFromValueString(level, kCompressionLevels);
+  }
+  if (settings.algorithm && settings.level) {
+    throw formats::json::ParseException(
+        "Only one of 'algorithm' and 'level' may be set for gRPC compression");
+  }
+  settings.min_size = value["min-size"].As<std::size_t>(settings.min_size);
+  return settings;
+}
+
+const dynamic_config::Key<ServerCompression> kServerCompression{
+    "USERVER_GRPC_SERVER_COMPRESSION",
+    dynamic_config::DefaultAsJsonString{R"({"__default__": {}})"},
+};
+
+const dynamic_config::Key<ServerAdaptiveConcurrency>
+    kServerAdaptiveConcurrency{
+        "USERVER_GRPC_SERVER_ADAPTIVE_CONCURRENCY",
+        dynamic_config::DefaultAsJsonString{
+            R"({"__default__": {"enabled": false}})"},
+    };
+
+const CompressionSettings& FindCompressionSettings(
+    const ServerCompression& config, std::string_view call_name,
+    std::string_view service_name) {
+  static const CompressionSettings kNoCompression{};
+
+  if (config.HasValue(call_name)) return config[call_name];
+  if (config.HasValue(service_name) || config.HasDefaultValue()) {
+    return config[service_name];
+  }
+  return kNoCompression;
+}
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include <grpc/compression.h>
+
+#include <userver/congestion_control/adaptive_limiter.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/dynamic_config/value.hpp>
+#include <userver/formats/json_fwd.hpp>
+#include <userver/formats/parse/to.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,6 +18,42 @@ namespace ugrpc::server::impl {
 
 extern const dynamic_config::Key<bool> kServerCancelTaskByDeadline;
 
+/// Compression of the response messages of an RPC. Either the algorithm or
+/// the level is set, the level lets gRPC pick an algorithm supported by the
+/// client.
+struct CompressionSettings final {
+  std::optional<grpc_compression_algorithm> algorithm;
+  std::optional<grpc_compression_level> level;
+
+  /// Messages smaller than that are sent uncompressed. A non-zero value
+  /// costs an extra ByteSizeLong call per response.
+  std::size_t min_size{0};
+
+  bool IsEnabled() const noexcept;
+};
+
+CompressionSettings Parse(const formats::json::Value& value,
+                          formats::parse::To<CompressionSettings>);
+
+/// Settings by `full.path.ServiceName/MethodName` or `full.path.ServiceName`
+using ServerCompression = dynamic_config::ValueDict<CompressionSettings>;
+
+extern const dynamic_config::Key<ServerCompression> kServerCompression;
+
+/// Settings for the method if any, then for the service, then the default ones
+const CompressionSettings& FindCompressionSettings(
+    const ServerCompression& config, std::string_view call_name,
+    std::string_view service_name);
+
+/// Adaptive concurrency limits by `full.path.ServiceName/MethodName` or
+/// `full.path.ServiceName`. Each method with its own settings gets its own
+/// limiter, other methods share a limiter per service.
+using ServerAdaptiveConcurrency =
+    dynamic_config::ValueDict<congestion_control::AdaptiveConcurrencyConfig>;
+
+extern const dynamic_config::Key<ServerAdaptiveConcurrency>
+    kServerAdaptiveConcurrency;
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,9 @@ struct ServiceDefaults final {
   // using boost::optional to easily generalize to references
   boost::optional<engine::TaskProcessor&> task_processor;
   boost::optional<std::vector<std::string>> middleware_names;
+  boost::optional<bool> use_arena;
+  boost::optional<engine::TaskProcessor*> serialization_task_processor;
+  boost::optional<std::size_t> serialization_offload_min_size;
 };
 
 }  // namespace ugrpc::server::impl
@@ -20,6 +20,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server::impl {
 
+google::protobuf::ArenaOptions MakeArenaOptions() {
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = kArenaStartBlockSize;
+  return options;
+}
+
 void ReportHandlerError(
     const std::exception& ex, std::string_view call_name, tracing::Span& span,
     ugrpc::impl::RpcStatisticsScope& statistics_scope) noexcept {
@@ -119,6 +125,25 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                              ugrpc::impl::ToGrpcString(span.GetLink()));
 }
 
+ResponseWriteSettings MakeResponseWriteSettings(
+    const dynamic_config::Snapshot& config, std::string_view call_name,
+    std::string_view service_name, const ServiceSettings& settings) {
+  ResponseWriteSettings write_settings;
+  write_settings.serialization_task_processor =
+      settings.serialization_task_processor;
+  write_settings.serialization_offload_min_size =
+      settings.serialization_offload_min_size;
+
+  const auto& compression = FindCompressionSettings(
+      config[kServerCompression], call_name, service_name);
+  if (compression.IsEnabled()) {
+    write_settings.compression_algorithm = compression.algorithm;
+    write_settings.compression_level = compression.level;
+    write_settings.compression_min_size = compression.min_size;
+  }
+  return write_settings;
+}
+
 void ParseGenericCallName(std::string_view generic_call_name,
                           std::string_view& call_name,
                           std::string_view& service_name,
@@ -134,6 +159,22 @@ void ParseGenericCallName(std::string_view generic_call_name,
   method_name = generic_call_name.substr(slash_pos + 1);
 }
 
+std::vector<MiddlewareMethodStates> MakeMiddlewareMethodStates(
+    const Middlewares& middlewares,
+    const ugrpc::impl::StaticServiceMetadata& metadata) {
+  std::vector<MiddlewareMethodStates> states;
+  states.reserve(metadata.method_full_names.size());
+  for (const auto call_name : metadata.method_full_names) {
+    auto& method_states = states.emplace_back();
+    method_states.reserve(middlewares.size());
+    for (const auto& middleware : middlewares) {
+      method_states.push_back(
+          middleware->MakeMethodState(call_name, metadata.service_full_name));
+    }
+  }
+  return states;
+}
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
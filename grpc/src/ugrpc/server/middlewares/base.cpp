@@ -1,5 +1,7 @@
 #include <userver/ugrpc/server/middlewares/base.hpp>
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::server {
@@ -9,16 +11,19 @@ MiddlewareBase::MiddlewareBase() = default;
 MiddlewareBase::~MiddlewareBase() = default;
 
 MiddlewareCallContext::MiddlewareCallContext(
-    const Middlewares& middlewares, CallAnyBase& call,
-    utils::function_ref<void()> user_call,
+    const Middlewares& middlewares, const MiddlewareMethodStates& method_states,
+    CallAnyBase& call, utils::function_ref<void()> user_call,
     const dynamic_config::Snapshot& config,
     ::google::protobuf::Message* request)
     : middleware_(middlewares.begin()),
       middleware_end_(middlewares.end()),
+      method_state_(method_states.begin()),
       user_call_(std::move(user_call)),
       call_(call),
       config_(config),
-      request_(request) {}
+      request_(request) {
+  UASSERT(middlewares.size() == method_states.size());
+}
 
 void MiddlewareCallContext::Next() {
   if (is_called_from_handle_) {
@@ -27,6 +32,7 @@ void MiddlewareCallContext::Next() {
       (*middleware_)->CallRequestHook(*this, *request_);
     }
     ++middleware_;
+    ++method_state_;
   }
   if (middleware_ == middleware_end_) {
     ClearMiddlewaresResources();
@@ -50,12 +56,22 @@ const dynamic_config::Snapshot& MiddlewareCallContext::GetInitialDynamicConfig()
   return config_.value();
 }
 
+const utils::AnyMovable& MiddlewareCallContext::GetMethodState() const {
+  UASSERT(middleware_ != middleware_end_);
+  return *method_state_;
+}
+
 void MiddlewareBase::CallRequestHook(const MiddlewareCallContext&,
                                      google::protobuf::Message&) {}
 
 void MiddlewareBase::CallResponseHook(const MiddlewareCallContext&,
                                       google::protobuf::Message&) {}
 
+utils::AnyMovable MiddlewareBase::MakeMethodState(std::string_view,
+                                                  std::string_view) const {
+  return {};
+}
+
 }  // namespace ugrpc::server
 
 USERVER_NAMESPACE_END
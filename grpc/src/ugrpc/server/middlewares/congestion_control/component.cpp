@@ -3,6 +3,7 @@
 #include <ugrpc/server/middlewares/congestion_control/middleware.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
 #include <userver/congestion_control/component.hpp>
 #include <userver/ugrpc/server/server_component.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
@@ -24,8 +25,18 @@ Component::Component(const components::ComponentConfig& config,
   auto& server = context.FindComponent<ServerComponent>().GetServer();
   auto& server_sensor = cc_component.GetServerSensor();
   server_sensor.RegisterRequestsSource(server);
+
+  statistics_holder_ =
+      context.FindComponent<components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("grpc.server.adaptive-concurrency",
+                          [this](utils::statistics::Writer& writer) {
+                            middleware_->WriteStatistics(writer);
+                          });
 }
 
+Component::~Component() { statistics_holder_.Unregister(); }
+
 std::shared_ptr<MiddlewareBase> Component::GetMiddleware() {
   return middleware_;
 }
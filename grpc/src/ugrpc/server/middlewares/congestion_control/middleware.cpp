@@ -1,6 +1,10 @@
 #include "middleware.hpp"
 
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
 #include <ugrpc/impl/rpc_metadata.hpp>
+#include <ugrpc/server/impl/server_configs.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,6 +27,20 @@ bool CheckRatelimit(utils::TokenBucket& rate_limit,
   return false;
 }
 
+void RejectCall(MiddlewareCallContext& context, const char* message) {
+  auto& call = context.GetCall();
+  auto& server_context = call.GetContext();
+
+  server_context.AddInitialMetadata(ugrpc::impl::kXYaTaxiRatelimitedBy,
+                                    ugrpc::impl::kHostname);
+  server_context.AddInitialMetadata(
+      ugrpc::impl::kXYaTaxiRatelimitReason,
+      ugrpc::impl::kCongestionControlRatelimitReason);
+
+  call.FinishWithError(
+      grpc::Status{grpc::StatusCode::RESOURCE_EXHAUSTED, message});
+}
+
 }  // namespace
 
 void Middleware::SetLimit(std::optional<size_t> new_limit) {
@@ -41,25 +59,92 @@ void Middleware::SetLimit(std::optional<size_t> new_limit) {
   }
 }
 
+utils::AnyMovable Middleware::MakeMethodState(std::string_view call_name,
+                                              std::string_view) const {
+  return utils::AnyMovable{std::in_place_type<MethodState>, call_name};
+}
+
 void Middleware::Handle(MiddlewareCallContext& context) const {
   auto& call = context.GetCall();
 
-  if (!CheckRatelimit(rate_limit_, context.GetCall().GetCallName())) {
-    auto& server_context = context.GetCall().GetContext();
+  if (!CheckRatelimit(rate_limit_, call.GetCallName())) {
+    RejectCall(context, "Congestion control: rate limit exceeded");
+    return;
+  }
 
-    server_context.AddInitialMetadata(ugrpc::impl::kXYaTaxiRatelimitedBy,
-                                      ugrpc::impl::kHostname);
-    server_context.AddInitialMetadata(
-        ugrpc::impl::kXYaTaxiRatelimitReason,
-        ugrpc::impl::kCongestionControlRatelimitReason);
+  const auto& adaptive_concurrency =
+      context.GetInitialDynamicConfig()[impl::kServerAdaptiveConcurrency];
+  const auto call_name = call.GetCallName();
+  const auto service_name = call.GetServiceName();
+
+  // Calls of a generic service share a single state, and its names are fake
+  const auto* state = utils::AnyCast<MethodState>(&context.GetMethodState());
+  if (state && state->call_name != call_name) state = nullptr;
+
+  if (adaptive_concurrency.HasValue(call_name)) {
+    HandleWithAdaptiveConcurrency(context, call_name,
+                                  adaptive_concurrency[call_name],
+                                  state ? &state->method_limiter : nullptr);
+  } else if (adaptive_concurrency.HasValue(service_name) ||
+             adaptive_concurrency.HasDefaultValue()) {
+    HandleWithAdaptiveConcurrency(context, service_name,
+                                  adaptive_concurrency[service_name],
+                                  state ? &state->service_limiter : nullptr);
+  } else {
+    context.Next();
+  }
+}
 
-    call.FinishWithError(
-        grpc::Status{grpc::StatusCode::RESOURCE_EXHAUSTED,
-                     "Congestion control: rate limit exceeded"});
+void Middleware::HandleWithAdaptiveConcurrency(
+    MiddlewareCallContext& context, std::string_view limiter_name,
+    const AdaptiveConcurrencyConfig& config,
+    std::atomic<AdaptiveLimiter*>* cached_limiter) const {
+  if (!config.enabled) {
+    context.Next();
+    return;
+  }
+
+  auto* limiter = cached_limiter
+                      ? cached_limiter->load(std::memory_order_acquire)
+                      : nullptr;
+  if (!limiter) {
+    limiter = GetAdaptiveLimiter(limiter_name, config).get();
+    if (cached_limiter) {
+      cached_limiter->store(limiter, std::memory_order_release);
+    }
+  }
+
+  auto token = limiter->TryAcquire(config);
+  if (!token) {
+    LOG_LIMITED_WARNING() << "Request throttled (adaptive concurrency limit "
+                          << limiter->GetLimit() << " of '" << limiter_name
+                          << "', via USERVER_GRPC_SERVER_ADAPTIVE_CONCURRENCY)";
+    RejectCall(context, "Congestion control: concurrency limit exceeded");
     return;
   }
 
   context.Next();
+
+  // Deadline propagation cancels the task once the deadline expires
+  if (engine::current_task::ShouldCancel()) {
+    token->OnDropped();
+  } else {
+    token->OnSuccess();
+  }
+}
+
+std::shared_ptr<Middleware::AdaptiveLimiter> Middleware::GetAdaptiveLimiter(
+    std::string_view limiter_name,
+    const AdaptiveConcurrencyConfig& config) const {
+  std::string name{limiter_name};
+  if (auto limiter = adaptive_limiters_.Get(name)) return limiter;
+  return adaptive_limiters_.TryEmplace(name, config).value;
+}
+
+void Middleware::WriteStatistics(utils::statistics::Writer& writer) const {
+  for (const auto& [name, limiter] : adaptive_limiters_) {
+    writer.ValueWithLabels(*limiter, {"grpc_destination", name});
+  }
 }
 
 }  // namespace ugrpc::server::middlewares::congestion_control
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/congestion_control/adaptive_limiter.hpp>
+#include <userver/rcu/rcu_map.hpp>
 #include <userver/server/congestion_control/limiter.hpp>
 #include <userver/ugrpc/server/middlewares/base.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/token_bucket.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,8 +24,38 @@ class Middleware final
 
   void SetLimit(std::optional<size_t> new_limit) override;
 
+  utils::AnyMovable MakeMethodState(
+      std::string_view call_name,
+      std::string_view service_name) const override;
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
  private:
+  using AdaptiveLimiter = USERVER_NAMESPACE::congestion_control::AdaptiveLimiter;
+  using AdaptiveConcurrencyConfig =
+      USERVER_NAMESPACE::congestion_control::AdaptiveConcurrencyConfig;
+
+  // Limiters of a method, resolved on the first call that needs them. They
+  // are owned by adaptive_limiters_, which never drops them.
+  struct MethodState final {
+    explicit MethodState(std::string_view call_name) : call_name(call_name) {}
+
+    const std::string_view call_name;
+    mutable std::atomic<AdaptiveLimiter*> method_limiter{nullptr};
+    mutable std::atomic<AdaptiveLimiter*> service_limiter{nullptr};
+  };
+
+  void HandleWithAdaptiveConcurrency(
+      MiddlewareCallContext& context, std::string_view limiter_name,
+      const AdaptiveConcurrencyConfig& config,
+      std::atomic<AdaptiveLimiter*>* cached_limiter) const;
+
+  std::shared_ptr<AdaptiveLimiter> GetAdaptiveLimiter(
+      std::string_view limiter_name,
+      const AdaptiveConcurrencyConfig& config) const;
+
   mutable utils::TokenBucket rate_limit_{utils::TokenBucket::MakeUnbounded()};
+  mutable rcu::RcuMap<std::string, AdaptiveLimiter> adaptive_limiters_;
 };
 
 }  // namespace ugrpc::server::middlewares::congestion_control
@@ -1,11 +1,15 @@
 #include <userver/ugrpc/server/rpc.hpp>
 
+#include <ctime>
+
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
 #include <fmt/format.h>
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <userver/compiler/thread_local.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
@@ -73,6 +77,21 @@ std::string_view GetCurrentTimeString(
   return std::string_view{cache->cached_time_string, kTimeTemplate.size()};
 }
 
+// The task does not suspend while serializing, so it stays on the same thread
+std::chrono::microseconds GetThreadCpuTime() noexcept {
+  struct timespec ts {};
+  ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds{ts.tv_sec} +
+         std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::nanoseconds{ts.tv_nsec});
+}
+
+std::chrono::microseconds MeasureCpuTime(utils::function_ref<void()> func) {
+  const auto start = GetThreadCpuTime();
+  func();
+  return GetThreadCpuTime() - start;
+}
+
 }  // namespace
 
 namespace impl {
@@ -173,6 +192,65 @@ void CallAnyBase::RunMiddlewarePipeline(
   md_call_context.Next();
 }
 
+// ByteSizeLong walks the whole message, and grpcpp does it once more to
+// serialize it, so the size is only computed if some threshold needs it
+bool CallAnyBase::NeedsResponseSize() const noexcept {
+  const auto& settings = params_.write_settings;
+  return (settings.IsCompressionEnabled() &&
+          settings.compression_min_size > 0) ||
+         (settings.serialization_task_processor != nullptr &&
+          settings.serialization_offload_min_size > 0);
+}
+
+bool CallAnyBase::ShouldCompress(std::size_t size) const noexcept {
+  const auto& settings = params_.write_settings;
+  return settings.IsCompressionEnabled() &&
+         size >= settings.compression_min_size;
+}
+
+void CallAnyBase::EnableCompression() {
+  const auto& settings = params_.write_settings;
+  if (is_compression_enabled_ || !settings.IsCompressionEnabled()) return;
+  is_compression_enabled_ = true;
+
+  if (settings.compression_algorithm) {
+    params_.context.set_compression_algorithm(*settings.compression_algorithm);
+  } else {
+    // The algorithm is then picked among the ones the client accepts
+    params_.context.set_compression_level(*settings.compression_level);
+  }
+}
+
+void CallAnyBase::DisableCompressionIfSmall(
+    std::size_t size, grpc::WriteOptions& write_options) const {
+  if (is_compression_enabled_ && !ShouldCompress(size)) {
+    write_options.set_no_compression();
+  }
+}
+
+void CallAnyBase::StartWrite(std::size_t size,
+                             utils::function_ref<void()> start) {
+  auto* const task_processor =
+      params_.write_settings.serialization_task_processor;
+  if (!task_processor) {
+    start();
+    return;
+  }
+
+  if (size < params_.write_settings.serialization_offload_min_size) {
+    start();
+    params_.statistics.OnSerializationInline(size);
+    return;
+  }
+
+  // 'start' references the stack of the current task, so it must not be
+  // abandoned
+  const engine::TaskCancellationBlocker block_cancel;
+  const auto cpu_time =
+      engine::AsyncNoSpan(*task_processor, MeasureCpuTime, start).Get();
+  params_.statistics.OnSerializationOffload(cpu_time);
+}
+
 std::string_view CallAnyBase::GetServiceName() const {
   return params_.service_name;
 }
@@ -149,7 +149,7 @@ Server::Impl::Impl(ServerConfig&& config,
   server_builder_.emplace();
   ApplyChannelArgs(*server_builder_, config);
   queue_.emplace(static_cast<std::size_t>(config.completion_queue_num),
-                 std::ref(*server_builder_));
+                 std::ref(*server_builder_), config.completion_queue_polling);
 
   if (config.unix_socket_path) AddListeningUnixSocket(*config.unix_socket_path);
 
@@ -204,6 +204,9 @@ impl::ServiceSettings Server::Impl::MakeServiceSettings(
       std::move(config.middlewares),
       access_tskv_logger_,
       config_source_,
+      config.use_arena,
+      config.serialization_task_processor,
+      config.serialization_offload_min_size,
   };
 }
 
@@ -54,6 +54,19 @@ properties:
             completion queue count to create. Should be ~2 times less than worker
             threads for best RPS.
         minimum: 1
+    completion-queue-polling:
+        type: string
+        description: |
+            how the completion queues are polled: 'thread' - by a dedicated
+            thread per queue, 'task-processor' - by a task per queue on the
+            main task processor, without a cross-thread handoff per event
+            while the queue is non-empty; the task parks once the queue is
+            empty and a helper thread per queue waits for the next event, so
+            this mode also costs one thread per queue
+        defaultDescription: thread
+        enum:
+          - thread
+          - task-processor
     channel-args:
         type: object
         description: a map of channel arguments, see gRPC Core docs
@@ -94,6 +107,16 @@ properties:
                 items:
                     type: string
                     description: middleware component name
+            use-arena:
+                type: boolean
+                description: allocate the request of each RPC on a per-call protobuf arena
+            serialization-task-processor:
+                type: string
+                description: the task processor to serialize and compress large responses on
+                defaultDescription: responses are serialized on task-processor without offloading
+            serialization-offload-min-size:
+                type: integer
+                description: min size of a response to serialize it on serialization-task-processor
 )");
 }
 
@@ -47,6 +47,18 @@ properties:
         items:
             type: string
             description: middleware component name
+    use-arena:
+        type: boolean
+        description: allocate the request of each RPC on a per-call protobuf arena
+        defaultDescription: uses grpc-server.service-defaults.use-arena or false
+    serialization-task-processor:
+        type: string
+        description: the task processor to serialize and compress large responses on
+        defaultDescription: grpc-server.service-defaults.serialization-task-processor if set, otherwise the responses are serialized on task-processor without offloading
+    serialization-offload-min-size:
+        type: integer
+        description: min size of a response to serialize it on serialization-task-processor
+        defaultDescription: 65536
 )");
 }
 
@@ -35,6 +35,7 @@ server::ServiceConfig ServiceBase::MakeServiceConfig() {
   return server::ServiceConfig{
       engine::current_task::GetTaskProcessor(),
       server_middlewares_,
+      /*use_arena=*/false,
   };
 }
 
@@ -0,0 +1,80 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+
+#include <tests/nested_messages_client.usrv.pb.hpp>
+#include <tests/nested_messages_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class NestedMessagesService final
+    : public sample::ugrpc::NestedMessagesServiceBase {
+ public:
+  void Echo(EchoCall& call, sample::ugrpc::NestedBatch&& request) override {
+    auto* arena = call.GetArena();
+    EXPECT_EQ(request.GetArena(), arena);
+
+    if (arena) {
+      auto* response =
+          google::protobuf::Arena::CreateMessage<sample::ugrpc::NestedBatch>(
+              arena);
+      response->Swap(&request);
+      call.Finish(*response);
+    } else {
+      call.Finish(request);
+    }
+  }
+};
+
+class NestedMessagesServer final : public ugrpc::tests::ServiceBase {
+ public:
+  explicit NestedMessagesServer(bool use_arena) {
+    GetServer().AddService(
+        service_, ugrpc::server::ServiceConfig{
+                      engine::current_task::GetTaskProcessor(),
+                      /*middlewares=*/{},
+                      use_arena,
+                  });
+    StartServer();
+  }
+
+  ~NestedMessagesServer() override { StopServer(); }
+
+ private:
+  NestedMessagesService service_;
+};
+
+void CheckEcho(NestedMessagesServer& server) {
+  auto client =
+      server.MakeClient<sample::ugrpc::NestedMessagesServiceClient>();
+
+  sample::ugrpc::NestedBatch request;
+  for (int i = 0; i < 10; ++i) {
+    auto& item = *request.add_items();
+    item.set_id(i);
+    item.set_name("name");
+    item.add_tags("tag");
+  }
+
+  const auto response = client.Echo(request).Finish();
+  ASSERT_EQ(response.items_size(), 10);
+  EXPECT_EQ(response.items(9).id(), 9);
+  EXPECT_EQ(response.items(9).tags(0), "tag");
+}
+
+}  // namespace
+
+UTEST(GrpcServerArena, Enabled) {
+  NestedMessagesServer server{/*use_arena=*/true};
+  CheckEcho(server);
+}
+
+UTEST(GrpcServerArena, Disabled) {
+  NestedMessagesServer server{/*use_arena=*/false};
+  CheckEcho(server);
+}
+
+USERVER_NAMESPACE_END
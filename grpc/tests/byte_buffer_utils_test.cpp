@@ -0,0 +1,54 @@
+#include <userver/ugrpc/byte_buffer_utils.hpp>
+
+#include <string>
+
+#include <grpcpp/support/slice.h>
+
+#include <userver/utest/utest.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+grpc::ByteBuffer MakeMultiSliceBuffer() {
+  const std::string first(10, 'a');
+  const std::string second(10, 'b');
+  grpc::Slice slices[] = {grpc::Slice{first}, grpc::Slice{second}};
+  return grpc::ByteBuffer{slices, 2};
+}
+
+}  // namespace
+
+TEST(GetByteBufferPrefix, Basic) {
+  const auto buffer = MakeMultiSliceBuffer();
+  EXPECT_EQ(ugrpc::GetByteBufferPrefix(buffer, 0), "");
+  EXPECT_EQ(ugrpc::GetByteBufferPrefix(buffer, 5), "aaaaa");
+  EXPECT_EQ(ugrpc::GetByteBufferPrefix(buffer, 12),
+            std::string(10, 'a') + "bb");
+  EXPECT_EQ(ugrpc::GetByteBufferPrefix(buffer, 100),
+            std::string(10, 'a') + std::string(10, 'b'));
+
+  // The buffer is still usable
+  EXPECT_EQ(buffer.Length(), 20);
+}
+
+TEST(GetByteBufferPrefix, Empty) {
+  EXPECT_EQ(ugrpc::GetByteBufferPrefix(grpc::ByteBuffer{}, 10), "");
+}
+
+TEST(GetByteBufferPrefix, Message) {
+  sample::ugrpc::GreetingRequest request;
+  request.set_name(std::string(10000, 'x'));
+  auto buffer = ugrpc::SerializeToByteBuffer(request, /*block_size=*/1024);
+
+  const auto prefix = ugrpc::GetByteBufferPrefix(buffer, 100);
+  EXPECT_EQ(prefix, request.SerializeAsString().substr(0, 100));
+
+  sample::ugrpc::GreetingRequest parsed;
+  ASSERT_TRUE(ugrpc::ParseFromByteBuffer(std::move(buffer), parsed));
+  EXPECT_EQ(parsed.name(), request.name());
+}
+
+USERVER_NAMESPACE_END
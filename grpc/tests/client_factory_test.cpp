@@ -1,5 +1,7 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <vector>
+
 #include <userver/ugrpc/client/impl/client_data.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -9,6 +11,41 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace {
+
+class ChatService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    while (call.Read(request)) {
+      response.set_number(request.number());
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+class GrowingChannelsService final : public ugrpc::tests::ServiceBase {
+ public:
+  GrowingChannelsService() {
+    RegisterService(service_);
+    ugrpc::client::ClientFactorySettings settings;
+    settings.channel_count = 1;
+    settings.max_channel_count = 3;
+    settings.channel_growth_threshold = 2;
+    settings.separate_channel_connections = true;
+    StartServer(std::move(settings));
+  }
+
+  ~GrowingChannelsService() override { StopServer(); }
+
+ private:
+  ChatService service_;
+};
+
+}  // namespace
+
 using GrpcClientMultichannel =
     tests::ServiceFixtureMultichannel<sample::ugrpc::UnitTestServiceBase>;
 
@@ -18,7 +55,62 @@ UTEST_P(GrpcClientMultichannel, ChannelsCount) {
   ASSERT_EQ(data.GetChannelToken().GetChannelCount(), GetParam());
 }
 
+UTEST_P(GrpcClientMultichannel, LeastLoadedChannel) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto& token = ugrpc::client::impl::GetClientData(client).GetChannelToken();
+
+  std::vector<ugrpc::client::impl::ChannelInFlightGuard> rpcs;
+  for (std::size_t i = 0; i < 2 * GetParam(); ++i) {
+    rpcs.push_back(token.StartRpc(token.PickLeastLoadedChannel()));
+  }
+  for (std::size_t i = 0; i < GetParam(); ++i) {
+    EXPECT_EQ(token.GetInFlight(i), 2);
+  }
+
+  rpcs.clear();
+  for (std::size_t i = 0; i < GetParam(); ++i) {
+    EXPECT_EQ(token.GetInFlight(i), 0);
+  }
+}
+
 INSTANTIATE_UTEST_SUITE_P(/*no prefix*/, GrpcClientMultichannel,
                           testing::Values(std::size_t{1}, std::size_t{4}));
 
+UTEST(GrpcClientChannels, GrowsUnderLoad) {
+  GrowingChannelsService service;
+  auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto& token = ugrpc::client::impl::GetClientData(client).GetChannelToken();
+  ASSERT_EQ(token.GetChannelCount(), 1);
+  ASSERT_EQ(token.GetMaxChannelCount(), 3);
+
+  // Streams are in flight until destroyed
+  std::vector<sample::ugrpc::UnitTestServiceClient::ChatCall> streams;
+  for (int i = 0; i < 2; ++i) streams.push_back(client.Chat());
+  EXPECT_EQ(token.GetChannelCount(), 1);
+  EXPECT_EQ(token.GetInFlight(0), 2);
+
+  streams.push_back(client.Chat());
+  EXPECT_EQ(token.GetChannelCount(), 2);
+  EXPECT_EQ(token.GetInFlight(1), 1);
+
+  for (int i = 0; i < 10; ++i) streams.push_back(client.Chat());
+  EXPECT_EQ(token.GetChannelCount(), 3);
+
+  sample::ugrpc::StreamGreetingRequest request;
+  sample::ugrpc::StreamGreetingResponse response;
+  for (auto& stream : streams) {
+    request.set_number(42);
+    ASSERT_TRUE(stream.Write(request));
+    ASSERT_TRUE(stream.Read(response));
+    EXPECT_EQ(response.number(), 42);
+    ASSERT_TRUE(stream.WritesDone());
+    EXPECT_FALSE(stream.Read(response));
+  }
+
+  streams.clear();
+  for (std::size_t i = 0; i < token.GetChannelCount(); ++i) {
+    EXPECT_EQ(token.GetInFlight(i), 0);
+  }
+}
+
 USERVER_NAMESPACE_END
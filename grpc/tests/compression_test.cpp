@@ -0,0 +1,231 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/ugrpc/byte_buffer_utils.hpp>
+#include <userver/ugrpc/client/generic.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+#include <ugrpc/server/impl/server_configs.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kLargeNameSize = 100'000;
+
+class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name(std::move(*request.mutable_name()));
+    call.Finish(response);
+  }
+
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    sample::ugrpc::StreamGreetingResponse response;
+    for (int i = 0; i < request.number(); ++i) {
+      // Interleave compressed and uncompressed messages
+      response.set_number(i);
+      if (i % 2 == 0) {
+        response.set_name(std::string(kLargeNameSize, 'a'));
+      } else {
+        response.set_name("small");
+      }
+      call.Write(response);
+    }
+    call.Finish();
+  }
+
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    while (call.Read(request)) {
+      response.set_number(request.number());
+      response.set_name(request.name());
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+class CompressedService final : public ugrpc::tests::ServiceBase {
+ public:
+  explicit CompressedService(std::size_t offload_min_size) {
+    ExtendDynamicConfig({
+        {ugrpc::server::impl::kServerCompression,
+         formats::json::FromString(R"({
+            "__default__": {"algorithm": "gzip", "min-size": 1024},
+            "sample.ugrpc.UnitTestService/Chat": {"level": "high"}
+         })")
+             .As<ugrpc::server::impl::ServerCompression>()},
+    });
+
+    ugrpc::server::ServiceConfig config{
+        engine::current_task::GetTaskProcessor(),
+        /*middlewares=*/{},
+    };
+    config.serialization_task_processor =
+        &engine::current_task::GetTaskProcessor();
+    config.serialization_offload_min_size = offload_min_size;
+    GetServer().AddService(service_, std::move(config));
+
+    // Keep the responses as they came over the wire. Typed clients still
+    // decompress them when parsing, GenericClient exposes the raw bytes.
+    ugrpc::client::ClientFactorySettings settings;
+    settings.channel_args.SetInt(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION, 0);
+    StartServer(std::move(settings));
+  }
+
+  ~CompressedService() override { StopServer(); }
+
+  utils::statistics::Snapshot GetStatistics(std::string_view method) {
+    return utils::statistics::Snapshot{
+        GetStatisticsStorage(),
+        "grpc.server.by-destination.serialization",
+        {{"grpc_destination", "sample.ugrpc.UnitTestService/" +
+                                  std::string{method}}}};
+  }
+
+ private:
+  UnitTestService service_;
+};
+
+void CheckCalls(sample::ugrpc::UnitTestServiceClient& client) {
+  for (const auto size : {std::size_t{10}, kLargeNameSize}) {
+    sample::ugrpc::GreetingRequest request;
+    request.set_name(std::string(size, 'x'));
+    EXPECT_EQ(client.SayHello(request).Finish().name(), request.name());
+  }
+
+  {
+    sample::ugrpc::StreamGreetingRequest request;
+    request.set_number(4);
+    auto stream = client.ReadMany(request);
+    sample::ugrpc::StreamGreetingResponse response;
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(stream.Read(response));
+      EXPECT_EQ(response.number(), i);
+      EXPECT_EQ(response.name().size(), i % 2 == 0 ? kLargeNameSize : 5);
+    }
+    EXPECT_FALSE(stream.Read(response));
+  }
+
+  {
+    auto stream = client.Chat();
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    for (int i = 0; i < 4; ++i) {
+      request.set_number(i);
+      request.set_name(std::string(i % 2 == 0 ? kLargeNameSize : 1, 'z'));
+      ASSERT_TRUE(stream.Write(request));
+      ASSERT_TRUE(stream.Read(response));
+      EXPECT_EQ(response.name(), request.name());
+    }
+    ASSERT_TRUE(stream.WritesDone());
+    EXPECT_FALSE(stream.Read(response));
+  }
+}
+
+std::size_t WireSize(const ugrpc::client::GenericClient& client,
+                     std::size_t name_size) {
+  sample::ugrpc::GreetingRequest request;
+  request.set_name(std::string(name_size, 'x'));
+  return client
+      .UnaryCall("sample.ugrpc.UnitTestService/SayHello",
+                 ugrpc::SerializeToByteBuffer(request))
+      .Finish()
+      .Length();
+}
+
+}  // namespace
+
+TEST(GrpcServerCompression, FindSettings) {
+  const auto config =
+      formats::json::FromString(R"({
+        "__default__": {"algorithm": "gzip"},
+        "a.Service": {"level": "low", "min-size": 100},
+        "a.Service/Method": {"algorithm": "none"}
+      })")
+          .As<ugrpc::server::impl::ServerCompression>();
+
+  const auto& method = ugrpc::server::impl::FindCompressionSettings(
+      config, "a.Service/Method", "a.Service");
+  EXPECT_FALSE(method.IsEnabled());
+
+  const auto& service = ugrpc::server::impl::FindCompressionSettings(
+      config, "a.Service/Other", "a.Service");
+  EXPECT_TRUE(service.IsEnabled());
+  EXPECT_EQ(service.level, GRPC_COMPRESS_LEVEL_LOW);
+  EXPECT_EQ(service.min_size, 100);
+
+  const auto& other = ugrpc::server::impl::FindCompressionSettings(
+      config, "b.Service/Method", "b.Service");
+  EXPECT_EQ(other.algorithm, GRPC_COMPRESS_GZIP);
+  EXPECT_EQ(other.min_size, 0);
+}
+
+TEST(GrpcServerCompression, AlgorithmAndLevelAreExclusive) {
+  EXPECT_THROW(formats::json::FromString(
+                   R"({"__default__": {"algorithm": "gzip", "level": "low"}})")
+                   .As<ugrpc::server::impl::ServerCompression>(),
+               formats::json::Exception);
+}
+
+UTEST_MT(GrpcServerCompression, CompressedResponses, 2) {
+  CompressedService service{ugrpc::server::kDefaultSerializationOffloadMinSize};
+  auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  CheckCalls(client);
+
+  // Only the large responses are offloaded
+  EXPECT_EQ(service.GetStatistics("SayHello").SingleMetric("offloaded").AsRate(),
+            1);
+  EXPECT_EQ(service.GetStatistics("ReadMany").SingleMetric("offloaded").AsRate(),
+            2);
+  EXPECT_EQ(service.GetStatistics("Chat").SingleMetric("offloaded").AsRate(), 2);
+
+  // The small ones are only counted on the handler task processor
+  const auto say_hello = service.GetStatistics("SayHello");
+  EXPECT_EQ(say_hello.SingleMetric("inline").AsRate(), 1);
+  EXPECT_GT(say_hello.SingleMetric("bytes.inline").AsRate().value, 0);
+  EXPECT_EQ(service.GetStatistics("ReadMany").SingleMetric("inline").AsRate(),
+            2);
+}
+
+UTEST_MT(GrpcServerCompression, CompressedOnTheWire, 2) {
+  CompressedService service{ugrpc::server::kDefaultSerializationOffloadMinSize};
+  const auto client = service.MakeClient<ugrpc::client::GenericClient>();
+
+  // Below "min-size": sent as is
+  sample::ugrpc::GreetingResponse small;
+  small.set_name(std::string(10, 'x'));
+  EXPECT_EQ(WireSize(client, 10), small.ByteSizeLong());
+
+  // A run of the same byte shrinks by orders of magnitude with gzip
+  EXPECT_LT(WireSize(client, kLargeNameSize), kLargeNameSize / 10);
+}
+
+UTEST_MT(GrpcServerCompression, OffloadAll, 2) {
+  CompressedService service{0};
+  auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  CheckCalls(client);
+
+  EXPECT_EQ(service.GetStatistics("SayHello").SingleMetric("offloaded").AsRate(),
+            2);
+  EXPECT_EQ(service.GetStatistics("ReadMany").SingleMetric("offloaded").AsRate(),
+            4);
+  EXPECT_EQ(service.GetStatistics("SayHello").SingleMetric("inline").AsRate(),
+            0);
+}
+
+USERVER_NAMESPACE_END
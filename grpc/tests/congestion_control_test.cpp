@@ -1,10 +1,13 @@
 #include <userver/utest/utest.hpp>
 
-#include <ugrpc/server/middlewares/congestion_control/middleware.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/formats/json/serialize.hpp>
 #include <userver/ugrpc/tests/service_fixtures.hpp>
 #include <userver/utils/algo.hpp>
 
 #include <ugrpc/impl/rpc_metadata.hpp>
+#include <ugrpc/server/impl/server_configs.hpp>
+#include <ugrpc/server/middlewares/congestion_control/middleware.hpp>
 
 #include <tests/unit_test_client.usrv.pb.hpp>
 #include <tests/unit_test_service.usrv.pb.hpp>
@@ -39,6 +42,52 @@ class CongestionControlTest : public ugrpc::tests::ServiceFixtureBase {
   UnitTestService service_;
 };
 
+class BlockingService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    if (request.name() == "block") {
+      started.Send();
+      EXPECT_TRUE(release.WaitForEventFor(utest::kMaxTestWaitTime));
+    }
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  engine::SingleConsumerEvent started;
+  engine::SingleConsumerEvent release;
+};
+
+class AdaptiveConcurrencyTest : public ugrpc::tests::ServiceFixtureBase {
+ protected:
+  AdaptiveConcurrencyTest() {
+    ExtendDynamicConfig({
+        {ugrpc::server::impl::kServerAdaptiveConcurrency,
+         formats::json::FromString(R"({
+            "__default__": {"enabled": false},
+            "sample.ugrpc.UnitTestService/SayHello": {
+              "initial-limit": 1,
+              "min-limit": 1
+            }
+         })")
+             .As<ugrpc::server::impl::ServerAdaptiveConcurrency>()},
+    });
+    SetServerMiddlewares({std::make_shared<
+        ugrpc::server::middlewares::congestion_control::Middleware>()});
+
+    RegisterService(service_);
+    StartServer();
+  }
+
+  ~AdaptiveConcurrencyTest() override { StopServer(); }
+
+  BlockingService& GetService() { return service_; }
+
+ private:
+  BlockingService service_;
+};
+
 }  // namespace
 
 UTEST_F(CongestionControlTest, Basic) {
@@ -56,4 +105,22 @@ UTEST_F(CongestionControlTest, Basic) {
       utils::FindOrDefault(metadata, ugrpc::impl::kXYaTaxiRatelimitReason));
 }
 
+UTEST_F(AdaptiveConcurrencyTest, RejectsOverLimit) {
+  const auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  sample::ugrpc::GreetingRequest blocking_request;
+  blocking_request.set_name("block");
+  auto blocked_call = client.SayHello(blocking_request);
+  ASSERT_TRUE(GetService().started.WaitForEventFor(utest::kMaxTestWaitTime));
+
+  sample::ugrpc::GreetingRequest request;
+  request.set_name("userver");
+  UEXPECT_THROW(client.SayHello(request).Finish(),
+                ugrpc::client::ResourceExhaustedError);
+
+  GetService().release.Send();
+  EXPECT_EQ(blocked_call.Finish().name(), "Hello block");
+  EXPECT_EQ(client.SayHello(request).Finish().name(), "Hello userver");
+}
+
 USERVER_NAMESPACE_END
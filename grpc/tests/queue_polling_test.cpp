@@ -0,0 +1,97 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    while (call.Read(request)) {
+      response.set_number(request.number());
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+ugrpc::server::ServerConfig MakeTaskProcessorPollingConfig() {
+  ugrpc::server::ServerConfig config;
+  config.completion_queue_polling =
+      ugrpc::impl::QueuePollingMode::kTaskProcessor;
+  return config;
+}
+
+void CheckCalls(sample::ugrpc::UnitTestServiceClient& client) {
+  sample::ugrpc::GreetingRequest request;
+  request.set_name("userver");
+  EXPECT_EQ(client.SayHello(request).Finish().name(), "Hello userver");
+
+  auto stream = client.Chat();
+  sample::ugrpc::StreamGreetingRequest stream_request;
+  sample::ugrpc::StreamGreetingResponse stream_response;
+  for (int i = 0; i < 10; ++i) {
+    stream_request.set_number(i);
+    ASSERT_TRUE(stream.Write(stream_request));
+    ASSERT_TRUE(stream.Read(stream_response));
+    EXPECT_EQ(stream_response.number(), i);
+  }
+  ASSERT_TRUE(stream.WritesDone());
+  EXPECT_FALSE(stream.Read(stream_response));
+}
+
+}  // namespace
+
+// The poller shares the only worker thread with the callers
+UTEST(QueuePolling, TaskProcessorSingleThread) {
+  ugrpc::tests::Service<UnitTestService> service{
+      MakeTaskProcessorPollingConfig()};
+  auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  CheckCalls(client);
+}
+
+// The idle poller parks and gets woken up by the next event
+UTEST(QueuePolling, TaskProcessorAfterIdle) {
+  ugrpc::tests::Service<UnitTestService> service{
+      MakeTaskProcessorPollingConfig()};
+  auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  for (int i = 0; i < 3; ++i) {
+    CheckCalls(client);
+    engine::SleepFor(std::chrono::milliseconds{20});
+  }
+}
+
+UTEST_MT(QueuePolling, TaskProcessorConcurrentCalls, 4) {
+  ugrpc::tests::Service<UnitTestService> service{
+      MakeTaskProcessorPollingConfig()};
+  auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 8; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&client] { CheckCalls(client); }));
+  }
+  engine::GetAll(tasks);
+}
+
+USERVER_NAMESPACE_END
@@ -15,7 +15,9 @@
 #include <userver/storages/mysql/cluster_host_type.hpp>
 #include <userver/storages/mysql/command_result_set.hpp>
 #include <userver/storages/mysql/cursor_result_set.hpp>
+#include <userver/storages/mysql/execution_result.hpp>
 #include <userver/storages/mysql/impl/bind_helper.hpp>
+#include <userver/storages/mysql/impl/bulk_chunks.hpp>
 #include <userver/storages/mysql/options.hpp>
 #include <userver/storages/mysql/query.hpp>
 #include <userver/storages/mysql/statement_result_set.hpp>
@@ -188,6 +190,49 @@ class Cluster final {
                                        const Query& query,
                                        const Container& params) const;
 
+  /// @brief Executes a statement on a host of host_type with default deadline,
+  /// splitting `params` into several bulk statements as configured by
+  /// `settings`.
+  /// Requirements are the same as for ExecuteBulk.
+  ///
+  /// @note Requires MariaDB 10.2.6+ as a server
+  ///
+  /// UINVARIANTs on params count mismatch, doesn't validate types.
+  /// UINVARIANTs on empty params container.
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(
+      ClusterHostType host_type, const Query& query, const Container& params,
+      const BulkChunkingSettings& settings = {}) const;
+
+  // clang-format off
+  /// @brief Executes a statement on a host of host_type with provided
+  /// CommandControl, splitting `params` into several bulk statements as
+  /// configured by `settings`.
+  /// Requirements are the same as for ExecuteBulk.
+  ///
+  /// Unlike ExecuteBulk this doesn't hit the `max_allowed_packet` of the
+  /// server for large containers. With `settings.max_parallel_chunks` above 1
+  /// the chunks are executed concurrently over several connections of the pool,
+  /// so a failure may leave some of the chunks applied; use
+  /// Transaction::ExecuteBulkChunked if the rows must be applied atomically.
+  ///
+  /// `command_control` limits every chunk separately.
+  /// Returns the sum of `rows_affected` of the chunks and `last_insert_id`
+  /// of the first chunk.
+  ///
+  /// @note Requires MariaDB 10.2.6+ as a server
+  ///
+  /// UINVARIANTs on params count mismatch, doesn't validate types.
+  /// UINVARIANTs on empty params container.
+  ///
+  /// @snippet storages/tests/unittests/cluster_mysqltest.cpp uMySQL usage sample - Cluster ExecuteBulkChunked
+  // clang-format on
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(
+      OptionalCommandControl command_control, ClusterHostType host_type,
+      const Query& query, const Container& params,
+      const BulkChunkingSettings& settings = {}) const;
+
   /// @brief Begin a transaction with default deadline.
   ///
   /// @note The deadline is transaction-wide, not just for Begin query itself.
@@ -349,6 +394,33 @@ StatementResultSet Cluster::ExecuteBulkMapped(
                    params_binder, std::nullopt);
 }
 
+template <typename Container>
+ExecutionResult Cluster::ExecuteBulkChunked(
+    ClusterHostType host_type, const Query& query, const Container& params,
+    const BulkChunkingSettings& settings) const {
+  return ExecuteBulkChunked(std::nullopt, host_type, query, params, settings);
+}
+
+template <typename Container>
+ExecutionResult Cluster::ExecuteBulkChunked(
+    OptionalCommandControl command_control, ClusterHostType host_type,
+    const Query& query, const Container& params,
+    const BulkChunkingSettings& settings) const {
+  UINVARIANT(!params.empty(), "Empty params in bulk execution");
+
+  const auto chunks = impl::SplitIntoChunks(params, settings);
+
+  return impl::ExecuteChunks(
+      chunks.size(), settings.max_parallel_chunks, [&](std::size_t chunk) {
+        auto params_binder =
+            impl::BindHelper::BindContainerAsParams(chunks[chunk]);
+
+        return DoExecute(command_control, host_type, query.GetStatement(),
+                         params_binder, std::nullopt)
+            .AsExecutionResult();
+      });
+}
+
 template <typename T, typename... Args>
 CursorResultSet<T> Cluster::GetCursor(ClusterHostType host_type,
                                       std::size_t batch_size,
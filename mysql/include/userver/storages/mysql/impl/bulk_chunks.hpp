@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/utils/function_ref.hpp>
+
+#include <userver/storages/mysql/execution_result.hpp>
+#include <userver/storages/mysql/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::impl {
+
+/// A contiguous range of rows of a bulk container, which is bound by
+/// io::InsertBinder as if it was a container itself.
+template <typename Iterator>
+class BulkChunk final {
+ public:
+  using value_type = typename std::iterator_traits<Iterator>::value_type;
+  using const_iterator = Iterator;
+
+  BulkChunk(Iterator begin, Iterator end, std::size_t size)
+      : begin_{begin}, end_{end}, size_{size} {}
+
+  Iterator begin() const { return begin_; }
+  Iterator end() const { return end_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  Iterator begin_;
+  Iterator end_;
+  std::size_t size_;
+};
+
+// Rough estimates of the COM_STMT_BULK_EXECUTE payload: every field is
+// prefixed with an indicator byte, strings are length-encoded.
+inline constexpr std::size_t kLengthEncodedPrefixSize = 9;
+inline constexpr std::size_t kUnknownFieldSizeEstimate = 32;
+
+template <typename T>
+std::size_t EstimateFieldSize(const T&) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return sizeof(T);
+  } else {
+    return kUnknownFieldSizeEstimate;
+  }
+}
+
+inline std::size_t EstimateFieldSize(std::string_view field) {
+  return kLengthEncodedPrefixSize + field.size();
+}
+
+inline std::size_t EstimateFieldSize(const std::string& field) {
+  return kLengthEncodedPrefixSize + field.size();
+}
+
+template <typename T>
+std::size_t EstimateFieldSize(const std::optional<T>& field) {
+  return field.has_value() ? EstimateFieldSize(*field) : 0;
+}
+
+template <typename Row>
+std::size_t EstimateRowSize(const Row& row) {
+  std::size_t size = 0;
+  boost::pfr::for_each_field(
+      row, [&size](const auto& field) { size += 1 + EstimateFieldSize(field); });
+  return size;
+}
+
+/// Splits `params` into chunks of at most `settings.max_rows` rows, each
+/// estimated to fit into `settings.max_packet_size` bytes. A single row
+/// exceeding the packet size makes a chunk on its own.
+template <typename Container>
+std::vector<BulkChunk<typename Container::const_iterator>> SplitIntoChunks(
+    const Container& params, const BulkChunkingSettings& settings) {
+  std::vector<BulkChunk<typename Container::const_iterator>> chunks;
+
+  auto chunk_begin = params.begin();
+  std::size_t chunk_rows = 0;
+  std::size_t chunk_size = 0;
+  for (auto it = params.begin(); it != params.end(); ++it) {
+    const auto row_size = EstimateRowSize(*it);
+    if (chunk_rows != 0 && (chunk_rows == settings.max_rows ||
+                            chunk_size + row_size > settings.max_packet_size)) {
+      chunks.emplace_back(chunk_begin, it, chunk_rows);
+      chunk_begin = it;
+      chunk_rows = 0;
+      chunk_size = 0;
+    }
+    ++chunk_rows;
+    chunk_size += row_size;
+  }
+  if (chunk_rows != 0) {
+    chunks.emplace_back(chunk_begin, params.end(), chunk_rows);
+  }
+
+  return chunks;
+}
+
+/// Calls `execute_chunk` for every chunk index, at most `max_parallel_chunks`
+/// of them concurrently. Returns the sum of `rows_affected` and
+/// `last_insert_id` of the first chunk.
+ExecutionResult ExecuteChunks(
+    std::size_t chunks_count, std::size_t max_parallel_chunks,
+    utils::function_ref<ExecutionResult(std::size_t)> execute_chunk);
+
+}  // namespace storages::mysql::impl
+
+USERVER_NAMESPACE_END
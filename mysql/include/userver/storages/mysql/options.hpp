@@ -3,6 +3,7 @@
 /// @file userver/storages/mysql/options.hpp
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,6 +35,24 @@ struct CommandControl final {
 /// @brief storages::mysql::CommandControl that may not be set.
 using OptionalCommandControl = std::optional<CommandControl>;
 
+/// @brief Controls how storages::mysql::Cluster::ExecuteBulkChunked splits
+/// the rows into separate bulk statements.
+///
+/// The packet size of a row is estimated from its fields: strings by their
+/// length, arithmetic types by their size, other types by a fixed guess.
+/// Keep `max_packet_size` well below the `max_allowed_packet` of the server.
+struct BulkChunkingSettings final {
+  /// Estimated size of the rows sent in a single statement, in bytes.
+  std::size_t max_packet_size{4 * 1024 * 1024};
+
+  /// Max number of rows sent in a single statement.
+  std::size_t max_rows{10000};
+
+  /// Number of chunks executed concurrently, each on its own connection.
+  /// With 1 the chunks are executed one after another.
+  std::size_t max_parallel_chunks{1};
+};
+
 }  // namespace storages::mysql
 
 USERVER_NAMESPACE_END
@@ -8,7 +8,9 @@
 #include <userver/storages/mysql/cluster_host_type.hpp>
 #include <userver/storages/mysql/command_result_set.hpp>
 #include <userver/storages/mysql/cursor_result_set.hpp>
+#include <userver/storages/mysql/execution_result.hpp>
 #include <userver/storages/mysql/impl/bind_helper.hpp>
+#include <userver/storages/mysql/impl/bulk_chunks.hpp>
 #include <userver/storages/mysql/options.hpp>
 #include <userver/storages/mysql/query.hpp>
 #include <userver/storages/mysql/statement_result_set.hpp>
@@ -91,6 +93,24 @@ class Transaction final {
                                        const Container& params) const;
   // clang-format on
 
+  /// @brief Executes a statement with default deadline, splitting `params`
+  /// into several bulk statements as configured by `settings`.
+  /// Requirements are the same as for ExecuteBulk.
+  ///
+  /// The chunks are always executed one after another on the connection of
+  /// the transaction, `settings.max_parallel_chunks` is ignored.
+  /// Returns the sum of `rows_affected` of the chunks and `last_insert_id`
+  /// of the first chunk.
+  ///
+  /// @note Requires MariaDB 10.2.6+ as a server
+  ///
+  /// UINVARIANTs on params count mismatch, doesn't validate types.
+  /// UINVARIANTs on empty params container.
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(
+      const Query& query, const Container& params,
+      const BulkChunkingSettings& settings = {}) const;
+
   /// @brief Commit the transaction
   void Commit();
 
@@ -145,6 +165,21 @@ StatementResultSet Transaction::ExecuteBulkMapped(
   return DoExecute(query.GetStatement(), params_binder);
 }
 
+template <typename Container>
+ExecutionResult Transaction::ExecuteBulkChunked(
+    const Query& query, const Container& params,
+    const BulkChunkingSettings& settings) const {
+  UINVARIANT(!params.empty(), "Empty params in bulk execution");
+
+  const auto chunks = impl::SplitIntoChunks(params, settings);
+
+  return impl::ExecuteChunks(chunks.size(), 1, [&](std::size_t chunk) {
+    auto params_binder = impl::BindHelper::BindContainerAsParams(chunks[chunk]);
+
+    return DoExecute(query.GetStatement(), params_binder).AsExecutionResult();
+  });
+}
+
 }  // namespace storages::mysql
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,54 @@
+#include <userver/storages/mysql/impl/bulk_chunks.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::impl {
+
+ExecutionResult ExecuteChunks(
+    std::size_t chunks_count, std::size_t max_parallel_chunks,
+    utils::function_ref<ExecutionResult(std::size_t)> execute_chunk) {
+  UINVARIANT(max_parallel_chunks > 0, "max_parallel_chunks should be positive");
+
+  std::vector<ExecutionResult> results(chunks_count);
+  const auto workers_count = std::min(chunks_count, max_parallel_chunks);
+  if (workers_count <= 1) {
+    for (std::size_t i = 0; i < chunks_count; ++i) {
+      results[i] = execute_chunk(i);
+    }
+  } else {
+    // Every worker holds a connection of its own and takes the next chunk
+    // as soon as it's done with the previous one.
+    std::atomic<std::size_t> next_chunk{0};
+    std::vector<engine::TaskWithResult<void>> workers;
+    workers.reserve(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+      workers.push_back(utils::Async("mysql_bulk_chunks", [&] {
+        for (auto chunk = next_chunk++; chunk < chunks_count;
+             chunk = next_chunk++) {
+          results[chunk] = execute_chunk(chunk);
+        }
+      }));
+    }
+    engine::WaitAllChecked(workers);
+  }
+
+  ExecutionResult total{};
+  for (const auto& result : results) {
+    total.rows_affected += result.rows_affected;
+  }
+  if (!results.empty()) {
+    total.last_insert_id = results.front().last_insert_id;
+  }
+  return total;
+}
+
+}  // namespace storages::mysql::impl
+
+USERVER_NAMESPACE_END
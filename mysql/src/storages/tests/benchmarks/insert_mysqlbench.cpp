@@ -42,6 +42,8 @@ void insert_retrieve(benchmark::State& state) {
         state.SkipWithError("oops");
       }
     }
+    state.counters["rows_per_second"] = benchmark::Counter(
+        rows_count * state.iterations(), benchmark::Counter::kIsRate);
   });
 }
 BENCHMARK(insert_retrieve)->Range(1 << 10, 1 << 20)->RangeMultiplier(4);
@@ -100,10 +102,58 @@ void batch_insert(benchmark::State& state) {
       table.DefaultExecute("DROP TABLE {}");
       state.ResumeTiming();
     }
+    state.counters["rows_per_second"] = benchmark::Counter(
+        state.range(0) * state.iterations(), benchmark::Counter::kIsRate);
   });
 }
 BENCHMARK(batch_insert)->Range(1000, 100'000);
 
+void chunked_insert(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config{};
+
+  engine::RunStandalone(4, config, [&state] {
+    tests::ClusterWrapper cluster;
+    struct Row final {
+      std::int32_t id{};
+      std::string value;
+    };
+    const auto rows_count = state.range(0);
+    std::vector<Row> rows_to_insert;
+    rows_to_insert.reserve(rows_count);
+    for (int i = 0; i < rows_count; ++i) {
+      rows_to_insert.push_back({i, "some string, i don't really care"});
+    }
+
+    BulkChunkingSettings settings;
+    settings.max_rows = 10'000;
+    settings.max_parallel_chunks = state.range(1);
+
+    for (auto _ : state) {
+      state.PauseTiming();
+      tests::TmpTable table{cluster,
+                            "Id INT NOT NULL PRIMARY KEY, Value TEXT NOT NULL"};
+      const storages::mysql::Query query{
+          table.FormatWithTableName("INSERT INTO {} VALUES(?, ?)")};
+      state.ResumeTiming();
+
+      const auto result = cluster->ExecuteBulkChunked(
+          ClusterHostType::kPrimary, query, rows_to_insert, settings);
+
+      state.PauseTiming();
+      if (result.rows_affected != rows_to_insert.size()) {
+        state.SkipWithError("oops");
+      }
+      table.DefaultExecute("DROP TABLE {}");
+      state.ResumeTiming();
+    }
+    state.counters["rows_per_second"] = benchmark::Counter(
+        rows_count * state.iterations(), benchmark::Counter::kIsRate);
+  });
+}
+BENCHMARK(chunked_insert)
+    ->ArgsProduct({{100'000, 1'000'000}, {1, 2, 4, 8}})
+    ->ArgNames({"rows", "parallel"});
+
 }  // namespace storages::mysql::benches
 
 USERVER_NAMESPACE_END
@@ -407,6 +407,106 @@ UTEST(Cluster, ExecuteBulkMapped) {
 
 }  // namespace execute_bulk_mapped_sample
 
+namespace execute_bulk_chunked_sample {
+
+/// [uMySQL usage sample - Cluster ExecuteBulkChunked]
+struct SampleRow final {
+  std::string title;
+  int amount;
+  std::chrono::system_clock::time_point created;
+};
+
+void PerformExecuteBulkChunked(const Cluster& cluster,
+                               std::chrono::milliseconds timeout,
+                               const std::vector<SampleRow>& rows) {
+  BulkChunkingSettings settings;
+  settings.max_rows = 1000;
+  // Chunks are inserted over 4 connections, not atomically
+  settings.max_parallel_chunks = 4;
+
+  const auto bulk_insertion_result = cluster.ExecuteBulkChunked(
+      CommandControl{timeout}, ClusterHostType::kPrimary,
+      "INSERT INTO SampleTable(title, amount, created) VALUES(?, ?, ?)", rows,
+      settings);
+
+  EXPECT_EQ(bulk_insertion_result.rows_affected, rows.size());
+}
+/// [uMySQL usage sample - Cluster ExecuteBulkChunked]
+
+UTEST_MT(Cluster, ExecuteBulkChunked, 2) {
+  const ClusterWrapper cluster{};
+
+  PrepareExampleTable(*cluster);
+
+  constexpr std::size_t kRowsCount = 3500;
+  std::vector<SampleRow> rows;
+  rows.reserve(kRowsCount);
+  for (std::size_t i = 0; i < kRowsCount; ++i) {
+    rows.push_back(
+        SampleRow{std::to_string(i), 1, std::chrono::system_clock::now()});
+  }
+
+  PerformExecuteBulkChunked(*cluster, std::chrono::milliseconds{5000}, rows);
+}
+
+}  // namespace execute_bulk_chunked_sample
+
+UTEST(Cluster, ExecuteBulkChunkedByPacketSize) {
+  ClusterWrapper cluster{};
+  TmpTable table{cluster, "Id INT PRIMARY KEY, Value TEXT NOT NULL"};
+
+  constexpr int kRowsCount = 100;
+  std::vector<Row> rows_to_insert;
+  rows_to_insert.reserve(kRowsCount);
+  for (int i = 0; i < kRowsCount; ++i) {
+    rows_to_insert.push_back({i, std::string(1000, 'a')});
+  }
+
+  BulkChunkingSettings settings;
+  // ~10 rows per chunk
+  settings.max_packet_size = 10 * 1024;
+
+  ASSERT_EQ(impl::SplitIntoChunks(rows_to_insert, settings).size(), 10);
+
+  const auto result = cluster->ExecuteBulkChunked(
+      ClusterHostType::kPrimary,
+      table.FormatWithTableName("INSERT INTO {}(Id, Value) VALUES(?, ?)"),
+      rows_to_insert, settings);
+  EXPECT_EQ(result.rows_affected, kRowsCount);
+
+  const auto db_rows =
+      table.DefaultExecute("SELECT Id, Value FROM {} ORDER BY Id")
+          .AsVector<Row>();
+  EXPECT_EQ(db_rows, rows_to_insert);
+}
+
+UTEST(Transaction, ExecuteBulkChunkedRollback) {
+  ClusterWrapper cluster{};
+  TmpTable table{cluster, "Id INT PRIMARY KEY, Value TEXT NOT NULL"};
+
+  constexpr int kRowsCount = 50;
+  std::vector<Row> rows_to_insert;
+  rows_to_insert.reserve(kRowsCount);
+  for (int i = 0; i < kRowsCount; ++i) {
+    rows_to_insert.push_back({i, "value"});
+  }
+
+  BulkChunkingSettings settings;
+  settings.max_rows = 7;
+  {
+    auto transaction = table.Begin();
+    const auto result = transaction.ExecuteBulkChunked(
+        table.FormatWithTableName("INSERT INTO {}(Id, Value) VALUES(?, ?)"),
+        rows_to_insert, settings);
+    EXPECT_EQ(result.rows_affected, kRowsCount);
+    // destroyed without Commit
+  }
+
+  const auto db_rows =
+      table.DefaultExecute("SELECT Id, Value FROM {}").AsVector<Row>();
+  EXPECT_TRUE(db_rows.empty());
+}
+
 namespace get_cursor_sample {
 
 /// [uMySQL usage sample - Cluster GetCursor]
@@ -0,0 +1,159 @@
+#pragma once
+
+/// @file userver/storages/postgres/dist_lock_batcher.hpp
+/// @brief @copybrief storages::postgres::DistLockBatcher
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// Settings of DistLockBatcher
+struct DistLockBatcherSettings final {
+  /// How often the pending acquire/prolong requests are sent
+  std::chrono::milliseconds batch_interval{100};
+
+  /// Max number of locks acquired/prolonged by a single query
+  std::size_t max_batch_size{1000};
+
+  /// Command control of the batch queries
+  CommandControl command_control{std::chrono::seconds{1},
+                                 std::chrono::seconds{1}};
+};
+
+// clang-format off
+
+/// @brief Acquires and prolongs many Postgres distributed locks with a single
+/// query per `batch_interval`, and issues fencing tokens for them.
+///
+/// A service running hundreds of locked workers over the same table would
+/// otherwise send a query per lock per prolong interval. With the batcher the
+/// workers' DistLockStrategy::Acquire calls are accumulated and sent together.
+///
+/// The fencing token of a lock is incremented each time the lock changes its
+/// owner and is kept while the owner prolongs the lock. To keep the token
+/// monotonic the released locks are expired instead of being deleted.
+///
+/// The batcher requires an additional column in the distlocks table:
+///
+/// ```SQL
+/// CREATE TABLE service.distlocks
+/// (
+///     key             TEXT PRIMARY KEY,
+///     owner           TEXT,
+///     expiration_time TIMESTAMPTZ,
+///     fencing_token   BIGINT NOT NULL DEFAULT 1
+/// );
+/// ```
+///
+/// @see BatchedDistLockStrategy
+
+// clang-format on
+
+class DistLockBatcher final {
+ public:
+  DistLockBatcher(ClusterPtr cluster, const std::string& table,
+                  const DistLockBatcherSettings& settings);
+
+  ~DistLockBatcher();
+
+  DistLockBatcher(const DistLockBatcher&) = delete;
+  DistLockBatcher& operator=(const DistLockBatcher&) = delete;
+
+  /// @brief Acquires or prolongs the lock with the next batch query.
+  /// @returns the fencing token of the lock
+  /// @throws dist_lock::LockIsAcquiredByAnotherHostException if the lock is
+  /// held by another owner
+  /// @throws std::runtime_error if the batcher is destroyed before the
+  /// request is sent
+  /// @throws anything else if the batch query fails
+  dist_lock::FencingToken Acquire(const std::string& key,
+                                  const std::string& owner,
+                                  std::chrono::milliseconds lock_ttl);
+
+  /// Releases the lock right away, without batching.
+  void Release(const std::string& key, const std::string& owner);
+
+  void UpdateCommandControl(CommandControl cc);
+
+  const DistLockBatcherSettings& GetSettings() const noexcept;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const DistLockBatcher& batcher);
+
+ private:
+  struct Request {
+    std::string key;
+    std::string owner;
+    double ttl_seconds;
+    engine::Promise<std::optional<dist_lock::FencingToken>> promise;
+  };
+
+  void Run();
+  void Flush(std::vector<Request>& requests);
+
+  ClusterPtr cluster_;
+  const DistLockBatcherSettings settings_;
+  rcu::Variable<CommandControl> cc_;
+  const std::string acquire_query_;
+  const std::string release_query_;
+
+  engine::Mutex mutex_;
+  std::vector<Request> pending_;
+  bool is_stopped_{false};
+
+  utils::statistics::RateCounter batches_;
+  utils::statistics::RateCounter batch_failures_;
+  utils::statistics::RateCounter acquired_;
+  utils::statistics::RateCounter busy_;
+  std::atomic<std::size_t> last_batch_size_{0};
+
+  // Must be the last field
+  engine::TaskWithResult<void> task_;
+};
+
+/// @brief Postgres distributed locking strategy that acquires and prolongs
+/// the lock through a DistLockBatcher shared by many locks.
+///
+/// Unlike DistLockStrategy, provides fencing tokens, see
+/// dist_lock::DistLockedWorker::GetFencingToken.
+class BatchedDistLockStrategy final : public dist_lock::DistLockStrategyBase {
+ public:
+  BatchedDistLockStrategy(std::shared_ptr<DistLockBatcher> batcher,
+                          const std::string& lock_name);
+
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override;
+
+  std::optional<dist_lock::FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl,
+      const std::string& locker_id) override;
+
+  void Release(const std::string& locker_id) override;
+
+ private:
+  std::shared_ptr<DistLockBatcher> batcher_;
+  const std::string lock_name_;
+  const std::string owner_prefix_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,78 @@
+#pragma once
+
+/// @file userver/storages/postgres/dist_lock_batcher_component.hpp
+/// @brief @copybrief storages::postgres::DistLockBatcherComponent
+
+#include <memory>
+#include <string_view>
+
+#include <userver/components/component_base.hpp>
+#include <userver/storages/postgres/dist_lock_batcher.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that owns a storages::postgres::DistLockBatcher shared by
+/// postgres-based distlock worker components.
+///
+/// Refer to it from storages::postgres::DistLockComponentBase by the
+/// `batcher` static option to acquire and prolong all the locks of the table
+/// with a single query per `batch-interval`.
+///
+/// ## Static configuration example:
+///
+/// ```yaml
+///        pg-distlock-batcher:
+///            cluster: postgresql-service
+///            table: service.distlocks
+///            batch-interval: 100ms
+///            pg-timeout: 1s
+/// ```
+///
+/// ## Static options:
+/// name           | Description  | Default value
+/// -------------- | ------------ | -------------
+/// cluster        | postgres cluster name | --
+/// table          | table name to store distlocks, must have a `fencing_token` column | --
+/// batch-interval | how often the pending acquire/prolong requests are sent | 100ms
+/// max-batch-size | max number of locks acquired/prolonged by a single query | 1000
+/// pg-timeout     | timeout of the batch queries, must be less than lock-ttl/2 of the locks | 1s
+
+// clang-format on
+
+class DistLockBatcherComponent final : public components::ComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of storages::postgres::DistLockBatcherComponent
+  static constexpr std::string_view kName = "pg-distlock-batcher";
+
+  DistLockBatcherComponent(const components::ComponentConfig&,
+                           const components::ComponentContext&);
+
+  ~DistLockBatcherComponent() override;
+
+  std::shared_ptr<DistLockBatcher> GetBatcher() const;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::shared_ptr<DistLockBatcher> batcher_;
+
+  // Subscriptions must be the last fields.
+  USERVER_NAMESPACE::utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace storages::postgres
+
+template <>
+inline constexpr bool
+    components::kHasValidate<storages::postgres::DistLockBatcherComponent> =
+        true;
+
+USERVER_NAMESPACE_END
@@ -48,6 +48,7 @@ namespace storages::postgres {
 /// lockname       | name of the lock | --
 /// lock-ttl       | TTL of the lock; must be at least as long as the duration between subsequent cancellation checks, otherwise brain split is possible | --
 /// pg-timeout     | timeout, must be less than lock-ttl/2 | --
+/// batcher        | name of the storages::postgres::DistLockBatcherComponent to acquire the lock through; cluster, table and pg-timeout are taken from it | --
 /// restart-delay  | how much time to wait after failed task restart | 100ms
 /// autostart      | if true, start automatically after component load | false
 /// task-processor | the name of the TaskProcessor for running DoWork | main-task-processor
@@ -67,6 +68,13 @@ namespace storages::postgres {
 /// );
 /// ```
 ///
+/// ## Batching
+///
+/// Services with many locks over the same table may set the `batcher` option
+/// to acquire and prolong all of them with a single query per interval, see
+/// storages::postgres::DistLockBatcherComponent. Batched locks also provide
+/// fencing tokens via dist_lock::DistLockedWorker::GetFencingToken.
+///
 /// @see @ref scripts/docs/en/userver/periodics.md
 
 // clang-format on
@@ -0,0 +1,254 @@
+#include <userver/storages/postgres/dist_lock_batcher.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/hostinfo/blocking/get_hostname.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// keys - $1
+// owners - $2
+// timeouts in seconds - $3
+std::string MakeBatchAcquireQuery(const std::string& table) {
+  static constexpr auto kBatchAcquireQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time, fencing_token)
+    SELECT r.key, r.owner, current_timestamp + make_interval(secs => r.ttl), 1
+    FROM UNNEST($1::TEXT[], $2::TEXT[], $3::DOUBLE PRECISION[])
+    AS r(key, owner, ttl)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = excluded.owner, expiration_time = excluded.expiration_time,
+    fencing_token = CASE WHEN t.owner = excluded.owner THEN t.fencing_token
+                    ELSE t.fencing_token + 1 END
+    WHERE (t.owner = excluded.owner) OR
+    (t.expiration_time <= current_timestamp)
+    RETURNING t.key, t.fencing_token;
+)";
+  return fmt::format(FMT_COMPILE(kBatchAcquireQueryFmt), table);
+}
+
+// The row is kept to keep the fencing token of the key monotonic.
+// key - $1
+// owner - $2
+std::string MakeExpireQuery(const std::string& table) {
+  static constexpr auto kExpireQueryFmt = R"(
+    UPDATE {}
+    SET owner = NULL, expiration_time = current_timestamp
+    WHERE key = $1
+    AND owner = $2
+    RETURNING 1;
+)";
+  return fmt::format(FMT_COMPILE(kExpireQueryFmt), table);
+}
+
+std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
+  return fmt::format(FMT_COMPILE("{}:{}"), prefix, locker);
+}
+
+}  // namespace
+
+DistLockBatcher::DistLockBatcher(ClusterPtr cluster, const std::string& table,
+                                 const DistLockBatcherSettings& settings)
+    : cluster_(std::move(cluster)),
+      settings_(settings),
+      cc_(settings.command_control),
+      acquire_query_(MakeBatchAcquireQuery(table)),
+      release_query_(MakeExpireQuery(table)) {
+  UINVARIANT(settings_.batch_interval.count() > 0,
+             "batch_interval must be positive");
+  UINVARIANT(settings_.max_batch_size > 0, "max_batch_size must be positive");
+  task_ = engine::CriticalAsyncNoSpan([this] { Run(); });
+}
+
+DistLockBatcher::~DistLockBatcher() {
+  {
+    std::lock_guard lock(mutex_);
+    is_stopped_ = true;
+  }
+  task_.SyncCancel();
+
+  // No requests are added after is_stopped_ and the task is done, fail the
+  // ones it has not sent
+  std::vector<Request> pending;
+  {
+    std::lock_guard lock(mutex_);
+    pending.swap(pending_);
+  }
+  for (auto& request : pending) {
+    request.promise.set_exception(std::make_exception_ptr(
+        std::runtime_error("Distlock batcher is stopped")));
+  }
+}
+
+dist_lock::FencingToken DistLockBatcher::Acquire(
+    const std::string& key, const std::string& owner,
+    std::chrono::milliseconds lock_ttl) {
+  engine::Future<std::optional<dist_lock::FencingToken>> future;
+  {
+    std::lock_guard lock(mutex_);
+    if (is_stopped_) {
+      throw std::runtime_error("Distlock batcher is stopped");
+    }
+    auto& request = pending_.emplace_back(
+        Request{key, owner, lock_ttl.count() / 1000.0, {}});
+    future = request.promise.get_future();
+  }
+
+  const auto token = future.get();
+  if (!token) throw dist_lock::LockIsAcquiredByAnotherHostException();
+  return *token;
+}
+
+void DistLockBatcher::Release(const std::string& key,
+                              const std::string& owner) {
+  auto cc_ptr = cc_.Read();
+  cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, release_query_, key,
+                    owner);
+}
+
+void DistLockBatcher::UpdateCommandControl(CommandControl cc) {
+  auto cc_ptr = cc_.StartWrite();
+  *cc_ptr = cc;
+  cc_ptr.Commit();
+}
+
+const DistLockBatcherSettings& DistLockBatcher::GetSettings() const noexcept {
+  return settings_;
+}
+
+void DistLockBatcher::Run() {
+  std::vector<Request> requests;
+  while (!engine::current_task::ShouldCancel()) {
+    engine::InterruptibleSleepFor(settings_.batch_interval);
+    // The destructor fails the pending requests
+    if (engine::current_task::ShouldCancel()) break;
+
+    requests.clear();
+    {
+      std::lock_guard lock(mutex_);
+      requests.swap(pending_);
+    }
+    if (requests.empty()) continue;
+
+    for (std::size_t begin = 0; begin < requests.size();
+         begin += settings_.max_batch_size) {
+      const auto end =
+          std::min(begin + settings_.max_batch_size, requests.size());
+      std::vector<Request> batch(
+          std::make_move_iterator(requests.begin() + begin),
+          std::make_move_iterator(requests.begin() + end));
+      Flush(batch);
+    }
+  }
+}
+
+void DistLockBatcher::Flush(std::vector<Request>& requests) {
+  tracing::Span span{"pg_distlock_batch"};
+
+  // A single INSERT ... ON CONFLICT may not touch a row twice, so only the
+  // first request per key goes to the query. The others either share its
+  // result or are reported busy and retry with the next batch.
+  std::unordered_map<std::string, std::size_t> query_index;
+  std::vector<std::string> keys;
+  std::vector<std::string> owners;
+  std::vector<double> ttls;
+  for (const auto& request : requests) {
+    if (query_index.emplace(request.key, keys.size()).second) {
+      keys.push_back(request.key);
+      owners.push_back(request.owner);
+      ttls.push_back(request.ttl_seconds);
+    }
+  }
+
+  last_batch_size_ = keys.size();
+  ++batches_;
+
+  std::unordered_map<std::string, dist_lock::FencingToken> tokens;
+  try {
+    auto cc_ptr = cc_.Read();
+    const auto result = cluster_->Execute(ClusterHostType::kMaster, *cc_ptr,
+                                          acquire_query_, keys, owners, ttls);
+    for (const auto& [key, token] :
+         result.AsSetOf<std::tuple<std::string, std::int64_t>>(kRowTag)) {
+      tokens.emplace(key, static_cast<dist_lock::FencingToken>(token));
+    }
+  } catch (const std::exception& ex) {
+    ++batch_failures_;
+    LOG_WARNING() << "Distlock batch of " << keys.size()
+                  << " locks failed: " << ex;
+    for (auto& request : requests) {
+      request.promise.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  for (auto& request : requests) {
+    const auto& queried_owner = owners[query_index.at(request.key)];
+    const auto it = tokens.find(request.key);
+    if (it != tokens.end() && queried_owner == request.owner) {
+      ++acquired_;
+      request.promise.set_value(it->second);
+    } else {
+      ++busy_;
+      request.promise.set_value(std::nullopt);
+    }
+  }
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const DistLockBatcher& batcher) {
+  writer["batches"] = batcher.batches_.Load();
+  writer["batch-failures"] = batcher.batch_failures_.Load();
+  writer["last-batch-size"] = batcher.last_batch_size_.load();
+  writer["acquired"] = batcher.acquired_.Load();
+  writer["busy"] = batcher.busy_.Load();
+}
+
+BatchedDistLockStrategy::BatchedDistLockStrategy(
+    std::shared_ptr<DistLockBatcher> batcher, const std::string& lock_name)
+    : batcher_(std::move(batcher)),
+      lock_name_(lock_name),
+      owner_prefix_(hostinfo::blocking::GetRealHostName()) {
+  UASSERT(batcher_);
+}
+
+void BatchedDistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
+                                      const std::string& locker_id) {
+  AcquireWithFencingToken(lock_ttl, locker_id);
+}
+
+std::optional<dist_lock::FencingToken>
+BatchedDistLockStrategy::AcquireWithFencingToken(
+    std::chrono::milliseconds lock_ttl, const std::string& locker_id) {
+  return batcher_->Acquire(lock_name_, MakeOwnerId(owner_prefix_, locker_id),
+                           lock_ttl);
+}
+
+void BatchedDistLockStrategy::Release(const std::string& locker_id) {
+  batcher_->Release(lock_name_, MakeOwnerId(owner_prefix_, locker_id));
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
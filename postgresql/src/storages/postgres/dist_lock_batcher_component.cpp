@@ -0,0 +1,89 @@
+#include <userver/storages/postgres/dist_lock_batcher_component.hpp>
+
+#include <stdexcept>
+
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+DistLockBatcherComponent::DistLockBatcherComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : components::ComponentBase(config, context) {
+  auto cluster = context
+                     .FindComponent<components::Postgres>(
+                         config["cluster"].As<std::string>())
+                     .GetCluster();
+
+  DistLockBatcherSettings settings;
+  settings.batch_interval =
+      config["batch-interval"].As<std::chrono::milliseconds>(
+          settings.batch_interval);
+  settings.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(settings.max_batch_size);
+  const auto pg_timeout = config["pg-timeout"].As<std::chrono::milliseconds>(
+      settings.command_control.execute);
+  settings.command_control = CommandControl{pg_timeout, pg_timeout};
+
+  if (settings.batch_interval.count() <= 0 || settings.max_batch_size == 0) {
+    throw std::runtime_error(
+        "batch-interval and max-batch-size must be positive");
+  }
+
+  batcher_ = std::make_shared<DistLockBatcher>(
+      std::move(cluster), config["table"].As<std::string>(), settings);
+
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>();
+  statistics_holder_ = statistics_storage.GetStorage().RegisterWriter(
+      "distlock.batcher",
+      [this](USERVER_NAMESPACE::utils::statistics::Writer& writer) {
+        writer = *batcher_;
+      },
+      {{"distlock_batcher", config.Name()}});
+}
+
+DistLockBatcherComponent::~DistLockBatcherComponent() {
+  statistics_holder_.Unregister();
+}
+
+std::shared_ptr<DistLockBatcher> DistLockBatcherComponent::GetBatcher() const {
+  return batcher_;
+}
+
+yaml_config::Schema DistLockBatcherComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::ComponentBase>(R"(
+type: object
+description: Component that owns a batcher of postgres-based distlocks
+additionalProperties: false
+properties:
+    cluster:
+        type: string
+        description: postgres cluster name
+    table:
+        type: string
+        description: table name to store distlocks, must have a fencing_token column
+    batch-interval:
+        type: string
+        description: how often the pending acquire/prolong requests are sent
+        defaultDescription: 100ms
+    max-batch-size:
+        type: integer
+        description: max number of locks acquired/prolonged by a single query
+        defaultDescription: 1000
+        minimum: 1
+    pg-timeout:
+        type: string
+        description: timeout of the batch queries, must be less than lock-ttl/2 of the locks
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dist_lock/dist_lock_settings.hpp>
+#include <userver/storages/postgres/dist_lock_batcher_component.hpp>
 #include <userver/storages/postgres/component.hpp>
 #include <userver/testsuite/tasks.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
@@ -15,30 +16,52 @@ DistLockComponentBase::DistLockComponentBase(
     const components::ComponentConfig& component_config,
     const components::ComponentContext& component_context)
     : components::ComponentBase(component_config, component_context) {
-  auto cluster = component_context
-                     .FindComponent<components::Postgres>(
-                         component_config["cluster"].As<std::string>())
-                     .GetCluster();
-  auto table = component_config["table"].As<std::string>();
   auto lock_name = component_config["lockname"].As<std::string>();
 
   auto ttl = component_config["lock-ttl"].As<std::chrono::milliseconds>();
-  auto pg_timeout =
-      component_config["pg-timeout"].As<std::chrono::milliseconds>();
   const auto prolong_ratio = 10;
+  const auto batcher_name =
+      component_config["batcher"].As<std::optional<std::string>>();
 
-  if (pg_timeout >= ttl / 2)
-    throw std::runtime_error("pg-timeout must be less than lock-ttl / 2");
-
+  std::shared_ptr<dist_lock::DistLockStrategyBase> strategy;
   dist_lock::DistLockSettings settings{ttl / prolong_ratio, ttl / prolong_ratio,
-                                       ttl, pg_timeout};
+                                       ttl};
+  if (batcher_name) {
+    auto batcher = component_context
+                       .FindComponent<DistLockBatcherComponent>(*batcher_name)
+                       .GetBatcher();
+    const auto& batcher_settings = batcher->GetSettings();
+    // A prolongation waits for the next batch and then for the query
+    const auto pg_timeout = batcher_settings.command_control.execute;
+    if (batcher_settings.batch_interval + pg_timeout >= ttl / 2) {
+      throw std::runtime_error(
+          "batch-interval + pg-timeout of the batcher must be less than "
+          "lock-ttl / 2");
+    }
+
+    settings.forced_stop_margin = pg_timeout;
+    strategy = std::make_shared<BatchedDistLockStrategy>(std::move(batcher),
+                                                         lock_name);
+  } else {
+    auto cluster = component_context
+                       .FindComponent<components::Postgres>(
+                           component_config["cluster"].As<std::string>())
+                       .GetCluster();
+    auto table = component_config["table"].As<std::string>();
+    auto pg_timeout =
+        component_config["pg-timeout"].As<std::chrono::milliseconds>();
+
+    if (pg_timeout >= ttl / 2)
+      throw std::runtime_error("pg-timeout must be less than lock-ttl / 2");
+
+    settings.forced_stop_margin = pg_timeout;
+    strategy = std::make_shared<DistLockStrategy>(std::move(cluster), table,
+                                                  lock_name, settings);
+  }
   settings.worker_func_restart_delay =
       component_config["restart-delay"].As<std::chrono::milliseconds>(
           settings.worker_func_restart_delay);
 
-  auto strategy = std::make_shared<DistLockStrategy>(std::move(cluster), table,
-                                                     lock_name, settings);
-
   auto task_processor_name =
       component_config["task-processor"].As<std::optional<std::string>>();
   auto* task_processor =
@@ -113,6 +136,10 @@ properties:
     table:
         type: string
         description: table name to store distlocks
+    batcher:
+        type: string
+        description: name of the DistLockBatcherComponent to acquire the lock through, cluster, table and pg-timeout are taken from it
+        defaultDescription: the lock is acquired by its own queries
     lockname:
         type: string
         description: name of the lock
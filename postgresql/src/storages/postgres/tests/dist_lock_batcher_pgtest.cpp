@@ -0,0 +1,311 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <userver/storages/postgres/dist_lock_batcher.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/error_injection/settings.hpp>
+#include <userver/hostinfo/blocking/get_hostname.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/testsuite/postgres_control.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr std::string_view kTable = "distlock_batcher_pgtest";
+constexpr std::chrono::milliseconds kLockTtl{10'000};
+
+// Long enough for all the concurrently started requests to get into one batch
+constexpr std::chrono::milliseconds kSingleBatchInterval{500};
+
+pg::ClusterPtr CreateCluster(const pg::DsnList& dsns,
+                             engine::TaskProcessor& bg_task_processor,
+                             testsuite::TestsuiteTasks& testsuite_tasks) {
+  auto source = dynamic_config::GetDefaultSource();
+  return std::make_shared<pg::Cluster>(
+      dsns, nullptr, bg_task_processor,
+      pg::ClusterSettings{{},
+                          {utest::kMaxTestWaitTime},
+                          {0, 2, 2},
+                          kCachePreparedStatements,
+                          pg::InitMode::kAsync,
+                          "",
+                          {},
+                          {}},
+      pg::DefaultCommandControls{kTestCmdCtl, {}, {}},
+      testsuite::PostgresControl{}, error_injection::Settings{},
+      testsuite_tasks, source, 0);
+}
+
+void PrepareTable(pg::Cluster& cluster) {
+  cluster.Execute(pg::ClusterHostType::kMaster,
+                  fmt::format("DROP TABLE IF EXISTS {}", kTable));
+  cluster.Execute(pg::ClusterHostType::kMaster,
+                  fmt::format(R"(
+    CREATE TABLE {} (
+      key             TEXT PRIMARY KEY,
+      owner           TEXT,
+      expiration_time TIMESTAMPTZ,
+      fencing_token   BIGINT NOT NULL DEFAULT 1
+    ))",
+                              kTable));
+}
+
+using LockRow = std::tuple<std::optional<std::string>, std::int64_t, bool>;
+
+// owner, fencing token and whether the lock is still held
+LockRow ReadLock(pg::Cluster& cluster, const std::string& key) {
+  return cluster
+      .Execute(pg::ClusterHostType::kMaster,
+               fmt::format("SELECT owner, fencing_token, "
+                           "expiration_time > current_timestamp "
+                           "FROM {} WHERE key = $1",
+                           kTable),
+               key)
+      .AsSingleRow<LockRow>(pg::kRowTag);
+}
+
+pg::DistLockBatcherSettings MakeSettings(
+    std::chrono::milliseconds batch_interval) {
+  pg::DistLockBatcherSettings settings;
+  settings.batch_interval = batch_interval;
+  settings.command_control = kTestCmdCtl;
+  return settings;
+}
+
+std::optional<dist_lock::FencingToken> TryAcquire(pg::DistLockBatcher& batcher,
+                                                  const std::string& key,
+                                                  const std::string& owner) {
+  try {
+    return batcher.Acquire(key, owner, kLockTtl);
+  } catch (const dist_lock::LockIsAcquiredByAnotherHostException&) {
+    return std::nullopt;
+  }
+}
+
+class PostgreDistLockBatcher : public PostgreSQLBase {
+ protected:
+  PostgreDistLockBatcher()
+      : cluster_(CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(),
+                               testsuite_tasks_)) {
+    PrepareTable(*cluster_);
+  }
+
+  ~PostgreDistLockBatcher() override {
+    cluster_->Execute(pg::ClusterHostType::kMaster,
+                      fmt::format("DROP TABLE IF EXISTS {}", kTable));
+  }
+
+  pg::Cluster& GetCluster() { return *cluster_; }
+
+  std::shared_ptr<pg::DistLockBatcher> MakeBatcher(
+      std::chrono::milliseconds batch_interval = std::chrono::milliseconds{10},
+      std::string_view table = kTable) {
+    return std::make_shared<pg::DistLockBatcher>(
+        cluster_, std::string{table}, MakeSettings(batch_interval));
+  }
+
+ private:
+  testsuite::TestsuiteTasks testsuite_tasks_{true};
+  pg::ClusterPtr cluster_;
+};
+
+}  // namespace
+
+UTEST_F(PostgreDistLockBatcher, Acquire) {
+  const auto batcher = MakeBatcher();
+
+  EXPECT_EQ(batcher->Acquire("key", "owner", kLockTtl), 1);
+  EXPECT_EQ(ReadLock(GetCluster(), "key"), (LockRow{"owner", 1, true}));
+
+  // Prolonging keeps the token
+  EXPECT_EQ(batcher->Acquire("key", "owner", kLockTtl), 1);
+
+  // The row is kept on release to keep the token monotonic
+  batcher->Release("key", "owner");
+  EXPECT_EQ(ReadLock(GetCluster(), "key"),
+            (LockRow{std::nullopt, 1, false}));
+}
+
+UTEST_F(PostgreDistLockBatcher, FencingTokenIncrements) {
+  const auto batcher = MakeBatcher();
+
+  EXPECT_EQ(batcher->Acquire("key", "first", kLockTtl), 1);
+  batcher->Release("key", "first");
+
+  EXPECT_EQ(batcher->Acquire("key", "second", kLockTtl), 2);
+  EXPECT_EQ(batcher->Acquire("key", "second", kLockTtl), 2);
+
+  // An expired lock is taken over without a release
+  EXPECT_EQ(batcher->Acquire("key", "second", std::chrono::milliseconds{1}),
+            2);
+  engine::SleepFor(std::chrono::milliseconds{50});
+  EXPECT_EQ(batcher->Acquire("key", "third", kLockTtl), 3);
+  EXPECT_EQ(ReadLock(GetCluster(), "key"), (LockRow{"third", 3, true}));
+
+  // Other keys have their own tokens
+  EXPECT_EQ(batcher->Acquire("other", "first", kLockTtl), 1);
+}
+
+UTEST_F(PostgreDistLockBatcher, Busy) {
+  const auto batcher = MakeBatcher();
+
+  utils::statistics::Storage storage;
+  const auto statistics_holder = storage.RegisterWriter(
+      "distlock",
+      [&batcher](utils::statistics::Writer& writer) { writer = *batcher; });
+
+  EXPECT_EQ(batcher->Acquire("key", "owner", kLockTtl), 1);
+  UEXPECT_THROW(batcher->Acquire("key", "intruder", kLockTtl),
+                dist_lock::LockIsAcquiredByAnotherHostException);
+
+  // A busy lock is left intact
+  EXPECT_EQ(ReadLock(GetCluster(), "key"), (LockRow{"owner", 1, true}));
+
+  // Releasing a lock of another owner does nothing
+  batcher->Release("key", "intruder");
+  EXPECT_EQ(ReadLock(GetCluster(), "key"), (LockRow{"owner", 1, true}));
+
+  const utils::statistics::Snapshot snapshot{storage, "distlock"};
+  EXPECT_EQ(snapshot.SingleMetric("acquired").AsRate().value, 1);
+  EXPECT_EQ(snapshot.SingleMetric("busy").AsRate().value, 1);
+  EXPECT_EQ(snapshot.SingleMetric("batch-failures").AsRate().value, 0);
+}
+
+UTEST_F(PostgreDistLockBatcher, DestroyedWithPendingRequests) {
+  auto batcher = MakeBatcher(utest::kMaxTestWaitTime);
+
+  auto task = engine::AsyncNoSpan([raw_batcher = batcher.get()] {
+    return raw_batcher->Acquire("key", "owner", kLockTtl);
+  });
+  engine::Yield();
+  ASSERT_FALSE(task.IsFinished());
+
+  batcher.reset();
+  UEXPECT_THROW(task.Get(), std::runtime_error);
+}
+
+UTEST_F_MT(PostgreDistLockBatcher, Contention, 4) {
+  const auto batcher = MakeBatcher();
+  constexpr std::size_t kOwners = 16;
+
+  std::vector<engine::TaskWithResult<std::optional<dist_lock::FencingToken>>>
+      tasks;
+  tasks.reserve(kOwners);
+  for (std::size_t i = 0; i < kOwners; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&batcher, i] {
+      return TryAcquire(*batcher, "key", "owner-" + std::to_string(i));
+    }));
+  }
+
+  std::size_t winners = 0;
+  for (auto& task : tasks) {
+    const auto token = task.Get();
+    if (token) {
+      ++winners;
+      EXPECT_EQ(*token, 1);
+    }
+  }
+  EXPECT_EQ(winners, 1);
+}
+
+UTEST_F(PostgreDistLockBatcher, SameKeyInOneBatch) {
+  const auto batcher = MakeBatcher(kSingleBatchInterval);
+
+  utils::statistics::Storage storage;
+  const auto statistics_holder = storage.RegisterWriter(
+      "distlock",
+      [&batcher](utils::statistics::Writer& writer) { writer = *batcher; });
+
+  // An INSERT ... ON CONFLICT fails if it touches a row twice, so the batcher
+  // must send each key only once
+  const std::vector<std::pair<std::string, std::string>> requests{
+      {"key", "first"},
+      {"key", "second"},
+      {"key", "first"},
+      {"other", "first"},
+  };
+  std::vector<engine::TaskWithResult<std::optional<dist_lock::FencingToken>>>
+      tasks;
+  for (const auto& [key, owner] : requests) {
+    tasks.push_back(engine::AsyncNoSpan([&batcher, &key = key, &owner = owner] {
+      return TryAcquire(*batcher, key, owner);
+    }));
+  }
+
+  std::vector<std::optional<dist_lock::FencingToken>> tokens;
+  for (auto& task : tasks) tokens.push_back(task.Get());
+
+  // Whoever got to the batch first wins, the duplicates share its result
+  const auto [winner, is_held, _] = ReadLock(GetCluster(), "key");
+  ASSERT_TRUE(winner);
+  for (std::size_t i = 0; i < 3; ++i) {
+    if (requests[i].second == *winner) {
+      EXPECT_EQ(tokens[i], 1);
+    } else {
+      EXPECT_FALSE(tokens[i]);
+    }
+  }
+  EXPECT_TRUE(is_held);
+  EXPECT_EQ(tokens[3], 1);
+
+  const utils::statistics::Snapshot snapshot{storage, "distlock"};
+  EXPECT_EQ(snapshot.SingleMetric("batches").AsRate().value, 1);
+  EXPECT_EQ(snapshot.SingleMetric("last-batch-size").AsInt(), 2);
+}
+
+UTEST_F(PostgreDistLockBatcher, BatchFailure) {
+  const auto batcher = MakeBatcher(std::chrono::milliseconds{10},
+                                   "distlock_batcher_pgtest_missing");
+
+  utils::statistics::Storage storage;
+  const auto statistics_holder = storage.RegisterWriter(
+      "distlock",
+      [&batcher](utils::statistics::Writer& writer) { writer = *batcher; });
+
+  // The query error is not mistaken for a busy lock
+  UEXPECT_THROW(batcher->Acquire("key", "owner", kLockTtl), pg::Error);
+
+  const utils::statistics::Snapshot snapshot{storage, "distlock"};
+  EXPECT_EQ(snapshot.SingleMetric("batch-failures").AsRate().value, 1);
+  EXPECT_EQ(snapshot.SingleMetric("busy").AsRate().value, 0);
+}
+
+UTEST_F(PostgreDistLockBatcher, Strategy) {
+  const auto batcher = MakeBatcher();
+  pg::BatchedDistLockStrategy strategy{batcher, "key"};
+  pg::BatchedDistLockStrategy other_strategy{batcher, "key"};
+
+  const auto owner =
+      hostinfo::blocking::GetRealHostName() + std::string{":locker"};
+
+  EXPECT_EQ(strategy.AcquireWithFencingToken(kLockTtl, "locker"), 1);
+  EXPECT_EQ(ReadLock(GetCluster(), "key"), (LockRow{owner, 1, true}));
+  UEXPECT_NO_THROW(strategy.Acquire(kLockTtl, "locker"));
+
+  UEXPECT_THROW(other_strategy.Acquire(kLockTtl, "other-locker"),
+                dist_lock::LockIsAcquiredByAnotherHostException);
+
+  strategy.Release("locker");
+  EXPECT_EQ(other_strategy.AcquireWithFencingToken(kLockTtl, "other-locker"),
+            2);
+}
+
+USERVER_NAMESPACE_END
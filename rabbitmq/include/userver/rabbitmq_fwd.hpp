@@ -20,6 +20,7 @@ using ClientPtr = std::shared_ptr<Client>;
 class AdminChannel;
 class Channel;
 class ReliableChannel;
+class PublishConfirmation;
 
 class Queue;
 class Exchange;
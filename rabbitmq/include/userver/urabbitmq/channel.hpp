@@ -15,6 +15,10 @@ namespace urabbitmq {
 
 class ConnectionPtr;
 
+namespace impl {
+class ResponseAwaiter;
+}
+
 /// @brief Publisher interface for the broker.
 /// You may use this class to publish your messages.
 ///
@@ -48,6 +52,30 @@ class Channel final : IChannelInterface {
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
 
+/// @brief A pending publisher confirm for a message published with
+/// `ReliableChannel::PublishReliableAsync`.
+///
+/// Holds one of the in-flight requests slots of the underlying connection
+/// (see `max_in_flight_requests` of the pool settings) until it is destroyed,
+/// so keep a bounded window of confirmations and wait for the oldest one
+/// before publishing more.
+class PublishConfirmation final {
+ public:
+  PublishConfirmation(impl::ResponseAwaiter&& awaiter);
+  ~PublishConfirmation();
+
+  PublishConfirmation(PublishConfirmation&& other) noexcept;
+  PublishConfirmation& operator=(PublishConfirmation&& other) noexcept;
+
+  /// @brief Wait for the broker to confirm the message.
+  /// Throws if the broker rejected the message, the connection broke or the
+  /// deadline expired; in that case the message might have not been delivered.
+  void Wait(engine::Deadline deadline);
+
+ private:
+  std::unique_ptr<impl::ResponseAwaiter> awaiter_;
+};
+
 /// @brief Reliable publisher interface for the broker.
 /// You may use this class to reliably publish your messages
 /// (publisher-confirms).
@@ -77,6 +105,20 @@ class ReliableChannel final : IReliableChannelInterface {
                     deadline);
   }
 
+  /// @brief Publish a message to an exchange without waiting for the broker
+  /// confirmation.
+  ///
+  /// Allows pipelining: many messages could be published one after another
+  /// and awaited later, confirmations arrive in the background as the broker
+  /// sends them. The amount of outstanding `PublishConfirmation`s is bounded
+  /// by `max_in_flight_requests` of the pool settings, the call blocks until
+  /// a slot is available or `deadline` expires.
+  ///
+  /// Messages published via a single `ReliableChannel` are sent in order.
+  [[nodiscard]] PublishConfirmation PublishReliableAsync(
+      const Exchange& exchange, const std::string& routing_key,
+      const std::string& message, MessageType type, engine::Deadline deadline);
+
  private:
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
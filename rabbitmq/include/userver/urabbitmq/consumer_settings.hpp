@@ -3,6 +3,7 @@
 /// @file userver/urabbitmq/consumer_settings.hpp
 /// @brief Consumer settings.
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/urabbitmq/typedefs.hpp>
@@ -24,6 +25,19 @@ struct ConsumerSettings final {
   /// Settings this value to 1 basically makes a consumer synchronous, which
   /// could be of use for some workloads
   std::uint16_t prefetch_count;
+
+  /// Processed messages are acknowledged to the broker with a single
+  /// `multiple` ack once this many of them are settled in delivery order.
+  /// Keep this value well below `prefetch_count`, otherwise the broker stops
+  /// delivering before a batch is complete and only `ack_flush_interval`
+  /// makes progress.
+  ///
+  /// Value of 1 (the default) acks every message as soon as it is processed.
+  std::uint16_t ack_batch_size{1};
+
+  /// Upper bound on how long a processed message may stay unacked while
+  /// waiting for its batch to fill up. Ignored if `ack_batch_size` is 1.
+  std::chrono::milliseconds ack_flush_interval{100};
 };
 
 }  // namespace urabbitmq
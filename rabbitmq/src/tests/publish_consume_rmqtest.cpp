@@ -1,5 +1,6 @@
 #include "utils_rmqtest.hpp"
 
+#include <deque>
 #include <optional>
 
 #include <userver/engine/sleep.hpp>
@@ -234,4 +235,44 @@ UTEST(Consumer, ForDifferentQueuesWork) {
       .RemoveQueue(second_queue, client.GetDeadline());
 }
 
+UTEST(Consumer, BatchedAcksWork) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+
+  const size_t messages_count = 1000;
+  {
+    auto channel = client->GetReliableChannel(client.GetDeadline());
+    // keep a few publishes in flight, bounded by max_in_flight_requests
+    const size_t window_size = 4;
+    std::deque<urabbitmq::PublishConfirmation> in_flight;
+    for (size_t i = 0; i < messages_count; ++i) {
+      if (in_flight.size() == window_size) {
+        in_flight.front().Wait(client.GetDeadline());
+        in_flight.pop_front();
+      }
+      in_flight.push_back(channel.PublishReliableAsync(
+          client.GetExchange(), client.GetRoutingKey(), std::to_string(i),
+          urabbitmq::MessageType::kTransient, client.GetDeadline()));
+    }
+    for (auto& confirmation : in_flight) {
+      confirmation.Wait(client.GetDeadline());
+    }
+  }
+
+  urabbitmq::ConsumerSettings settings{client.GetQueue(), 50};
+  settings.ack_batch_size = 16;
+  {
+    Consumer consumer{client.Get(), settings};
+    consumer.ExpectConsume(messages_count);
+    consumer.Start();
+    EXPECT_EQ(consumer.Wait().size(), messages_count);
+  }
+
+  // everything is acked, nothing gets redelivered
+  Consumer consumer{client.Get(), settings};
+  consumer.Start();
+  engine::InterruptibleSleepFor(std::chrono::milliseconds{200});
+  EXPECT_EQ(consumer.Get().size(), 0);
+}
+
 USERVER_NAMESPACE_END
@@ -1,7 +1,10 @@
 #include <userver/urabbitmq/channel.hpp>
 
+#include <userver/utils/assert.hpp>
+
 #include <urabbitmq/connection_helper.hpp>
 #include <urabbitmq/connection_ptr.hpp>
+#include <urabbitmq/impl/response_awaiter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -27,6 +30,32 @@ std::string Channel::Get(const Queue& queue, utils::Flags<Queue::Flags> flags,
   return message;
 }
 
+PublishConfirmation::PublishConfirmation(impl::ResponseAwaiter&& awaiter)
+    : awaiter_{std::make_unique<impl::ResponseAwaiter>(std::move(awaiter))} {}
+
+PublishConfirmation::~PublishConfirmation() {
+  // Dropping an unawaited confirmation is fine here, the message was sent and
+  // the confirm (if any) will just be ignored
+  if (awaiter_) awaiter_->Abandon();
+}
+
+PublishConfirmation::PublishConfirmation(PublishConfirmation&& other) noexcept =
+    default;
+
+PublishConfirmation& PublishConfirmation::operator=(
+    PublishConfirmation&& other) noexcept {
+  if (this != &other) {
+    if (awaiter_) awaiter_->Abandon();
+    awaiter_ = std::move(other.awaiter_);
+  }
+  return *this;
+}
+
+void PublishConfirmation::Wait(engine::Deadline deadline) {
+  UINVARIANT(awaiter_, "Wait called on a moved-from PublishConfirmation");
+  awaiter_->Wait(deadline);
+}
+
 ReliableChannel::ReliableChannel(ConnectionPtr&& channel)
     : impl_{std::move(channel)} {}
 
@@ -44,6 +73,13 @@ void ReliableChannel::PublishReliable(const Exchange& exchange,
       .Wait(deadline);
 }
 
+PublishConfirmation ReliableChannel::PublishReliableAsync(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::string& message, MessageType type, engine::Deadline deadline) {
+  return {ConnectionHelper::PublishReliable(*impl_, exchange, routing_key,
+                                            message, type, deadline)};
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include "consumer_base_impl.hpp"
 
+#include <mutex>
 #include <string>
 
 #include <fmt/format.h>
@@ -8,6 +9,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 #include <urabbitmq/connection.hpp>
 #include <urabbitmq/impl/amqp_channel.hpp>
@@ -28,6 +30,8 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
     : dispatcher_{engine::current_task::GetTaskProcessor()},
       queue_name_{settings.queue.GetUnderlying()},
       prefetch_count_{settings.prefetch_count},
+      ack_batch_size_{settings.ack_batch_size},
+      ack_flush_interval_{settings.ack_flush_interval},
       connection_ptr_{std::move(connection)},
       channel_{connection_ptr_->GetChannel()} {
   // We take ownership of the connection, because if it remains pooled
@@ -56,15 +60,20 @@ void ConsumerBaseImpl::Start(DispatchCallback cb) {
         }
       },
       // message callback
-      [this](const AMQP::Message& message, uint64_t delivery_tag, bool) {
+      [this](impl::DeliveredMessage&& message, uint64_t delivery_tag) {
         // We received a message but won't ack it, so it will be requeued
         // at some point
         if (!stopped_) {
-          OnMessage(message, delivery_tag);
+          OnMessage(std::move(message), delivery_tag);
         }
       },
       start_deadline);
 
+  if (ack_batch_size_ > 1) {
+    ack_flusher_.Start(fmt::format("{}_consumer_ack_flusher", queue_name_),
+                       {ack_flush_interval_}, [this] { FlushAcks(); });
+  }
+
   LOG_INFO() << "Started a consumer for '" << queue_name_ << "' queue";
 }
 
@@ -76,9 +85,19 @@ void ConsumerBaseImpl::Stop() {
     // Connection is broken, but that's not a problem
   }
 
+  ack_flusher_.Stop();
+
   // Cancel all the active dispatched tasks
   bts_.CancelAndWait();
 
+  // Send the acks for the messages we already processed, otherwise they would
+  // be redelivered
+  try {
+    FlushAcks();
+  } catch (const std::exception&) {
+    // Connection is broken, messages will be requeued by RabbitMQ
+  }
+
   // Destroy the connection: at this point all the remaining tasks are stopped,
   // consumer is either stopped or in unknown state - that could happen if we
   // didn't receive onSuccess callback yet.
@@ -91,16 +110,18 @@ bool ConsumerBaseImpl::IsBroken() const {
   return broken_ || !connection_ptr_.IsUsable();
 }
 
-void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
+void ConsumerBaseImpl::OnMessage(impl::DeliveredMessage&& message,
                                  uint64_t delivery_tag) {
+  if (ack_batch_size_ > 1) {
+    uint64_t expected = 0;
+    first_delivery_tag_.compare_exchange_strong(expected, delivery_tag);
+  }
+
   std::string span_name{fmt::format("consume_{}_{}", queue_name_,
                                     consumer_tag_.value_or("ctag:unknown"))};
-  std::string trace_id = message.headers().get("u-trace-id");
-  std::string parent_span_id = message.headers().get("u-parent-span-id");
-  ConsumedMessage consumed;
-  consumed.message = std::string(message.body(), message.bodySize());
-  consumed.metadata.exchange = message.exchange();
-  consumed.metadata.routingKey = message.routingkey();
+  std::string trace_id = std::move(message.trace_id);
+  std::string parent_span_id = std::move(message.parent_span_id);
+  ConsumedMessage consumed = std::move(message.consumed);
 
   bts_.Detach(engine::AsyncNoSpan(
       dispatcher_,
@@ -110,6 +131,20 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
         auto span = tracing::Span::MakeSpan(std::move(span_name), trace_id,
                                             {parent_span_id});
         bool success = false;
+        // The delivery is settled however the handler exits, otherwise the
+        // batched acks would stall on its tag
+        const utils::ScopeGuard settle_guard{[this, delivery_tag, &success] {
+          try {
+            Settle(delivery_tag, success);
+          } catch (const std::exception& ex) {
+            LOG_WARNING()
+                << "Failed to " << (success ? "ack" : "requeue")
+                << " the message, it will be requeued by RabbitMQ at some "
+                   "point: "
+                << ex;
+          }
+        }};
+
         try {
           dispatch_callback_(std::move(consumed));
           success = true;
@@ -117,22 +152,72 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
           LOG_ERROR() << "Failed to process the consumed message, " << ex.what()
                       << "; would requeue";
         }
-
-        try {
-          if (success) {
-            channel_.Ack(delivery_tag, {});
-            channel_.AccountMessageConsumed();
-          } else {
-            channel_.Reject(delivery_tag, true, {});
-          }
-        } catch (const std::exception& ex) {
-          LOG_WARNING()
-              << "Failed to " << (success ? "ack" : "requeue")
-              << " the message, it will be requeued by RabbitMQ at some point";
-        }
       }));
 }
 
+void ConsumerBaseImpl::Settle(uint64_t delivery_tag, bool success) {
+  if (!success) {
+    try {
+      channel_.Reject(delivery_tag, true, {});
+    } catch (const std::exception&) {
+      // The next `multiple` ack would ack the delivery instead of requeueing
+      // it. Have the consumer restarted, RabbitMQ requeues the unacked
+      // deliveries of the closed channel.
+      broken_.store(true, std::memory_order_relaxed);
+      throw;
+    }
+  } else {
+    channel_.AccountMessageConsumed();
+  }
+
+  if (ack_batch_size_ == 1) {
+    if (success) channel_.Ack(delivery_tag, false, {});
+    return;
+  }
+
+  std::optional<uint64_t> ack_up_to;
+  {
+    std::lock_guard lock{ack_mutex_};
+    auto& state = ack_state_;
+    if (!state.initialized) {
+      const auto first_tag = first_delivery_tag_.load();
+      UASSERT(first_tag != 0 && first_tag <= delivery_tag);
+      state.settled_up_to = state.acked_up_to = first_tag - 1;
+      state.initialized = true;
+    }
+
+    state.settled_out_of_order.insert(delivery_tag);
+    auto it = state.settled_out_of_order.begin();
+    while (it != state.settled_out_of_order.end() &&
+           *it == state.settled_up_to + 1) {
+      ++state.settled_up_to;
+      it = state.settled_out_of_order.erase(it);
+    }
+
+    if (state.settled_up_to - state.acked_up_to >= ack_batch_size_) {
+      ack_up_to = state.acked_up_to = state.settled_up_to;
+    }
+  }
+
+  // Already rejected deliveries are not affected by a `multiple` ack
+  if (ack_up_to.has_value()) channel_.Ack(*ack_up_to, true, {});
+}
+
+void ConsumerBaseImpl::FlushAcks() {
+  if (ack_batch_size_ == 1) return;
+
+  std::optional<uint64_t> ack_up_to;
+  {
+    std::lock_guard lock{ack_mutex_};
+    auto& state = ack_state_;
+    if (state.initialized && state.settled_up_to > state.acked_up_to) {
+      ack_up_to = state.acked_up_to = state.settled_up_to;
+    }
+  }
+
+  if (ack_up_to.has_value()) channel_.Ack(*ack_up_to, true, {});
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
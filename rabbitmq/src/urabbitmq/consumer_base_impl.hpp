@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <set>
 
 #include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 #include <urabbitmq/connection_ptr.hpp>
 
@@ -17,7 +20,8 @@ namespace urabbitmq {
 
 namespace impl {
 class AmqpChannel;
-}
+struct DeliveredMessage;
+}  // namespace impl
 
 class ConsumerBaseImpl final {
  public:
@@ -32,18 +36,42 @@ class ConsumerBaseImpl final {
   bool IsBroken() const;
 
  private:
-  void OnMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void OnMessage(impl::DeliveredMessage&& message, uint64_t delivery_tag);
   void Stop();
 
+  // Acks (possibly in a batch) or requeues the message once it's processed
+  void Settle(uint64_t delivery_tag, bool success);
+  void FlushAcks();
+
   engine::TaskProcessor& dispatcher_;
   const std::string queue_name_;
   uint16_t prefetch_count_;
+  const uint16_t ack_batch_size_;
+  const std::chrono::milliseconds ack_flush_interval_;
 
   ConnectionPtr connection_ptr_;
   impl::AmqpChannel& channel_;
 
   std::optional<std::string> consumer_tag_;
 
+  // Delivery tags are channel-wide and the channel might have been used
+  // before we adopted it, so we start counting from the first delivery seen
+  std::atomic<uint64_t> first_delivery_tag_{0};
+
+  struct AckState final {
+    bool initialized{false};
+    // All the deliveries up to this one are either acked, rejected or
+    // processed and waiting for the batch ack
+    uint64_t settled_up_to{0};
+    // All the deliveries up to this one are already acked or rejected
+    uint64_t acked_up_to{0};
+    // Settled deliveries that are not contiguous with `settled_up_to` yet
+    std::set<uint64_t> settled_out_of_order;
+  };
+  engine::Mutex ack_mutex_;
+  AckState ack_state_;
+  utils::PeriodicTask ack_flusher_;
+
   DispatchCallback dispatch_callback_;
 
   std::atomic<bool> stopped_{false};
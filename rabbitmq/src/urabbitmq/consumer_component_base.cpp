@@ -19,7 +19,16 @@ ConsumerSettings Parse(const yaml_config::YamlConfig& config,
   settings.queue = Queue{config["queue"].As<std::string>()};
   settings.prefetch_count = config["prefetch_count"].As<uint16_t>();
 
+  settings.ack_batch_size =
+      config["ack_batch_size"].As<uint16_t>(settings.ack_batch_size);
+  settings.ack_flush_interval =
+      config["ack_flush_interval"].As<std::chrono::milliseconds>(
+          settings.ack_flush_interval);
+
   UINVARIANT(settings.prefetch_count > 0, "prefetch_count is set to zero");
+  UINVARIANT(settings.ack_batch_size > 0, "ack_batch_size is set to zero");
+  UINVARIANT(settings.ack_batch_size <= settings.prefetch_count,
+             "ack_batch_size should not exceed prefetch_count");
 
   return settings;
 }
@@ -83,6 +92,17 @@ properties:
     prefetch_count:
         type: integer
         description: prefetch_count for the consumer
+    ack_batch_size:
+        type: integer
+        description: |
+            acknowledge processed messages with a single 'multiple' ack
+            once this many of them are settled, 1 disables batching
+        defaultDescription: 1
+    ack_flush_interval:
+        type: string
+        description: |
+            max time a processed message may wait for its ack batch to fill up
+        defaultDescription: 100ms
 )");
 }
 
@@ -1,6 +1,8 @@
 #include "amqp_channel.hpp"
 
+#include <chrono>
 #include <optional>
+#include <utility>
 
 #include <userver/engine/task/task.hpp>
 #include <userver/tracing/span.hpp>
@@ -181,10 +183,11 @@ void AmqpChannel::Publish(const Exchange& exchange,
   // We don't account publish here, because there's no way to ensure success
 }
 
-void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline) {
+void AmqpChannel::Ack(uint64_t delivery_tag, bool multiple,
+                      engine::Deadline deadline) {
   // No way to acknowledge success, no way to handle synchronous errors
   auto channel = conn_.GetChannel(deadline);
-  channel->ack(delivery_tag);
+  channel->ack(delivery_tag, multiple ? AMQP::multiple : 0);
 }
 
 void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
@@ -210,10 +213,38 @@ void AmqpChannel::SetupConsumer(const std::string& queue, ErrorCb error_cb,
                                 engine::Deadline deadline) {
   auto channel = conn_.GetChannel(deadline);
 
+  // We don't use onMessage here: AMQP-CPP would assemble the body into its
+  // own buffer just for us to copy it once again. Instead the body frames are
+  // appended to a buffer preallocated from the announced message size, which
+  // is then moved into the callback. Callbacks for a channel are invoked
+  // sequentially from the socket reader, so a single buffer is enough.
+  auto delivery = std::make_shared<DeliveredMessage>();
+
   channel->onError(error_cb);
   channel->consume(queue)
       .onSuccess(success_cb)
-      .onMessage(message_cb)
+      .onBegin([delivery](const std::string& exchange,
+                          const std::string& routing_key) {
+        delivery->consumed.metadata.exchange = exchange;
+        delivery->consumed.metadata.routingKey = routing_key;
+      })
+      .onSize([delivery](uint64_t body_size) {
+        delivery->consumed.message.reserve(body_size);
+      })
+      .onHeaders([delivery](const AMQP::MetaData& metadata) {
+        std::string trace_id = metadata.headers().get("u-trace-id");
+        std::string parent_span_id =
+            metadata.headers().get("u-parent-span-id");
+        delivery->trace_id = std::move(trace_id);
+        delivery->parent_span_id = std::move(parent_span_id);
+      })
+      .onData([delivery](const char* data, size_t size) {
+        delivery->consumed.message.append(data, size);
+      })
+      .onDelivered([delivery, message_cb = std::move(message_cb)](
+                       uint64_t delivery_tag, bool) {
+        message_cb(std::exchange(*delivery, DeliveredMessage{}), delivery_tag);
+      })
       .onError(error_cb);
 }
 
@@ -248,12 +279,23 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
   {
     auto reliable = conn_.GetReliableChannel(deadline);
 
+    // Confirms arrive asynchronously, so many publishes could be in flight
+    // on the channel at once, see ReliableChannel::PublishReliableAsync
+    const auto start = std::chrono::steady_clock::now();
+    auto& stats = conn_.GetStatistics();
+    stats.AccountReliablePublishStarted();
+
     reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
-        .onAck([this, deferred = awaiter.GetWrapper()] {
+        .onAck([this, &stats, start, deferred = awaiter.GetWrapper()] {
+          stats.AccountReliablePublishFinished(
+              std::chrono::steady_clock::now() - start);
           AccountMessagePublished();
           deferred->Ok();
         })
-        .onError([deferred = awaiter.GetWrapper()](const char* error) {
+        .onError([&stats, start,
+                  deferred = awaiter.GetWrapper()](const char* error) {
+          stats.AccountReliablePublishFinished(
+              std::chrono::steady_clock::now() - start);
           deferred->Fail(error);
         });
   }
@@ -28,6 +28,13 @@ namespace urabbitmq::impl {
 class AmqpConnection;
 class AmqpReliableChannel;
 
+// A consumed message assembled from the delivery frames
+struct DeliveredMessage final {
+  ConsumedMessage consumed;
+  std::string trace_id;
+  std::string parent_span_id;
+};
+
 class AmqpChannel final {
  public:
   AmqpChannel(AmqpConnection& conn);
@@ -57,7 +64,9 @@ class AmqpChannel final {
                const std::string& message, MessageType type,
                engine::Deadline deadline);
 
-  void Ack(uint64_t delivery_tag, engine::Deadline deadline);
+  // With `multiple` set acknowledges all the outstanding deliveries up to and
+  // including `delivery_tag`
+  void Ack(uint64_t delivery_tag, bool multiple, engine::Deadline deadline);
 
   void Reject(uint64_t delivery_tag, bool requeue, engine::Deadline deadline);
 
@@ -65,7 +74,7 @@ class AmqpChannel final {
 
   using ErrorCb = std::function<void(const char*)>;
   using SuccessCb = std::function<void(const std::string&)>;
-  using MessageCb = std::function<void(const AMQP::Message&, uint64_t, bool)>;
+  using MessageCb = std::function<void(DeliveredMessage&&, uint64_t)>;
   void SetupConsumer(const std::string& queue, ErrorCb error_cb,
                      SuccessCb success_cb, MessageCb message_cb,
                      engine::Deadline deadline);
@@ -0,0 +1,54 @@
+#include "read_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq::impl::io {
+
+ReadBuffer::ReadBuffer() { data_.resize(kMinReadSize); }
+
+utils::span<char> ReadBuffer::PrepareWrite(std::size_t expected_size) {
+  const auto readable_size = end_ - begin_;
+  const auto required_free = std::max(
+      kMinReadSize,
+      expected_size > readable_size ? expected_size - readable_size : 0);
+
+  if (data_.size() - end_ < required_free && begin_ != 0) {
+    // Only the tail of a partially received frame is moved, which is much
+    // cheaper than moving the remainder after every parse
+    std::memmove(data_.data(), data_.data() + begin_, readable_size);
+    begin_ = 0;
+    end_ = readable_size;
+  }
+
+  if (data_.size() - end_ < required_free) {
+    data_.resize(std::max(data_.size() * 2, end_ + required_free));
+  }
+
+  return {data_.data() + end_, data_.size() - end_};
+}
+
+void ReadBuffer::CommitWrite(std::size_t size) noexcept {
+  UASSERT(end_ + size <= data_.size());
+  end_ += size;
+}
+
+std::string_view ReadBuffer::Readable() const noexcept {
+  return {data_.data() + begin_, end_ - begin_};
+}
+
+void ReadBuffer::Consume(std::size_t size) noexcept {
+  UASSERT(begin_ + size <= end_);
+  begin_ += size;
+  if (begin_ == end_) {
+    begin_ = end_ = 0;
+  }
+}
+
+}  // namespace urabbitmq::impl::io
+
+USERVER_NAMESPACE_END
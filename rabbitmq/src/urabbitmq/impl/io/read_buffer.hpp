@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq::impl::io {
+
+// Buffer for the incoming AMQP data.
+//
+// Socket is read directly into the free tail of the buffer and parsed bytes
+// are dropped from the head without moving the rest of the data, so in the
+// common case of a fully parsed read there are no copies at all.
+// The buffer grows to fit the biggest frame the connection expects and is
+// reused afterwards, so big message bodies don't cause reallocations once the
+// buffer is warmed up.
+class ReadBuffer final {
+ public:
+  static constexpr std::size_t kMinReadSize = 1 << 15;
+
+  ReadBuffer();
+
+  // Returns the writable tail of at least
+  // max(kMinReadSize, `expected_size` - unparsed bytes) bytes.
+  utils::span<char> PrepareWrite(std::size_t expected_size);
+
+  // Marks `size` bytes of the span returned by `PrepareWrite` as written.
+  void CommitWrite(std::size_t size) noexcept;
+
+  // Data that is read but not consumed yet.
+  std::string_view Readable() const noexcept;
+
+  // Drops `size` bytes from the head of readable data.
+  void Consume(std::size_t size) noexcept;
+
+  std::size_t Capacity() const noexcept { return data_.size(); }
+
+ private:
+  std::vector<char> data_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+};
+
+}  // namespace urabbitmq::impl::io
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,170 @@
+#include <urabbitmq/impl/io/read_buffer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// AMQP frame: type(1) + channel(2) + payload size(4) + payload + frame-end(1)
+constexpr std::size_t kFrameHeaderSize = 7;
+constexpr std::size_t kFrameOverhead = kFrameHeaderSize + 1;
+constexpr std::uint8_t kFrameBody = 3;
+constexpr char kFrameEnd = '\xCE';
+// Default frame_max negotiated by RabbitMQ
+constexpr std::size_t kMaxFrameSize = 131072;
+// What a single socket read typically returns
+constexpr std::size_t kSocketChunkSize = 65536;
+
+std::string MakeBodyFrames(std::size_t body_size) {
+  std::string result;
+  const auto max_payload = kMaxFrameSize - kFrameOverhead;
+  for (std::size_t offset = 0; offset < body_size; offset += max_payload) {
+    const auto payload_size =
+        static_cast<std::uint32_t>(std::min(max_payload, body_size - offset));
+    result.push_back(static_cast<char>(kFrameBody));
+    result.append(2, '\0');
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      result.push_back(static_cast<char>((payload_size >> shift) & 0xFF));
+    }
+    result.append(payload_size, 'x');
+    result.push_back(kFrameEnd);
+  }
+  return result;
+}
+
+// Mimics AMQP::Connection::parse and ::expected: consumes complete frames
+// and appends their payload to the message body like the consumer does
+class FrameParser final {
+ public:
+  explicit FrameParser(std::size_t body_size) { body_.reserve(body_size); }
+
+  std::size_t Parse(const char* data, std::size_t size) {
+    std::size_t parsed = 0;
+    while (size - parsed >= kFrameHeaderSize) {
+      const auto* header =
+          reinterpret_cast<const unsigned char*>(data + parsed);
+      const std::size_t payload_size = (std::size_t{header[3]} << 24) |
+                                       (std::size_t{header[4]} << 16) |
+                                       (std::size_t{header[5]} << 8) |
+                                       std::size_t{header[6]};
+      expected_ = payload_size + kFrameOverhead;
+      if (size - parsed < expected_) break;
+
+      body_.append(data + parsed + kFrameHeaderSize, payload_size);
+      parsed += expected_;
+      expected_ = kFrameHeaderSize;
+    }
+    return parsed;
+  }
+
+  std::size_t Expected() const { return expected_; }
+
+  std::string ReleaseBody() { return std::move(body_); }
+
+ private:
+  std::string body_;
+  std::size_t expected_{kFrameHeaderSize};
+};
+
+// The previous reader implementation: read into a temporary buffer, append
+// to the accumulated data, parse, move the remainder to the front
+class CopyingReader final {
+ public:
+  CopyingReader() { data_.resize(kTmpBufferSize); }
+
+  template <typename Socket>
+  std::size_t ReadAndParse(Socket& socket, FrameParser& parser) {
+    const auto bytes_read = socket.ReadSome(tmp_buffer_, kTmpBufferSize);
+    data_.resize(size_ + bytes_read);
+    std::memcpy(data_.data() + size_, tmp_buffer_, bytes_read);
+    size_ += bytes_read;
+
+    const auto parsed = parser.Parse(data_.data(), size_);
+    if (parsed != 0) {
+      std::memmove(data_.data(), data_.data() + parsed, size_ - parsed);
+      size_ -= parsed;
+    }
+    return bytes_read;
+  }
+
+ private:
+  static constexpr std::size_t kTmpBufferSize = 1 << 15;
+  char tmp_buffer_[kTmpBufferSize]{};
+
+  std::vector<char> data_{};
+  std::size_t size_{0};
+};
+
+class ZeroCopyReader final {
+ public:
+  template <typename Socket>
+  std::size_t ReadAndParse(Socket& socket, FrameParser& parser) {
+    const auto free_space = buffer_.PrepareWrite(parser.Expected());
+    const auto bytes_read =
+        socket.ReadSome(free_space.data(), free_space.size());
+    buffer_.CommitWrite(bytes_read);
+
+    const auto readable = buffer_.Readable();
+    buffer_.Consume(parser.Parse(readable.data(), readable.size()));
+    return bytes_read;
+  }
+
+ private:
+  urabbitmq::impl::io::ReadBuffer buffer_;
+};
+
+// Hands out the frames in chunks, like a socket does
+class FakeSocket final {
+ public:
+  explicit FakeSocket(std::string_view data) : data_{data} {}
+
+  std::size_t ReadSome(char* buf, std::size_t size) {
+    const auto to_read =
+        std::min({size, kSocketChunkSize, data_.size() - offset_});
+    std::memcpy(buf, data_.data() + offset_, to_read);
+    offset_ += to_read;
+    return to_read;
+  }
+
+  bool IsExhausted() const { return offset_ == data_.size(); }
+
+ private:
+  std::string_view data_;
+  std::size_t offset_{0};
+};
+
+}  // namespace
+
+template <typename Reader>
+void rabbitmq_read_body_frames(benchmark::State& state) {
+  const auto body_size = static_cast<std::size_t>(state.range(0));
+  const auto frames = MakeBodyFrames(body_size);
+
+  // The reader lives as long as the connection does
+  Reader reader;
+  for ([[maybe_unused]] auto _ : state) {
+    FakeSocket socket{frames};
+    FrameParser parser{body_size};
+    while (!socket.IsExhausted()) {
+      reader.ReadAndParse(socket, parser);
+    }
+    benchmark::DoNotOptimize(parser.ReleaseBody());
+  }
+  state.SetBytesProcessed(state.iterations() * frames.size());
+}
+BENCHMARK_TEMPLATE(rabbitmq_read_body_frames, CopyingReader)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(rabbitmq_read_body_frames, ZeroCopyReader)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+
+USERVER_NAMESPACE_END
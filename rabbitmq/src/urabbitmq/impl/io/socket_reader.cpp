@@ -1,7 +1,5 @@
 #include "socket_reader.hpp"
 
-#include <cstring>
-
 #include <userver/engine/io/common.hpp>
 #include <userver/logging/log.hpp>
 
@@ -32,34 +30,36 @@ void SocketReader::Start(AmqpConnection* connection) {
 
 void SocketReader::Stop() { reader_task_.SyncCancel(); }
 
-SocketReader::Buffer::Buffer() { data_.resize(kTmpBufferSize); }
-
 bool SocketReader::Buffer::Read(engine::io::RwBase& socket,
                                 AmqpConnection* conn,
                                 AmqpConnectionHandler& parent) {
   try {
     bool is_readable = true;
-    if (last_bytes_read_ != kTmpBufferSize) {
+    if (!last_read_filled_buffer_) {
       is_readable = socket.WaitReadable({});
     }
 
-    last_bytes_read_ =
-        is_readable ? socket.ReadSome(&tmp_buffer_[0], kTmpBufferSize, {}) : 0;
-    if (last_bytes_read_ == 0) {
+    // Read directly into the buffer, sized to hold the whole expected frame
+    const auto free_space = data_.PrepareWrite(expected_size_);
+    const auto bytes_read =
+        is_readable ? socket.ReadSome(free_space.data(), free_space.size(), {})
+                    : 0;
+    if (bytes_read == 0) {
       throw std::runtime_error{"Connection is closed by remote"};
     }
-
-    data_.resize(size_ + last_bytes_read_);
-    std::memcpy(data_.data() + size_, &tmp_buffer_[0], last_bytes_read_);
-    size_ += last_bytes_read_;
+    last_read_filled_buffer_ = bytes_read == free_space.size();
+    data_.CommitWrite(bytes_read);
 
     const auto parsed = [this, conn] {
       auto lock = AmqpConnectionLocker{*conn}.Lock({});
-      return conn->GetNative().parse(data_.data(), size_);
+      const auto readable = data_.Readable();
+      const auto parsed_bytes =
+          conn->GetNative().parse(readable.data(), readable.size());
+      expected_size_ = conn->GetNative().expected();
+      return parsed_bytes;
     }();
     if (parsed != 0) {
-      std::memmove(data_.data(), data_.data() + parsed, size_ - parsed);
-      size_ -= parsed;
+      data_.Consume(parsed);
       parent.AccountRead(parsed);
     }
 
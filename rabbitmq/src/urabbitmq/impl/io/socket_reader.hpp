@@ -1,9 +1,9 @@
 #pragma once
 
-#include <vector>
-
 #include <userver/engine/async.hpp>
 
+#include <urabbitmq/impl/io/read_buffer.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
@@ -31,19 +31,15 @@ class SocketReader final {
  private:
   class Buffer final {
    public:
-    Buffer();
-
     bool Read(engine::io::RwBase& socket, AmqpConnection* conn,
               AmqpConnectionHandler& parent);
 
    private:
-    static constexpr size_t kTmpBufferSize = 1 << 15;
-    char tmp_buffer_[kTmpBufferSize]{};
-
-    std::vector<char> data_{};
-    size_t size_{0};
+    ReadBuffer data_;
+    // Size of the next frame as reported by the parser
+    size_t expected_size_{0};
 
-    size_t last_bytes_read_{0};
+    bool last_read_filled_buffer_{false};
   };
 
   AmqpConnectionHandler& parent_;
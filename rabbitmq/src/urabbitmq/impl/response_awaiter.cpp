@@ -1,5 +1,7 @@
 #include "response_awaiter.hpp"
 
+#include <utility>
+
 #ifndef NDEBUG
 #include <userver/utils/assert.hpp>
 #endif
@@ -22,7 +24,15 @@ ResponseAwaiter::~ResponseAwaiter() {
 ResponseAwaiter::~ResponseAwaiter() = default;
 #endif
 
-ResponseAwaiter::ResponseAwaiter(ResponseAwaiter&& other) noexcept = default;
+ResponseAwaiter::ResponseAwaiter(ResponseAwaiter&& other) noexcept
+    : span_{std::move(other.span_)},
+      lock_{std::move(other.lock_)},
+      wrapper_{std::move(other.wrapper_)} {
+#ifndef NDEBUG
+  // moved-from awaiter has nothing to wait for
+  awaited_ = std::exchange(other.awaited_, true);
+#endif
+}
 
 void ResponseAwaiter::SetSpan(tracing::Span&& span) {
   span_.emplace(std::move(span));
@@ -35,6 +45,12 @@ void ResponseAwaiter::Wait(engine::Deadline deadline) const {
   GetWrapper()->Wait(deadline);
 }
 
+void ResponseAwaiter::Abandon() noexcept {
+#ifndef NDEBUG
+  awaited_ = true;
+#endif
+}
+
 const std::shared_ptr<DeferredWrapper>& ResponseAwaiter::GetWrapper() const {
   return wrapper_;
 }
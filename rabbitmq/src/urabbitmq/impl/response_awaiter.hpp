@@ -23,6 +23,9 @@ class ResponseAwaiter final {
   void SetSpan(tracing::Span&& span);
   void Wait(engine::Deadline deadline) const;
 
+  // Allows dropping the awaiter without waiting for the response
+  void Abandon() noexcept;
+
   const std::shared_ptr<DeferredWrapper>& GetWrapper() const;
 
  private:
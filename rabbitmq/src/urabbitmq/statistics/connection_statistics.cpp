@@ -6,6 +6,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace urabbitmq::statistics {
 
+namespace {
+
+// milliseconds
+constexpr double kPublishConfirmBounds[] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000,
+};
+
+}  // namespace
+
+ConnectionStatistics::ConnectionStatistics()
+    : publish_confirm_timings_{kPublishConfirmBounds} {}
+
 void ConnectionStatistics::AccountConnectionCreated() {
   ++connections_created_;
 }
@@ -26,18 +38,34 @@ void ConnectionStatistics::AccountMessagePublished() { ++messages_published_; }
 
 void ConnectionStatistics::AccountMessageConsumed() { ++messages_consumed_; }
 
+void ConnectionStatistics::AccountReliablePublishStarted() {
+  ++reliable_publishes_in_flight_;
+}
+
+void ConnectionStatistics::AccountReliablePublishFinished(
+    std::chrono::steady_clock::duration confirm_latency) noexcept {
+  --reliable_publishes_in_flight_;
+  publish_confirm_timings_.Account(
+      std::chrono::duration<double, std::milli>{confirm_latency}.count());
+}
+
 ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   Frozen result{};
+  result.publish_confirm_timings.Add(publish_confirm_timings_.GetView());
   result.connections_created = connections_created_.Load();
   result.connections_closed = connections_closed_.Load();
   result.bytes_sent = bytes_sent_.Load();
   result.bytes_read = bytes_read_.Load();
   result.messages_published = messages_published_.Load();
   result.messages_consumed = messages_consumed_.Load();
+  result.reliable_publishes_in_flight = reliable_publishes_in_flight_.Load();
 
   return result;
 }
 
+ConnectionStatistics::Frozen::Frozen()
+    : publish_confirm_timings{kPublishConfirmBounds} {}
+
 ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
     const Frozen& other) {
   connections_created += other.connections_created;
@@ -46,6 +74,8 @@ ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
   bytes_read += other.bytes_read;
   messages_published += other.messages_published;
   messages_consumed += other.messages_consumed;
+  reliable_publishes_in_flight += other.reliable_publishes_in_flight;
+  publish_confirm_timings.Add(other.publish_confirm_timings.GetView());
 
   return *this;
 }
@@ -58,6 +88,8 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["bytes_read"] = value.bytes_read;
   writer["messages_published"] = value.messages_published;
   writer["messages_consumed"] = value.messages_consumed;
+  writer["reliable_publishes_in_flight"] = value.reliable_publishes_in_flight;
+  writer["publish_confirm_timings"] = value.publish_confirm_timings;
 }
 
 }  // namespace urabbitmq::statistics
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/histogram_aggregator.hpp>
 #include <userver/utils/statistics/relaxed_counter.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
@@ -11,6 +14,8 @@ namespace urabbitmq::statistics {
 
 class ConnectionStatistics final {
  public:
+  ConnectionStatistics();
+
   void AccountConnectionCreated();
   void AccountConnectionClosed() noexcept;
 
@@ -20,7 +25,13 @@ class ConnectionStatistics final {
   void AccountMessagePublished();
   void AccountMessageConsumed();
 
+  void AccountReliablePublishStarted();
+  void AccountReliablePublishFinished(
+      std::chrono::steady_clock::duration confirm_latency) noexcept;
+
   struct Frozen final {
+    Frozen();
+
     Frozen& operator+=(const Frozen& other);
 
     size_t connections_created{0};
@@ -31,6 +42,9 @@ class ConnectionStatistics final {
 
     size_t messages_published{0};
     size_t messages_consumed{0};
+
+    size_t reliable_publishes_in_flight{0};
+    utils::statistics::HistogramAggregator publish_confirm_timings;
   };
   Frozen Get() const;
 
@@ -43,6 +57,9 @@ class ConnectionStatistics final {
 
   utils::statistics::RelaxedCounter<size_t> messages_published_{0};
   utils::statistics::RelaxedCounter<size_t> messages_consumed_{0};
+
+  utils::statistics::RelaxedCounter<size_t> reliable_publishes_in_flight_{0};
+  utils::statistics::Histogram publish_confirm_timings_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -3,17 +3,120 @@
 /// @file userver/storages/rocks/client.hpp
 /// @brief @copybrief storages::rocks::Client
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
 
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::rocks {
 
+/// @brief Settings for storages::rocks::Client
+struct ClientSettings final {
+  /// Column families to open in addition to the default one, missing ones
+  /// are created. Column families already present in the database are opened
+  /// regardless of this list.
+  std::vector<std::string> column_families;
+
+  /// Group concurrent Put and Delete calls into a single atomic WriteBatch,
+  /// trading a bit of latency for much higher write throughput under
+  /// concurrency.
+  bool write_coalescing{false};
+
+  /// Max number of operations in a single coalesced WriteBatch.
+  std::size_t max_coalesced_writes{1024};
+};
+
+/// @brief A record returned by storages::rocks::Cursor
+struct KeyValue final {
+  std::string key;
+  std::string value;
+};
+
+class Client;
+
+/**
+ * @brief A set of updates applied atomically by storages::rocks::Client::Write
+ *
+ * Usually retrieved from storages::rocks::Client::MakeWriteBatch. Must not
+ * outlive the client it was created by.
+ */
+class WriteBatch final {
+ public:
+  /**
+   * @brief Adds a record to be put into the database.
+   *
+   * @param key The key of the record.
+   * @param value The value of the record.
+   * @param column_family The column family name, default one if empty.
+   */
+  void Put(std::string_view key, std::string_view value,
+           std::string_view column_family = {});
+
+  /**
+   * @brief Adds a record to be deleted from the database.
+   *
+   * @param key The key of the record.
+   * @param column_family The column family name, default one if empty.
+   */
+  void Delete(std::string_view key, std::string_view column_family = {});
+
+  /// @brief Number of operations in the batch.
+  std::size_t GetSize() const;
+
+ private:
+  friend class Client;
+
+  explicit WriteBatch(const Client& client);
+
+  const Client* client_;
+  rocksdb::WriteBatch batch_;
+};
+
+/**
+ * @brief Streams the records of a key range to the coroutine in chunks.
+ *
+ * Usually retrieved from storages::rocks::Client::Scan or
+ * storages::rocks::Client::ScanPrefix. The cursor sees a consistent snapshot
+ * of the database taken at the first NextChunk call. Must not outlive the
+ * client it was created by.
+ */
+class Cursor final {
+ public:
+  Cursor(Cursor&&) noexcept;
+  Cursor& operator=(Cursor&&) noexcept;
+  ~Cursor();
+
+  /**
+   * @brief Fetches the next chunk of records in key order.
+   *
+   * @returns at most `chunk_size` records, empty vector if the range is
+   * exhausted.
+   */
+  std::vector<KeyValue> NextChunk();
+
+ private:
+  friend class Client;
+
+  struct Impl;
+
+  explicit Cursor(std::unique_ptr<Impl>&& impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
 /**
  * @brief Client for working with RocksDB storage.
  *
@@ -23,37 +126,115 @@ namespace storages::rocks {
  */
 class Client final {
  public:
+  static constexpr std::size_t kDefaultChunkSize = 1000;
+
   /**
    * @brief Constructor of the Client class.
    *
    * @param db_path The path to the RocksDB database.
    * @param blocking_task_processor - task processor to execute blocking FS
    * operations
+   * @param settings Client settings.
    */
   Client(const std::string& db_path,
-         engine::TaskProcessor& blocking_task_processor);
+         engine::TaskProcessor& blocking_task_processor,
+         const ClientSettings& settings = {});
+
+  ~Client();
 
   /**
    * @brief Puts a record into the database.
    *
    * @param key The key of the record.
    * @param value The value of the record.
+   * @param column_family The column family name, default one if empty.
    */
-  void Put(std::string_view key, std::string_view value);
+  void Put(std::string_view key, std::string_view value,
+           std::string_view column_family = {});
 
   /**
    * @brief Retrieves the value of a record from the database by key.
    *
    * @param key The key of the record.
+   * @param column_family The column family name, default one if empty.
    */
-  std::string Get(std::string_view key);
+  std::string Get(std::string_view key, std::string_view column_family = {});
+
+  /**
+   * @brief Retrieves the value of a record from the database by key.
+   *
+   * @param key The key of the record.
+   * @param column_family The column family name, default one if empty.
+   * @returns the value, std::nullopt if the record is missing.
+   */
+  std::optional<std::string> GetOptional(std::string_view key,
+                                         std::string_view column_family = {});
 
   /**
    * @brief Deletes a record from the database by key.
    *
    * @param key The key of the record to be deleted.
+   * @param column_family The column family name, default one if empty.
+   */
+  void Delete(std::string_view key, std::string_view column_family = {});
+
+  /**
+   * @brief Deletes all the records with keys in [begin_key, end_key) with a
+   * single range tombstone.
+   *
+   * @param begin_key The first key of the range, inclusive.
+   * @param end_key The end of the range, exclusive.
+   * @param column_family The column family name, default one if empty.
+   */
+  void DeleteRange(std::string_view begin_key, std::string_view end_key,
+                   std::string_view column_family = {});
+
+  /**
+   * @brief Retrieves the values of multiple records in a single batched
+   * lookup.
+   *
+   * @param keys The keys of the records.
+   * @param column_family The column family name, default one if empty.
+   * @returns values in the order of `keys`, std::nullopt for missing records.
+   */
+  std::vector<std::optional<std::string>> MultiGet(
+      utils::span<const std::string_view> keys,
+      std::string_view column_family = {});
+
+  /// @brief Creates an empty batch of updates for this client.
+  WriteBatch MakeWriteBatch() const;
+
+  /**
+   * @brief Atomically applies a batch of updates.
+   *
+   * @param batch The batch created by MakeWriteBatch of this client.
+   */
+  void Write(WriteBatch&& batch);
+
+  /**
+   * @brief Creates a cursor over the records with keys in
+   * [begin_key, end_key).
+   *
+   * @param begin_key The first key of the range (inclusive).
+   * @param end_key The last key of the range (exclusive).
+   * @param column_family The column family name, default one if empty.
+   * @param chunk_size Max number of records returned by Cursor::NextChunk.
    */
-  void Delete(std::string_view key);
+  Cursor Scan(std::string_view begin_key, std::string_view end_key,
+              std::string_view column_family = {},
+              std::size_t chunk_size = kDefaultChunkSize);
+
+  /**
+   * @brief Creates a cursor over the records with keys starting with
+   * `prefix`.
+   *
+   * @param prefix The key prefix.
+   * @param column_family The column family name, default one if empty.
+   * @param chunk_size Max number of records returned by Cursor::NextChunk.
+   */
+  Cursor ScanPrefix(std::string_view prefix,
+                    std::string_view column_family = {},
+                    std::size_t chunk_size = kDefaultChunkSize);
 
   /**
    * Checks the status of an operation and handles any errors based on the given
@@ -65,8 +246,30 @@ class Client final {
   void CheckStatus(rocksdb::Status status, std::string_view method_name);
 
  private:
+  friend class WriteBatch;
+  friend class Cursor;
+
+  struct WriteGroup;
+
+  rocksdb::ColumnFamilyHandle* GetColumnFamily(
+      std::string_view column_family) const;
+
+  void CoalescedWrite(rocksdb::ColumnFamilyHandle* column_family,
+                      std::string_view key,
+                      std::optional<std::string_view> value);
+
   std::unique_ptr<rocksdb::DB> db_;
+  std::vector<rocksdb::ColumnFamilyHandle*> column_family_handles_;
+  std::unordered_map<std::string, rocksdb::ColumnFamilyHandle*>
+      column_families_;
   engine::TaskProcessor& blocking_task_processor_;
+
+  const bool write_coalescing_;
+  const std::size_t max_coalesced_writes_;
+  engine::Mutex write_mutex_;
+  engine::ConditionVariable write_cv_;
+  std::shared_ptr<WriteGroup> open_write_group_;
+  bool write_in_progress_{false};
 };
 }  // namespace storages::rocks
 
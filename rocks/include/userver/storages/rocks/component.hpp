@@ -23,6 +23,9 @@ namespace storages::rocks {
 /// ---------------------------------- | ------------------------------------------------ | ---------------
 /// task-processor                     | name of the task processor to run the blocking file operations | -
 /// db-path                            | path to database file                            | -
+/// column-families                    | column families to open in addition to the default one | []
+/// write-coalescing                   | group concurrent Put/Delete calls into a single WriteBatch | false
+/// max-coalesced-writes               | max number of operations in a coalesced WriteBatch | 1024
 
 // clang-format on
 
@@ -0,0 +1,187 @@
+#pragma once
+
+/// @file userver/storages/rocks/disk_cache_tier.hpp
+/// @brief @copybrief storages::rocks::DiskCacheTier
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/cache/lru_cache_statistics.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/meta.hpp>
+#include <userver/dump/impl/string_operations.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/rocks/client.hpp>
+#include <userver/storages/rocks/client_fwd.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+/// @brief Statistics of storages::rocks::DiskCacheTier
+struct DiskCacheTierStatistics final {
+  cache::impl::ExpirableLruCacheStatistics lookups;
+  utils::statistics::RelaxedCounter<std::size_t> writes{0};
+  utils::statistics::RelaxedCounter<std::size_t> errors{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const DiskCacheTierStatistics& stats);
+
+namespace impl {
+
+/// @returns the smallest key greater than all the keys starting with
+/// `prefix`, std::nullopt if there is no such key
+std::optional<std::string> PrefixEnd(std::string_view prefix);
+
+}  // namespace impl
+
+/**
+ * @brief Persistent second-level tier for LRU caches, backed by RocksDB.
+ *
+ * Stores the values under the `key_prefix` followed by the binary
+ * representation of the key, so multiple tiers may share a database.
+ * Both Key and Value must be @ref scripts/docs/en/userver/cache_dumps.md
+ * "dumpable".
+ *
+ * Storage errors are logged and accounted in the statistics, a failed lookup
+ * is reported as a miss.
+ */
+template <typename Key, typename Value>
+class DiskCacheTier final {
+  static_assert(dump::kIsDumpable<Key> && dump::kIsDumpable<Value>,
+                "Key and Value of DiskCacheTier must be dumpable");
+
+ public:
+  /**
+   * @param client RocksDB client to store the values in.
+   * @param key_prefix Prefix of all the keys written by this tier.
+   * @param lifetime TTL of the stored values, 0 is unlimited.
+   * @param column_family The column family name, default one if empty.
+   */
+  DiskCacheTier(ClientPtr client, std::string key_prefix,
+                std::chrono::milliseconds lifetime,
+                std::string column_family = {});
+
+  /// @returns the value if it is present in the tier and not expired
+  std::optional<Value> Get(const Key& key);
+
+  /// @brief Stores the value, replacing the previous one
+  void Put(const Key& key, const Value& value);
+
+  /// @brief Removes the value from the tier
+  void InvalidateByKey(const Key& key);
+
+  /// @brief Removes all the values of the tier
+  void Invalidate();
+
+  const DiskCacheTierStatistics& GetStatistics() const { return stats_; }
+
+ private:
+  std::string MakeKey(const Key& key) const;
+
+  const ClientPtr client_;
+  const std::string key_prefix_;
+  const std::chrono::milliseconds lifetime_;
+  const std::string column_family_;
+  DiskCacheTierStatistics stats_;
+};
+
+template <typename Key, typename Value>
+DiskCacheTier<Key, Value>::DiskCacheTier(ClientPtr client,
+                                         std::string key_prefix,
+                                         std::chrono::milliseconds lifetime,
+                                         std::string column_family)
+    : client_(std::move(client)),
+      key_prefix_(std::move(key_prefix)),
+      lifetime_(lifetime),
+      column_family_(std::move(column_family)) {
+  UINVARIANT(client_, "DiskCacheTier requires a RocksDB client");
+}
+
+template <typename Key, typename Value>
+std::optional<Value> DiskCacheTier<Key, Value>::Get(const Key& key) {
+  try {
+    auto record = client_->GetOptional(MakeKey(key), column_family_);
+    if (!record) {
+      cache::impl::CacheMiss(stats_.lookups);
+      return std::nullopt;
+    }
+
+    dump::impl::StringReader reader{*record};
+    const auto update_time =
+        reader.Read<std::chrono::system_clock::time_point>();
+    if (lifetime_.count() != 0 &&
+        std::chrono::system_clock::now() > update_time + lifetime_) {
+      cache::impl::CacheStale(stats_.lookups);
+      cache::impl::CacheMiss(stats_.lookups);
+      return std::nullopt;
+    }
+    auto value = reader.Read<Value>();
+    reader.Finish();
+
+    cache::impl::CacheHit(stats_.lookups);
+    return value;
+  } catch (const std::exception& ex) {
+    ++stats_.errors;
+    LOG_WARNING() << "Failed to read from the disk cache tier: " << ex;
+    cache::impl::CacheMiss(stats_.lookups);
+    return std::nullopt;
+  }
+}
+
+template <typename Key, typename Value>
+void DiskCacheTier<Key, Value>::Put(const Key& key, const Value& value) {
+  try {
+    dump::impl::StringWriter writer;
+    writer.Write(std::chrono::system_clock::now());
+    writer.Write(value);
+    writer.Finish();
+    client_->Put(MakeKey(key), std::move(writer).Extract(), column_family_);
+    ++stats_.writes;
+  } catch (const std::exception& ex) {
+    ++stats_.errors;
+    LOG_WARNING() << "Failed to write to the disk cache tier: " << ex;
+  }
+}
+
+template <typename Key, typename Value>
+void DiskCacheTier<Key, Value>::InvalidateByKey(const Key& key) {
+  client_->Delete(MakeKey(key), column_family_);
+}
+
+template <typename Key, typename Value>
+void DiskCacheTier<Key, Value>::Invalidate() {
+  if (const auto end = impl::PrefixEnd(key_prefix_)) {
+    client_->DeleteRange(key_prefix_, *end, column_family_);
+    return;
+  }
+
+  auto cursor = client_->ScanPrefix(key_prefix_, column_family_);
+  for (auto chunk = cursor.NextChunk(); !chunk.empty();
+       chunk = cursor.NextChunk()) {
+    auto batch = client_->MakeWriteBatch();
+    for (const auto& record : chunk) {
+      batch.Delete(record.key, column_family_);
+    }
+    client_->Write(std::move(batch));
+  }
+}
+
+template <typename Key, typename Value>
+std::string DiskCacheTier<Key, Value>::MakeKey(const Key& key) const {
+  dump::impl::StringWriter writer;
+  writer.Write(key);
+  writer.Finish();
+  return key_prefix_ + std::move(writer).Extract();
+}
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
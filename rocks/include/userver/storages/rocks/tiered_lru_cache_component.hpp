@@ -0,0 +1,162 @@
+#pragma once
+
+/// @file userver/storages/rocks/tiered_lru_cache_component.hpp
+/// @brief @copybrief storages::rocks::TieredLruCacheComponent
+
+#include <chrono>
+#include <string>
+
+#include <userver/cache/lru_cache_component_base.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/storages/rocks/component.hpp>
+#include <userver/storages/rocks/disk_cache_tier.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+// clang-format off
+
+/// @ingroup userver_components userver_base_classes
+///
+/// @brief Base class for LRU-cache components with a persistent RocksDB tier
+///
+/// Works like cache::LruCacheComponent, but the values missing in memory are
+/// looked up in a RocksDB database before going to the source. Values fetched
+/// from the source are written through to the database, so the disk tier holds
+/// a superset of the memory tier, survives restarts and may be much larger
+/// than the memory tier.
+///
+/// You need to override TieredLruCacheComponent::DoGetByKeyFromSource to
+/// handle misses of both tiers. Key and Value must be
+/// @ref scripts/docs/en/userver/cache_dumps.md "dumpable".
+///
+/// `GetCache().InvalidateByKey(key)` and the testsuite cache reset invalidate
+/// both tiers.
+///
+/// Memory tier statistics are reported as for cache::LruCacheComponent, the
+/// disk tier ones are reported under `cache.disk-tier` with the same
+/// `cache_name` label.
+///
+/// ## Static options:
+/// Options of cache::LruCacheComponent and
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// rocks-component | name of the storages::rocks::Component to store the values in | --
+/// disk-column-family | column family to store the values in, default one if empty | ''
+/// disk-lifetime | TTL for the values in the disk tier (0 is unlimited) | value of `lifetime`
+
+// clang-format on
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class TieredLruCacheComponent
+    : public cache::LruCacheComponent<Key, Value, Hash, Equal> {
+ public:
+  TieredLruCacheComponent(const components::ComponentConfig&,
+                          const components::ComponentContext&);
+
+  ~TieredLruCacheComponent() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  /// Called if the value is missing in both memory and disk tiers
+  virtual Value DoGetByKeyFromSource(const Key& key) = 0;
+
+  DiskCacheTier<Key, Value>& GetDiskTier() { return disk_tier_; }
+
+ private:
+  Value DoGetByKey(const Key& key) final;
+
+  void DoInvalidateByKey(const Key& key) final;
+
+  void DoDropCache() final;
+
+  DiskCacheTier<Key, Value> disk_tier_;
+
+  // Subscriptions must be the last fields.
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+TieredLruCacheComponent<Key, Value, Hash, Equal>::TieredLruCacheComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : cache::LruCacheComponent<Key, Value, Hash, Equal>(config, context),
+      disk_tier_(
+          context
+              .FindComponent<Component>(
+                  config["rocks-component"].As<std::string>())
+              .MakeClient(),
+          components::GetCurrentComponentName(config) + '\0',
+          config["disk-lifetime"].As<std::chrono::milliseconds>(
+              config["lifetime"].As<std::chrono::milliseconds>(0)),
+          config["disk-column-family"].As<std::string>("")) {
+  statistics_holder_ =
+      context.FindComponent<components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter(
+              "cache.disk-tier",
+              [this](utils::statistics::Writer& writer) {
+                writer = disk_tier_.GetStatistics();
+              },
+              {{"cache_name", components::GetCurrentComponentName(config)}});
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+TieredLruCacheComponent<Key, Value, Hash, Equal>::~TieredLruCacheComponent() {
+  statistics_holder_.Unregister();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value TieredLruCacheComponent<Key, Value, Hash, Equal>::DoGetByKey(
+    const Key& key) {
+  auto value = disk_tier_.Get(key);
+  if (value) return std::move(*value);
+
+  auto result = DoGetByKeyFromSource(key);
+  disk_tier_.Put(key, result);
+  return result;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void TieredLruCacheComponent<Key, Value, Hash, Equal>::DoInvalidateByKey(
+    const Key& key) {
+  disk_tier_.InvalidateByKey(key);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void TieredLruCacheComponent<Key, Value, Hash, Equal>::DoDropCache() {
+  disk_tier_.Invalidate();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+yaml_config::Schema
+TieredLruCacheComponent<Key, Value, Hash, Equal>::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<
+      cache::LruCacheComponent<Key, Value, Hash, Equal>>(R"(
+type: object
+description: LRU-cache component with a persistent RocksDB tier
+additionalProperties: false
+properties:
+    rocks-component:
+        type: string
+        description: name of the storages::rocks::Component to store the values in
+    disk-column-family:
+        type: string
+        description: column family to store the values in, default one if empty
+        defaultDescription: ''
+    disk-lifetime:
+        type: string
+        description: TTL for the values in the disk tier (0 is unlimited)
+        defaultDescription: value of `lifetime`
+)");
+}
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
@@ -1,61 +1,359 @@
 #include <userver/storages/rocks/client.hpp>
 
+#include <algorithm>
+#include <mutex>
+
 #include <fmt/format.h>
 
+#include <userver/engine/task/cancel.hpp>
 #include <userver/storages/rocks/exception.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::rocks {
 
+namespace {
+
+// Smallest key that is greater than all the keys starting with `prefix`,
+// std::nullopt if there is no such key
+std::optional<std::string> PrefixSuccessor(std::string_view prefix) {
+  std::string result{prefix};
+  while (!result.empty()) {
+    auto& last = result.back();
+    if (static_cast<unsigned char>(last) != 0xFF) {
+      ++last;
+      return result;
+    }
+    result.pop_back();
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+struct Client::WriteGroup final {
+  rocksdb::WriteBatch batch;
+  std::size_t size{0};
+  bool done{false};
+  rocksdb::Status status;
+};
+
+struct Cursor::Impl final {
+  Client& client;
+  rocksdb::ColumnFamilyHandle* column_family;
+  std::string begin_key;
+  std::optional<std::string> end_key;
+  std::size_t chunk_size;
+
+  // ReadOptions keep a pointer to the bound, so it lives here
+  rocksdb::Slice upper_bound{};
+  std::unique_ptr<rocksdb::Iterator> iterator{};
+};
+
+WriteBatch::WriteBatch(const Client& client) : client_(&client) {}
+
+void WriteBatch::Put(std::string_view key, std::string_view value,
+                     std::string_view column_family) {
+  batch_.Put(client_->GetColumnFamily(column_family), key, value);
+}
+
+void WriteBatch::Delete(std::string_view key, std::string_view column_family) {
+  batch_.Delete(client_->GetColumnFamily(column_family), key);
+}
+
+std::size_t WriteBatch::GetSize() const { return batch_.Count(); }
+
+Cursor::Cursor(std::unique_ptr<Impl>&& impl) : impl_(std::move(impl)) {}
+
+Cursor::Cursor(Cursor&&) noexcept = default;
+
+Cursor& Cursor::operator=(Cursor&&) noexcept = default;
+
+Cursor::~Cursor() = default;
+
+std::vector<KeyValue> Cursor::NextChunk() {
+  UINVARIANT(impl_, "NextChunk called on a moved-from Cursor");
+  auto& impl = *impl_;
+
+  return engine::AsyncNoSpan(
+             impl.client.blocking_task_processor_,
+             [&impl] {
+               if (!impl.iterator) {
+                 rocksdb::ReadOptions options;
+                 if (impl.end_key) {
+                   impl.upper_bound = *impl.end_key;
+                   options.iterate_upper_bound = &impl.upper_bound;
+                 }
+                 impl.iterator.reset(impl.client.db_->NewIterator(
+                     options, impl.column_family));
+                 impl.iterator->Seek(impl.begin_key);
+               }
+
+               auto& iterator = *impl.iterator;
+               std::vector<KeyValue> result;
+               for (; iterator.Valid() && result.size() < impl.chunk_size;
+                    iterator.Next()) {
+                 result.push_back(
+                     {iterator.key().ToString(), iterator.value().ToString()});
+               }
+               impl.client.CheckStatus(iterator.status(), "Scan");
+               return result;
+             })
+      .Get();
+}
+
 Client::Client(const std::string& db_path,
-               engine::TaskProcessor& blocking_task_processor)
-    : blocking_task_processor_(blocking_task_processor) {
+               engine::TaskProcessor& blocking_task_processor,
+               const ClientSettings& settings)
+    : blocking_task_processor_(blocking_task_processor),
+      write_coalescing_(settings.write_coalescing),
+      max_coalesced_writes_(std::max<std::size_t>(
+          settings.max_coalesced_writes, 1)) {
   rocksdb::Options options;
   options.create_if_missing = true;
+  options.create_missing_column_families = true;
+
+  // All the column families present in the database must be opened. Listing
+  // fails if the database does not exist yet, which is fine
+  std::vector<std::string> names;
+  [[maybe_unused]] const auto list_status =
+      rocksdb::DB::ListColumnFamilies(options, db_path, &names);
+  for (const auto& name : settings.column_families) {
+    if (std::find(names.begin(), names.end(), name) == names.end()) {
+      names.push_back(name);
+    }
+  }
+  if (std::find(names.begin(), names.end(),
+                rocksdb::kDefaultColumnFamilyName) == names.end()) {
+    names.push_back(rocksdb::kDefaultColumnFamilyName);
+  }
+
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  descriptors.reserve(names.size());
+  for (const auto& name : names) {
+    descriptors.emplace_back(name, rocksdb::ColumnFamilyOptions{options});
+  }
 
   rocksdb::DB* db{};
-  rocksdb::Status status = rocksdb::DB::Open(options, db_path, &db);
+  rocksdb::Status status = rocksdb::DB::Open(options, db_path, descriptors,
+                                             &column_family_handles_, &db);
   db_.reset(db);
   CheckStatus(status, "Create client");
+
+  for (auto* handle : column_family_handles_) {
+    column_families_.emplace(handle->GetName(), handle);
+  }
 }
 
-void Client::Put(std::string_view key, std::string_view value) {
-  engine::AsyncNoSpan(blocking_task_processor_, [this, key, value] {
-    rocksdb::Status status = db_->Put(rocksdb::WriteOptions(), key, value);
+Client::~Client() {
+  for (auto* handle : column_family_handles_) {
+    [[maybe_unused]] const auto status =
+        db_->DestroyColumnFamilyHandle(handle);
+  }
+}
+
+void Client::Put(std::string_view key, std::string_view value,
+                 std::string_view column_family) {
+  auto* handle = GetColumnFamily(column_family);
+  if (write_coalescing_) {
+    CoalescedWrite(handle, key, value);
+    return;
+  }
+
+  engine::AsyncNoSpan(blocking_task_processor_, [this, handle, key, value] {
+    rocksdb::Status status =
+        db_->Put(rocksdb::WriteOptions(), handle, key, value);
     CheckStatus(status, "Put");
   }).Get();
 }
 
-std::string Client::Get(std::string_view key) {
+std::string Client::Get(std::string_view key, std::string_view column_family) {
+  auto* handle = GetColumnFamily(column_family);
   return engine::AsyncNoSpan(blocking_task_processor_,
-                             [this, key] {
+                             [this, handle, key] {
                                std::string res;
-                               rocksdb::Status status =
-                                   db_->Get(rocksdb::ReadOptions(), key, &res);
+                               rocksdb::Status status = db_->Get(
+                                   rocksdb::ReadOptions(), handle, key, &res);
                                CheckStatus(status, "Get");
                                return res;
                              })
       .Get();
 }
 
-void Client::Delete(std::string_view key) {
+std::optional<std::string> Client::GetOptional(
+    std::string_view key, std::string_view column_family) {
+  auto* handle = GetColumnFamily(column_family);
+  return engine::AsyncNoSpan(
+             blocking_task_processor_,
+             [this, handle, key]() -> std::optional<std::string> {
+               std::string res;
+               rocksdb::Status status =
+                   db_->Get(rocksdb::ReadOptions(), handle, key, &res);
+               if (status.IsNotFound()) return std::nullopt;
+               CheckStatus(status, "Get");
+               return res;
+             })
+      .Get();
+}
+
+void Client::Delete(std::string_view key, std::string_view column_family) {
+  auto* handle = GetColumnFamily(column_family);
+  if (write_coalescing_) {
+    CoalescedWrite(handle, key, std::nullopt);
+    return;
+  }
+
   return engine::AsyncNoSpan(blocking_task_processor_,
-                             [this, key] {
-                               rocksdb::Status status =
-                                   db_->Delete(rocksdb::WriteOptions(), key);
+                             [this, handle, key] {
+                               rocksdb::Status status = db_->Delete(
+                                   rocksdb::WriteOptions(), handle, key);
                                CheckStatus(status, "Delete");
                              })
       .Get();
 }
 
+void Client::DeleteRange(std::string_view begin_key, std::string_view end_key,
+                         std::string_view column_family) {
+  auto* handle = GetColumnFamily(column_family);
+  engine::AsyncNoSpan(blocking_task_processor_,
+                      [this, handle, begin_key, end_key] {
+                        rocksdb::Status status =
+                            db_->DeleteRange(rocksdb::WriteOptions(), handle,
+                                             begin_key, end_key);
+                        CheckStatus(status, "DeleteRange");
+                      })
+      .Get();
+}
+
+std::vector<std::optional<std::string>> Client::MultiGet(
+    utils::span<const std::string_view> keys, std::string_view column_family) {
+  auto* handle = GetColumnFamily(column_family);
+  return engine::AsyncNoSpan(
+             blocking_task_processor_,
+             [this, handle, keys] {
+               std::vector<rocksdb::Slice> slices(keys.begin(), keys.end());
+               std::vector<rocksdb::PinnableSlice> values(keys.size());
+               std::vector<rocksdb::Status> statuses(keys.size());
+               db_->MultiGet(rocksdb::ReadOptions(), handle, slices.size(),
+                             slices.data(), values.data(), statuses.data());
+
+               std::vector<std::optional<std::string>> result;
+               result.reserve(keys.size());
+               for (std::size_t i = 0; i < keys.size(); ++i) {
+                 if (statuses[i].IsNotFound()) {
+                   result.emplace_back();
+                   continue;
+                 }
+                 CheckStatus(statuses[i], "MultiGet");
+                 result.emplace_back(values[i].ToString());
+               }
+               return result;
+             })
+      .Get();
+}
+
+WriteBatch Client::MakeWriteBatch() const { return WriteBatch{*this}; }
+
+void Client::Write(WriteBatch&& batch) {
+  UINVARIANT(batch.client_ == this,
+             "WriteBatch was created by a different client");
+  engine::AsyncNoSpan(blocking_task_processor_, [this, &batch] {
+    rocksdb::Status status = db_->Write(rocksdb::WriteOptions(), &batch.batch_);
+    CheckStatus(status, "Write");
+  }).Get();
+}
+
+Cursor Client::Scan(std::string_view begin_key, std::string_view end_key,
+                    std::string_view column_family, std::size_t chunk_size) {
+  UINVARIANT(chunk_size > 0, "chunk_size should be positive");
+  return Cursor{std::make_unique<Cursor::Impl>(
+      Cursor::Impl{*this, GetColumnFamily(column_family),
+                   std::string{begin_key}, std::string{end_key}, chunk_size})};
+}
+
+Cursor Client::ScanPrefix(std::string_view prefix,
+                          std::string_view column_family,
+                          std::size_t chunk_size) {
+  UINVARIANT(chunk_size > 0, "chunk_size should be positive");
+  return Cursor{std::make_unique<Cursor::Impl>(
+      Cursor::Impl{*this, GetColumnFamily(column_family), std::string{prefix},
+                   PrefixSuccessor(prefix), chunk_size})};
+}
+
 void Client::CheckStatus(rocksdb::Status status, std::string_view method_name) {
   if (!status.ok() && !status.IsNotFound()) {
     throw USERVER_NAMESPACE::storages::rocks::RequestFailedException(
         method_name, status.ToString());
   }
 }
+
+rocksdb::ColumnFamilyHandle* Client::GetColumnFamily(
+    std::string_view column_family) const {
+  if (column_family.empty()) return db_->DefaultColumnFamily();
+
+  const auto it = column_families_.find(std::string{column_family});
+  if (it == column_families_.end()) {
+    throw Exception(fmt::format("Unknown column family '{}'", column_family));
+  }
+  return it->second;
+}
+
+void Client::CoalescedWrite(rocksdb::ColumnFamilyHandle* column_family,
+                            std::string_view key,
+                            std::optional<std::string_view> value) {
+  // Once the update is added to a group, someone has to write that group
+  const engine::TaskCancellationBlocker cancel_blocker;
+
+  std::unique_lock lock{write_mutex_};
+  if (!open_write_group_) {
+    open_write_group_ = std::make_shared<WriteGroup>();
+  }
+  const auto group = open_write_group_;
+  if (value) {
+    group->batch.Put(column_family, key, *value);
+  } else {
+    group->batch.Delete(column_family, key);
+  }
+  if (++group->size >= max_coalesced_writes_) {
+    open_write_group_.reset();
+  }
+
+  [[maybe_unused]] const bool is_ready = write_cv_.Wait(
+      lock, [&] { return group->done || !write_in_progress_; });
+  UASSERT(is_ready);
+
+  if (!group->done) {
+    // Nobody is writing at the moment, so we write our group including the
+    // updates of everyone who joined it while the previous write was running
+    if (open_write_group_ == group) {
+      open_write_group_.reset();
+    }
+    write_in_progress_ = true;
+    lock.unlock();
+
+    rocksdb::Status status;
+    try {
+      status = engine::AsyncNoSpan(blocking_task_processor_, [this, &group] {
+                 return db_->Write(rocksdb::WriteOptions(), &group->batch);
+               }).Get();
+    } catch (const std::exception& ex) {
+      status = rocksdb::Status::Aborted(ex.what());
+    }
+
+    lock.lock();
+    group->status = std::move(status);
+    group->done = true;
+    write_in_progress_ = false;
+    write_cv_.NotifyAll();
+  }
+
+  const auto status = group->status;
+  lock.unlock();
+  CheckStatus(status, value ? "Put" : "Delete");
+}
+
 }  // namespace storages::rocks
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,124 @@
+#include <userver/storages/rocks/client.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kKeysCount = 1024;
+constexpr std::size_t kWorkerThreads = 4;
+
+std::string MakeKey(std::size_t i) { return fmt::format("key_{:08}", i); }
+
+void FillDatabase(storages::rocks::Client& client) {
+  auto batch = client.MakeWriteBatch();
+  for (std::size_t i = 0; i < kKeysCount; ++i) {
+    batch.Put(MakeKey(i), std::string(100, 'v'));
+  }
+  client.Write(std::move(batch));
+}
+
+void RunConcurrentPuts(benchmark::State& state, bool write_coalescing) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::ClientSettings settings;
+    settings.write_coalescing = write_coalescing;
+    storages::rocks::Client client{
+        dir.GetPath(), engine::current_task::GetTaskProcessor(), settings};
+
+    const auto writers = static_cast<std::size_t>(state.range(0));
+    const auto puts_per_writer = kKeysCount / writers;
+    for ([[maybe_unused]] auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(writers);
+      for (std::size_t i = 0; i < writers; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&client, i, puts_per_writer] {
+          for (std::size_t j = 0; j < puts_per_writer; ++j) {
+            client.Put(MakeKey(i * puts_per_writer + j), "value");
+          }
+        }));
+      }
+      engine::WaitAllChecked(tasks);
+    }
+    state.SetItemsProcessed(state.iterations() * writers * puts_per_writer);
+  });
+}
+
+}  // namespace
+
+void rocks_concurrent_put(benchmark::State& state) {
+  RunConcurrentPuts(state, false);
+}
+BENCHMARK(rocks_concurrent_put)->RangeMultiplier(4)->Range(1, 64);
+
+void rocks_concurrent_put_coalesced(benchmark::State& state) {
+  RunConcurrentPuts(state, true);
+}
+BENCHMARK(rocks_concurrent_put_coalesced)->RangeMultiplier(4)->Range(1, 64);
+
+void rocks_get_per_call(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    FillDatabase(client);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < kKeysCount; ++i) {
+        benchmark::DoNotOptimize(client.Get(MakeKey(i)));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * kKeysCount);
+  });
+}
+BENCHMARK(rocks_get_per_call);
+
+void rocks_multi_get(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    FillDatabase(client);
+
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < kKeysCount; ++i) keys.push_back(MakeKey(i));
+    const std::vector<std::string_view> key_views(keys.begin(), keys.end());
+
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(client.MultiGet(key_views));
+    }
+    state.SetItemsProcessed(state.iterations() * kKeysCount);
+  });
+}
+BENCHMARK(rocks_multi_get);
+
+void rocks_scan(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    FillDatabase(client);
+
+    const auto chunk_size = static_cast<std::size_t>(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+      auto cursor = client.ScanPrefix("key_", {}, chunk_size);
+      while (!cursor.NextChunk().empty()) {
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * kKeysCount);
+  });
+}
+BENCHMARK(rocks_scan)->RangeMultiplier(8)->Range(8, 1024);
+
+USERVER_NAMESPACE_END
@@ -1,4 +1,14 @@
 #include <userver/storages/rocks/client.hpp>
+
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/storages/rocks/exception.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/async.hpp>
 
@@ -25,6 +35,152 @@ UTEST(Rocks, CheckCRUD) {
   EXPECT_EQ("", res);
 }
 
+UTEST(Rocks, GetOptional) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  EXPECT_EQ(client.GetOptional("key"), std::nullopt);
+
+  client.Put("key", "");
+  EXPECT_EQ(client.GetOptional("key"), "");
+
+  client.Put("key", "value");
+  EXPECT_EQ(client.GetOptional("key"), "value");
+
+  client.Delete("key");
+  EXPECT_EQ(client.GetOptional("key"), std::nullopt);
+}
+
+UTEST(Rocks, DeleteRange) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  client.Put("a", "1");
+  client.Put("b1", "2");
+  client.Put("b2", "3");
+  client.Put("c", "4");
+
+  client.DeleteRange("b", "c");
+  EXPECT_EQ(client.GetOptional("a"), "1");
+  EXPECT_EQ(client.GetOptional("b1"), std::nullopt);
+  EXPECT_EQ(client.GetOptional("b2"), std::nullopt);
+  EXPECT_EQ(client.GetOptional("c"), "4");
+}
+
+UTEST(Rocks, MultiGet) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  client.Put("a", "1");
+  client.Put("c", "3");
+
+  const std::vector<std::string_view> keys{"a", "b", "c"};
+  const auto values = client.MultiGet(keys);
+  ASSERT_EQ(values.size(), 3);
+  EXPECT_EQ(values[0], "1");
+  EXPECT_EQ(values[1], std::nullopt);
+  EXPECT_EQ(values[2], "3");
+}
+
+UTEST(Rocks, WriteBatch) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+  client.Put("stale", "value");
+
+  auto batch = client.MakeWriteBatch();
+  batch.Put("key1", "value1");
+  batch.Put("key2", "value2");
+  batch.Delete("stale");
+  EXPECT_EQ(batch.GetSize(), 3);
+  client.Write(std::move(batch));
+
+  EXPECT_EQ(client.Get("key1"), "value1");
+  EXPECT_EQ(client.Get("key2"), "value2");
+  EXPECT_EQ(client.Get("stale"), "");
+}
+
+UTEST(Rocks, ScanInChunks) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  for (char c = 'a'; c <= 'z'; ++c) {
+    client.Put(std::string{"key_"} + c, std::string{c});
+  }
+  client.Put("other", "value");
+
+  auto cursor = client.ScanPrefix("key_", {}, 10);
+  std::string scanned;
+  std::vector<std::size_t> chunk_sizes;
+  for (auto chunk = cursor.NextChunk(); !chunk.empty();
+       chunk = cursor.NextChunk()) {
+    chunk_sizes.push_back(chunk.size());
+    for (const auto& record : chunk) scanned += record.value;
+  }
+  EXPECT_EQ(scanned, "abcdefghijklmnopqrstuvwxyz");
+  EXPECT_EQ(chunk_sizes, (std::vector<std::size_t>{10, 10, 6}));
+
+  auto range = client.Scan("key_c", "key_f");
+  const auto chunk = range.NextChunk();
+  ASSERT_EQ(chunk.size(), 3);
+  EXPECT_EQ(chunk.front().key, "key_c");
+  EXPECT_EQ(chunk.back().key, "key_e");
+  EXPECT_TRUE(range.NextChunk().empty());
+}
+
+UTEST(Rocks, ColumnFamilies) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::ClientSettings settings;
+  settings.column_families = {"cf"};
+
+  {
+    storages::rocks::Client client{
+        dir.GetPath(), engine::current_task::GetTaskProcessor(), settings};
+    client.Put("key", "default");
+    client.Put("key", "cf", "cf");
+    EXPECT_EQ(client.Get("key"), "default");
+    EXPECT_EQ(client.Get("key", "cf"), "cf");
+    EXPECT_THROW(client.Get("key", "unknown"), storages::rocks::Exception);
+  }
+
+  // existing column families are reopened even if not listed
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+  EXPECT_EQ(client.Get("key", "cf"), "cf");
+}
+
+UTEST_MT(Rocks, WriteCoalescing, 4) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::ClientSettings settings;
+  settings.write_coalescing = true;
+  settings.max_coalesced_writes = 16;
+  storages::rocks::Client client{
+      dir.GetPath(), engine::current_task::GetTaskProcessor(), settings};
+
+  constexpr std::size_t kWriters = 8;
+  constexpr std::size_t kWritesPerWriter = 100;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kWriters; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&client, i] {
+      for (std::size_t j = 0; j < kWritesPerWriter; ++j) {
+        client.Put(fmt::format("{}_{}", i, j), std::to_string(j));
+      }
+      client.Delete(fmt::format("{}_{}", i, 0));
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  for (std::size_t i = 0; i < kWriters; ++i) {
+    EXPECT_EQ(client.Get(fmt::format("{}_{}", i, 0)), "");
+    EXPECT_EQ(client.Get(fmt::format("{}_{}", i, kWritesPerWriter - 1)),
+              std::to_string(kWritesPerWriter - 1));
+  }
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
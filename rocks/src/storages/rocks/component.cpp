@@ -1,6 +1,8 @@
 #include <userver/storages/rocks/component.hpp>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/storages/rocks/client.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
@@ -9,13 +11,29 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::rocks {
 
+namespace {
+
+ClientSettings ParseClientSettings(const components::ComponentConfig& config) {
+  ClientSettings settings;
+  settings.column_families =
+      config["column-families"].As<std::vector<std::string>>({});
+  settings.write_coalescing =
+      config["write-coalescing"].As<bool>(settings.write_coalescing);
+  settings.max_coalesced_writes = config["max-coalesced-writes"].As<size_t>(
+      settings.max_coalesced_writes);
+  return settings;
+}
+
+}  // namespace
+
 Component::Component(const components::ComponentConfig& config,
                      const components::ComponentContext& context)
     : ComponentBase(config, context),
       client_ptr_(std::make_shared<storages::rocks::Client>(
           config["db-path"].As<std::string>(),
           context.GetTaskProcessor(
-              config["task-processor"].As<std::string>()))) {}
+              config["task-processor"].As<std::string>()),
+          ParseClientSettings(config))) {}
 
 storages::rocks::ClientPtr Component::MakeClient() { return client_ptr_; }
 
@@ -31,6 +49,21 @@ properties:
     db-path:
         type: string
         description: path to database file
+    column-families:
+        type: array
+        description: column families to open in addition to the default one
+        defaultDescription: '[]'
+        items:
+            type: string
+            description: column family name
+    write-coalescing:
+        type: boolean
+        description: group concurrent Put/Delete calls into a single WriteBatch
+        defaultDescription: false
+    max-coalesced-writes:
+        type: integer
+        description: max number of operations in a coalesced WriteBatch
+        defaultDescription: 1024
 )");
 }
 }  // namespace storages::rocks
@@ -0,0 +1,31 @@
+#include <userver/storages/rocks/disk_cache_tier.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const DiskCacheTierStatistics& stats) {
+  cache::impl::DumpMetric(writer, stats.lookups);
+  writer["writes"] = stats.writes.Load();
+  writer["errors"] = stats.errors.Load();
+}
+
+namespace impl {
+
+std::optional<std::string> PrefixEnd(std::string_view prefix) {
+  std::string end{prefix};
+  while (!end.empty() && static_cast<unsigned char>(end.back()) == 0xff) {
+    end.pop_back();
+  }
+  if (end.empty()) return std::nullopt;
+
+  end.back() = static_cast<char>(static_cast<unsigned char>(end.back()) + 1);
+  return end;
+}
+
+}  // namespace impl
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
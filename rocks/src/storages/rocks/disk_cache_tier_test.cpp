@@ -0,0 +1,131 @@
+#include <userver/storages/rocks/disk_cache_tier.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Tier = storages::rocks::DiskCacheTier<std::string, std::size_t>;
+
+storages::rocks::ClientPtr MakeClient(const fs::blocking::TempDirectory& dir) {
+  return std::make_shared<storages::rocks::Client>(
+      dir.GetPath(), engine::current_task::GetTaskProcessor());
+}
+
+}  // namespace
+
+UTEST(RocksDiskCacheTier, PutGet) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  Tier tier{MakeClient(dir), "cache", std::chrono::milliseconds{0}};
+
+  EXPECT_EQ(tier.Get("key"), std::nullopt);
+  tier.Put("key", 42);
+  EXPECT_EQ(tier.Get("key"), 42);
+  tier.InvalidateByKey("key");
+  EXPECT_EQ(tier.Get("key"), std::nullopt);
+
+  const auto& stats = tier.GetStatistics();
+  EXPECT_EQ(stats.lookups.total.hits.load(), 1);
+  EXPECT_EQ(stats.lookups.total.misses.load(), 2);
+  EXPECT_EQ(stats.writes.Load(), 1);
+  EXPECT_EQ(stats.errors.Load(), 0);
+}
+
+UTEST(RocksDiskCacheTier, KeyPrefixesDoNotClash) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto client = MakeClient(dir);
+  Tier first{client, std::string{"first\0", 6}, std::chrono::milliseconds{0}};
+  Tier second{client, std::string{"second\0", 7}, std::chrono::milliseconds{0}};
+
+  first.Put("key", 1);
+  second.Put("key", 2);
+  EXPECT_EQ(first.Get("key"), 1);
+  EXPECT_EQ(second.Get("key"), 2);
+}
+
+UTEST(RocksDiskCacheTier, InvalidateAll) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto client = MakeClient(dir);
+  Tier tier{client, std::string{"tier\0", 5}, std::chrono::milliseconds{0}};
+  Tier other{client, std::string{"other\0", 6}, std::chrono::milliseconds{0}};
+
+  tier.Put("a", 1);
+  tier.Put("b", 2);
+  other.Put("a", 3);
+
+  tier.Invalidate();
+  EXPECT_EQ(tier.Get("a"), std::nullopt);
+  EXPECT_EQ(tier.Get("b"), std::nullopt);
+  EXPECT_EQ(other.Get("a"), 3);
+}
+
+UTEST(RocksDiskCacheTier, InvalidateAllWithoutPrefixEnd) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto client = MakeClient(dir);
+  Tier tier{client, "\xff", std::chrono::milliseconds{0}};
+  Tier other{client, "\xfe", std::chrono::milliseconds{0}};
+
+  tier.Put("a", 1);
+  other.Put("a", 2);
+
+  tier.Invalidate();
+  EXPECT_EQ(tier.Get("a"), std::nullopt);
+  EXPECT_EQ(other.Get("a"), 2);
+}
+
+TEST(RocksDiskCacheTier, PrefixEnd) {
+  using storages::rocks::impl::PrefixEnd;
+  EXPECT_EQ(PrefixEnd("tier"), "ties");
+  EXPECT_EQ(PrefixEnd(std::string{"tier\0", 5}), (std::string{"tier\1", 5}));
+  EXPECT_EQ(PrefixEnd("a\xff\xff"), "b");
+  EXPECT_EQ(PrefixEnd("\xff"), std::nullopt);
+  EXPECT_EQ(PrefixEnd(""), std::nullopt);
+}
+
+UTEST(RocksDiskCacheTier, SurvivesReopen) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  {
+    Tier tier{MakeClient(dir), "cache", std::chrono::milliseconds{0}};
+    tier.Put("key", 42);
+  }
+
+  Tier tier{MakeClient(dir), "cache", std::chrono::milliseconds{0}};
+  EXPECT_EQ(tier.Get("key"), 42);
+}
+
+UTEST(RocksDiskCacheTier, Expiration) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  Tier tier{MakeClient(dir), "cache", std::chrono::milliseconds{10}};
+
+  tier.Put("key", 42);
+  engine::SleepFor(std::chrono::milliseconds{20});
+  EXPECT_EQ(tier.Get("key"), std::nullopt);
+  EXPECT_EQ(tier.GetStatistics().lookups.total.stale.load(), 1);
+}
+
+UTEST(RocksDiskCacheTier, CorruptedRecordIsAMiss) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto client = MakeClient(dir);
+  Tier tier{client, "cache", std::chrono::milliseconds{0}};
+
+  tier.Put("key", 42);
+  auto batch = client->MakeWriteBatch();
+  // Overwrite all the records of the tier with garbage
+  auto cursor = client->ScanPrefix("cache");
+  for (const auto& record : cursor.NextChunk()) {
+    batch.Put(record.key, "garbage");
+  }
+  client->Write(std::move(batch));
+
+  EXPECT_EQ(tier.Get("key"), std::nullopt);
+  EXPECT_EQ(tier.GetStatistics().errors.Load(), 1);
+}
+
+USERVER_NAMESPACE_END
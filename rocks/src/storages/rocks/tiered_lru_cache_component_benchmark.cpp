@@ -0,0 +1,188 @@
+#include <userver/storages/rocks/tiered_lru_cache_component.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <userver/cache/lru_cache_component_base.hpp>
+#include <userver/components/component_base.hpp>
+#include <userver/components/minimal_component_list.hpp>
+#include <userver/components/run.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/storages/rocks/component.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The dataset is 8 times larger than the memory tier
+constexpr std::size_t kMemoryTierSize = 1024;
+constexpr std::size_t kDatasetSize = kMemoryTierSize * 8;
+constexpr std::size_t kWays = 16;
+// Latency of the slow source the cache protects
+constexpr std::chrono::microseconds kSourceLatency{200};
+
+using Key = std::uint64_t;
+using Value = std::string;
+
+Value FetchFromSource(Key key) {
+  engine::SleepFor(kSourceLatency);
+  return Value(256, static_cast<char>('a' + key % 26));
+}
+
+class MemoryOnlyCache final : public cache::LruCacheComponent<Key, Value> {
+ public:
+  static constexpr std::string_view kName = "memory-only-cache";
+  static constexpr std::string_view kExtraConfig = "";
+
+  using LruCacheComponent::LruCacheComponent;
+
+ private:
+  Value DoGetByKey(const Key& key) override { return FetchFromSource(key); }
+};
+
+class TieredCache final
+    : public storages::rocks::TieredLruCacheComponent<Key, Value> {
+ public:
+  static constexpr std::string_view kName = "tiered-cache";
+  static constexpr std::string_view kExtraConfig = "rocks-component: rocks-db";
+
+  using TieredLruCacheComponent::TieredLruCacheComponent;
+
+  const storages::rocks::DiskCacheTierStatistics& GetDiskStatistics() {
+    return GetDiskTier().GetStatistics();
+  }
+
+ private:
+  Value DoGetByKeyFromSource(const Key& key) override {
+    return FetchFromSource(key);
+  }
+};
+
+struct Lookups final {
+  std::size_t hits{0};
+  std::size_t misses{0};
+};
+
+Lookups GetLookups(const cache::impl::ExpirableLruCacheStatistics& stats) {
+  return {stats.total.hits.load(), stats.total.misses.load()};
+}
+
+double HitRatio(Lookups before, Lookups after) {
+  const auto hits = after.hits - before.hits;
+  const auto total = hits + after.misses - before.misses;
+  return static_cast<double>(hits) /
+         static_cast<double>(std::max<std::size_t>(total, 1));
+}
+
+// Components are constructed by components::RunOnce, so the state is passed
+// to the runner component through a global.
+benchmark::State* current_state = nullptr;
+
+template <typename Cache>
+class LookupsRunner final : public components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "lookups-runner";
+
+  LookupsRunner(const components::ComponentConfig& config,
+                const components::ComponentContext& context)
+      : ComponentBase(config, context) {
+    auto& component = context.FindComponent<Cache>();
+    auto cache = component.GetCache();
+    auto& state = *current_state;
+
+    // Warm up the tiers with the whole dataset
+    for (Key key = 0; key < kDatasetSize; ++key) {
+      cache.Get(key);
+    }
+
+    std::minstd_rand rng{42};
+    std::uniform_int_distribution<Key> distribution{0, kDatasetSize - 1};
+    const auto memory_before = GetLookups(cache.GetCache()->GetStatistics());
+    Lookups disk_before;
+    if constexpr (std::is_same_v<Cache, TieredCache>) {
+      disk_before = GetLookups(component.GetDiskStatistics().lookups);
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(cache.Get(distribution(rng)));
+    }
+
+    state.counters["memory_hit_ratio"] = HitRatio(
+        memory_before, GetLookups(cache.GetCache()->GetStatistics()));
+    if constexpr (std::is_same_v<Cache, TieredCache>) {
+      state.counters["disk_hit_ratio"] = HitRatio(
+          disk_before, GetLookups(component.GetDiskStatistics().lookups));
+    }
+  }
+};
+
+constexpr std::string_view kStaticConfig = R"(
+components_manager:
+  default_task_processor: main-task-processor
+  event_thread_pool:
+    threads: 1
+  task_processors:
+    main-task-processor:
+      worker_threads: 1
+    fs-task-processor:
+      worker_threads: 1
+  components:
+    logging:
+      fs-task-processor: fs-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+    testsuite-support:
+    rocks-db:
+      task-processor: fs-task-processor
+      db-path: {db_path}
+    {cache_name}:
+      size: {size}
+      ways: {ways}
+      config-settings: false
+      {extra_config}
+    lookups-runner:
+)";
+
+template <typename Cache>
+void RunLookups(benchmark::State& state) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto config = fmt::format(
+      kStaticConfig, fmt::arg("db_path", dir.GetPath()),
+      fmt::arg("cache_name", Cache::kName), fmt::arg("size", kMemoryTierSize),
+      fmt::arg("ways", kWays), fmt::arg("extra_config", Cache::kExtraConfig));
+
+  auto component_list = components::MinimalComponentList();
+  component_list.Append<components::TestsuiteSupport>();
+  component_list.Append<storages::rocks::Component>("rocks-db");
+  component_list.Append<Cache>();
+  component_list.Append<LookupsRunner<Cache>>();
+
+  current_state = &state;
+  components::RunOnce(components::InMemoryConfig{config}, component_list);
+  current_state = nullptr;
+}
+
+}  // namespace
+
+void rocks_lru_memory_only(benchmark::State& state) {
+  RunLookups<MemoryOnlyCache>(state);
+}
+BENCHMARK(rocks_lru_memory_only);
+
+void rocks_lru_with_disk_tier(benchmark::State& state) {
+  RunLookups<TieredCache>(state);
+}
+BENCHMARK(rocks_lru_with_disk_tier);
+
+USERVER_NAMESPACE_END
@@ -5,14 +5,19 @@
 #include <grpcpp/support/byte_buffer.h>
 
 #include <userver/components/component.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/ugrpc/byte_buffer_utils.hpp>
 #include <userver/ugrpc/client/generic.hpp>
 #include <userver/ugrpc/client/simple_client_component.hpp>
+#include <userver/utils/encoding/hex.hpp>
 
 namespace samples {
 
 namespace {
 
+// Logging the whole body of a large message would cost more than proxying it
+constexpr std::size_t kLoggedRequestPrefixSize = 64;
+
 grpc::string ToGrpcString(grpc::string_ref str) {
   return {str.data(), str.size()};
 }
@@ -78,12 +83,22 @@ void ProxyService::Handle(Call& call) {
     return;
   }
 
+  // The prefix is only copied out if the log level is enabled
+  LOG_DEBUG() << "Proxying " << request_bytes.Length()
+              << " bytes, request prefix: "
+              << utils::encoding::ToHex(ugrpc::GetByteBufferPrefix(
+                     request_bytes, kLoggedRequestPrefixSize));
+
   auto client_context = std::make_unique<grpc::ClientContext>();
   ProxyRequestMetadata(call.GetContext(), *client_context);
 
   // Deadline propagation will work, as we've registered the DP middleware
   // in the config of grpc-server component.
   // Optionally, we can set an additional timeout using GenericOptions::qos.
+  //
+  // The request and response slices are passed through untouched, as copying
+  // a grpc::ByteBuffer only references them. Avoid converting the bodies to
+  // std::string in the proxying path.
   auto client_rpc = client_.UnaryCall(call.GetCallName(), request_bytes,
                                       std::move(client_context));
 
@@ -9,16 +9,21 @@
 
 #include <userver/utest/using_namespace_userver.hpp>
 
+#include "simulation.hpp"
+
 using namespace congestion_control;
 
 struct Config {
   Policy policy;
   std::string log_level = "none";
+  bool simulate = false;
+  SimulationConfig simulation;
 };
 
 Config ParseArgs(int argc, char* argv[]) {
   Config config;
   std::string policy_json;
+  std::string adaptive_json;
 
   namespace po = boost::program_options;
 
@@ -32,6 +37,25 @@ Config ParseArgs(int argc, char* argv[]) {
     ("policy,p",
      po::value(&policy_json)->default_value(std::string{}),
      "policy in JSON")
+    ("simulate",
+     po::bool_switch(&config.simulate),
+     "read offered RPS per second and simulate a service with the chosen "
+     "controller")
+    ("controller",
+     po::value(&config.simulation.controller)
+         ->default_value(config.simulation.controller),
+     "simulation: linear, gradient2 or vegas")
+    ("workers",
+     po::value(&config.simulation.workers)
+         ->default_value(config.simulation.workers),
+     "simulation: requests the service processes concurrently")
+    ("base-latency-ms",
+     po::value(&config.simulation.base_latency_ms)
+         ->default_value(config.simulation.base_latency_ms),
+     "simulation: latency of a request without queueing")
+    ("adaptive",
+     po::value(&adaptive_json)->default_value(std::string{}),
+     "simulation: adaptive concurrency settings in JSON")
   ;
   // clang-format on
 
@@ -47,6 +71,12 @@ Config ParseArgs(int argc, char* argv[]) {
   if (!policy_json.empty()) {
     config.policy = formats::json::FromString(policy_json).As<Policy>();
   }
+  config.simulation.policy = config.policy;
+
+  if (!adaptive_json.empty()) {
+    config.simulation.adaptive = formats::json::FromString(adaptive_json)
+                                     .As<AdaptiveConcurrencyConfig>();
+  }
 
   return config;
 }
@@ -58,6 +88,11 @@ int main(int argc, char* argv[]) {
       logging::MakeStderrLogger("default", logging::Format::kTskv,
                                 logging::LevelFromString(config.log_level))};
 
+  if (config.simulate) {
+    Simulate(config.simulation, std::cin, std::cout);
+    return 0;
+  }
+
   dynamic_config::StorageMock dynamic_config{
       {congestion_control::impl::kRpsCcConfig, {config.policy, true}}};
   Controller ctrl("cc", dynamic_config.GetSource());
@@ -0,0 +1,183 @@
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/congestion_control/controller.hpp>
+#include <userver/dynamic_config/storage_mock.hpp>
+
+namespace {
+
+constexpr int kTicksPerSecond = 100;
+constexpr double kTickSeconds = 1.0 / kTicksPerSecond;
+
+// Requests that spend more than that in the system are overload events for
+// the linear controller, like tasks that waited too long in the queue
+constexpr double kOverloadLatencyFactor = 2;
+
+class Service final {
+ public:
+  explicit Service(const SimulationConfig& config)
+      : workers_(static_cast<double>(config.workers)),
+        base_latency_s_(config.base_latency_ms / 1000),
+        throughput_per_tick_(workers_ / base_latency_s_ * kTickSeconds) {}
+
+  double GetInSystem() const { return in_system_; }
+
+  // Time in system by Little's law
+  double GetLatencySeconds() const {
+    return base_latency_s_ * std::max(1.0, in_system_ / workers_);
+  }
+
+  bool IsOverloaded() const {
+    return GetLatencySeconds() > base_latency_s_ * kOverloadLatencyFactor;
+  }
+
+  double Tick(double admitted) {
+    in_system_ += admitted;
+    const auto served = std::min(in_system_, throughput_per_tick_);
+    in_system_ -= served;
+    return served;
+  }
+
+ private:
+  const double workers_;
+  const double base_latency_s_;
+  const double throughput_per_tick_;
+  double in_system_{0};
+};
+
+struct SecondStats {
+  double admitted{0};
+  double served{0};
+  double overloaded{0};
+  double latency_sum_s{0};
+};
+
+class LinearAdmission final {
+ public:
+  explicit LinearAdmission(const SimulationConfig& config)
+      : config_storage_({{congestion_control::impl::kRpsCcConfig,
+                          {config.policy, true}}}),
+        controller_("cc", config_storage_.GetSource()) {}
+
+  double Admit(double arrived, const Service&) const {
+    if (!limit_) return arrived;
+    return std::min(arrived, static_cast<double>(*limit_) * kTickSeconds);
+  }
+
+  void OnTick(const Service&, double) {}
+
+  void OnSecond(const SecondStats& stats) {
+    congestion_control::Sensor::Data data;
+    data.current_load = static_cast<std::uint64_t>(stats.admitted);
+    data.overload_events_count = static_cast<std::uint64_t>(stats.overloaded);
+    data.no_overload_events_count =
+        static_cast<std::uint64_t>(stats.admitted - stats.overloaded);
+    controller_.Feed(data);
+    limit_ = controller_.GetLimit().load_limit;
+  }
+
+  std::string GetLimit() const {
+    return limit_ ? std::to_string(*limit_) + "rps" : "(none)";
+  }
+
+ private:
+  dynamic_config::StorageMock config_storage_;
+  congestion_control::Controller controller_;
+  std::optional<std::size_t> limit_;
+};
+
+class AdaptiveAdmission final {
+ public:
+  explicit AdaptiveAdmission(const SimulationConfig& config)
+      : config_(config.adaptive), limit_(config_) {}
+
+  double Admit(double arrived, const Service& service) const {
+    const auto free_slots =
+        static_cast<double>(limit_.GetLimit()) - service.GetInSystem();
+    return std::clamp(free_slots, 0.0, arrived);
+  }
+
+  void OnTick(const Service& service, double admitted) {
+    if (admitted <= 0) return;
+    limit_.Update(config_,
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::duration<double>(
+                          service.GetLatencySeconds())),
+                  static_cast<std::size_t>(std::ceil(service.GetInSystem())),
+                  false);
+  }
+
+  void OnSecond(const SecondStats&) {}
+
+  std::string GetLimit() const {
+    return std::to_string(limit_.GetLimit()) + "inflight";
+  }
+
+ private:
+  const congestion_control::AdaptiveConcurrencyConfig config_;
+  congestion_control::AdaptiveConcurrencyLimit limit_;
+};
+
+template <typename Admission>
+void Run(const SimulationConfig& config, Admission& admission,
+         std::istream& input, std::ostream& output) {
+  Service service{config};
+
+  output << "second\toffered\tadmitted\tserved\tlatency_ms\tlimit\n";
+  for (std::size_t second = 0;; ++second) {
+    double offered_rps = 0;
+    input >> offered_rps;
+    if (input.eof()) break;
+    if (!input.good()) throw std::runtime_error("Invalid input");
+
+    SecondStats stats;
+    for (int tick = 0; tick < kTicksPerSecond; ++tick) {
+      const auto admitted =
+          admission.Admit(offered_rps * kTickSeconds, service);
+      stats.served += service.Tick(admitted);
+      stats.admitted += admitted;
+      if (service.IsOverloaded()) stats.overloaded += admitted;
+      stats.latency_sum_s += service.GetLatencySeconds();
+      admission.OnTick(service, admitted);
+    }
+    admission.OnSecond(stats);
+
+    output << fmt::format("{}\t{:.0f}\t{:.0f}\t{:.0f}\t{:.1f}\t{}\n", second,
+                          offered_rps, stats.admitted, stats.served,
+                          stats.latency_sum_s * 1000 / kTicksPerSecond,
+                          admission.GetLimit());
+  }
+}
+
+}  // namespace
+
+void Simulate(const SimulationConfig& config, std::istream& input,
+              std::ostream& output) {
+  if (config.controller == "linear") {
+    LinearAdmission admission{config};
+    Run(config, admission, input, output);
+    return;
+  }
+
+  auto adaptive_config = config;
+  if (config.controller == "gradient2") {
+    adaptive_config.adaptive.algorithm =
+        congestion_control::AdaptiveAlgorithm::kGradient2;
+  } else if (config.controller == "vegas") {
+    adaptive_config.adaptive.algorithm =
+        congestion_control::AdaptiveAlgorithm::kVegas;
+  } else {
+    throw std::runtime_error("Unknown controller: " + config.controller);
+  }
+  AdaptiveAdmission admission{adaptive_config};
+  Run(adaptive_config, admission, input, output);
+}
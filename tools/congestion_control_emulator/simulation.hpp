@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+#include <userver/congestion_control/adaptive_limiter.hpp>
+#include <userver/congestion_control/config.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+// Fluid model of a service with a fixed number of workers. Reads the offered
+// RPS, one line per second, and prints how the chosen controller admits it.
+struct SimulationConfig {
+  // "linear", "gradient2" or "vegas"
+  std::string controller = "linear";
+  std::size_t workers = 100;
+  double base_latency_ms = 100;
+  congestion_control::Policy policy;
+  congestion_control::AdaptiveConcurrencyConfig adaptive;
+};
+
+void Simulate(const SimulationConfig& config, std::istream& input,
+              std::ostream& output);
@@ -0,0 +1,125 @@
+#pragma once
+
+/// @file userver/ydb/bulk_upsert_batcher.hpp
+/// @brief @copybrief ydb::BulkUpsertBatcher
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ydb-cpp-sdk/client/value/value.h>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/yaml_config/fwd.hpp>
+#include <userver/ydb/io/traits.hpp>
+#include <userver/ydb/settings.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ydb {
+
+class TableClient;
+
+/// Settings of ydb::BulkUpsertBatcher
+struct BulkUpsertBatcherSettings final {
+  /// A batch is written once it has that many rows...
+  std::size_t max_batch_rows{1000};
+  /// ...or that many bytes of serialized rows...
+  std::size_t max_batch_bytes{4 * 1024 * 1024};
+  /// ...or once its first row waits for that long
+  std::chrono::milliseconds max_batch_delay{100};
+  /// Rows over that limit are dropped by Push
+  std::size_t max_queue_size{100'000};
+  /// Settings of the BulkUpsert requests, retries of the transient errors
+  /// included
+  OperationSettings operation_settings{};
+};
+
+BulkUpsertBatcherSettings Parse(const yaml_config::YamlConfig& config,
+                                formats::parse::To<BulkUpsertBatcherSettings>);
+
+/// @brief Write-behind batcher for TableClient::BulkUpsert.
+///
+/// Accepts rows from concurrent producers and writes them to the table in
+/// batches, bounded by rows count, bytes and time. Rows are serialized by the
+/// producers, the writes are done by a single background task.
+///
+/// A batch that failed after all the retries is dropped and accounted in the
+/// metrics.
+///
+/// @see ydb::BulkUpsertBatcherComponent
+class BulkUpsertBatcher final {
+ public:
+  BulkUpsertBatcher(std::shared_ptr<TableClient> table_client,
+                    std::string table, BulkUpsertBatcherSettings settings);
+
+  /// Writes the queued rows, see Stop
+  ~BulkUpsertBatcher();
+
+  /// @brief Queues a row, which must be a struct, see
+  /// @ref scripts/docs/en/userver/ydb.md
+  /// @returns false if the queue is full and the row is dropped
+  template <typename T>
+  bool Push(const T& row);
+
+  /// @brief Queues a row, which must be a `Struct` value
+  /// @returns false if the queue is full and the row is dropped
+  bool PushValue(NYdb::TValue&& row);
+
+  /// @brief Writes the queued rows and stops the background task.
+  /// @warning No Push calls are allowed after Stop
+  void Stop() noexcept;
+
+  /// @cond
+  // For internal use only.
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const BulkUpsertBatcher& batcher);
+  /// @endcond
+
+ private:
+  struct QueuedRow final {
+    std::optional<NYdb::TValue> value;
+    std::size_t bytes{0};
+  };
+
+  using Queue = concurrent::NonFifoMpscQueue<QueuedRow>;
+
+  struct Stats final {
+    utils::statistics::RateCounter rows_queued;
+    utils::statistics::RateCounter rows_dropped;
+    utils::statistics::RateCounter rows_written;
+    utils::statistics::RateCounter rows_failed;
+    utils::statistics::RateCounter bytes_written;
+    utils::statistics::RateCounter batches_written;
+    utils::statistics::RateCounter batches_failed;
+  };
+
+  void WritingLoop(Queue::Consumer& consumer);
+
+  void WriteBatch(const std::vector<NYdb::TValue>& rows, std::size_t bytes);
+
+  const std::shared_ptr<TableClient> table_client_;
+  const std::string table_;
+  const BulkUpsertBatcherSettings settings_;
+  Stats stats_;
+  std::shared_ptr<Queue> queue_;
+  std::optional<Queue::MultiProducer> producer_;
+  engine::TaskWithResult<void> writer_task_;  // Must be the last member
+};
+
+template <typename T>
+bool BulkUpsertBatcher::Push(const T& row) {
+  NYdb::TValueBuilder builder;
+  ydb::Write(builder, row);
+  return PushValue(builder.Build());
+}
+
+}  // namespace ydb
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#pragma once
+
+/// @file userver/ydb/bulk_upsert_batcher_component.hpp
+/// @brief @copybrief ydb::BulkUpsertBatcherComponent
+
+#include <optional>
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/ydb/bulk_upsert_batcher.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ydb {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that owns a ydb::BulkUpsertBatcher for a single table
+///
+/// Register the component under different names to write to several tables.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// dbname | the key of the database within ydb component (NOT the actual database path) | --
+/// table | the table to write to, relative to the database | --
+/// max-batch-rows | a batch is written once it has that many rows | 1000
+/// max-batch-bytes | a batch is written once it has that many bytes of serialized rows | 4194304
+/// max-batch-delay | a batch is written once its first row waits for that long | 100ms
+/// max-queue-size | rows over that limit are dropped | 100000
+/// retries | retries count of a batch, transient errors only | operation-settings.retries of ydb component
+
+// clang-format on
+class BulkUpsertBatcherComponent final : public components::ComponentBase {
+ public:
+  static constexpr std::string_view kName = "ydb-bulk-upsert-batcher";
+
+  BulkUpsertBatcherComponent(const components::ComponentConfig&,
+                             const components::ComponentContext&);
+  ~BulkUpsertBatcherComponent() override;
+
+  BulkUpsertBatcher& GetBatcher();
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::optional<BulkUpsertBatcher> batcher_;
+
+  // Subscriptions must be the last fields.
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace ydb
+
+template <>
+inline constexpr bool
+    components::kHasValidate<ydb::BulkUpsertBatcherComponent> = true;
+
+USERVER_NAMESPACE_END
@@ -51,6 +51,7 @@ class Driver;
 /// databases.<dbname>.max_pool_size | maximum pool size for database with name <dbname> | 50
 /// databases.<dbname>.get_session_retry_limit | retries count to get session, every attempt with a get-session-timeout | 5
 /// databases.<dbname>.keep-in-query-cache | whether to use query cache | true
+/// databases.<dbname>.warmup-sessions | sessions opened on start, the queries passed to ydb::TableClient::Warmup are prepared on each of them | 0
 /// databases.<dbname>.prefer_local_dc | prefer making requests to local DataCenter | false
 /// databases.<dbname>.aliases | list of alias names for this database | []
 /// databases.<dbname>.sync_start | fail on boot time if YDB is not accessible | true
@@ -183,10 +183,15 @@ class ExecuteResponse final {
   /// Returns true if Execute used the server query cache
   bool IsFromServerQueryCache() const noexcept;
 
+  /// Returns true if the query was already prepared, either on the session or
+  /// in the server query cache
+  bool IsFromQueryCache() const noexcept;
+
  private:
   void EnsureResultSetsNotEmpty() const;
 
   std::optional<NYdb::NTable::TQueryStats> query_stats_;
+  bool is_from_session_query_cache_{false};
   std::vector<NYdb::TResultSet> result_sets_;
 };
 
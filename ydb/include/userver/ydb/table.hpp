@@ -2,6 +2,13 @@
 
 #include <ydb-cpp-sdk/client/table/table.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
 #include <userver/dynamic_config/source.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -37,6 +44,30 @@ enum class IsStreaming : bool {};
 
 using ScanQuerySettings = NYdb::NTable::TStreamExecScanQuerySettings;
 
+/// Settings of the parallel reads, see TableClient::ReadTableParallel
+struct ParallelReadSettings final {
+  /// Max partitions read concurrently
+  std::size_t max_parallelism{4};
+  /// Settings of each partial read
+  OperationSettings operation_settings{};
+};
+
+/// Statistics of a single partition of a parallel read
+struct PartitionReadStats final {
+  std::size_t partition{0};
+  std::size_t rows{0};
+  std::size_t result_parts{0};
+  std::chrono::milliseconds elapsed{0};
+};
+
+/// @brief Consumer of the parallel reads, receives the partition index and
+/// a part of its rows.
+///
+/// @warning Called concurrently for different partitions. The calls for the
+/// same partition are sequential.
+using PartitionConsumer =
+    std::function<void(std::size_t partition, Cursor&& cursor)>;
+
 class TableClient final {
  public:
   /// @cond
@@ -107,6 +138,17 @@ class TableClient final {
   /// Builder for storing dynamic query params.
   PreparedArgsBuilder GetBuilder() const;
 
+  /// @brief Opens `warmup-sessions` sessions of the pool at once and prepares
+  /// `queries` on each of them, so that the first requests after a restart
+  /// do not wait for new sessions and query compilation.
+  ///
+  /// Sessions are warmed up when the client is created. Call this function
+  /// with the queries of a component from its constructor, so that they are
+  /// prepared before the service starts accepting requests.
+  ///
+  /// Does nothing if `warmup-sessions` is 0. Errors are logged and ignored.
+  void Warmup(const std::vector<Query>& queries = {});
+
   /// Efficiently write large ranges of table data.
   void BulkUpsert(std::string_view table, NYdb::TValue&& rows,
                   OperationSettings settings = {});
@@ -123,6 +165,44 @@ class TableClient final {
       NYdb::NTable::TReadTableSettings&& read_settings = {},
       OperationSettings settings = {});
 
+  /// @name Parallel reads
+  /// @brief Split a read into partitions that are read concurrently, with at
+  /// most ParallelReadSettings::max_parallelism partitions at a time.
+  ///
+  /// Rows are decoded by the tasks that read the partitions, so the decoding
+  /// is parallel too. Each partition is read in its own tracing span.
+  /// @{
+
+  /// Key ranges of the table partitions, in the key order
+  std::vector<NYdb::NTable::TKeyRange> GetPartitionKeyRanges(
+      std::string_view table);
+
+  /// @brief Reads the table by its partitions. The key bounds of
+  /// `read_settings` are replaced by the partition boundaries.
+  /// @returns statistics of each partition
+  std::vector<PartitionReadStats> ReadTableParallel(
+      std::string_view table, NYdb::NTable::TReadTableSettings read_settings,
+      const PartitionConsumer& consumer, ParallelReadSettings settings = {});
+
+  /// @brief Reads the table by its partitions and parses the rows to `T`,
+  /// which must be a struct type, see ydb::Row::As.
+  /// @returns rows of all the partitions, in the key order if
+  /// `read_settings` are `Ordered`
+  template <typename T>
+  std::vector<T> ReadTableParallelAs(
+      std::string_view table,
+      NYdb::NTable::TReadTableSettings read_settings = {},
+      ParallelReadSettings settings = {});
+
+  /// @brief Executes the scan query once per element of `shards` with its
+  /// parameters, e.g. with the bounds of a key range.
+  /// @returns statistics of each shard
+  std::vector<PartitionReadStats> ExecuteScanQueryParallel(
+      ScanQuerySettings scan_settings, const Query& query,
+      std::vector<PreparedArgsBuilder>&& shards,
+      const PartitionConsumer& consumer, ParallelReadSettings settings = {});
+  /// @}
+
   /// @name Scan queries execution
   /// A separate data access interface designed primarily for performing
   /// analytical ad-hoc queries.
@@ -169,6 +249,11 @@ class TableClient final {
   template <typename... Args>
   PreparedArgsBuilder MakeBuilder(Args&&... args);
 
+  std::vector<PartitionReadStats> ReadKeyRangesParallel(
+      std::string_view table, std::vector<NYdb::NTable::TKeyRange>&& key_ranges,
+      const NYdb::NTable::TReadTableSettings& read_settings,
+      const PartitionConsumer& consumer, ParallelReadSettings&& settings);
+
   // Func: (TSession, const std::string& full_path, const Settings&)
   //       -> NThreading::TFuture<T>
   //       OR
@@ -183,6 +268,7 @@ class TableClient final {
   dynamic_config::Source config_source_;
   const OperationSettings default_settings_;
   const bool keep_in_query_cache_;
+  const std::uint32_t warmup_sessions_;
   std::unique_ptr<impl::Stats> stats_;
   std::shared_ptr<impl::Driver> driver_;
   std::unique_ptr<NYdb::NScheme::TSchemeClient> scheme_client_;
@@ -219,6 +305,37 @@ void TableClient::BulkUpsert(std::string_view table, const RangeOfStructs& rows,
   BulkUpsert(table, builder.Build(), std::move(settings));
 }
 
+template <typename T>
+std::vector<T> TableClient::ReadTableParallelAs(
+    std::string_view table, NYdb::NTable::TReadTableSettings read_settings,
+    ParallelReadSettings settings) {
+  auto key_ranges = GetPartitionKeyRanges(table);
+  std::vector<std::vector<T>> partitions(
+      std::max<std::size_t>(key_ranges.size(), 1));
+
+  ReadKeyRangesParallel(
+      table, std::move(key_ranges), read_settings,
+      [&partitions](std::size_t partition, Cursor&& cursor) {
+        auto& rows = partitions[partition];
+        rows.reserve(rows.size() + cursor.size());
+        for (auto row : cursor) {
+          rows.push_back(std::move(row).template As<T>());
+        }
+      },
+      std::move(settings));
+
+  std::size_t total_rows = 0;
+  for (const auto& rows : partitions) total_rows += rows.size();
+
+  std::vector<T> result;
+  result.reserve(total_rows);
+  for (auto& rows : partitions) {
+    result.insert(result.end(), std::make_move_iterator(rows.begin()),
+                  std::make_move_iterator(rows.end()));
+  }
+  return result;
+}
+
 template <typename... Args>
 ScanQueryResults TableClient::ExecuteScanQuery(const Query& query,
                                                Args&&... args) {
@@ -0,0 +1,159 @@
+#include <userver/ydb/bulk_upsert_batcher.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+#include <userver/ydb/table.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ydb {
+
+namespace {
+
+utils::statistics::Rate ToRate(std::size_t value) {
+  return utils::statistics::Rate{
+      static_cast<utils::statistics::Rate::ValueType>(value)};
+}
+
+}  // namespace
+
+BulkUpsertBatcherSettings Parse(const yaml_config::YamlConfig& config,
+                                formats::parse::To<BulkUpsertBatcherSettings>) {
+  BulkUpsertBatcherSettings result;
+  result.max_batch_rows =
+      config["max-batch-rows"].As<std::size_t>(result.max_batch_rows);
+  result.max_batch_bytes =
+      config["max-batch-bytes"].As<std::size_t>(result.max_batch_bytes);
+  result.max_batch_delay =
+      config["max-batch-delay"].As<std::chrono::milliseconds>(
+          result.max_batch_delay);
+  result.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(result.max_queue_size);
+  result.operation_settings.retries =
+      config["retries"].As<std::optional<std::uint32_t>>();
+
+  if (result.max_batch_rows == 0 || result.max_batch_bytes == 0) {
+    throw std::runtime_error(fmt::format(
+        "Validation max-batch-rows > 0 and max-batch-bytes > 0 failed for "
+        "'{}'",
+        config.GetPath()));
+  }
+  return result;
+}
+
+BulkUpsertBatcher::BulkUpsertBatcher(std::shared_ptr<TableClient> table_client,
+                                     std::string table,
+                                     BulkUpsertBatcherSettings settings)
+    : table_client_(std::move(table_client)),
+      table_(std::move(table)),
+      settings_(std::move(settings)),
+      queue_(Queue::Create(settings_.max_queue_size)),
+      producer_(queue_->GetMultiProducer()) {
+  writer_task_ = engine::CriticalAsyncNoSpan(
+      [this, consumer = queue_->GetConsumer()]() mutable {
+        WritingLoop(consumer);
+      });
+}
+
+BulkUpsertBatcher::~BulkUpsertBatcher() { Stop(); }
+
+bool BulkUpsertBatcher::PushValue(NYdb::TValue&& row) {
+  UASSERT_MSG(producer_, "Push after Stop");
+  QueuedRow queued_row;
+  queued_row.bytes = row.GetProto().ByteSizeLong();
+  queued_row.value.emplace(std::move(row));
+
+  if (!producer_->PushNoblock(std::move(queued_row))) {
+    ++stats_.rows_dropped;
+    return false;
+  }
+  ++stats_.rows_queued;
+  return true;
+}
+
+void BulkUpsertBatcher::Stop() noexcept {
+  if (!writer_task_.IsValid()) return;
+
+  // The writer drains the queue and exits once there are no producers
+  producer_.reset();
+  try {
+    writer_task_.Get();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to write the queued rows to '" << table_
+                << "': " << ex;
+    writer_task_.SyncCancel();
+  }
+}
+
+void BulkUpsertBatcher::WritingLoop(Queue::Consumer& consumer) {
+  QueuedRow row;
+  std::vector<NYdb::TValue> batch;
+  while (consumer.Pop(row)) {
+    const auto deadline =
+        engine::Deadline::FromDuration(settings_.max_batch_delay);
+    std::size_t batch_bytes = 0;
+    do {
+      batch_bytes += row.bytes;
+      batch.push_back(std::move(*row.value));
+    } while (batch.size() < settings_.max_batch_rows &&
+             batch_bytes < settings_.max_batch_bytes &&
+             consumer.Pop(row, deadline));
+
+    WriteBatch(batch, batch_bytes);
+    batch.clear();
+  }
+}
+
+void BulkUpsertBatcher::WriteBatch(const std::vector<NYdb::TValue>& rows,
+                                   std::size_t bytes) {
+  tracing::Span span{"ydb_bulk_upsert_batch"};
+  span.AddTag("ydb_table", table_);
+  span.AddTag("ydb_batch_rows", rows.size());
+
+  NYdb::TValueBuilder builder;
+  builder.BeginList();
+  for (const auto& row : rows) {
+    builder.AddListItem(row);
+  }
+  builder.EndList();
+
+  // Transient errors are retried by BulkUpsert itself
+  try {
+    table_client_->BulkUpsert(table_, builder.Build(),
+                              OperationSettings{settings_.operation_settings});
+    ++stats_.batches_written;
+    stats_.rows_written += ToRate(rows.size());
+    stats_.bytes_written += ToRate(bytes);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to write a batch of " << rows.size()
+                << " rows to '" << table_ << "': " << ex;
+    ++stats_.batches_failed;
+    stats_.rows_failed += ToRate(rows.size());
+  }
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const BulkUpsertBatcher& batcher) {
+  const auto& stats = batcher.stats_;
+  writer["queue-size"] = batcher.queue_->GetSizeApproximate();
+  writer["rows"]["queued"] = stats.rows_queued.Load();
+  writer["rows"]["dropped"] = stats.rows_dropped.Load();
+  writer["rows"]["written"] = stats.rows_written.Load();
+  writer["rows"]["failed"] = stats.rows_failed.Load();
+  writer["bytes-written"] = stats.bytes_written.Load();
+  writer["batches"]["written"] = stats.batches_written.Load();
+  writer["batches"]["failed"] = stats.batches_failed.Load();
+}
+
+}  // namespace ydb
+
+USERVER_NAMESPACE_END
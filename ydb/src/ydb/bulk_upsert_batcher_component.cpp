@@ -0,0 +1,80 @@
+#include <userver/ydb/bulk_upsert_batcher_component.hpp>
+
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/ydb/component.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ydb {
+
+BulkUpsertBatcherComponent::BulkUpsertBatcherComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : components::ComponentBase(config, context) {
+  const auto dbname = config["dbname"].As<std::string>();
+  auto table = config["table"].As<std::string>();
+
+  auto table_client =
+      context.FindComponent<YdbComponent>().GetTableClient(dbname);
+  batcher_.emplace(std::move(table_client), table,
+                   config.As<BulkUpsertBatcherSettings>());
+
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = statistics_storage.RegisterWriter(
+      "ydb.bulk-upsert-batcher",
+      [this](utils::statistics::Writer& writer) { writer = *batcher_; },
+      {{"ydb_database", dbname}, {"ydb_table", std::move(table)}});
+}
+
+BulkUpsertBatcherComponent::~BulkUpsertBatcherComponent() {
+  statistics_holder_.Unregister();
+  batcher_->Stop();
+}
+
+BulkUpsertBatcher& BulkUpsertBatcherComponent::GetBatcher() {
+  return *batcher_;
+}
+
+yaml_config::Schema BulkUpsertBatcherComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::ComponentBase>(R"(
+type: object
+description: YDB BulkUpsert write-behind batcher component
+additionalProperties: false
+properties:
+    dbname:
+        type: string
+        description: the key of the database within ydb component (NOT the actual database path)
+    table:
+        type: string
+        description: the table to write to, relative to the database
+    max-batch-rows:
+        type: integer
+        description: a batch is written once it has that many rows
+        defaultDescription: 1000
+        minimum: 1
+    max-batch-bytes:
+        type: integer
+        description: a batch is written once it has that many bytes of serialized rows
+        defaultDescription: 4194304
+        minimum: 1
+    max-batch-delay:
+        type: string
+        description: a batch is written once its first row waits for that long
+        defaultDescription: 100ms
+    max-queue-size:
+        type: integer
+        description: rows over that limit are dropped
+        defaultDescription: 100000
+    retries:
+        type: integer
+        description: retries count of a batch, transient errors only
+        defaultDescription: operation-settings.retries of ydb component
+  )");
+}
+
+}  // namespace ydb
+
+USERVER_NAMESPACE_END
@@ -251,6 +251,13 @@ properties:
                     type: boolean
                     defaultDescription: true
                     description: whether to use query cache
+                warmup-sessions:
+                    type: integer
+                    minimum: 0
+                    defaultDescription: 0
+                    description: |
+                        sessions opened on start, the queries passed to
+                        TableClient::Warmup are prepared on each of them
                 prefer_local_dc:
                     type: boolean
                     defaultDescription: true
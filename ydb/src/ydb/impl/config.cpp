@@ -44,6 +44,8 @@ TableSettings ParseTableSettings(const yaml_config::YamlConfig& dbconfig,
           result.get_session_retry_limit);
   result.keep_in_query_cache =
       dbconfig["keep-in-query-cache"].As<bool>(result.keep_in_query_cache);
+  result.warmup_sessions =
+      dbconfig["warmup-sessions"].As<std::uint32_t>(result.warmup_sessions);
 
   result.sync_start = dbconfig["sync_start"].As<bool>(result.sync_start);
 
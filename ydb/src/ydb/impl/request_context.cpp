@@ -147,8 +147,9 @@ RequestContext::RequestContext(TableClient& table_client_, const Query& query,
                                const utils::impl::SourceLocation& location)
     : table_client(table_client_),
       settings(settings),
+      table_stats(*table_client.stats_),
       initial_uncaught_exceptions(std::uncaught_exceptions()),
-      stats_scope(*table_client.stats_, query),
+      stats_scope(table_stats, query),
       config_snapshot(table_client.config_source_.GetSnapshot()),
       // Note: comma operator is used to insert code between initializations.
       span((PrepareSettings(query, config_snapshot, settings, is_streaming,
@@ -32,6 +32,8 @@ struct RequestContext final {
 
   TableClient& table_client;
   OperationSettings& settings;
+  // Outlives the request, unlike the context itself
+  Stats& table_stats;
   const int initial_uncaught_exceptions;
   StatsScope stats_scope;
   dynamic_config::Snapshot config_snapshot;
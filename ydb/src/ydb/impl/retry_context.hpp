@@ -2,6 +2,9 @@
 
 #include <ydb-cpp-sdk/client/retry/retry.h>
 
+#include <chrono>
+#include <utility>
+
 #include <userver/utils/retry_budget.hpp>
 #include <userver/ydb/table.hpp>
 
@@ -45,7 +48,21 @@ auto RetryOperation(impl::RequestContext& request_context, Func&& func) {
   return request_context.table_client.GetNativeTableClient()
       .RetryOperation(
           [final_result, func = std::forward<Func>(func),
-           &retry_budget = retry_budget](FuncArg arg) mutable {
+           &retry_budget = retry_budget,
+           &session_acquisition_timings =
+               request_context.table_stats.session_acquisition_timings,
+           start = std::chrono::steady_clock::now(),
+           is_first_attempt = true](FuncArg arg) mutable {
+            if constexpr (std::is_same_v<FuncArg, NYdb::NTable::TSession>) {
+              if (std::exchange(is_first_attempt, false)) {
+                session_acquisition_timings.Account(
+                    std::chrono::duration_cast<
+                        std::chrono::duration<double, std::milli>>(
+                        std::chrono::steady_clock::now() - start)
+                        .count());
+              }
+            }
+
             // If `func` throws, `RetryOperation` will immediately rethrow
             // the exception without further retries.
             AsyncResultType result_future = func(std::forward<FuncArg>(arg));
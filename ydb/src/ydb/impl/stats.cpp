@@ -51,6 +51,9 @@ void DoDumpMetric(utils::statistics::Writer& writer, const T& stats) {
   writer["timings"] = stats.timings;
 
   writer["cancelled"] = stats.cancelled;
+
+  writer["query-cache"]["hit"] = Load(stats.query_cache_hit);
+  writer["query-cache"]["miss"] = Load(stats.query_cache_miss);
 }
 
 }  // namespace
@@ -76,6 +79,8 @@ void StatsAggregator::Add(const StatsCounters& other) {
   transport_error += other.transport_error.Load();
   timings.Add(other.timings.GetView());
   cancelled += other.cancelled.Load();
+  query_cache_hit += other.query_cache_hit.Load();
+  query_cache_miss += other.query_cache_miss.Load();
 }
 
 void StatsAggregator::Assign(const StatsCounters& other) {
@@ -85,6 +90,8 @@ void StatsAggregator::Assign(const StatsCounters& other) {
   timings.Reset();
   timings.Add(other.timings.GetView());
   cancelled = other.cancelled.Load();
+  query_cache_hit = other.query_cache_hit.Load();
+  query_cache_miss = other.query_cache_miss.Load();
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -98,6 +105,7 @@ Stats::Stats(utils::span<const double> by_database_histogram_bounds,
           by_database_histogram_bounds)),
       by_query_histogram_bounds(
           utils::AsContainer<std::vector<double>>(by_query_histogram_bounds)),
+      session_acquisition_timings(by_database_histogram_bounds),
       unnamed_queries(by_database_histogram_bounds) {}
 
 void DumpMetric(utils::statistics::Writer& writer, const Stats& stats) {
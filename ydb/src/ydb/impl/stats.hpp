@@ -25,6 +25,8 @@ struct StatsCounters final {
   utils::statistics::RateCounter transport_error;
   utils::statistics::Histogram timings;
   utils::statistics::RateCounter cancelled;
+  utils::statistics::RateCounter query_cache_hit;
+  utils::statistics::RateCounter query_cache_miss;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const StatsCounters& stats);
@@ -41,6 +43,8 @@ struct StatsAggregator final {
   utils::statistics::Rate transport_error;
   utils::statistics::HistogramAggregator timings;
   utils::statistics::Rate cancelled;
+  utils::statistics::Rate query_cache_hit;
+  utils::statistics::Rate query_cache_miss;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -53,6 +57,9 @@ struct Stats final {
   const std::vector<double> by_database_histogram_bounds;
   const std::vector<double> by_query_histogram_bounds;
 
+  // Time from the start of a request till its first session is acquired
+  utils::statistics::Histogram session_acquisition_timings;
+
   StatsCounters unnamed_queries;
   rcu::RcuMap<std::string, StatsCounters> by_query;
   rcu::RcuMap<std::string, StatsCounters> by_transaction;
@@ -128,6 +128,7 @@ std::optional<NYdb::NTable::TQueryStats> GetStats(
 
 ExecuteResponse::ExecuteResponse(NYdb::NTable::TDataQueryResult&& query_result)
     : query_stats_(GetStats(query_result)),
+      is_from_session_query_cache_(query_result.IsQueryFromCache()),
       result_sets_(std::move(query_result).ExtractResultSets()) {}
 
 std::size_t ExecuteResponse::GetCursorCount() const {
@@ -168,6 +169,10 @@ bool ExecuteResponse::IsFromServerQueryCache() const noexcept {
   return stats_raw.compilation().from_cache();
 }
 
+bool ExecuteResponse::IsFromQueryCache() const noexcept {
+  return is_from_session_query_cache_ || IsFromServerQueryCache();
+}
+
 void ExecuteResponse::EnsureResultSetsNotEmpty() const {
   if (result_sets_.empty()) {
     throw EmptyResponseError{"There are no result sets in ExecuteResponse"};
@@ -1,8 +1,13 @@
 #include <userver/ydb/table.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/wait_all_checked.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <userver/ydb/impl/cast.hpp>
 
@@ -32,6 +37,50 @@ NYdb::NTable::TTxSettings PrepareTxSettings(const OperationSettings& settings) {
   }
 }
 
+// ReadPartition: (std::size_t partition, PartitionReadStats&) -> void
+template <typename ReadPartition>
+std::vector<PartitionReadStats> ReadPartitionsParallel(
+    std::size_t partitions_count, std::size_t max_parallelism,
+    const ReadPartition& read_partition) {
+  std::vector<PartitionReadStats> stats(partitions_count);
+  std::atomic<std::size_t> next_partition{0};
+
+  const auto workers_count =
+      std::min(partitions_count, std::max<std::size_t>(max_parallelism, 1));
+  std::vector<engine::TaskWithResult<void>> workers;
+  workers.reserve(workers_count);
+  for (std::size_t i = 0; i < workers_count; ++i) {
+    workers.push_back(utils::Async("ydb_read_partitions", [&] {
+      for (auto partition = next_partition++; partition < partitions_count;
+           partition = next_partition++) {
+        tracing::Span span{"ydb_read_partition"};
+        span.AddTag("ydb_partition", partition);
+
+        auto& partition_stats = stats[partition];
+        partition_stats.partition = partition;
+        const auto start = std::chrono::steady_clock::now();
+        read_partition(partition, partition_stats);
+        partition_stats.elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        span.AddTag("ydb_partition_rows", partition_stats.rows);
+      }
+    }));
+  }
+  engine::WaitAllChecked(workers);
+
+  return stats;
+}
+
+void ConsumePartitionCursor(std::size_t partition, Cursor&& cursor,
+                            PartitionReadStats& stats,
+                            const PartitionConsumer& consumer) {
+  ++stats.result_parts;
+  stats.rows += cursor.size();
+  consumer(partition, std::move(cursor));
+}
+
 }  // namespace
 
 TableClient::TableClient(impl::TableSettings settings,
@@ -41,6 +90,8 @@ TableClient::TableClient(impl::TableSettings settings,
     : config_source_(config_source),
       default_settings_(std::move(operation_settings)),
       keep_in_query_cache_(settings.keep_in_query_cache),
+      warmup_sessions_(
+          std::min(settings.warmup_sessions, settings.max_pool_size)),
       stats_(std::make_unique<impl::Stats>(
           settings.by_database_timings_buckets
               ? utils::span{*settings.by_database_timings_buckets}
@@ -66,6 +117,9 @@ TableClient::TableClient(impl::TableSettings settings,
                 << driver_->GetDbName() << "'";
     Select1();
   }
+  if (warmup_sessions_ != 0) {
+    Warmup();
+  }
 }
 
 TableClient::~TableClient() {
@@ -154,6 +208,126 @@ ScanQueryResults TableClient::ExecuteScanQuery(
       std::move(future), "ExecuteScanQuery", context)};
 }
 
+std::vector<NYdb::NTable::TKeyRange> TableClient::GetPartitionKeyRanges(
+    std::string_view table) {
+  using Settings = NYdb::NTable::TDescribeTableSettings;
+  const auto result = ExecuteWithPathImpl<Settings>(
+      table, "DescribeTable", /*settings=*/{},
+      [](NYdb::NTable::TSession session, const std::string& full_path,
+         const Settings& settings) {
+        auto describe_settings = settings;
+        describe_settings.WithKeyShardBoundary(true);
+        return session.DescribeTable(impl::ToString(full_path),
+                                     describe_settings);
+      });
+
+  const auto& key_ranges = result.GetTableDescription().GetKeyRanges();
+  return {key_ranges.begin(), key_ranges.end()};
+}
+
+std::vector<PartitionReadStats> TableClient::ReadTableParallel(
+    std::string_view table, NYdb::NTable::TReadTableSettings read_settings,
+    const PartitionConsumer& consumer, ParallelReadSettings settings) {
+  return ReadKeyRangesParallel(table, GetPartitionKeyRanges(table),
+                               read_settings, consumer, std::move(settings));
+}
+
+std::vector<PartitionReadStats> TableClient::ReadKeyRangesParallel(
+    std::string_view table, std::vector<NYdb::NTable::TKeyRange>&& key_ranges,
+    const NYdb::NTable::TReadTableSettings& read_settings,
+    const PartitionConsumer& consumer, ParallelReadSettings&& settings) {
+  // A table without the known boundaries is read as a whole
+  if (key_ranges.empty()) key_ranges.emplace_back(std::nullopt, std::nullopt);
+
+  return ReadPartitionsParallel(
+      key_ranges.size(), settings.max_parallelism,
+      [&](std::size_t partition, PartitionReadStats& stats) {
+        const auto& key_range = key_ranges[partition];
+        auto partition_settings = read_settings;
+        partition_settings.From_ = key_range.From();
+        partition_settings.To_ = key_range.To();
+
+        auto results = ReadTable(table, std::move(partition_settings),
+                                 OperationSettings{settings.operation_settings});
+        while (auto cursor = results.GetNextResult()) {
+          ConsumePartitionCursor(partition, std::move(*cursor), stats,
+                                 consumer);
+        }
+      });
+}
+
+std::vector<PartitionReadStats> TableClient::ExecuteScanQueryParallel(
+    ScanQuerySettings scan_settings, const Query& query,
+    std::vector<PreparedArgsBuilder>&& shards,
+    const PartitionConsumer& consumer, ParallelReadSettings settings) {
+  return ReadPartitionsParallel(
+      shards.size(), settings.max_parallelism,
+      [&](std::size_t shard, PartitionReadStats& stats) {
+        auto results = ExecuteScanQuery(
+            ScanQuerySettings{scan_settings},
+            OperationSettings{settings.operation_settings}, query,
+            std::move(shards[shard]));
+        while (auto cursor = results.GetNextCursor()) {
+          ConsumePartitionCursor(shard, std::move(*cursor), stats, consumer);
+        }
+      });
+}
+
+void TableClient::Warmup(const std::vector<Query>& queries) {
+  if (warmup_sessions_ == 0) return;
+
+  tracing::Span span{"ydb_warmup"};
+  span.AddTag("ydb_database", driver_->GetDbName());
+
+  NYdb::NTable::TCreateSessionSettings session_settings;
+  if (default_settings_.get_session_timeout_ms.count() > 0) {
+    session_settings.ClientTimeout(default_settings_.get_session_timeout_ms);
+  }
+
+  // All the sessions are requested at once, so that the pool has to grow
+  std::vector<NYdb::NTable::TAsyncCreateSessionResult> session_futures;
+  session_futures.reserve(warmup_sessions_);
+  for (std::uint32_t i = 0; i < warmup_sessions_; ++i) {
+    session_futures.push_back(table_client_->GetSession(session_settings));
+  }
+
+  std::vector<NYdb::NTable::TSession> sessions;
+  sessions.reserve(warmup_sessions_);
+  for (auto& future : session_futures) {
+    try {
+      sessions.push_back(
+          impl::GetFutureValueChecked(std::move(future), "GetSession")
+              .GetSession());
+    } catch (const BaseError& ex) {
+      LOG_WARNING() << "Failed to open a session for warmup: " << ex;
+    }
+  }
+
+  // Prepared queries are kept in the query cache of each session
+  std::vector<NYdb::NTable::TAsyncPrepareQueryResult> prepare_futures;
+  prepare_futures.reserve(sessions.size() * queries.size());
+  for (auto& session : sessions) {
+    for (const auto& query : queries) {
+      prepare_futures.push_back(
+          session.PrepareDataQuery(impl::ToString(query.Statement())));
+    }
+  }
+
+  std::size_t prepared_count = 0;
+  for (auto& future : prepare_futures) {
+    try {
+      impl::GetFutureValueChecked(std::move(future), "PrepareDataQuery");
+      ++prepared_count;
+    } catch (const BaseError& ex) {
+      LOG_WARNING() << "Failed to prepare a query for warmup: " << ex;
+    }
+  }
+
+  LOG_INFO() << "Warmed up " << sessions.size() << " sessions of ydb database '"
+             << driver_->GetDbName() << "', prepared " << prepared_count
+             << " of " << prepare_futures.size() << " queries";
+}
+
 void TableClient::Select1() {
   const auto response = ExecuteDataQuery(Query("SELECT 1"))
                             .GetSingleCursor()
@@ -310,10 +484,12 @@ ExecuteResponse TableClient::ExecuteDataQuery(QuerySettings query_settings,
                                               const Query& query,
                                               PreparedArgsBuilder&& builder) {
   impl::RequestContext context{*this, query, settings};
+  auto exec_settings = ToExecQuerySettings(query_settings);
+  const bool keep_in_query_cache = exec_settings.KeepInQueryCache_;
 
   auto future = impl::RetryOperation(
       context, [query = query.Statement(), params = std::move(builder).Build(),
-                exec_settings = ToExecQuerySettings(query_settings),
+                exec_settings = std::move(exec_settings),
                 settings = std::move(settings), deadline = context.deadline](
                    NYdb::NTable::TSession session) mutable {
         impl::ApplyToRequestSettings(exec_settings, settings, deadline);
@@ -324,8 +500,12 @@ ExecuteResponse TableClient::ExecuteDataQuery(QuerySettings query_settings,
                                         exec_settings);
       });
 
-  return ExecuteResponse{impl::GetFutureValueChecked(
+  ExecuteResponse response{impl::GetFutureValueChecked(
       std::move(future), "ExecuteDataQuery", context)};
+  if (keep_in_query_cache) {
+    context.stats_scope.OnQueryCacheResult(response.IsFromQueryCache());
+  }
+  return response;
 }
 
 std::string TableClient::JoinDbPath(std::string_view path) const {
@@ -342,6 +522,8 @@ void DumpMetric(utils::statistics::Writer& writer,
       table_client.table_client_->GetActiveSessionCount();
   writer["pool"]["max-size"] =
       table_client.table_client_->GetActiveSessionsLimit();
+  writer["pool"]["session-acquisition-timings"] =
+      table_client.stats_->session_acquisition_timings;
 }
 
 PreparedArgsBuilder TableClient::GetBuilder() const {
@@ -157,7 +157,11 @@ ExecuteResponse Transaction::Execute(QuerySettings query_settings,
       table_client_.driver_->GetRetryBudget(), context);
 
   error_guard.Release();
-  return ExecuteResponse(std::move(status));
+  ExecuteResponse response{std::move(status)};
+  if (exec_settings.KeepInQueryCache_) {
+    context.stats_scope.OnQueryCacheResult(response.IsFromQueryCache());
+  }
+  return response;
 }
 
 }  // namespace ydb
@@ -0,0 +1,99 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/testing.hpp>
+#include <userver/ydb/bulk_upsert_batcher.hpp>
+
+#include "small_table.hpp"
+#include "test_utils.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kProducersCount = 4;
+constexpr std::size_t kRowsPerProducer = 50;
+
+class YdbBulkUpsertBatcher : public YdbSmallTableTest {
+ protected:
+  std::vector<tests::RowValue> SelectAllRows() {
+    auto cursor =
+        GetTableClient().ExecuteDataQuery(kSelectAllRows).GetSingleCursor();
+    std::vector<tests::RowValue> rows;
+    for (auto row : cursor) {
+      rows.push_back(std::move(row).As<tests::RowValue>());
+    }
+    return rows;
+  }
+};
+
+tests::RowValue MakeRow(std::size_t index) {
+  // Zero-padded, so that the keys are ordered as the indexes
+  return {fmt::format("key{:04}", index), fmt::format("value{}", index),
+          static_cast<std::int32_t>(index)};
+}
+
+}  // namespace
+
+UTEST_F_MT(YdbBulkUpsertBatcher, ConcurrentProducers, kProducersCount) {
+  CreateTable("test_table", false);
+
+  ydb::BulkUpsertBatcherSettings settings;
+  settings.max_batch_rows = 16;
+  ydb::BulkUpsertBatcher batcher{GetTableClientPtr(), "test_table", settings};
+
+  std::vector<engine::TaskWithResult<void>> producers;
+  for (std::size_t producer = 0; producer < kProducersCount; ++producer) {
+    producers.push_back(utils::Async("producer", [&batcher, producer] {
+      for (std::size_t i = 0; i < kRowsPerProducer; ++i) {
+        EXPECT_TRUE(batcher.Push(MakeRow(producer * kRowsPerProducer + i)));
+      }
+    }));
+  }
+  for (auto& producer : producers) producer.Get();
+  batcher.Stop();
+
+  const auto rows = SelectAllRows();
+  ASSERT_EQ(rows.size(), kProducersCount * kRowsPerProducer);
+  for (const auto& [index, row] : utils::enumerate(rows)) {
+    EXPECT_EQ(row.key, MakeRow(index).key);
+    EXPECT_EQ(row.value_int, static_cast<std::int32_t>(index));
+  }
+
+  utils::statistics::Storage storage;
+  const auto entry = storage.RegisterWriter(
+      "batcher",
+      [&batcher](utils::statistics::Writer& writer) { writer = batcher; });
+  const utils::statistics::Snapshot snapshot{storage, "batcher"};
+  EXPECT_EQ(snapshot.SingleMetric("rows.written").AsRate(),
+            kProducersCount * kRowsPerProducer);
+  EXPECT_EQ(snapshot.SingleMetric("rows.dropped").AsRate(), 0);
+  EXPECT_GE(snapshot.SingleMetric("batches.written").AsRate(),
+            kProducersCount * kRowsPerProducer / settings.max_batch_rows);
+}
+
+UTEST_F(YdbBulkUpsertBatcher, WritesByDelay) {
+  CreateTable("test_table", false);
+
+  ydb::BulkUpsertBatcherSettings settings;
+  settings.max_batch_delay = std::chrono::milliseconds{10};
+  ydb::BulkUpsertBatcher batcher{GetTableClientPtr(), "test_table", settings};
+
+  for (const auto& row : kPreFilledRows) {
+    ASSERT_TRUE(batcher.Push(row));
+  }
+
+  // The batch is not full, so it is written by the delay
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (SelectAllRows().size() != kPreFilledRows.size()) {
+    ASSERT_FALSE(deadline.IsReached());
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -601,4 +601,36 @@ UTEST_F(YdbExecute, CursorThrow) {
   UASSERT_THROW(cursor.GetFirstRow(), ydb::EmptyResponseError);
 }
 
+UTEST_F(YdbExecute, QueryCacheMetrics) {
+  CreateTable("query_cache", true);
+  const ydb::Query query{R"(
+        SELECT *
+        FROM query_cache
+        WHERE key = "key1";
+    )",
+                         ydb::Query::Name{"query_cache_select"}};
+
+  constexpr int kExecutionsCount = 3;
+  for (int i = 0; i < kExecutionsCount; ++i) {
+    GetTableClient().ExecuteDataQuery(query);
+  }
+
+  const auto metrics = GetMetrics();
+  const auto query_metrics = [&](std::string_view path) {
+    return metrics
+        .SingleMetric(std::string{path}, {{"ydb_query", "query_cache_select"}})
+        .AsRate();
+  };
+  // The query is prepared on the first execution on a session
+  EXPECT_EQ(query_metrics("ydb.by-query.query-cache.hit") +
+                query_metrics("ydb.by-query.query-cache.miss"),
+            kExecutionsCount);
+  EXPECT_GE(query_metrics("ydb.by-query.query-cache.miss"), 1);
+
+  EXPECT_GT(metrics.SingleMetric("ydb.pool.session-acquisition-timings")
+                .AsHistogram()
+                .GetTotalCount(),
+            0);
+}
+
 USERVER_NAMESPACE_END
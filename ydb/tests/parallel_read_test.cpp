@@ -0,0 +1,153 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+
+#include "small_table.hpp"
+#include "test_utils.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tests {
+
+struct PartitionedRow {
+  static constexpr ydb::StructMemberNames kYdbMemberNames{};
+
+  std::uint64_t key;
+  std::string value;
+};
+
+}  // namespace tests
+
+namespace {
+
+constexpr std::size_t kPartitionsCount = 4;
+constexpr std::uint64_t kRowsCount = 100;
+
+class YdbParallelRead : public YdbSmallTableTest {
+ protected:
+  void CreatePartitionedTable() {
+    DoCreateTable(
+        "partitioned_table",
+        NYdb::NTable::TTableBuilder()
+            .AddNonNullableColumn("key", NYdb::EPrimitiveType::Uint64)
+            .AddNullableColumn("value", NYdb::EPrimitiveType::String)
+            .SetPrimaryKeyColumn("key")
+            .SetUniformPartitions(kPartitionsCount)
+            .Build());
+
+    // Spread the keys over the whole range, so that every partition has rows
+    constexpr auto kKeyStep = std::numeric_limits<std::uint64_t>::max() /
+                              kRowsCount;
+    std::vector<tests::PartitionedRow> rows;
+    for (std::uint64_t i = 0; i < kRowsCount; ++i) {
+      rows.push_back({i * kKeyStep, std::to_string(i)});
+    }
+    GetTableClient().BulkUpsert("partitioned_table", rows);
+  }
+};
+
+}  // namespace
+
+UTEST_F(YdbParallelRead, PartitionKeyRanges) {
+  CreatePartitionedTable();
+
+  const auto key_ranges =
+      GetTableClient().GetPartitionKeyRanges("partitioned_table");
+  ASSERT_EQ(key_ranges.size(), kPartitionsCount);
+  EXPECT_FALSE(key_ranges.front().From().has_value());
+  EXPECT_FALSE(key_ranges.back().To().has_value());
+}
+
+UTEST_F(YdbParallelRead, ReadTableParallelAs) {
+  CreatePartitionedTable();
+
+  const auto rows =
+      GetTableClient().ReadTableParallelAs<tests::PartitionedRow>(
+          "partitioned_table", NYdb::NTable::TReadTableSettings{}.Ordered(true),
+          {/*max_parallelism=*/2});
+
+  ASSERT_EQ(rows.size(), kRowsCount);
+  EXPECT_TRUE(std::is_sorted(rows.begin(), rows.end(),
+                             [](const auto& lhs, const auto& rhs) {
+                               return lhs.key < rhs.key;
+                             }));
+  for (const auto& [index, row] : utils::enumerate(rows)) {
+    EXPECT_EQ(row.value, std::to_string(index));
+  }
+}
+
+UTEST_F(YdbParallelRead, ReadTableParallelStats) {
+  CreatePartitionedTable();
+
+  engine::Mutex mutex;
+  std::size_t rows_count = 0;
+  const auto stats = GetTableClient().ReadTableParallel(
+      "partitioned_table", {},
+      [&](std::size_t partition, ydb::Cursor&& cursor) {
+        EXPECT_LT(partition, kPartitionsCount);
+        const std::lock_guard lock{mutex};
+        rows_count += cursor.size();
+      });
+
+  EXPECT_EQ(rows_count, kRowsCount);
+  ASSERT_EQ(stats.size(), kPartitionsCount);
+  std::size_t stats_rows_count = 0;
+  for (const auto& [index, partition_stats] : utils::enumerate(stats)) {
+    EXPECT_EQ(partition_stats.partition, index);
+    EXPECT_GT(partition_stats.rows, 0);
+    stats_rows_count += partition_stats.rows;
+  }
+  EXPECT_EQ(stats_rows_count, kRowsCount);
+}
+
+UTEST_F(YdbParallelRead, SinglePartition) {
+  CreateTable("test_table", true);
+
+  const auto rows = GetTableClient().ReadTableParallelAs<tests::RowValue>(
+      "test_table", NYdb::NTable::TReadTableSettings{}.Ordered(true));
+  ASSERT_EQ(rows.size(), kPreFilledRows.size());
+  for (const auto& [index, row] : utils::enumerate(rows)) {
+    EXPECT_EQ(row.key, kPreFilledRows[index].key);
+  }
+}
+
+UTEST_F(YdbParallelRead, ScanQueryFanOut) {
+  CreateTable("test_table", true);
+
+  const ydb::Query query{R"(
+    --!syntax_v1
+    DECLARE $key AS String;
+    SELECT key, value_str, value_int FROM test_table WHERE key = $key;
+  )"};
+
+  std::vector<ydb::PreparedArgsBuilder> shards;
+  for (const auto& row : kPreFilledRows) {
+    auto builder = GetTableClient().GetBuilder();
+    builder.Add("$key", row.key);
+    shards.push_back(std::move(builder));
+  }
+
+  std::vector<std::vector<tests::RowValue>> results(shards.size());
+  const auto stats = GetTableClient().ExecuteScanQueryParallel(
+      {}, query, std::move(shards),
+      [&](std::size_t shard, ydb::Cursor&& cursor) {
+        for (auto row : cursor) {
+          results[shard].push_back(std::move(row).As<tests::RowValue>());
+        }
+      });
+
+  ASSERT_EQ(stats.size(), kPreFilledRows.size());
+  for (const auto& [index, shard_rows] : utils::enumerate(results)) {
+    ASSERT_EQ(shard_rows.size(), 1);
+    EXPECT_EQ(shard_rows.front().key, kPreFilledRows[index].key);
+    EXPECT_EQ(stats[index].rows, 1);
+  }
+}
+
+USERVER_NAMESPACE_END
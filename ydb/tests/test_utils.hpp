@@ -33,6 +33,10 @@ class TestClientsBase {
 
   ydb::TableClient& GetTableClient() { return *table_client_; }
 
+  std::shared_ptr<ydb::TableClient> GetTableClientPtr() {
+    return table_client_;
+  }
+
   NYdb::NTable::TTableClient& GetNativeTableClient() {
     return table_client_->GetNativeTableClient();
   }